@@ -0,0 +1,23 @@
+HEADERS = \
+    include/octree/Octree.h \
+    include/octree/CompactOctree.h \
+    include/octree/FileIO.h
+
+SOURCES = \
+    src/Octree.cpp \
+    src/CompactOctree.cpp \
+    benchmark/benchmark_octree.cpp \
+    src/FileIO.cpp
+
+INCLUDEPATH += include
+INCLUDEPATH += ../includes
+TEMPLATE = app
+CONFIG -= qt
+CONFIG -= app_bundle
+TARGET = octree-benchmark
+CONFIG += c++11
+DEFINES += PROJECT_SOURCE_DIR=\\\"$$absolute_path(".")\\\"
+windows:{
+    QMAKE_LFLAGS += -static
+    CONFIG += windows console
+}
@@ -1,11 +1,13 @@
 HEADERS = \
     include/octree/Octree.h \
+    include/octree/CompactOctree.h \
     include/octree/FileIO.h
 
 
 SOURCES = \
     ../gtest/src/gtest-all.cc \
     src/Octree.cpp \
+    src/CompactOctree.cpp \
     src/FileIO.cpp \
     test/test_octree.cpp
 
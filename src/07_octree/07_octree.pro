@@ -1,9 +1,11 @@
 HEADERS = \
     include/octree/Octree.h \
+    include/octree/CompactOctree.h \
     include/octree/FileIO.h
 
 SOURCES = \
     src/Octree.cpp \
+    src/CompactOctree.cpp \
     src/main.cpp \
     src/FileIO.cpp
 
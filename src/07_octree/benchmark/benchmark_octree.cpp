@@ -0,0 +1,168 @@
+#include <octree/Octree.h>
+#include <octree/CompactOctree.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace octree;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * \brief Samples points on the walls, floor and ceiling of a room and on the surfaces of some boxes.
+ */
+std::vector<Eigen::Vector3d> roomPointCloud(const size_t numPoints, unsigned int seed) {
+	// room of 8 m x 6 m x 3 m and some furniture given by minimum and maximum corners
+	const double boxes[4][6] = {
+		{ 0.0, 0.0, 0.0, 8.0, 6.0, 3.0 },
+		{ 1.0, 1.0, 0.0, 3.0, 2.0, 0.8 },
+		{ 5.0, 3.5, 0.0, 5.6, 5.5, 2.0 },
+		{ 6.5, 0.5, 0.0, 7.5, 1.5, 1.1 }
+	};
+	std::vector<Eigen::Vector3d> points;
+	points.reserve(numPoints);
+	while (points.size() < numPoints) {
+		seed = seed * 1103515245u + 12345u;
+		const double* box = boxes[(seed >> 16) % 4 == 0 ? (seed >> 8) % 3 + 1 : 0];
+		Eigen::Vector3d point;
+		for (int i = 0; i < 3; ++i) {
+			seed = seed * 1103515245u + 12345u;
+			point(i) = box[i] + (box[i + 3] - box[i]) * ((seed >> 8) & 0xFFFF) / 65536.0;
+		}
+		// project onto one of the six faces
+		seed = seed * 1103515245u + 12345u;
+		const int face = (seed >> 16) % 6;
+		point(face % 3) = box[face % 3 + (face / 3) * 3];
+		points.push_back(point);
+	}
+	return points;
+}
+
+size_t countNodes(const Node * const node) {
+	size_t count = 1;
+	for (size_t i = 0; i < 8; ++i) {
+		if (node->children[i]) {
+			count += countNodes(node->children[i]);
+		}
+	}
+	return count;
+}
+
+double milliseconds(const Clock::time_point& begin) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+}
+
+void print(const std::string& name, const size_t numPoints, const double time, const size_t nodes, const size_t bytes) {
+	std::cout << "  " << std::left << std::setw(18) << name << std::right
+			<< std::setw(10) << std::fixed << std::setprecision(1) << time << " ms"
+			<< std::setw(12) << std::setprecision(2) << numPoints / time / 1000.0 << " Mpts/s"
+			<< std::setw(12) << nodes << " nodes"
+			<< std::setw(10) << std::setprecision(1) << bytes / 1048576.0 << " MiB" << std::endl;
+}
+
+/**
+ * \brief Compares castRays() with sampling each ray in fixed steps using findNode().
+ *
+ * Sampling can step over the corner of an occupied cube and then reports a later hit or none,
+ * such rays are counted as skipped.
+ */
+void benchmarkRayCasting(const Octree& octree, const size_t numRays) {
+	const Eigen::Vector3d origin(4.0, 3.0, 1.5);
+	const double maxRange = 15.0;
+	const double step = (octree.root->corner2(0) - octree.root->corner1(0)) / (1 << octree.maxDepth) / 2;
+	std::vector<Eigen::Vector3d> directions;
+	unsigned int seed = 7;
+	while (directions.size() < numRays) {
+		Eigen::Vector3d direction;
+		for (int i = 0; i < 3; ++i) {
+			seed = seed * 1103515245u + 12345u;
+			direction(i) = ((seed >> 8) & 0xFFFF) / 32768.0 - 1.0;
+		}
+		if (direction.norm() > 0.1) {
+			directions.push_back(direction.normalized());
+		}
+	}
+
+	Clock::time_point begin = Clock::now();
+	std::vector<double> ranges;
+	octree.castRays(origin, directions, maxRange, ranges);
+	const double castTime = milliseconds(begin);
+
+	begin = Clock::now();
+	size_t skipped = 0;
+	for (size_t r = 0; r < directions.size(); ++r) {
+		double range = -1;
+		for (double t = 0; t <= maxRange; t += step) {
+			const Node * const node = octree.findNode(origin + t * directions[r]);
+			if (node->content == OCCUPIED) {
+				range = t;
+				break;
+			}
+		}
+		if ((range < 0) != (ranges[r] < 0) || std::fabs(range - ranges[r]) > step) {
+			++skipped;
+		}
+	}
+	const double sampleTime = milliseconds(begin);
+
+	std::cout << "  " << numRays << " rays: castRays " << std::fixed << std::setprecision(1) << castTime
+			<< " ms, fixed-step findNode (" << std::setprecision(3) << step * 100 << " cm steps) "
+			<< std::setprecision(1) << sampleTime << " ms, " << skipped << " rays skipped a cube" << std::endl;
+}
+
+}  // namespace
+
+/*
+ * Usage: octree-benchmark [number of points] [maximum depth] [number of rays]
+ *
+ * Inserts a synthetic point cloud of a room (8 m x 6 m x 3 m) into a root cube with an edge
+ * length of 10.24 m, so maximum depth 9 corresponds to 2 cm cubes and depth 10 to 1 cm cubes.
+ * Configure with -DCMAKE_BUILD_TYPE=Release, Eigen is very slow without optimization.
+ */
+int main(int argc, char **argv) {
+	const size_t numPoints = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	const unsigned int maxDepth = argc > 2 ? std::atoi(argv[2]) : 9;
+	const size_t numRays = argc > 3 ? std::atoi(argv[3]) : 10000;
+	const Eigen::Vector3d corner1(-1.0, -1.0, -1.0);
+	const Eigen::Vector3d corner2(9.24, 9.24, 9.24);
+
+	const std::vector<Eigen::Vector3d> points = roomPointCloud(numPoints, 42);
+	std::cout << numPoints << " points, maximum depth " << maxDepth << " ("
+			<< std::setprecision(2) << std::fixed << 1024.0 / (1 << maxDepth) << " cm cubes)" << std::endl;
+
+	{
+		Octree octree(corner1, corner2, maxDepth);
+		const Clock::time_point begin = Clock::now();
+		for (size_t i = 0; i < points.size(); ++i) {
+			octree.insertPoint(points[i]);
+		}
+		const double time = milliseconds(begin);
+		const size_t nodes = countNodes(octree.root);
+		// each node is a separate heap allocation with at least 16 bytes of allocator overhead
+		print("Octree", numPoints, time, nodes, nodes * (sizeof(Node) + 16));
+	}
+	{
+		Octree octree(corner1, corner2, maxDepth);
+		const Clock::time_point begin = Clock::now();
+		octree.insertPointCloud(points);
+		const double time = milliseconds(begin);
+		const size_t nodes = countNodes(octree.root);
+		print("insertPointCloud", numPoints, time, nodes, nodes * (sizeof(Node) + 16));
+		benchmarkRayCasting(octree, numRays);
+	}
+	{
+		CompactOctree octree(corner1, corner2, maxDepth);
+		const Clock::time_point begin = Clock::now();
+		for (size_t i = 0; i < points.size(); ++i) {
+			octree.insertPoint(points[i]);
+		}
+		const double time = milliseconds(begin);
+		print("CompactOctree", numPoints, time, octree.getNumNodes(), octree.getMemoryUsage());
+	}
+	return 0;
+}
@@ -0,0 +1,135 @@
+#ifndef OCTREE_COMPACTOCTREE_H_
+#define OCTREE_COMPACTOCTREE_H_
+
+#include <vector>
+#include <stdint.h>
+#include <octree/Octree.h>
+
+namespace octree {
+
+/**
+ * \brief Lightweight handle of a node in a CompactOctree.
+ *
+ * The node is identified by its depth and its Morton key: the key consists of the child
+ * indices (see Node::findIndex()) on the path from the root, three bits per level, with the
+ * index of the first level in the most significant position. The root has depth 0 and key 0.
+ */
+struct CompactNode {
+	uint64_t key;          ///< Morton key of the node (3 * depth bits).
+	unsigned int depth;    ///< Depth of the node within the tree (0 = root node).
+	Content content;       ///< Content label of the node (FREE, OCCUPIED, or MIXED).
+
+	CompactNode() : key(0), depth(0), content(FREE) {};
+	CompactNode(const uint64_t key, const unsigned int depth, const Content content)
+	: key(key), depth(depth), content(content) {};
+
+	bool operator==(const CompactNode& other) const {
+		return key == other.key && depth == other.depth && content == other.content;
+	}
+};
+
+/**
+ * \brief Memory-efficient octree with the same insertion semantics as Octree.
+ *
+ * The bounds of a node are not stored but computed from its depth and key. The eight children
+ * of a node are stored together in one block of a pool. Each child is described by a 32-bit
+ * entry: the lower two bits hold the content code (the value of the Content enumeration), the
+ * upper 30 bits hold the index of the child's own block if the child is MIXED. A node thus
+ * needs 4 bytes, compared to more than 100 bytes for a Node. Blocks released by merging are
+ * reused by later splits.
+ *
+ * A point that lies exactly on the boundary between two cubes belongs to the lower cube, as in
+ * Node::findIndex(). Since the cube of a point is computed directly instead of by comparing
+ * with the centers of the nodes along the path, points within rounding error of a boundary can
+ * end up in a different cube than in an Octree. Points outside the root cube are assigned to
+ * the nearest cube at the border.
+ */
+class CompactOctree {
+public:
+	static const unsigned int MAX_DEPTH = 21;   ///< Maximum supported depth (3 * 21 bits fit into a key).
+
+	const Eigen::Vector3d corner1;   ///< Coordinates of the first (minimum) corner of the root cube
+	const Eigen::Vector3d corner2;   ///< Coordinates of the opposite (maximum) corner of the root cube
+	const unsigned int maxDepth;     ///< Maximum depth of the tree, limiting the minimum cube size
+
+	/**
+	 * \brief Constructor
+	 * \param[in] corner1 Coordinates of the minimum corner of the root cube
+	 * \param[in] corner2 Coordinates of the maximum corner of the root cube
+	 * \param[in] maxDepth Maximum depth of the tree
+	 * \throws std::invalid_argument if corner2 is not larger than corner1 in all coordinates or maxDepth exceeds MAX_DEPTH
+	 */
+	CompactOctree(const Eigen::Vector3d& corner1, const Eigen::Vector3d& corner2, const unsigned int maxDepth);
+
+	bool insertPoint(const Eigen::Vector3d& point);
+	CompactNode findNode(const Eigen::Vector3d& point) const;
+
+	/**
+	 * \brief Computes the Morton key of the cube at maximum depth that contains a point.
+	 * \param[in] point The 3D point
+	 * \return The key of the cube with depth maxDepth containing the point.
+	 */
+	uint64_t computeKey(const Eigen::Vector3d& point) const;
+
+	/**
+	 * \brief Computes the bounds of a node.
+	 * \param[in] node The node
+	 * \param[out] nodeCorner1 The minimum corner of the node's cube
+	 * \param[out] nodeCorner2 The maximum corner of the node's cube
+	 */
+	void getBounds(const CompactNode& node, Eigen::Vector3d& nodeCorner1, Eigen::Vector3d& nodeCorner2) const;
+
+	/**
+	 * \brief Collects the nodes of the tree in depth-first order (parents before their children).
+	 * \param[out] nodes The nodes
+	 * \param[in] leavesOnly If true, only nodes without children are returned.
+	 */
+	void getNodes(std::vector<CompactNode>& nodes, const bool leavesOnly = false) const;
+
+	/**
+	 * \brief Returns the number of nodes in the tree.
+	 * \return The number of nodes, including the root.
+	 */
+	size_t getNumNodes() const {
+		return 1 + 8 * (blocks.size() - freeBlocks.size());
+	}
+
+	/**
+	 * \brief Returns the number of bytes allocated for the tree structure.
+	 * \return The allocated memory in bytes.
+	 */
+	size_t getMemoryUsage() const {
+		return sizeof(*this) + blocks.capacity() * sizeof(Block) + freeBlocks.capacity() * sizeof(uint32_t);
+	}
+
+private:
+	struct Block {
+		uint32_t children[8];
+	};
+
+	static const uint32_t CONTENT_MASK = 3;
+
+	static Content contentOf(const uint32_t entry) {
+		return static_cast<Content>(entry & CONTENT_MASK);
+	}
+	static uint32_t blockOf(const uint32_t entry) {
+		return entry >> 2;
+	}
+	static uint32_t mixedEntry(const uint32_t block) {
+		return (block << 2) | MIXED;
+	}
+
+	uint32_t allocateBlock();
+	void releaseBlock(const uint32_t block);
+	void collectNodes(const uint32_t entry, const uint64_t key, const unsigned int depth,
+			std::vector<CompactNode>& nodes, const bool leavesOnly) const;
+
+	uint32_t root;                     ///< Entry of the root node
+	std::vector<Block> blocks;         ///< Pool of child blocks
+	std::vector<uint32_t> freeBlocks;  ///< Indices of unused blocks in the pool
+	Eigen::Vector3d scale;             ///< Number of cubes at maximum depth per unit length
+};
+
+}  // namespace octree
+
+#endif  // OCTREE_COMPACTOCTREE_H_
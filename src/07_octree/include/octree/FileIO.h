@@ -4,6 +4,7 @@
 #include <string>
 #include <fstream>
 #include <octree/Octree.h>
+#include <octree/CompactOctree.h>
 
 namespace octree {
 
@@ -21,6 +22,13 @@ public:
 	 * @return True if the file was written successfully.
 	 */
 	bool writeToFile(const Octree& oc, const std::string &filename);
+	/**
+	 * Write a compact octree to a file, in the same format as for an Octree.
+	 * @param oc Compact octree.
+	 * @param filename Name of the output file.
+	 * @return True if the file was written successfully.
+	 */
+	bool writeToFile(const CompactOctree& oc, const std::string &filename);
 	/**
 	 * Returns the number of written nodes after saving an octree to a file using writeToFile().
 	 * @return Number of nodes.
@@ -29,6 +37,8 @@ public:
 
 private:
 	void writeNode(std::ofstream& ofs, const Node * const node);
+	void writeNode(std::ofstream& ofs, const Eigen::Vector3d& corner1, const Eigen::Vector3d& corner2,
+			const unsigned int depth, const Content content);
 	int numWritten;
 };
 
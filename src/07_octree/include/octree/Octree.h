@@ -1,6 +1,8 @@
 #ifndef OCTREE_H_
 #define OCTREE_H_
 
+#include <vector>
+#include <stdint.h>
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
@@ -97,7 +99,20 @@ public:
 	}
 
 	bool insertPoint(const Eigen::Vector3d& point);
+	bool insertPointCloud(const std::vector<Eigen::Vector3d>& points);
 	Node * findNode(const Eigen::Vector3d& point) const;
+	bool castRay(const Eigen::Vector3d& origin, const Eigen::Vector3d& direction, const double maxRange, double& range) const;
+	void castRays(const Eigen::Vector3d& origin, const std::vector<Eigen::Vector3d>& directions, const double maxRange,
+			std::vector<double>& ranges) const;
+
+private:
+	Octree(const Octree&);
+	Octree& operator=(const Octree&);
+
+	uint64_t computeKey(const Eigen::Vector3d& point) const;
+	bool insertKeys(Node * const node, const uint64_t * const begin, const uint64_t * const end, const bool parallel);
+	double castRay(const Node * const node, const Eigen::Vector3d& origin, const Eigen::Vector3d& direction,
+			const Eigen::Vector3d& inverseDirection, const double t0, const double t1) const;
 };
 
 
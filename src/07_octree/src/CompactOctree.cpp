@@ -0,0 +1,191 @@
+#include <octree/CompactOctree.h>
+#include <cmath>
+#include <stdexcept>
+
+namespace octree {
+
+namespace {
+
+/**
+ * \brief Spreads the lower 21 bits of a value so that bit i moves to bit 3 * i.
+ */
+uint64_t spreadBits(uint64_t value) {
+	value &= 0x1FFFFFull;
+	value = (value | (value << 32)) & 0x001F00000000FFFFull;
+	value = (value | (value << 16)) & 0x001F0000FF0000FFull;
+	value = (value | (value << 8))  & 0x100F00F00F00F00Full;
+	value = (value | (value << 4))  & 0x10C30C30C30C30C3ull;
+	value = (value | (value << 2))  & 0x1249249249249249ull;
+	return value;
+}
+
+/**
+ * \brief Inverse of spreadBits(): collects every third bit of a value.
+ */
+uint64_t compactBits(uint64_t value) {
+	value &= 0x1249249249249249ull;
+	value = (value | (value >> 2))  & 0x10C30C30C30C30C3ull;
+	value = (value | (value >> 4))  & 0x100F00F00F00F00Full;
+	value = (value | (value >> 8))  & 0x001F0000FF0000FFull;
+	value = (value | (value >> 16)) & 0x001F00000000FFFFull;
+	value = (value | (value >> 32)) & 0x1FFFFFull;
+	return value;
+}
+
+}  // namespace
+
+CompactOctree::CompactOctree(const Eigen::Vector3d& corner1, const Eigen::Vector3d& corner2, const unsigned int maxDepth)
+: corner1(corner1), corner2(corner2), maxDepth(maxDepth), root(FREE) {
+	if (!(corner1.array() < corner2.array()).all()) {
+		throw std::invalid_argument("CompactOctree: corner2 has to be larger than corner1 in all coordinates");
+	}
+	if (maxDepth > MAX_DEPTH) {
+		throw std::invalid_argument("CompactOctree: maxDepth is too large");
+	}
+	scale = Eigen::Vector3d::Constant(std::ldexp(1.0, maxDepth)).cwiseQuotient(corner2 - corner1);
+}
+
+/**
+ * \brief Computes the Morton key of the cube at maximum depth that contains a point.
+ * \param[in] point The 3D point
+ * \return The key of the cube with depth maxDepth containing the point.
+ */
+uint64_t CompactOctree::computeKey(const Eigen::Vector3d& point) const {
+	const int64_t maxIndex = (int64_t(1) << maxDepth) - 1;
+	uint64_t key = 0;
+	for (int i = 0; i < 3; ++i) {
+		// ceil() - 1 assigns points on a boundary to the lower cube
+		int64_t index = static_cast<int64_t>(std::ceil((point(i) - corner1(i)) * scale(i))) - 1;
+		if (index < 0) {
+			index = 0;
+		} else if (index > maxIndex) {
+			index = maxIndex;
+		}
+		key |= spreadBits(static_cast<uint64_t>(index)) << i;
+	}
+	return key;
+}
+
+void CompactOctree::getBounds(const CompactNode& node, Eigen::Vector3d& nodeCorner1, Eigen::Vector3d& nodeCorner2) const {
+	const Eigen::Vector3d size = (corner2 - corner1) / std::ldexp(1.0, node.depth);
+	for (int i = 0; i < 3; ++i) {
+		const double index = static_cast<double>(compactBits(node.key >> i));
+		nodeCorner1(i) = corner1(i) + index * size(i);
+		nodeCorner2(i) = corner1(i) + (index + 1) * size(i);
+	}
+}
+
+uint32_t CompactOctree::allocateBlock() {
+	uint32_t block;
+	if (!freeBlocks.empty()) {
+		block = freeBlocks.back();
+		freeBlocks.pop_back();
+	} else {
+		block = static_cast<uint32_t>(blocks.size());
+		blocks.push_back(Block());
+	}
+	for (size_t i = 0; i < 8; ++i) {
+		blocks[block].children[i] = FREE;
+	}
+	return block;
+}
+
+void CompactOctree::releaseBlock(const uint32_t block) {
+	freeBlocks.push_back(block);
+}
+
+/**
+ * \brief Inserts a new point into the octree and marks the corresponding cell as occupied.
+ * \param[in] point The 3D point to insert into the octree.
+ * \return true if the point has been successfully inserted, false otherwise
+ *
+ * The resulting tree is the same as for Octree::insertPoint().
+ */
+bool CompactOctree::insertPoint(const Eigen::Vector3d& point) {
+	const uint64_t key = computeKey(point);
+	uint32_t path[MAX_DEPTH];   // blocks holding the children of the nodes along the path
+	uint32_t entry = root;
+
+	// Descend to the cube at maximum depth, splitting FREE nodes on the way
+	for (unsigned int depth = 0; depth < maxDepth; ++depth) {
+		const Content content = contentOf(entry);
+		if (content == OCCUPIED) {
+			return true;
+		}
+		uint32_t block;
+		if (content == FREE) {
+			block = allocateBlock();
+			if (depth == 0) {
+				root = mixedEntry(block);
+			} else {
+				blocks[path[depth - 1]].children[(key >> (3 * (maxDepth - depth))) & 7] = mixedEntry(block);
+			}
+		} else {
+			block = blockOf(entry);
+		}
+		path[depth] = block;
+		entry = blocks[block].children[(key >> (3 * (maxDepth - 1 - depth))) & 7];
+	}
+	if (contentOf(entry) == OCCUPIED) {
+		return true;
+	}
+	if (maxDepth == 0) {
+		root = OCCUPIED;
+		return true;
+	}
+	blocks[path[maxDepth - 1]].children[key & 7] = OCCUPIED;
+
+	// Traverse the tree towards the root and merge cells
+	for (unsigned int depth = maxDepth; depth > 0; --depth) {
+		const Block& block = blocks[path[depth - 1]];
+		for (size_t i = 0; i < 8; ++i) {
+			if (block.children[i] != OCCUPIED) {
+				return true;
+			}
+		}
+		releaseBlock(path[depth - 1]);
+		if (depth == 1) {
+			root = OCCUPIED;
+		} else {
+			blocks[path[depth - 2]].children[(key >> (3 * (maxDepth - depth + 1))) & 7] = OCCUPIED;
+		}
+	}
+	return true;
+}
+
+/**
+ * \brief Traverses the tree from the root to find the leaf that contains a given point.
+ * \param[in] point The 3D point
+ * \return Handle of the leaf containing the given 3D point
+ */
+CompactNode CompactOctree::findNode(const Eigen::Vector3d& point) const {
+	const uint64_t key = computeKey(point);
+	uint32_t entry = root;
+	unsigned int depth = 0;
+	while (contentOf(entry) == MIXED) {
+		entry = blocks[blockOf(entry)].children[(key >> (3 * (maxDepth - 1 - depth))) & 7];
+		++depth;
+	}
+	return CompactNode(key >> (3 * (maxDepth - depth)), depth, contentOf(entry));
+}
+
+void CompactOctree::getNodes(std::vector<CompactNode>& nodes, const bool leavesOnly) const {
+	nodes.clear();
+	collectNodes(root, 0, 0, nodes, leavesOnly);
+}
+
+void CompactOctree::collectNodes(const uint32_t entry, const uint64_t key, const unsigned int depth,
+		std::vector<CompactNode>& nodes, const bool leavesOnly) const {
+	const Content content = contentOf(entry);
+	if (content != MIXED || !leavesOnly) {
+		nodes.push_back(CompactNode(key, depth, content));
+	}
+	if (content == MIXED) {
+		const Block& block = blocks[blockOf(entry)];
+		for (uint64_t i = 0; i < 8; ++i) {
+			collectNodes(block.children[i], (key << 3) | i, depth + 1, nodes, leavesOnly);
+		}
+	}
+}
+
+}  // namespace octree
@@ -19,14 +19,42 @@ bool FileIO::writeToFile(const Octree& oc, const std::string& filename) {
 	return true;
 }
 
+bool FileIO::writeToFile(const CompactOctree& oc, const std::string& filename) {
+	std::ofstream ofs(filename.c_str());
+	if (!ofs.good()) {
+		std::cerr << "Could not open file " << filename << " for writing results" << std::endl;
+		return false;
+	}
+
+	numWritten = 0;
+	std::vector<CompactNode> nodes;
+	oc.getNodes(nodes);
+	Eigen::Vector3d corner1, corner2;
+	for (size_t i = 0; i < nodes.size() && numWritten <= 1000; ++i) {
+		oc.getBounds(nodes[i], corner1, corner2);
+		writeNode(ofs, corner1, corner2, nodes[i].depth, nodes[i].content);
+	}
+
+	ofs.close();
+	return true;
+}
+
 void FileIO::writeNode(std::ofstream& ofs, const Node *node) {
 	if (!node || numWritten > 1000) {
 		return;
 	}
-	ofs << node->corner1(0) << " " << node->corner1(1) << " " << node->corner1(2) << " " <<
-		   node->corner2(0) << " " << node->corner2(1) << " " << node->corner2(2) << " " <<
-		   node->depth << " ";
-	switch (node->content) {
+	writeNode(ofs, node->corner1, node->corner2, node->depth, node->content);
+	for (size_t i = 0; i < 8; ++i) {
+		writeNode(ofs, node->children[i]);
+	}
+}
+
+void FileIO::writeNode(std::ofstream& ofs, const Eigen::Vector3d& corner1, const Eigen::Vector3d& corner2,
+		const unsigned int depth, const Content content) {
+	ofs << corner1(0) << " " << corner1(1) << " " << corner1(2) << " " <<
+		   corner2(0) << " " << corner2(1) << " " << corner2(2) << " " <<
+		   depth << " ";
+	switch (content) {
 	case FREE: ofs << "FREE"; break;
 	case OCCUPIED: ofs << "OCCUPIED"; break;
 	case MIXED: ofs << "MIXED"; break;
@@ -34,9 +62,6 @@ void FileIO::writeNode(std::ofstream& ofs, const Node *node) {
 	}
 	ofs << std::endl;
 	++numWritten;
-	for (size_t i = 0; i < 8; ++i) {
-		writeNode(ofs, node->children[i]);
-	}
 }
 
 }  // namespace octree
@@ -1,8 +1,60 @@
 #include <octree/Octree.h>
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <thread>
 
 namespace octree {
 
+namespace {
+
+/**
+ * \brief Returns the index (0-7) of the child cube of a cube that contains a given 3D point.
+ */
+unsigned int childIndex(const Eigen::Vector3d& corner1, const Eigen::Vector3d& corner2, const Eigen::Vector3d& point) {
+	const Eigen::Vector3d center = (corner2 + corner1) / 2;
+	unsigned int index = 0;
+	for (int i = 2; i >= 0; i--) {
+		index <<= 1;
+		index += center(i) < point(i) ? 1 : 0;
+	}
+	return index;
+}
+
+/**
+ * \brief Computes the corners of a child cube.
+ *
+ * Node::split() and Octree::insertPointCloud() both use this function, so that the same
+ * cube always gets exactly the same corners.
+ */
+void childCorners(const Eigen::Vector3d& corner1, const Eigen::Vector3d& corner2, const unsigned int index,
+		Eigen::Vector3d& childCorner1, Eigen::Vector3d& childCorner2) {
+	const Eigen::Vector3d half = (corner2 - corner1) / 2;
+	childCorner1 = corner1;
+	for (int i = 0; i < 3; ++i) {
+		if (index & (1u << i)) {
+			childCorner1(i) += half(i);
+		}
+	}
+	childCorner2 = childCorner1 + half;
+}
+
+/**
+ * \brief Creates 8 free children for a leaf and marks the leaf as MIXED.
+ */
+void splitFree(Node * const node) {
+	node->content = MIXED;
+	Eigen::Vector3d childCorner1, childCorner2;
+	for (unsigned int i = 0; i < 8; ++i) {
+		childCorners(node->corner1, node->corner2, i, childCorner1, childCorner2);
+		node->children[i] = new Node(childCorner1, childCorner2, node, node->depth + 1, FREE);
+	}
+}
+
+}  // namespace
+
 /**
  * \brief Inserts a new point into the octree and marks the corresponding cell as occupied.
  * \param[in] point The 3D point to insert into the octree.
@@ -51,6 +103,313 @@ bool Octree::insertPoint(const Eigen::Vector3d& point) {
 	return true;
 }
 
+/**
+ * \brief Inserts a point cloud into the octree and marks the corresponding cells as occupied.
+ * \param[in] points The 3D points to insert into the octree.
+ * \return true if the points have been successfully inserted, false otherwise
+ *
+ * The resulting tree is identical to the one obtained by calling insertPoint() for each point.
+ * Instead of traversing the tree for every point, the method computes the Morton key of the
+ * cell at maximum depth for each point, sorts and deduplicates the keys, and then builds the
+ * affected subtrees in one recursive pass, merging each node at most once. The eight octants
+ * of the root are processed in parallel.
+ */
+bool Octree::insertPointCloud(const std::vector<Eigen::Vector3d>& points) {
+	if (points.empty()) {
+		return true;
+	}
+	if (maxDepth == 0 || 3 * maxDepth > 63) {
+		// keys do not fit into 64 bits (or there is nothing to sort)
+		bool result = true;
+		for (size_t i = 0; i < points.size(); ++i) {
+			result = insertPoint(points[i]) && result;
+		}
+		return result;
+	}
+
+	const bool parallel = points.size() >= 4096;
+	std::vector<uint64_t> keys(points.size());
+	if (parallel) {
+		size_t numThreads = std::thread::hardware_concurrency();
+		if (numThreads == 0) {
+			numThreads = 1;
+		}
+		numThreads = std::min(numThreads, points.size());
+		const size_t chunk = (points.size() + numThreads - 1) / numThreads;
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < numThreads; ++t) {
+			const size_t begin = std::min(points.size(), t * chunk);
+			const size_t end = std::min(points.size(), begin + chunk);
+			threads.push_back(std::thread([this, &points, &keys, begin, end] {
+				for (size_t i = begin; i < end; ++i) {
+					keys[i] = computeKey(points[i]);
+				}
+			}));
+		}
+		for (size_t t = 0; t < threads.size(); ++t) {
+			threads[t].join();
+		}
+	} else {
+		for (size_t i = 0; i < points.size(); ++i) {
+			keys[i] = computeKey(points[i]);
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	insertKeys(root, &keys[0], &keys[0] + keys.size(), parallel);
+	return true;
+}
+
+/**
+ * \brief Computes the Morton key of the cell at maximum depth that insertPoint() would use for a point.
+ * \param[in] point The 3D point
+ * \return The child indices along the path from the root, three bits per level, first level first.
+ */
+uint64_t Octree::computeKey(const Eigen::Vector3d& point) const {
+	Eigen::Vector3d corner1 = root->corner1;
+	Eigen::Vector3d corner2 = root->corner2;
+	Eigen::Vector3d childCorner1, childCorner2;
+	uint64_t key = 0;
+	for (unsigned int depth = 0; depth < maxDepth; ++depth) {
+		const unsigned int index = childIndex(corner1, corner2, point);
+		key = (key << 3) | index;
+		childCorners(corner1, corner2, index, childCorner1, childCorner2);
+		corner1 = childCorner1;
+		corner2 = childCorner2;
+	}
+	return key;
+}
+
+/**
+ * \brief Marks the cells of a sorted range of keys in the subtree of a node as occupied.
+ * \param[in] node The root of the subtree
+ * \param[in] begin First key of the range, all keys in the range lie within the node
+ * \param[in] end End of the range
+ * \param[in] parallel Process the children of the node in separate threads
+ * \return True if the node changed its content to OCCUPIED.
+ *
+ * A node is merged if one of its children became OCCUPIED and all children are OCCUPIED
+ * afterwards, which is exactly when insertPoint() would merge it.
+ */
+bool Octree::insertKeys(Node * const node, const uint64_t * const begin, const uint64_t * const end, const bool parallel) {
+	if (node->content == OCCUPIED) {
+		return false;
+	}
+	if (node->depth >= maxDepth) {
+		node->content = OCCUPIED;
+		return true;
+	}
+	if (!node->children[0]) {
+		splitFree(node);
+	}
+
+	// The keys are sorted, so the keys of each child form a contiguous range.
+	const unsigned int shift = 3 * (maxDepth - 1 - node->depth);
+	const uint64_t *ranges[9];
+	const uint64_t *it = begin;
+	for (unsigned int i = 0; i < 8; ++i) {
+		ranges[i] = it;
+		while (it != end && ((*it >> shift) & 7) == i) {
+			++it;
+		}
+	}
+	ranges[8] = end;
+
+	bool changed[8] = { false, false, false, false, false, false, false, false };
+	if (parallel) {
+		std::vector<std::thread> threads;
+		for (unsigned int i = 0; i < 8; ++i) {
+			if (ranges[i] != ranges[i + 1]) {
+				threads.push_back(std::thread([this, node, &ranges, &changed, i] {
+					changed[i] = insertKeys(node->children[i], ranges[i], ranges[i + 1], false);
+				}));
+			}
+		}
+		for (size_t t = 0; t < threads.size(); ++t) {
+			threads[t].join();
+		}
+	} else {
+		for (unsigned int i = 0; i < 8; ++i) {
+			if (ranges[i] != ranges[i + 1]) {
+				changed[i] = insertKeys(node->children[i], ranges[i], ranges[i + 1], false);
+			}
+		}
+	}
+
+	bool anyChanged = false;
+	for (unsigned int i = 0; i < 8; ++i) {
+		if (changed[i]) {
+			anyChanged = true;
+		} else if (node->children[i]->content != OCCUPIED) {
+			return false;
+		}
+	}
+	return anyChanged && node->merge();
+}
+
+/**
+ * \brief Casts a ray through the octree and returns the distance to the first occupied cube.
+ * \param[in] origin The start point of the ray
+ * \param[in] direction The direction of the ray (does not need to be normalized)
+ * \param[in] maxRange The maximum length of the ray
+ * \param[out] range The distance from the origin to the point where the ray enters the first
+ *             occupied cube (0 if the origin is occupied), unchanged if there is no hit.
+ * \return true if the ray hits an occupied cube within maxRange, false otherwise
+ * \throws std::invalid_argument if direction is zero
+ *
+ * The ray is traversed parametrically through the tree: the method descends into the children
+ * of a MIXED node in the order in which the ray passes through them, so that large FREE or
+ * OCCUPIED cubes are crossed in a single step.
+ */
+bool Octree::castRay(const Eigen::Vector3d& origin, const Eigen::Vector3d& direction, const double maxRange, double& range) const {
+	const double length = direction.norm();
+	if (!(length > 0)) {
+		throw std::invalid_argument("Octree::castRay(): direction is zero");
+	}
+	const Eigen::Vector3d dir = direction / length;
+	const Eigen::Vector3d inverseDirection = dir.cwiseInverse();
+
+	// Clip the ray against the root cube
+	const Eigen::Vector3d lower = root->corner1.cwiseMin(root->corner2);
+	const Eigen::Vector3d upper = root->corner1.cwiseMax(root->corner2);
+	double t0 = 0;
+	double t1 = maxRange;
+	for (int i = 0; i < 3; ++i) {
+		if (dir(i) == 0) {
+			if (origin(i) < lower(i) || origin(i) > upper(i)) {
+				return false;
+			}
+			continue;
+		}
+		double tLower = (lower(i) - origin(i)) * inverseDirection(i);
+		double tUpper = (upper(i) - origin(i)) * inverseDirection(i);
+		if (tLower > tUpper) {
+			std::swap(tLower, tUpper);
+		}
+		t0 = std::max(t0, tLower);
+		t1 = std::min(t1, tUpper);
+	}
+	if (t0 > t1) {
+		return false;
+	}
+
+	const double t = castRay(root, origin, dir, inverseDirection, t0, t1);
+	if (t < 0) {
+		return false;
+	}
+	range = t;
+	return true;
+}
+
+/**
+ * \brief Returns the ray parameter at which a ray enters the first occupied cube in a subtree.
+ * \param[in] node The root of the subtree
+ * \param[in] origin The start point of the ray
+ * \param[in] direction The normalized direction of the ray
+ * \param[in] inverseDirection The component-wise inverse of the direction
+ * \param[in] t0 The ray parameter where the ray enters the node
+ * \param[in] t1 The ray parameter where the ray leaves the node (or reaches its maximum range)
+ * \return The ray parameter of the hit, or -1 if the ray does not hit an occupied cube.
+ */
+double Octree::castRay(const Node * const node, const Eigen::Vector3d& origin, const Eigen::Vector3d& direction,
+		const Eigen::Vector3d& inverseDirection, const double t0, const double t1) const {
+	if (node->content == OCCUPIED) {
+		return t0;
+	}
+	if (node->content == FREE || !node->children[0]) {
+		return -1;
+	}
+
+	// Parameters at which the ray crosses the three planes through the center of the node
+	const Eigen::Vector3d center = (node->corner2 + node->corner1) / 2;
+	double tMid[3];
+	unsigned int index = 0;
+	for (int i = 0; i < 3; ++i) {
+		tMid[i] = direction(i) == 0 ? std::numeric_limits<double>::infinity() : (center(i) - origin(i)) * inverseDirection(i);
+		bool upperHalf;
+		if (direction(i) > 0) {
+			upperHalf = t0 >= tMid[i];
+		} else if (direction(i) < 0) {
+			upperHalf = t0 < tMid[i];
+		} else {
+			upperHalf = center(i) < origin(i);
+		}
+		index |= (upperHalf ? 1u : 0u) << i;
+	}
+
+	// Visit the children in the order in which the ray passes through them
+	double t = t0;
+	while (true) {
+		double tNext = t1;
+		for (int i = 0; i < 3; ++i) {
+			if (tMid[i] > t && tMid[i] < tNext) {
+				tNext = tMid[i];
+			}
+		}
+		const double hit = castRay(node->children[index], origin, direction, inverseDirection, t, tNext);
+		if (hit >= 0) {
+			return hit;
+		}
+		if (tNext >= t1) {
+			return -1;
+		}
+		for (int i = 0; i < 3; ++i) {
+			if (tMid[i] == tNext) {
+				index ^= 1u << i;
+			}
+		}
+		t = tNext;
+	}
+}
+
+/**
+ * \brief Casts a batch of rays from a common origin, e.g. the beams of a range scan.
+ * \param[in] origin The start point of all rays
+ * \param[in] directions The directions of the rays
+ * \param[in] maxRange The maximum length of the rays
+ * \param[out] ranges For each ray, the range as computed by castRay(), or -1 if there is no hit
+ *
+ * The rays are distributed in contiguous blocks over all hardware threads.
+ */
+void Octree::castRays(const Eigen::Vector3d& origin, const std::vector<Eigen::Vector3d>& directions, const double maxRange,
+		std::vector<double>& ranges) const {
+	ranges.assign(directions.size(), -1.0);
+	size_t numThreads = std::thread::hardware_concurrency();
+	if (numThreads == 0) {
+		numThreads = 1;
+	}
+	numThreads = std::min(numThreads, (directions.size() + 255) / 256);
+	if (numThreads == 0) {
+		return;
+	}
+	// contiguous blocks, so that no two threads write to the same cache line of ranges
+	const size_t chunk = (directions.size() + numThreads - 1) / numThreads;
+	std::vector<std::thread> threads;
+	std::vector<std::exception_ptr> errors(numThreads);
+	for (size_t t = 0; t < numThreads; ++t) {
+		const size_t begin = std::min(directions.size(), t * chunk);
+		const size_t end = std::min(directions.size(), begin + chunk);
+		threads.push_back(std::thread([this, &origin, &directions, maxRange, &ranges, &errors, t, begin, end] {
+			try {
+				for (size_t i = begin; i < end; ++i) {
+					castRay(origin, directions[i], maxRange, ranges[i]);
+				}
+			} catch (...) {
+				errors[t] = std::current_exception();
+			}
+		}));
+	}
+	for (size_t t = 0; t < threads.size(); ++t) {
+		threads[t].join();
+	}
+	for (size_t t = 0; t < errors.size(); ++t) {
+		if (errors[t]) {
+			std::rethrow_exception(errors[t]);
+		}
+	}
+}
+
 /**
  * \brief Returns the index (0-7) of the child cube containing a given 3D point.
  * \param[in] point The 3D point
@@ -65,16 +424,7 @@ unsigned int Node::findIndex(const Eigen::Vector3d& point) const {
 	 * - const Eigen::Vector3d corner2: opposite corner of the current cube
 	 */
 
-	Eigen::Vector3d center;
-
-	center = (corner2+corner1)/2;
-
-	for(int i=2;i>=0;i--)
-	{
-		index <<= 1;
-		int flag = center(i) < point(i)?1:0;
-		index += flag;	
-	}
+	index = childIndex(corner1, corner2, point);
 	return index;
 }
 
@@ -137,32 +487,7 @@ Node* Node::split(const Eigen::Vector3d& point) {
 	 * - findNode(const Eigen::Vector3d& point): method defined above
 	 */
 
-	content = MIXED;
-	Eigen::Vector3d lowerCorner = corner1;
-
-	Eigen::Vector3d center = (corner2-corner1)/2;
-
-
-	for(int i=0;i<8;i++){
-		Eigen::Vector3d upperCorner = lowerCorner + center;
-		Node * child = new Node(lowerCorner,upperCorner,this,depth+1,FREE);
-		children[i] = child;
-
-		if(i%2 ==0){
-			lowerCorner(0) = lowerCorner(0) + center(0);
-		}
-		else{
-			lowerCorner(0) = lowerCorner(0) - center(0);
-		} 
-
-		if((i-1)%4 ==0){
-			lowerCorner(1) = lowerCorner(1) + center(1);
-		}
-		if(i==3){
-			lowerCorner(1) = lowerCorner(1) - center(1);
-			lowerCorner(2) = lowerCorner(2) + center(2);
-		}
-	}
+	splitFree(this);
 
 	int index = this->findIndex(point);
 	children[index]->content = OCCUPIED;
@@ -1,5 +1,6 @@
 #include <octree/Octree.h>
 #include <octree/FileIO.h>
+#include <octree/CompactOctree.h>
 #include <gtest/gtest.h>
 
 using namespace octree;
@@ -223,6 +224,225 @@ TEST(OctreeTest, merge) {
 	}
 }
 
+/**
+ * \brief Collects the nodes of an Octree in depth-first order as CompactNode handles.
+ */
+void collectNodes(const Node * const node, const uint64_t key, std::vector<CompactNode>& nodes) {
+	nodes.push_back(CompactNode(key, node->depth, node->content));
+	for (uint64_t i = 0; i < 8; ++i) {
+		if (node->children[i]) {
+			collectNodes(node->children[i], (key << 3) | i, nodes);
+		}
+	}
+}
+
+TEST(OctreeTest, compactOctree) {
+	const Eigen::Vector3d corner1(-2, -8, -5);
+	const Eigen::Vector3d corner2(14,  8, 11);
+	const unsigned int maxDepth = 5;
+	Octree reference(corner1, corner2, maxDepth);
+	CompactOctree compact(corner1, corner2, maxDepth);
+
+	std::vector<Eigen::Vector3d> points;
+	unsigned int seed = 1;
+	for (size_t i = 0; i < 2000; ++i) {
+		Eigen::Vector3d point;
+		for (int j = 0; j < 3; ++j) {
+			seed = seed * 1103515245u + 12345u;
+			// a grid of 0.25 steps hits many cube boundaries exactly
+			point(j) = corner1(j) + ((seed >> 16) % 65) * 0.25;
+		}
+		points.push_back(point);
+	}
+	// a completely filled cube of depth 3 must be merged into one node
+	for (double x = 0.25; x < 2; x += 0.5) {
+		for (double y = 0.25; y < 2; y += 0.5) {
+			for (double z = 1.25; z < 3; z += 0.5) {
+				points.push_back(Eigen::Vector3d(x, y, z));
+			}
+		}
+	}
+	for (size_t i = 0; i < points.size(); ++i) {
+		ASSERT_TRUE(reference.insertPoint(points[i]));
+		ASSERT_TRUE(compact.insertPoint(points[i]));
+	}
+
+	std::vector<CompactNode> expectedNodes, nodes;
+	collectNodes(reference.root, 0, expectedNodes);
+	compact.getNodes(nodes);
+	ASSERT_EQ(expectedNodes.size(), nodes.size());
+	ASSERT_EQ(expectedNodes.size(), compact.getNumNodes());
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		ASSERT_TRUE(nodes[i] == expectedNodes[i]) << "node " << i;
+	}
+
+	const CompactNode merged = compact.findNode(Eigen::Vector3d(1, 1, 2));
+	EXPECT_EQ(OCCUPIED, merged.content);
+	EXPECT_EQ(3u, merged.depth);
+
+	for (size_t i = 0; i < 500; ++i) {
+		Eigen::Vector3d point;
+		for (int j = 0; j < 3; ++j) {
+			seed = seed * 1103515245u + 12345u;
+			point(j) = corner1(j) + ((seed >> 8) & 0xFFFF) / 65536.0 * 16.0;
+		}
+		const Node * const expected = reference.findNode(point);
+		const CompactNode node = compact.findNode(point);
+		ASSERT_EQ(expected->depth, node.depth);
+		ASSERT_EQ(expected->content, node.content);
+		Eigen::Vector3d nodeCorner1, nodeCorner2;
+		compact.getBounds(node, nodeCorner1, nodeCorner2);
+		ASSERT_TRUE(nodeCorner1.isApprox(expected->corner1.cwiseMin(expected->corner2)));
+		ASSERT_TRUE(nodeCorner2.isApprox(expected->corner1.cwiseMax(expected->corner2)));
+	}
+
+	std::vector<CompactNode> leaves;
+	compact.getNodes(leaves, true);
+	for (size_t i = 0; i < leaves.size(); ++i) {
+		ASSERT_NE(MIXED, leaves[i].content);
+	}
+	EXPECT_THROW(CompactOctree(corner2, corner1, maxDepth), std::invalid_argument);
+	EXPECT_THROW(CompactOctree(corner1, corner2, CompactOctree::MAX_DEPTH + 1), std::invalid_argument);
+}
+
+/**
+ * \brief Checks that two subtrees have the same structure, corners and content labels.
+ */
+void expectEqualTrees(const Node * const expected, const Node * const node) {
+	ASSERT_TRUE(expected->corner1 == node->corner1);
+	ASSERT_TRUE(expected->corner2 == node->corner2);
+	ASSERT_EQ(expected->depth, node->depth);
+	ASSERT_EQ(expected->content, node->content);
+	for (size_t i = 0; i < 8; ++i) {
+		ASSERT_EQ(expected->children[i] == NULL, node->children[i] == NULL);
+		if (expected->children[i]) {
+			ASSERT_TRUE(node->children[i]->parent == node);
+			expectEqualTrees(expected->children[i], node->children[i]);
+		}
+	}
+}
+
+TEST(OctreeTest, insertPointCloud) {
+	// non-dyadic bounds, so that rounding of the cube corners matters
+	const Eigen::Vector3d corner1(-1.0, -1.0, -1.0);
+	const Eigen::Vector3d corner2(9.24, 9.24, 9.24);
+	const unsigned int maxDepth = 6;
+	unsigned int seed = 9;
+	// a small cloud is inserted serially, a large one in parallel
+	const size_t sizes[3] = { 300, 20000, 5000 };
+	Octree reference(corner1, corner2, maxDepth);
+	Octree octree(corner1, corner2, maxDepth);
+	for (int c = 0; c < 3; ++c) {
+		std::vector<Eigen::Vector3d> points;
+		for (size_t i = 0; i < sizes[c]; ++i) {
+			Eigen::Vector3d point;
+			for (int j = 0; j < 3; ++j) {
+				seed = seed * 1103515245u + 12345u;
+				point(j) = -1.5 + ((seed >> 8) & 0xFFFF) / 65536.0 * 6.0;
+			}
+			// put many points onto planes, some of them exactly on cube boundaries
+			seed = seed * 1103515245u + 12345u;
+			point((seed >> 16) % 3) = (seed >> 20) % 2 ? 0.0 : 0.28 + 0.16 * c;
+			points.push_back(point);
+			if (i % 10 == 0) {
+				points.push_back(point);
+			}
+		}
+		// a completely filled region, so that cubes are merged
+		for (double x = 2.0; x < 3.5; x += 0.1) {
+			for (double y = 2.0; y < 3.5; y += 0.1) {
+				for (double z = 2.0 + c; z < 3.0 + c; z += 0.1) {
+					points.push_back(Eigen::Vector3d(x, y, z));
+				}
+			}
+		}
+		for (size_t i = 0; i < points.size(); ++i) {
+			ASSERT_TRUE(reference.insertPoint(points[i]));
+		}
+		ASSERT_TRUE(octree.insertPointCloud(points));
+		expectEqualTrees(reference.root, octree.root);
+	}
+	EXPECT_TRUE(octree.insertPointCloud(std::vector<Eigen::Vector3d>()));
+	expectEqualTrees(reference.root, octree.root);
+}
+
+TEST(OctreeTest, castRay) {
+	const Eigen::Vector3d corner1(-2, -8, -5);
+	const Eigen::Vector3d corner2(14,  8, 11);
+	const unsigned int maxDepth = 5;
+	Octree oc(corner1, corner2, maxDepth);
+	unsigned int seed = 4;
+	std::vector<Eigen::Vector3d> points;
+	for (size_t i = 0; i < 400; ++i) {
+		Eigen::Vector3d point;
+		for (int j = 0; j < 3; ++j) {
+			seed = seed * 1103515245u + 12345u;
+			point(j) = corner1(j) + ((seed >> 8) & 0xFFFF) / 65536.0 * 16.0;
+		}
+		points.push_back(point);
+	}
+	// a solid block that is merged into large occupied cubes
+	for (double x = 4.25; x < 8; x += 0.5) {
+		for (double y = -3.75; y < 0; y += 0.5) {
+			for (double z = 0.25; z < 4; z += 0.5) {
+				points.push_back(Eigen::Vector3d(x, y, z));
+			}
+		}
+	}
+	oc.insertPointCloud(points);
+
+	// simple ray
+	double range = -1;
+	ASSERT_TRUE(oc.castRay(Eigen::Vector3d(0.1, -1.9, 2.1), Eigen::Vector3d(2, 0, 0), 20, range));
+	EXPECT_NEAR(4.0 - 0.1, range, 1e-9);
+	EXPECT_FALSE(oc.castRay(Eigen::Vector3d(0.1, -1.9, 2.1), Eigen::Vector3d(1, 0, 0), 3.5, range));
+	EXPECT_FALSE(oc.castRay(Eigen::Vector3d(20, 0, 0), Eigen::Vector3d(1, 0, 0), 100, range));
+	EXPECT_THROW(oc.castRay(Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(0, 0, 0), 10, range), std::invalid_argument);
+
+	// compare with sampling the ray in small steps
+	const Eigen::Vector3d origin(1.3, 0.7, -0.4);
+	const double maxRange = 25;
+	const double step = 2e-3;
+	std::vector<Eigen::Vector3d> directions;
+	for (size_t i = 0; i < 80; ++i) {
+		Eigen::Vector3d direction;
+		for (int j = 0; j < 3; ++j) {
+			seed = seed * 1103515245u + 12345u;
+			direction(j) = ((seed >> 8) & 0xFFFF) / 32768.0 - 1.0;
+		}
+		directions.push_back(direction);
+	}
+	directions.push_back(Eigen::Vector3d(1, 0, 0));
+	directions.push_back(Eigen::Vector3d(0, -1, 0));
+	std::vector<double> ranges;
+	oc.castRays(origin, directions, maxRange, ranges);
+	ASSERT_EQ(directions.size(), ranges.size());
+	size_t numHits = 0;
+	for (size_t i = 0; i < directions.size(); ++i) {
+		const Eigen::Vector3d direction = directions[i].normalized();
+		double expected = -1;
+		for (double t = 0; t <= maxRange; t += step) {
+			const Eigen::Vector3d point = origin + t * direction;
+			if ((point.array() > corner2.array()).any() || (point.array() < corner1.array()).any()) {
+				break;
+			}
+			if (oc.findNode(point)->content == OCCUPIED) {
+				expected = t;
+				break;
+			}
+		}
+		double single = -1;
+		oc.castRay(origin, directions[i], maxRange, single);
+		EXPECT_EQ(single, ranges[i]);
+		ASSERT_EQ(expected >= 0, ranges[i] >= 0) << "ray " << i;
+		if (expected >= 0) {
+			++numHits;
+			EXPECT_NEAR(expected, ranges[i], step) << "ray " << i;
+		}
+	}
+	EXPECT_GT(numHits, directions.size() / 5);
+}
+
 int main(int argc, char *argv[]) {
 	::testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -1,17 +1,34 @@
 HEADERS = \
 	include/path_planning/OpenList.h \
 	include/path_planning/GridNode.h \
+	include/path_planning/GridNodeArena.h \
 	include/path_planning/ClosedList.h \
 	include/path_planning/AbstractNode.h \
 	include/path_planning/GridMap.h \
 	include/path_planning/PathPlanning.h \
+	include/path_planning/JumpPointPlanning.h \
+	include/path_planning/BatchPlanning.h \
+	include/path_planning/HierarchicalPlanning.h \
+	include/path_planning/IncrementalPlanning.h \
+	include/path_planning/LandmarkHeuristic.h \
+	include/path_planning/TraceLogger.h \
+	include/path_planning/SearchKernel.h \
+	include/path_planning/GridSearch.h \
 	include/path_planning/Heuristic.h \
 	include/path_planning/FileIO.h
 
 SOURCES = \
     ../gtest/src/gtest-all.cc \
 	src/GridNode.cpp \
+	src/GridNodeArena.cpp \
+	src/GridMap.cpp \
 	src/PathPlanning.cpp \
+	src/JumpPointPlanning.cpp \
+	src/BatchPlanning.cpp \
+	src/HierarchicalPlanning.cpp \
+	src/IncrementalPlanning.cpp \
+	src/LandmarkHeuristic.cpp \
+	src/TraceLogger.cpp \
 	src/OpenList.cpp \
 	src/ClosedList.cpp \
 	src/FileIO.cpp \
@@ -24,6 +41,7 @@ INCLUDEPATH += ../gtest
 TEMPLATE = app
 CONFIG -= qt
 CONFIG -= app_bundle
+CONFIG += c++11
 TARGET = path_planning-test
 DEFINES += PROJECT_SOURCE_DIR=\\\"$$absolute_path(".")\\\"
 unix:QMAKE_LFLAGS += -pthread
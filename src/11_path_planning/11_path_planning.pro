@@ -1,16 +1,33 @@
 HEADERS = \
 	include/path_planning/OpenList.h \
 	include/path_planning/GridNode.h \
+	include/path_planning/GridNodeArena.h \
 	include/path_planning/ClosedList.h \
 	include/path_planning/AbstractNode.h \
 	include/path_planning/GridMap.h \
 	include/path_planning/PathPlanning.h \
+	include/path_planning/JumpPointPlanning.h \
+	include/path_planning/BatchPlanning.h \
+	include/path_planning/HierarchicalPlanning.h \
+	include/path_planning/IncrementalPlanning.h \
+	include/path_planning/LandmarkHeuristic.h \
+	include/path_planning/TraceLogger.h \
+	include/path_planning/SearchKernel.h \
+	include/path_planning/GridSearch.h \
 	include/path_planning/Heuristic.h \
 	include/path_planning/FileIO.h
 
 SOURCES = \
 	src/GridNode.cpp \
+	src/GridNodeArena.cpp \
+	src/GridMap.cpp \
 	src/PathPlanning.cpp \
+	src/JumpPointPlanning.cpp \
+	src/BatchPlanning.cpp \
+	src/HierarchicalPlanning.cpp \
+	src/IncrementalPlanning.cpp \
+	src/LandmarkHeuristic.cpp \
+	src/TraceLogger.cpp \
 	src/OpenList.cpp \
 	src/main.cpp \
 	src/ClosedList.cpp \
@@ -22,7 +39,9 @@ INCLUDEPATH += ../includes
 TEMPLATE = app
 CONFIG -= qt
 CONFIG -= app_bundle
+CONFIG += c++11
 TARGET = path_planning_node
+unix:QMAKE_LFLAGS += -pthread
 DEFINES += PROJECT_SOURCE_DIR=\\\"$$absolute_path(".")\\\"
 windows:{
     QMAKE_LFLAGS += -static
@@ -0,0 +1,571 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <benchmark-helpers.h>
+#include <path_planning/BatchPlanning.h>
+#include <path_planning/FileIO.h>
+#include <path_planning/GridSearch.h>
+#include <path_planning/HierarchicalPlanning.h>
+#include <path_planning/IncrementalPlanning.h>
+#include <path_planning/JumpPointPlanning.h>
+#include <path_planning/LandmarkHeuristic.h>
+#include <path_planning/PathPlanning.h>
+#include <path_planning/TraceLogger.h>
+
+using namespace path_planning;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+typedef BatchPlanning::Query Query;
+
+/**
+ * @brief Enlarges a map by replacing each cell with a block of factor x factor cells.
+ */
+GridMap scaleMap(const GridMap& map, const size_t& factor) {
+	const size_t width = map.width * factor;
+	const size_t height = map.height * factor;
+	std::vector<bool> data(width * height);
+	for (size_t y = 0; y < height; ++y) {
+		for (size_t x = 0; x < width; ++x) {
+			data[y * width + x] = map.isOccupied(x / factor, y / factor);
+		}
+	}
+	return GridMap(width, height, data);
+}
+
+/**
+ * @brief Draws reproducible queries between free cells of a map.
+ */
+std::vector<Query> randomQueries(const GridMap& map, const size_t& count, unsigned int seed) {
+	std::vector<Query> queries;
+	while (queries.size() < count) {
+		int coords[4];
+		for (int c = 0; c < 4; c += 2) {
+			do {
+				seed = seed * 1103515245u + 12345u;
+				coords[c] = static_cast<int>((seed >> 8) % map.width);
+				seed = seed * 1103515245u + 12345u;
+				coords[c + 1] = static_cast<int>((seed >> 8) % map.height);
+			} while (map.isOccupied(coords[c], coords[c + 1]));
+		}
+		queries.push_back(Query(coords[0], coords[1], coords[2], coords[3]));
+	}
+	return queries;
+}
+
+double pathLength(const std::deque<const AbstractNode*>& path) {
+	double length = 0.0;
+	for (size_t i = 1; i < path.size(); ++i) {
+		const GridNode * const a = static_cast<const GridNode *>(path[i - 1]);
+		const GridNode * const b = static_cast<const GridNode *>(path[i]);
+		length += std::sqrt(static_cast<double>((a->x - b->x) * (a->x - b->x) + (a->y - b->y) * (a->y - b->y)));
+	}
+	return length;
+}
+
+/**
+ * @brief Accumulated results of one planner over a set of queries.
+ */
+struct Result {
+	size_t expansions;
+	double milliseconds;
+	std::vector<double> lengths;
+	Result() : expansions(0), milliseconds(0.0) {}
+};
+
+Result run(GridPathPlanning& planner, GridNodeArena& arena, const std::vector<Query>& queries) {
+	Result result;
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const Query& q = queries[i];
+		const Clock::time_point begin = Clock::now();
+		const std::deque<const AbstractNode*> path = planner.planPath(arena.get(q.startX, q.startY), arena.get(q.goalX, q.goalY));
+		result.milliseconds += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+		result.expansions += planner.getNumExpansions();
+		result.lengths.push_back(path.empty() ? -1.0 : pathLength(path));
+	}
+	return result;
+}
+
+void print(const std::string& name, const Result& result, const Result& reference) {
+	size_t mismatches = 0;
+	for (size_t i = 0; i < result.lengths.size(); ++i) {
+		if (std::fabs(result.lengths[i] - reference.lengths[i]) > 1e-6) {
+			++mismatches;
+		}
+	}
+	std::cout << "  " << std::left << std::setw(18) << name << std::right
+			<< std::setw(12) << result.expansions << " expansions"
+			<< std::setw(12) << std::fixed << std::setprecision(1) << result.milliseconds << " ms"
+			<< std::setw(8) << mismatches << " cost mismatches" << std::endl;
+}
+
+/**
+ * @brief Compares the time to load a large map from a plain PBM file character by character
+ * (like the loader used to) with FileIO::loadMap() on plain and raw PBM and binary map files.
+ */
+void benchmarkMapLoading(const GridMap& map, const std::string& directory) {
+	const std::string plainFile = directory + "/benchmark-map-plain.pbm";
+	const std::string rawFile = directory + "/benchmark-map-raw.pbm";
+	const std::string binaryFile = directory + "/benchmark-map.bin";
+	std::ofstream ofs(plainFile.c_str());
+	ofs << "P1\n" << map.width << " " << map.height << "\n";
+	std::string row(map.width + 1, '\n');
+	for (size_t y = 0; y < map.height; ++y) {
+		for (size_t x = 0; x < map.width; ++x) {
+			row[x] = map.isOccupied(x, y) ? '1' : '0';
+		}
+		ofs << row;
+	}
+	ofs.close();
+	ofs.open(rawFile.c_str(), std::ios::binary);
+	ofs << "P4\n" << map.width << " " << map.height << "\n";
+	for (size_t y = 0; y < map.height; ++y) {
+		for (size_t x = 0; x < map.width; x += 8) {
+			unsigned char byte = 0;
+			for (size_t i = 0; i < 8 && x + i < map.width; ++i) {
+				byte |= static_cast<unsigned char>(map.isOccupied(x + i, y) << (7 - i));
+			}
+			ofs.put(static_cast<char>(byte));
+		}
+	}
+	ofs.close();
+	FileIO::saveBinaryMap(binaryFile, map);
+
+	std::cout << "loading a " << map.width << "x" << map.height << " map:" << std::endl;
+	Clock::time_point begin = Clock::now();
+	std::ifstream ifs(plainFile.c_str());
+	std::string header;
+	size_t width = 0, height = 0;
+	ifs >> header >> width >> height;
+	std::vector<bool> data;
+	data.reserve(width * height);
+	char c;
+	while (ifs.get(c)) {
+		if (c == '0' || c == '1') {
+			data.push_back(c == '1');
+		}
+	}
+	const GridMap reference(width, height, data);
+	std::cout << "  " << std::left << std::setw(28) << "P1 character by character" << std::right << std::setw(10) << std::fixed
+			<< std::setprecision(1) << std::chrono::duration<double, std::milli>(Clock::now() - begin).count() << " ms" << std::endl;
+
+	const std::string names[3] = { "P1 loadMap()", "P4 loadMap()", "binary loadMap()" };
+	const std::string files[3] = { plainFile, rawFile, binaryFile };
+	for (int i = 0; i < 3; ++i) {
+		begin = Clock::now();
+		const GridMap * const loaded = FileIO::loadMap(files[i]);
+		const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+		std::cout << "  " << std::left << std::setw(28) << names[i] << std::right << std::setw(10) << std::fixed
+				<< std::setprecision(1) << milliseconds << " ms" << (loaded && loaded->getTiles() == reference.getTiles() ? "" : "  (wrong map)") << std::endl;
+		delete loaded;
+		std::remove(files[i].c_str());
+	}
+}
+
+/**
+ * @brief Compares A* with bidirectional A* and Jump Point Search (with and without precomputed jump distances).
+ * @return The results of A*, which serve as reference for the other planners.
+ */
+Result benchmarkJumpPointSearch(const GridMap& map, const std::vector<Query>& queries) {
+	StraightLineDistanceHeuristic heuristic;
+	GridNodeArena arena(map);
+
+	GridPathPlanning aStar(map, heuristic, arena);
+	const Result aStarResult = run(aStar, arena, queries);
+	print("A*", aStarResult, aStarResult);
+
+	GridPathPlanning bidirectional(map, heuristic, arena);
+	bidirectional.setBidirectional(true);
+	print("A* bidirectional", run(bidirectional, arena, queries), aStarResult);
+
+	JumpPointPlanning jps(map, heuristic, arena);
+	print("JPS", run(jps, arena, queries), aStarResult);
+
+	const Clock::time_point begin = Clock::now();
+	const JumpPointTable table(map);
+	const double tableMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+	JumpPointPlanning jpsPlus(map, heuristic, arena, &table);
+	print("JPS+", run(jpsPlus, arena, queries), aStarResult);
+	std::cout << "  (JPS+ table precomputation: " << std::fixed << std::setprecision(1) << tableMilliseconds << " ms)" << std::endl;
+	return aStarResult;
+}
+
+/**
+ * @brief Compares A* with the straight line distance and with landmarks, and the time to compute and to load the landmark table.
+ */
+void benchmarkLandmarkHeuristic(const GridMap& map, const std::vector<Query>& queries, const Result& aStarResult, const std::string& directory) {
+	LandmarkHeuristic heuristic(map);
+	Clock::time_point begin = Clock::now();
+	heuristic.compute(16);
+	const double computeMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+	const std::string filename = directory + "/benchmark-landmarks.bin";
+	heuristic.save(filename);
+	LandmarkHeuristic loaded(map);
+	begin = Clock::now();
+	const bool success = loaded.load(filename);
+	const double loadMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+	std::remove(filename.c_str());
+	if (!success) {
+		return;
+	}
+
+	GridNodeArena arena(map);
+	GridPathPlanning alt(map, loaded, arena);
+	print("A* landmarks", run(alt, arena, queries), aStarResult);
+	std::cout << "  (" << loaded.getLandmarks().size() << " landmarks, " << std::fixed << std::setprecision(1)
+			<< loaded.getMemoryUsage() / 1048576.0 << " MiB, computed in " << computeMilliseconds << " ms, loaded in "
+			<< loadMilliseconds << " ms)" << std::endl;
+}
+
+/**
+ * @brief Compares A* with floating-point costs and the binary heap with integer costs and the radix heap.
+ */
+void benchmarkIntegerCosts(const GridMap& map, const std::vector<Query>& queries, const Result& aStarResult) {
+	GridNodeArena arena(map);
+	OctileDistanceHeuristic octile;
+	GridPathPlanning exact(map, octile, arena);
+	exact.setLogging(false);
+	print("A* octile", run(exact, arena, queries), aStarResult);
+
+	OctileDistanceHeuristic fixedPointOctile(true);
+	GridPathPlanning integer(map, fixedPointOctile, arena);
+	integer.setLogging(false);
+	integer.setIntegerCosts(true);
+	const Result integerResult = run(integer, arena, queries);
+	print("A* integer radix", integerResult, aStarResult);
+	double maxDeviation = 0.0;
+	for (size_t i = 0; i < integerResult.lengths.size(); ++i) {
+		if (aStarResult.lengths[i] > 0.0) {
+			maxDeviation = std::max(maxDeviation, integerResult.lengths[i] / aStarResult.lengths[i] - 1.0);
+		}
+	}
+	std::cout << "  (largest relative excess of the integer paths: " << std::scientific << std::setprecision(2)
+			<< maxDeviation << ")" << std::endl;
+}
+
+/**
+ * @brief Compares A* with floating-point and with integer costs on a map without obstacles, where
+ * the open list holds the whole search frontier and dominates the run time.
+ */
+void benchmarkOpenMap(const size_t& size, const size_t& numQueries) {
+	const GridMap map(size, size, std::vector<bool>(size * size, false));
+	OpenList::map = &map;
+	const std::vector<Query> queries = randomQueries(map, numQueries, 42);
+	std::cout << "open map (" << map.width << "x" << map.height << "), " << queries.size() << " queries" << std::endl;
+	StraightLineDistanceHeuristic heuristic;
+	GridNodeArena arena(map);
+	GridPathPlanning aStar(map, heuristic, arena);
+	aStar.setLogging(false);
+	const Result aStarResult = run(aStar, arena, queries);
+	print("A*", aStarResult, aStarResult);
+	benchmarkIntegerCosts(map, queries, aStarResult);
+	OpenList::map = NULL;
+}
+
+/**
+ * @brief Compares the expansion rate of the virtual PathPlanning hierarchy with SearchKernel.
+ */
+void benchmarkSearchKernel(const GridMap& map, const std::vector<Query>& queries, const Result& virtualResult) {
+	GridSearch<> search(map);
+	Result kernelResult;
+	std::vector<GridCell> path;
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const Query& q = queries[i];
+		const Clock::time_point begin = Clock::now();
+		const double costs = search.planPath(GridCell(q.startX, q.startY), GridCell(q.goalX, q.goalY), path);
+		kernelResult.milliseconds += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+		kernelResult.expansions += search.getNumExpansions();
+		kernelResult.lengths.push_back(path.empty() ? -1.0 : costs);
+	}
+	print("SearchKernel A*", kernelResult, virtualResult);
+	std::cout << "  (" << std::fixed << std::setprecision(2)
+			<< virtualResult.expansions / virtualResult.milliseconds / 1000.0 << " M expansions/s virtual, "
+			<< kernelResult.expansions / kernelResult.milliseconds / 1000.0 << " M expansions/s kernel)" << std::endl;
+}
+
+/**
+ * @brief Compares A* with hierarchical planning in expansions and path costs.
+ */
+void benchmarkHierarchicalPlanning(const GridMap& map, const std::vector<Query>& queries, const Result& aStarResult) {
+	HierarchicalPlanning hpa(map, 16);
+	Clock::time_point begin = Clock::now();
+	hpa.update();
+	const double buildMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+	Result hpaResult;
+	size_t abstractExpansions = 0;
+	double boundSum = 0.0;
+	double suboptimalitySum = 0.0;
+	double maxSuboptimality = 1.0;
+	size_t numPaths = 0;
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const Query& q = queries[i];
+		begin = Clock::now();
+		const HierarchicalPlanning::Result result = hpa.planPath(q.startX, q.startY, q.goalX, q.goalY);
+		hpaResult.milliseconds += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+		hpaResult.expansions += result.expansions;
+		abstractExpansions += result.abstractExpansions;
+		hpaResult.lengths.push_back(result.path.empty() ? -1.0 : result.costs);
+		if (!result.path.empty() && aStarResult.lengths[i] > 0.0) {
+			const double suboptimality = result.costs / aStarResult.lengths[i];
+			suboptimalitySum += suboptimality;
+			maxSuboptimality = std::max(maxSuboptimality, suboptimality);
+			boundSum += result.getSuboptimalityBound();
+			++numPaths;
+		}
+	}
+	print("HPA* (16x16)", hpaResult, aStarResult);
+	std::cout << "  (" << std::fixed << std::setprecision(1) << buildMilliseconds << " ms to build "
+			<< hpa.getNumAbstractNodes() << " abstract nodes, " << abstractExpansions << " abstract expansions, "
+			<< std::setprecision(1) << static_cast<double>(aStarResult.expansions) / std::max<size_t>(hpaResult.expansions, 1)
+			<< "x fewer expansions than A*, suboptimality " << std::setprecision(3)
+			<< (numPaths ? suboptimalitySum / numPaths : 1.0) << " mean / " << maxSuboptimality << " max, reported bound "
+			<< (numPaths ? boundSum / numPaths : 1.0) << " mean)" << std::endl;
+}
+
+/**
+ * @brief Compares replanning from scratch with A* and D* Lite while cells along the path are toggled.
+ *
+ * For each query, the robot repeatedly moves a few cells along the current path, a random cell
+ * further along the path is blocked and a previously blocked cell is freed again.
+ */
+void benchmarkIncrementalPlanning(const GridMap& originalMap, const std::vector<Query>& queries, const size_t& numChanges) {
+	GridMap map(originalMap);
+	StraightLineDistanceHeuristic heuristic;
+	GridNodeArena arena(map);
+	GridPathPlanning aStar(map, heuristic, arena);
+	aStar.setLogging(false);
+	Result aStarResult, incrementalResult;
+	size_t initialExpansions = 0;
+	double initialMilliseconds = 0.0;
+	unsigned int seed = 3;
+	for (size_t q = 0; q < queries.size(); ++q) {
+		const Query& query = queries[q];
+		Clock::time_point begin = Clock::now();
+		IncrementalPlanning planner(map, query.startX, query.startY, query.goalX, query.goalY);
+		IncrementalPlanning::Result result = planner.planPath();
+		initialMilliseconds += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+		initialExpansions += result.expansions;
+
+		std::vector<std::pair<int, int> > blocked;
+		for (size_t c = 0; c < numChanges && result.path.size() > 10; ++c) {
+			const std::pair<int, int> start = result.path[std::min<size_t>(5, result.path.size() - 1)];
+			seed = seed * 1103515245u + 12345u;
+			const std::pair<int, int> block = result.path[6 + (seed >> 8) % (result.path.size() - 8)];
+			std::vector<std::pair<int, int> > changed(1, block);
+			map.setOccupied(block.first, block.second, true);
+			blocked.push_back(block);
+			if (blocked.size() > 5) {
+				// keep at most five cells blocked at a time
+				const std::pair<int, int> cell = blocked.front();
+				blocked.erase(blocked.begin());
+				if (cell != start) {
+					map.setOccupied(cell.first, cell.second, false);
+					changed.push_back(cell);
+				}
+			}
+
+			begin = Clock::now();
+			const std::deque<const AbstractNode*> path = aStar.planPath(arena.get(start.first, start.second), arena.get(query.goalX, query.goalY));
+			aStarResult.milliseconds += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+			aStarResult.expansions += aStar.getNumExpansions();
+			aStarResult.lengths.push_back(path.empty() ? -1.0 : pathLength(path));
+
+			begin = Clock::now();
+			planner.setStart(start.first, start.second);
+			planner.updateCells(changed);
+			result = planner.planPath();
+			incrementalResult.milliseconds += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+			incrementalResult.expansions += result.expansions;
+			incrementalResult.lengths.push_back(result.path.empty() ? -1.0 : result.costs);
+		}
+		// restore the map for the next query
+		for (size_t i = 0; i < blocked.size(); ++i) {
+			map.setOccupied(blocked[i].first, blocked[i].second, originalMap.isOccupied(blocked[i].first, blocked[i].second));
+		}
+	}
+	std::cout << "  " << aStarResult.lengths.size() << " replanning steps:" << std::endl;
+	print("A* from scratch", aStarResult, aStarResult);
+	print("D* Lite", incrementalResult, aStarResult);
+	std::cout << "  (initial D* Lite searches: " << initialExpansions << " expansions, " << std::fixed << std::setprecision(1)
+			<< initialMilliseconds << " ms)" << std::endl;
+}
+
+/**
+ * @brief Compares the throughput of serial A* queries with the batch planner.
+ */
+void benchmarkBatchPlanning(const GridMap& map, const std::vector<Query>& queries, const Result& serialResult) {
+	StraightLineDistanceHeuristic heuristic;
+	BatchPlanning batch(heuristic);
+	const Clock::time_point begin = Clock::now();
+	const std::vector<BatchPlanning::Result> results = batch.planBatch(map, queries);
+	const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+	Result batchResult;
+	batchResult.milliseconds = milliseconds;
+	for (size_t i = 0; i < results.size(); ++i) {
+		batchResult.expansions += results[i].expansions;
+		batchResult.lengths.push_back(results[i].path.empty() ? -1.0 : results[i].costs);
+	}
+	std::ostringstream name;
+	name << "A* batch (" << batch.getNumThreads() << "t)";
+	print(name.str(), batchResult, serialResult);
+	std::cout << "  (" << std::fixed << std::setprecision(1)
+			<< queries.size() * 1000.0 / serialResult.milliseconds << " queries/s serial, "
+			<< queries.size() * 1000.0 / milliseconds << " queries/s batch)" << std::endl;
+}
+
+/**
+ * @brief Measures the overhead of logging the open and close events as text and as binary trace.
+ */
+void benchmarkTracing(const GridMap& map, const std::vector<Query>& queries, const Result& plainResult, const std::string& directory) {
+	StraightLineDistanceHeuristic heuristic;
+	GridNodeArena arena(map);
+	GridPathPlanning aStar(map, heuristic, arena);
+	const std::string textFilename = directory + "/benchmark-log.txt";
+	const std::string traceFilename = directory + "/benchmark-trace.bin";
+
+	{
+		FileIO fileIO;
+		fileIO.openLogfile(textFilename);
+		OpenList::fileIO = &fileIO;
+		ClosedList::fileIO = &fileIO;
+		print("A* + text log", run(aStar, arena, queries), plainResult);
+		OpenList::fileIO = NULL;
+		ClosedList::fileIO = NULL;
+	}
+
+	TraceLogger logger;
+	logger.open(traceFilename, map);
+	OpenList::traceLogger = &logger;
+	ClosedList::traceLogger = &logger;
+	const Result traceResult = run(aStar, arena, queries);
+	OpenList::traceLogger = NULL;
+	ClosedList::traceLogger = NULL;
+	const uint64_t numRecords = logger.getNumRecords();
+	logger.close();
+	print("A* + binary trace", traceResult, plainResult);
+	std::cout << "  (" << numRecords << " trace records, "
+			<< std::fixed << std::setprecision(1) << numRecords * 1000.0 / traceResult.milliseconds << " records/s)" << std::endl;
+
+	std::remove(textFilename.c_str());
+	std::remove(traceFilename.c_str());
+}
+
+/**
+ * @brief Runs a planner on the queries of a synthetic map and records the statistics of each query.
+ */
+benchmark_helpers::BenchmarkResult runQueries(const std::string& name, GridPathPlanning& planner, GridNodeArena& arena,
+		const benchmark_helpers::SyntheticMap& syntheticMap, const std::vector<benchmark_helpers::Query>& queries) {
+	benchmark_helpers::BenchmarkResult result(name, syntheticMap);
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const benchmark_helpers::Query& q = queries[i];
+		const benchmark_helpers::Stopwatch stopwatch;
+		const std::deque<const AbstractNode*> path = planner.planPath(arena.get(q.startX, q.startY), arena.get(q.goalX, q.goalY));
+		const double milliseconds = stopwatch.milliseconds();
+		result.add(milliseconds, planner.getNumExpansions(), planner.getPeakOpenListSize(), path.empty() ? -1.0 : pathLength(path));
+	}
+	return result;
+}
+
+/**
+ * @brief Runs A*, bidirectional A*, JPS and A* with integer costs on synthetic maps of increasing
+ * size (random obstacles, mazes, rooms and corridors) and writes the statistics as JSON.
+ */
+void benchmarkSuite(const size_t& maxSize, const size_t& numQueries) {
+	const size_t sizes[] = { 100, 512, 1024, 4096 };
+	std::vector<benchmark_helpers::BenchmarkResult> results;
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= maxSize; ++s) {
+		std::vector<benchmark_helpers::SyntheticMap> syntheticMaps;
+		syntheticMaps.push_back(benchmark_helpers::randomMap(sizes[s], sizes[s], 10, 1));
+		syntheticMaps.push_back(benchmark_helpers::randomMap(sizes[s], sizes[s], 30, 2));
+		syntheticMaps.push_back(benchmark_helpers::mazeMap(sizes[s], sizes[s], 4, 3));
+		syntheticMaps.push_back(benchmark_helpers::roomsMap(sizes[s], sizes[s], 32, 4));
+		for (size_t m = 0; m < syntheticMaps.size(); ++m) {
+			const GridMap map(syntheticMaps[m].width, syntheticMaps[m].height, syntheticMaps[m].data);
+			OpenList::map = &map;
+			const std::vector<benchmark_helpers::Query> queries = benchmark_helpers::randomQueries(syntheticMaps[m], numQueries, 42);
+			StraightLineDistanceHeuristic heuristic;
+			OctileDistanceHeuristic fixedPointHeuristic(true);
+			GridNodeArena arena(map);
+
+			GridPathPlanning aStar(map, heuristic, arena);
+			results.push_back(runQueries("A*", aStar, arena, syntheticMaps[m], queries));
+			GridPathPlanning bidirectional(map, heuristic, arena);
+			bidirectional.setBidirectional(true);
+			results.push_back(runQueries("A* bidirectional", bidirectional, arena, syntheticMaps[m], queries));
+			JumpPointPlanning jps(map, heuristic, arena);
+			results.push_back(runQueries("JPS", jps, arena, syntheticMaps[m], queries));
+			GridPathPlanning integerCosts(map, fixedPointHeuristic, arena);
+			integerCosts.setIntegerCosts(true);
+			results.push_back(runQueries("A* integer costs", integerCosts, arena, syntheticMaps[m], queries));
+			OpenList::map = NULL;
+		}
+	}
+	benchmark_helpers::writeJson(std::cout, "path_planning", results);
+}
+
+}  // namespace
+
+/*
+ * Usage: path_planning-benchmark [number of queries] [scale factor]...
+ *        path_planning-benchmark --json [largest map size] [number of queries]
+ *
+ * The map data/map.pbm is enlarged by each of the given scale factors (default 10, 50, 200).
+ * The loading times are measured on an 8000x8000 enlargement first. Finally, the open lists are
+ * compared on a map without obstacles of the size of the largest enlargement.
+ *
+ * With --json, the planners run on synthetic maps from 100x100 up to the given size (default
+ * 4096x4096) with 50 queries each (by default), and the statistics are written to stdout as JSON.
+ */
+int main(int argc, char **argv) {
+	if (argc > 1 && std::string(argv[1]) == "--json") {
+		benchmarkSuite(argc > 2 ? std::atoi(argv[2]) : 4096, argc > 3 ? std::atoi(argv[3]) : 50);
+		return 0;
+	}
+	const std::string packagePath = PROJECT_SOURCE_DIR;
+	const GridMap * const baseMap = FileIO::loadMap(packagePath + "/data/map.pbm");
+	if (!baseMap) {
+		return 1;
+	}
+	const size_t numQueries = argc > 1 ? std::atoi(argv[1]) : 20;
+	std::vector<size_t> factors;
+	for (int i = 2; i < argc; ++i) {
+		factors.push_back(std::atoi(argv[i]));
+	}
+	if (factors.empty()) {
+		factors.push_back(10);
+		factors.push_back(50);
+		factors.push_back(200);
+	}
+
+	benchmarkMapLoading(scaleMap(*baseMap, 800), packagePath + "/data");
+	for (size_t i = 0; i < factors.size(); ++i) {
+		const GridMap map = scaleMap(*baseMap, factors[i]);
+		OpenList::map = &map;
+		const std::vector<Query> queries = randomQueries(map, numQueries, 42);
+		std::cout << "map.pbm x" << factors[i] << " (" << map.width << "x" << map.height << "), "
+				<< queries.size() << " queries" << std::endl;
+		const Result aStarResult = benchmarkJumpPointSearch(map, queries);
+		benchmarkLandmarkHeuristic(map, queries, aStarResult, packagePath + "/data");
+		benchmarkIntegerCosts(map, queries, aStarResult);
+		benchmarkSearchKernel(map, queries, aStarResult);
+		benchmarkHierarchicalPlanning(map, queries, aStarResult);
+		benchmarkBatchPlanning(map, queries, aStarResult);
+		benchmarkIncrementalPlanning(map, std::vector<Query>(queries.begin(), queries.begin() + std::min<size_t>(queries.size(), 5)), 20);
+		benchmarkTracing(map, queries, aStarResult, packagePath + "/data");
+	}
+	benchmarkOpenMap(baseMap->width * *std::max_element(factors.begin(), factors.end()), numQueries);
+
+	delete baseMap;
+	return 0;
+}
@@ -0,0 +1,126 @@
+#ifndef PATH_PLANNING_BATCHPLANNING_H_
+#define PATH_PLANNING_BATCHPLANNING_H_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <path_planning/PathPlanning.h>
+
+namespace path_planning {
+
+/**
+ * @brief Answers many path queries on the same grid map in parallel.
+ *
+ * The planner owns a pool of worker threads that is created once and reused for all batches.
+ * Every worker has its own search state (a GridNodeArena with the nodes of the map and the open
+ * and closed lists of GridPathPlanning), while the map and the heuristic are shared read-only.
+ * The queries of a batch are distributed round-robin over per-worker task queues. A worker takes
+ * tasks from the front of its own queue and, once that is empty, steals from the back of the
+ * queues of the other workers, so long and short queries are balanced automatically.
+ *
+ * The results do not depend on the number of threads: each query is answered exactly like a
+ * call to GridPathPlanning::planPath() with a node arena.
+ *
+ * Logging of the open and closed lists is disabled for the searches of the workers.
+ */
+class BatchPlanning {
+public:
+	/**
+	 * @brief A single path query.
+	 */
+	struct Query {
+		int startX;  ///< The x coordinate of the start cell.
+		int startY;  ///< The y coordinate of the start cell.
+		int goalX;   ///< The x coordinate of the goal cell.
+		int goalY;   ///< The y coordinate of the goal cell.
+
+		Query() : startX(0), startY(0), goalX(0), goalY(0) {};
+		Query(const int& startX, const int& startY, const int& goalX, const int& goalY) :
+			startX(startX), startY(startY), goalX(goalX), goalY(goalY) {};
+	};
+
+	/**
+	 * @brief The answer to a path query.
+	 */
+	struct Result {
+		std::vector<std::pair<int, int> > path;  ///< The cells of the path from start to goal, empty if there is none.
+		double costs;                            ///< The costs of the path, 0 if there is none.
+		size_t expansions;                       ///< The number of nodes expanded by the search.
+
+		Result() : costs(0.0), expansions(0) {};
+	};
+
+	/**
+	 * @brief Starts the worker threads.
+	 * @param heuristic The heuristic to use, which must outlive the planner and be safe to call
+	 *        from several threads at the same time.
+	 * @param numThreads The number of worker threads, 0 to use one per hardware thread.
+	 */
+	explicit BatchPlanning(const GridHeuristic& heuristic, const size_t& numThreads = 0);
+
+	/**
+	 * @brief Stops and joins the worker threads.
+	 */
+	virtual ~BatchPlanning();
+
+	/**
+	 * @brief Plans paths for a batch of queries.
+	 * @param map The grid map, which must not change while the batch is running.
+	 * @param queries The queries.
+	 * @return One result per query, in the order of the queries.
+	 * @throws std::out_of_range if a start or goal cell is outside the map.
+	 *
+	 * Calls from different threads are serialized.
+	 */
+	std::vector<Result> planBatch(const GridMap& map, const std::vector<Query>& queries);
+
+	/**
+	 * @brief Returns the number of worker threads.
+	 * @return The number of worker threads.
+	 */
+	size_t getNumThreads() const {
+		return workers.size();
+	}
+
+private:
+	BatchPlanning(const BatchPlanning&);
+	BatchPlanning& operator=(const BatchPlanning&);
+
+	struct Worker {
+		std::thread thread;
+		std::mutex mutex;                    ///< Protects tasks.
+		std::deque<size_t> tasks;            ///< Indices of the queries assigned to the worker.
+		GridNodeArena *arena;                ///< Search state, reallocated when the map size changes.
+
+		Worker() : arena(NULL) {};
+	};
+
+	void run(const size_t& workerIndex);
+	bool nextTask(const size_t& workerIndex, size_t& task);
+	void solve(GridPathPlanning& planner, GridNodeArena& arena, const size_t& task);
+
+	const GridHeuristic& heuristic;
+	std::vector<Worker *> workers;
+
+	std::mutex batchMutex;               ///< Serializes calls to planBatch().
+	std::mutex stateMutex;               ///< Protects the batch state below.
+	std::condition_variable batchStarted;
+	std::condition_variable batchFinished;
+	unsigned long generation;            ///< Incremented for every batch.
+	size_t numActive;                    ///< Number of workers still working on the current batch.
+	bool stopping;
+
+	// The current batch, written by planBatch() while no worker is active.
+	const GridMap *map;
+	const std::vector<Query> *queries;
+	std::vector<Result> *results;
+	std::exception_ptr error;
+};
+
+}  // namespace path_planning
+
+#endif /* PATH_PLANNING_BATCHPLANNING_H_ */
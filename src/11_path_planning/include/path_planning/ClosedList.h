@@ -2,18 +2,36 @@
 #define PATH_PLANNING_CLOSEDLIST_HPP_
 
 #include <set>
+#include <vector>
+#include <stdint.h>
 #include <path_planning/AbstractNode.h>
 #include <path_planning/FileIO.h>
+#include <path_planning/GridMap.h>
+#include <path_planning/TraceLogger.h>
 #include <iostream>
 
 namespace path_planning {
 
 /**
- * @brief Implements a "closed list" for A* based on a hash table.
+ * @brief Implements a "closed list" for A*.
+ *
+ * A list that is constructed for a grid map stores one generation stamp per cell, indexed by
+ * y * width + x: a node is closed iff the stamp of its cell equals the current generation. This
+ * makes add() and contains() O(1), and clear() only increments the generation, so the list can
+ * be reused for many queries on the same map. Without a map, the list falls back to a std::set
+ * of node pointers and accepts any kind of node.
  */
 class ClosedList {
 public:
+	/**
+	 * @brief Creates an empty closed list for arbitrary nodes.
+	 */
 	ClosedList();
+	/**
+	 * @brief Creates an empty closed list for the grid nodes of a map.
+	 * @param map The grid map, only its size is used.
+	 */
+	explicit ClosedList(const GridMap& map);
 	virtual ~ClosedList();
 
 	/**
@@ -33,12 +51,38 @@ public:
 	 */
 	bool contains(const AbstractNode * const node) const;
 
+	/**
+	 * @brief Removes all nodes from the list.
+	 *
+	 * For a list on a grid map, this takes constant time (apart from a full reset every
+	 * 2^32 - 1 calls when the generation counter wraps around).
+	 */
+	void clear();
+
+	/**
+	 * @brief Enables or disables logging for this closed list.
+	 * @param enabled If false, the list ignores ClosedList::fileIO and ClosedList::logToStdout.
+	 *
+	 * Logging is enabled by default. Lists used by concurrent searches should disable it.
+	 */
+	void setLogging(const bool& enabled) {
+		logging = enabled;
+	}
+
 private:
-	std::set<const AbstractNode *> list;
+	size_t getIndex(const AbstractNode * const node) const;
+
+	std::set<const AbstractNode *> list;  ///< The closed nodes if the list has no map.
+	size_t width;                         ///< The width of the map, 0 if the list has no map.
+	size_t height;                        ///< The height of the map, 0 if the list has no map.
+	std::vector<uint32_t> stamps;         ///< The generation in which each cell was closed.
+	uint32_t generation;
 	bool duplicateWarning;
+	bool logging;
 
 public:
 	static FileIO *fileIO;  ///< Helper for logging data.
+	static TraceLogger *traceLogger;  ///< Asynchronous binary logger for close events.
 	static bool logToStdout; ///< Write log messages to stdout.
 };
 
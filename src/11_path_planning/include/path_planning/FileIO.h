@@ -42,12 +42,33 @@ public:
 	/**
 	 * @brief Loads a grid map from a file.
 	 * @param filename The filename of the map file
-	 * @return Pointer to the newly allocated grid map.
+	 * @return Pointer to the newly allocated grid map, NULL if the file could not be read.
 	 *
 	 * The caller has to call "delete" in the end to free the map.
+	 *
+	 * The file can be a plain (P1) or raw (P4) PBM image, where black cells are occupied, a raw
+	 * PGM image with 8-bit values (P5), where cells darker than half the maximum value are
+	 * occupied, or a binary map written by saveBinaryMap(). The file is memory-mapped and the
+	 * images are decoded eight cells at a time into the tiles of the map, while the binary map
+	 * is copied without any decoding.
 	 */
 	static const GridMap * loadMap(const std::string& filename);
 
+	/**
+	 * @brief Writes a grid map to a binary map file.
+	 * @param filename The filename of the map file.
+	 * @param map The grid map.
+	 * @return True iff the file was written successfully.
+	 *
+	 * The file consists of a 32-byte header (the magic "GRIDMAP1", the 32-bit byte order mark
+	 * 0x01020304, the 32-bit number of distance layers, and the 64-bit width and height),
+	 * the occupancy in the tile layout of GridMap::getTiles(), and the distance layers with one
+	 * byte per cell in row-major order, each padded to a multiple of eight bytes. All numbers
+	 * are stored in the byte order of the host. Grid maps have no distance layers, but maps
+	 * with distance layers (e.g. of the footstep planner) can be loaded as grid maps.
+	 */
+	static bool saveBinaryMap(const std::string& filename, const GridMap& map);
+
 private:
 	std::ofstream logfile;
 };
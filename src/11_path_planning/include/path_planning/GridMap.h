@@ -3,16 +3,34 @@
 
 #include <stdexcept>
 #include <vector>
+#include <stdint.h>
 
 namespace path_planning {
 
 /**
  * @brief Represents a grid map.
+ *
+ * The occupancy is stored as one bit per cell. The cells are grouped into tiles of 8x8 cells,
+ * each of which is stored in a single 64-bit word (bit (y % 8) * 8 + (x % 8)), so that the
+ * 3x3 neighborhood of most cells can be read from one word.
  */
 struct GridMap {
 public:
 	const size_t width;   ///< The width of the map.
 	const size_t height;  ///< The height of the map.
+
+	static const int TILE_SIZE = 8;  ///< Width and height of a tile in cells.
+
+	/**
+	 * @brief Offsets of the eight neighbors of a cell in x direction.
+	 *
+	 * Neighbor i corresponds to bit i of the masks returned by getFreeNeighbors(). The
+	 * neighbors are ordered row by row: (-1, -1), (0, -1), (1, -1), (-1, 0), (1, 0),
+	 * (-1, 1), (0, 1), (1, 1).
+	 */
+	static const int NEIGHBOR_DX[8];
+	static const int NEIGHBOR_DY[8];  ///< Offsets of the eight neighbors of a cell in y direction.
+
 	/**
 	 * @brief Tests if a grid cell is occupied.
 	 * @param x The x coordinate of the grid cell.
@@ -21,10 +39,101 @@ public:
 	 * @throws std::out_of_range The cell index is outside the map bounds.
 	 */
 	bool isOccupied(const int& x, const int& y) const {
-		if (x < 0 || x >= static_cast<int>(width) || y < 0 || y >= static_cast<int>(width)) {
+		if (!isInside(x, y)) {
 			throw std::out_of_range("Index out of bounds in call to isOccupied()");
 		}
-		return data[y * width + x];
+		return isOccupiedUnchecked(x, y);
+	}
+
+	/**
+	 * @brief Tests if a grid cell is occupied without checking the map bounds.
+	 * @param x The x coordinate of the grid cell, must be inside the map.
+	 * @param y The y coordinate of the grid cell, must be inside the map.
+	 * @return True iff the grid cell is occupied.
+	 */
+	bool isOccupiedUnchecked(const int& x, const int& y) const {
+		return (tile(x, y) >> bit(x, y)) & 1u;
+	}
+
+	/**
+	 * @brief Changes the occupancy of a grid cell.
+	 * @param x The x coordinate of the grid cell.
+	 * @param y The y coordinate of the grid cell.
+	 * @param occupied True iff the cell is occupied.
+	 * @throws std::out_of_range The cell index is outside the map bounds.
+	 *
+	 * Planners that cache information about the map have to be notified separately.
+	 */
+	void setOccupied(const int& x, const int& y, const bool& occupied) {
+		if (!isInside(x, y)) {
+			throw std::out_of_range("Index out of bounds in call to setOccupied()");
+		}
+		uint64_t& word = tiles[(y / TILE_SIZE) * tilesPerRow + x / TILE_SIZE];
+		const uint64_t mask = static_cast<uint64_t>(1) << bit(x, y);
+		word = occupied ? (word | mask) : (word & ~mask);
+	}
+
+	/**
+	 * @brief Tests if a cell lies within the map bounds.
+	 * @param x The x coordinate of the grid cell.
+	 * @param y The y coordinate of the grid cell.
+	 * @return True iff the cell is inside the map.
+	 */
+	bool isInside(const int& x, const int& y) const {
+		return x >= 0 && x < static_cast<int>(width) && y >= 0 && y < static_cast<int>(height);
+	}
+
+	/**
+	 * @brief Returns the free cells in the 8-neighborhood of a cell.
+	 * @param x The x coordinate of the grid cell.
+	 * @param y The y coordinate of the grid cell.
+	 * @return A bit mask where bit i is set iff the neighbor (x + NEIGHBOR_DX[i], y + NEIGHBOR_DY[i])
+	 *         is inside the map and not occupied.
+	 * @throws std::out_of_range The cell index is outside the map bounds.
+	 */
+	unsigned int getFreeNeighbors(const int& x, const int& y) const {
+		if (x > 0 && y > 0 && x + 1 < static_cast<int>(width) && y + 1 < static_cast<int>(height)) {
+			return getFreeNeighborsUnchecked(x, y);
+		}
+		if (!isInside(x, y)) {
+			throw std::out_of_range("Index out of bounds in call to getFreeNeighbors()");
+		}
+		unsigned int result = 0;
+		for (int i = 0; i < 8; ++i) {
+			const int nx = x + NEIGHBOR_DX[i];
+			const int ny = y + NEIGHBOR_DY[i];
+			if (isInside(nx, ny) && !isOccupiedUnchecked(nx, ny)) {
+				result |= 1u << i;
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Returns the free cells in the 8-neighborhood of an interior cell.
+	 * @param x The x coordinate of the grid cell, must satisfy 0 < x < width - 1.
+	 * @param y The y coordinate of the grid cell, must satisfy 0 < y < height - 1.
+	 * @return The same bit mask as getFreeNeighbors().
+	 */
+	unsigned int getFreeNeighborsUnchecked(const int& x, const int& y) const {
+		const int tx = x % TILE_SIZE;
+		const int ty = y % TILE_SIZE;
+		uint64_t window;
+		if (tx > 0 && tx < TILE_SIZE - 1 && ty > 0 && ty < TILE_SIZE - 1) {
+			// the 3x3 window lies inside one tile: extract its three rows from the word
+			const uint64_t word = tile(x, y) >> ((ty - 1) * TILE_SIZE + tx - 1);
+			window = (word & 0x7u) | ((word >> (TILE_SIZE - 3)) & 0x38u) | ((word >> (2 * TILE_SIZE - 6)) & 0x1C0u);
+		} else {
+			window = 0;
+			for (int dy = -1; dy <= 1; ++dy) {
+				for (int dx = -1; dx <= 1; ++dx) {
+					window |= static_cast<uint64_t>(isOccupiedUnchecked(x + dx, y + dy)) << ((dy + 1) * 3 + dx + 1);
+				}
+			}
+		}
+		// drop the center cell (bit 4) and invert the occupancy
+		const unsigned int occupied = static_cast<unsigned int>((window & 0xFu) | ((window >> 1) & 0xF0u));
+		return ~occupied & 0xFFu;
 	}
 
 	/**
@@ -32,11 +141,52 @@ public:
 	 * @param width The width of the map.
 	 * @param height The height of the map.
 	 * @param data The occupancy data in row-major order.
+	 * @throws std::invalid_argument if data contains fewer than width * height cells.
+	 */
+	GridMap(const size_t& width, const size_t& height, const std::vector<bool>& data);
+
+	/**
+	 * @brief Constructs a grid map from occupancy data in the internal tile layout.
+	 * @param width The width of the map.
+	 * @param height The height of the map.
+	 * @param tiles getNumTiles(width, height) words, see getTiles().
+	 *
+	 * The data is copied as a whole, so this is the fastest way to restore a map that was
+	 * stored with getTiles().
+	 */
+	GridMap(const size_t& width, const size_t& height, const uint64_t * const tiles);
+
+	/**
+	 * @brief Returns the occupancy data in the internal tile layout.
+	 * @return The tiles in row-major order, ceil(width / TILE_SIZE) per row. Bit (y % TILE_SIZE) *
+	 *         TILE_SIZE + (x % TILE_SIZE) of tile (y / TILE_SIZE) * ceil(width / TILE_SIZE) +
+	 *         x / TILE_SIZE is set iff cell (x, y) is occupied. The bits of cells beyond the map
+	 *         bounds are zero.
+	 */
+	const std::vector<uint64_t>& getTiles() const {
+		return tiles;
+	}
+
+	/**
+	 * @brief Returns the number of tiles of a map.
+	 * @param width The width of the map.
+	 * @param height The height of the map.
+	 * @return The number of 64-bit words of the tile layout.
 	 */
-	GridMap(const size_t& width, const size_t& height, const std::vector<bool>& data) : width(width), height(height), data(data) {};
+	static size_t getNumTiles(const size_t& width, const size_t& height) {
+		return ((width + TILE_SIZE - 1) / TILE_SIZE) * ((height + TILE_SIZE - 1) / TILE_SIZE);
+	}
 
 private:
-	const std::vector<bool> data;
+	size_t tilesPerRow;
+	std::vector<uint64_t> tiles;
+
+	const uint64_t& tile(const int& x, const int& y) const {
+		return tiles[(y / TILE_SIZE) * tilesPerRow + x / TILE_SIZE];
+	}
+	static int bit(const int& x, const int& y) {
+		return (y % TILE_SIZE) * TILE_SIZE + x % TILE_SIZE;
+	}
 };
 
 }  // namespace path_planning
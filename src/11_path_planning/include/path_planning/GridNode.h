@@ -11,7 +11,9 @@ namespace path_planning {
 /**
  * @brief Represents a grid node for grid-based A* planning.
  *
- * The grid cells are stored in a sparse hash map for efficiency in large maps.
+ * The grid cells returned by get() are stored in a sparse map shared by the whole process.
+ * Planners that run many queries should use a GridNodeArena instead, which stores the nodes
+ * of one map densely and can be reset between queries.
  */
 class GridNode : public AbstractNode {
 public:
@@ -31,6 +33,7 @@ public:
 	std::string toLogString() const;
 
 private:
+	friend class GridNodeArena;
 	GridNode(const int& x, const int& y) : x(x), y(y) {};
 	typedef std::pair<int, int> IndexType;
 	typedef std::map<IndexType, GridNode*> MapType;
@@ -0,0 +1,105 @@
+#ifndef PATH_PLANNING_GRIDNODEARENA_H_
+#define PATH_PLANNING_GRIDNODEARENA_H_
+
+#include <stdexcept>
+#include <vector>
+#include <path_planning/GridMap.h>
+#include <path_planning/GridNode.h>
+
+namespace path_planning {
+
+/**
+ * @brief Dense storage for the grid nodes of one map.
+ *
+ * All nodes of the map are allocated once in a contiguous array and are indexed by
+ * y * width + x. In contrast to GridNode::get(), the nodes are owned by the arena and
+ * freed together with it. The arena remembers which nodes have been handed out since
+ * the last call to reset(), so that the search state (costs and predecessors) can be
+ * cleared between two planning queries without touching the whole map.
+ */
+class GridNodeArena {
+public:
+	/**
+	 * @brief Allocates the nodes for all cells of a map.
+	 * @param map The grid map.
+	 */
+	explicit GridNodeArena(const GridMap& map);
+	virtual ~GridNodeArena();
+
+	const size_t width;   ///< The width of the map in cells.
+	const size_t height;  ///< The height of the map in cells.
+
+	/**
+	 * @brief Provides access to a grid cell.
+	 * @param x The x coordinate of the grid cell.
+	 * @param y The y coordinate of the grid cell.
+	 * @return The grid cell.
+	 * @throws std::out_of_range The cell is outside the map bounds.
+	 */
+	GridNode* get(const int& x, const int& y) {
+		if (x < 0 || x >= static_cast<int>(width) || y < 0 || y >= static_cast<int>(height)) {
+			throw std::out_of_range("GridNodeArena::get(): cell is outside the map bounds");
+		}
+		return get(static_cast<size_t>(y) * width + x);
+	}
+
+	/**
+	 * @brief Provides access to a grid cell by its dense index.
+	 * @param index The index y * width + x of the cell, must be smaller than size().
+	 * @return The grid cell.
+	 *
+	 * The index is not checked.
+	 */
+	GridNode* get(const size_t& index) {
+		if (!touchedFlags[index]) {
+			touchedFlags[index] = true;
+			touched.push_back(index);
+		}
+		return &nodes[index];
+	}
+
+	/**
+	 * @brief Returns the dense index of a node.
+	 * @param node The node, which must belong to the map of this arena.
+	 * @return The index y * width + x of the node.
+	 */
+	size_t index(const GridNode * const node) const {
+		return static_cast<size_t>(node->y) * width + node->x;
+	}
+
+	/**
+	 * @brief Returns the number of cells in the arena.
+	 * @return width * height
+	 */
+	size_t size() const {
+		return nodes.size();
+	}
+
+	/**
+	 * @brief Returns the number of nodes handed out since the last reset.
+	 * @return The number of touched nodes.
+	 */
+	size_t numTouched() const {
+		return touched.size();
+	}
+
+	/**
+	 * @brief Clears the costs and predecessors of all nodes handed out since the last reset.
+	 *
+	 * The runtime is proportional to the number of touched nodes, not to the map size.
+	 * Pointers to nodes stay valid.
+	 */
+	void reset();
+
+private:
+	GridNodeArena(const GridNodeArena&);
+	GridNodeArena& operator=(const GridNodeArena&);
+
+	std::vector<GridNode> nodes;
+	std::vector<bool> touchedFlags;
+	std::vector<size_t> touched;
+};
+
+}  // namespace path_planning
+
+#endif /* PATH_PLANNING_GRIDNODEARENA_H_ */
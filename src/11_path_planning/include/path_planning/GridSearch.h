@@ -0,0 +1,195 @@
+#ifndef PATH_PLANNING_GRIDSEARCH_H_
+#define PATH_PLANNING_GRIDSEARCH_H_
+
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+#include <path_planning/GridMap.h>
+#include <path_planning/GridNode.h>
+#include <path_planning/GridNodeArena.h>
+#include <path_planning/SearchKernel.h>
+
+namespace path_planning {
+
+/**
+ * @brief A grid cell as a lightweight state for SearchKernel.
+ */
+struct GridCell {
+	int x;  ///< The x coordinate of the grid cell.
+	int y;  ///< The y coordinate of the grid cell.
+
+	GridCell() : x(0), y(0) {};
+	GridCell(const int& x, const int& y) : x(x), y(y) {};
+
+	bool operator==(const GridCell& other) const {
+		return x == other.x && y == other.y;
+	}
+};
+
+/**
+ * @brief State space policy for searching the free cells of a grid map with 8-connectivity.
+ *
+ * The successors are the same as in GridPathPlanning::getNeighborNodes().
+ */
+class GridSpace {
+public:
+	typedef GridCell State;
+
+	/**
+	 * @brief Constructor
+	 * @param map The grid map, which must outlive the state space.
+	 */
+	explicit GridSpace(const GridMap& map) : map(map) {};
+
+	size_t size() const {
+		return map.width * map.height;
+	}
+	size_t index(const GridCell& cell) const {
+		return static_cast<size_t>(cell.y) * map.width + cell.x;
+	}
+	GridCell state(const size_t& index) const {
+		return GridCell(static_cast<int>(index % map.width), static_cast<int>(index / map.width));
+	}
+	bool isGoal(const GridCell& cell, const GridCell& goal) const {
+		return cell == goal;
+	}
+	template <class Visitor>
+	void forEachSuccessor(const GridCell& cell, Visitor& visitor) const {
+		unsigned int freeNeighbors = map.getFreeNeighbors(cell.x, cell.y);
+		while (freeNeighbors) {
+			const int i = __builtin_ctz(freeNeighbors);
+			freeNeighbors &= freeNeighbors - 1;
+			visitor(GridCell(cell.x + GridMap::NEIGHBOR_DX[i], cell.y + GridMap::NEIGHBOR_DY[i]));
+		}
+	}
+
+	const GridMap& map;  ///< The grid map.
+};
+
+/**
+ * @brief Cost policy for grid cells: the Euclidean distance, as in GridPathPlanning::getCosts().
+ */
+struct GridCosts {
+	double operator()(const GridCell& from, const GridCell& to) const {
+		const int dx = to.x - from.x;
+		const int dy = to.y - from.y;
+		const int squared = dx * dx + dy * dy;
+		// neighbors in the 8-neighborhood need no square root
+		if (squared == 1) {
+			return 1.0;
+		}
+		if (squared == 2) {
+			return std::sqrt(2.0);
+		}
+		return std::sqrt(static_cast<double>(squared));
+	}
+};
+
+/**
+ * @brief Heuristic policy with the same values as StraightLineDistanceHeuristic.
+ */
+struct StraightLineDistancePolicy {
+	double operator()(const GridCell& cell, const GridCell& goal) const {
+		const double dx = cell.x - goal.x;
+		const double dy = cell.y - goal.y;
+		return std::sqrt(dx * dx + dy * dy);
+	}
+};
+
+/**
+ * @brief Heuristic policy with the same values as ManhattanDistanceHeuristic.
+ */
+struct ManhattanDistancePolicy {
+	double operator()(const GridCell& cell, const GridCell& goal) const {
+		return std::abs(cell.x - goal.x) + std::abs(cell.y - goal.y);
+	}
+};
+
+/**
+ * @brief Grid-based A* planning on top of SearchKernel.
+ *
+ * The planner finds paths with the same costs as GridPathPlanning with the corresponding
+ * heuristic, but without virtual calls in the expansion loop. Ties between nodes with equal
+ * costs may be broken differently, so the path and the number of expansions can differ.
+ */
+template <class Heuristic = StraightLineDistancePolicy>
+class GridSearch {
+public:
+	typedef SearchKernel<GridSpace, GridCosts, Heuristic> Kernel;
+
+	/**
+	 * @brief Constructs a planner for a given grid map.
+	 * @param map The grid map, which must outlive the planner.
+	 * @param heuristic The heuristic policy.
+	 */
+	explicit GridSearch(const GridMap& map, const Heuristic& heuristic = Heuristic()) :
+		space(map), kernel(space, GridCosts(), heuristic) {};
+
+	/**
+	 * @brief Plans a path between two cells.
+	 * @param[in] start The start cell.
+	 * @param[in] goal The goal cell.
+	 * @param[out] path The cells from the start to the goal, empty if there is no path.
+	 * @return The costs of the path, or infinity if there is no path.
+	 * @throws std::out_of_range if start or goal is outside the map.
+	 */
+	double planPath(const GridCell& start, const GridCell& goal, std::vector<GridCell>& path) {
+		if (!space.map.isInside(start.x, start.y) || !space.map.isInside(goal.x, goal.y)) {
+			throw std::out_of_range("GridSearch::planPath(): start or goal is outside the map");
+		}
+		kernel.search(start, goal);
+		kernel.getPath(path);
+		return kernel.getPathCosts();
+	}
+
+	/**
+	 * @brief Plans a path between two nodes of a node arena, like GridPathPlanning::planPath().
+	 * @param startNode The start node.
+	 * @param goalNode The goal node.
+	 * @param arena The node arena of the map, which is reset first.
+	 * @return The nodes of the path from the start node to the goal node, empty if there is none.
+	 * @throws std::invalid_argument if one of the nodes is NULL.
+	 * @throws std::out_of_range if a node is outside the map.
+	 *
+	 * The costs and predecessors of the nodes on the path are set, so the path can also be
+	 * retrieved with PathPlanning::followPath().
+	 */
+	std::deque<const AbstractNode*> planPath(const GridNode * const startNode, const GridNode * const goalNode, GridNodeArena& arena) {
+		if (!startNode || !goalNode) {
+			throw std::invalid_argument("GridSearch::planPath(): startNode or goalNode is NULL");
+		}
+		std::vector<GridCell> cells;
+		planPath(GridCell(startNode->x, startNode->y), GridCell(goalNode->x, goalNode->y), cells);
+		arena.reset();
+		std::deque<const AbstractNode*> path;
+		double costs = 0.0;
+		GridCosts cellCosts;
+		for (size_t i = 0; i < cells.size(); ++i) {
+			GridNode * const node = arena.get(cells[i].x, cells[i].y);
+			if (i > 0) {
+				costs += cellCosts(cells[i - 1], cells[i]);
+				node->setPredecessor(path.back());
+			}
+			node->costs = costs;
+			path.push_back(node);
+		}
+		return path;
+	}
+
+	/**
+	 * @brief Returns the number of nodes that were expanded by the last call to planPath().
+	 * @return The number of expanded nodes.
+	 */
+	size_t getNumExpansions() const {
+		return kernel.getNumExpansions();
+	}
+
+private:
+	GridSpace space;
+	Kernel kernel;
+};
+
+}  // namespace path_planning
+
+#endif /* PATH_PLANNING_GRIDSEARCH_H_ */
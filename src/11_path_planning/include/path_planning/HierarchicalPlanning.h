@@ -0,0 +1,183 @@
+#ifndef PATH_PLANNING_HIERARCHICALPLANNING_H_
+#define PATH_PLANNING_HIERARCHICALPLANNING_H_
+
+#include <utility>
+#include <vector>
+#include <stdint.h>
+#include <path_planning/GridMap.h>
+
+namespace path_planning {
+
+/**
+ * @brief Hierarchical path planning (HPA*) with an abstraction that is reused by all queries.
+ *
+ * The map is divided into square clusters. Wherever two neighboring clusters are connected,
+ * transitions between pairs of adjacent free cells are placed on their common border: one in
+ * the middle of every maximal run of connected border cells that is shorter than six cells and
+ * one at each end of longer runs. Diagonal moves across a border or a corner of four clusters
+ * that cannot be replaced by a straight crossing get a transition of their own, so two cells
+ * are connected in the abstraction iff they are connected in the map. The cells of the
+ * transitions are the nodes of the abstract graph. They are linked to the nodes of the same
+ * cluster by intra-cluster edges whose costs are computed once by a search within the cluster
+ * and cached.
+ *
+ * A query connects the start and the goal to the nodes of their clusters by one search within
+ * each cluster, searches the abstract graph with A*, and refines the abstract path by searches
+ * within the clusters along the path. The path is not necessarily optimal, since it has to pass
+ * through the transitions. Each result contains the octile distance between start and goal as a
+ * lower bound of the optimal costs, which bounds the suboptimality of the query.
+ *
+ * When the occupancy of a cell changes, invalidateCell() marks the cluster of the cell and the
+ * borders that the cell lies on as outdated. They are recomputed at the beginning of the next
+ * query. The clusters on the other side of these borders are only recomputed if the transitions
+ * on the border have changed.
+ *
+ * The planner is not thread-safe.
+ */
+class HierarchicalPlanning {
+public:
+	/**
+	 * @brief The answer to a path query.
+	 */
+	struct Result {
+		std::vector<std::pair<int, int> > path;  ///< The cells of the path from start to goal, empty if there is none.
+		double costs;                            ///< The costs of the path, 0 if there is none.
+		double lowerBound;                       ///< The octile distance from start to goal, a lower bound of the optimal costs.
+		size_t abstractExpansions;               ///< The number of nodes expanded by the search on the abstract graph.
+		size_t expansions;                       ///< The number of expanded nodes and cells, including the searches within clusters.
+
+		Result() : costs(0.0), lowerBound(0.0), abstractExpansions(0), expansions(0) {};
+
+		/**
+		 * @brief Returns an upper bound of the suboptimality of the path.
+		 * @return costs / lowerBound, 1 if start and goal are equal or there is no path.
+		 */
+		double getSuboptimalityBound() const {
+			return lowerBound > 0.0 && !path.empty() ? costs / lowerBound : 1.0;
+		}
+	};
+
+	/**
+	 * @brief Creates a planner for a grid map.
+	 * @param map The grid map, which must outlive the planner.
+	 * @param clusterSize The width and height of the clusters in cells.
+	 * @throws std::invalid_argument if clusterSize is smaller than 2.
+	 *
+	 * The abstraction is built by the first query.
+	 */
+	explicit HierarchicalPlanning(const GridMap& map, const size_t& clusterSize = 16);
+	virtual ~HierarchicalPlanning() {};
+
+	/**
+	 * @brief Plans a path between two cells.
+	 * @param startX The x coordinate of the start cell.
+	 * @param startY The y coordinate of the start cell.
+	 * @param goalX The x coordinate of the goal cell.
+	 * @param goalY The y coordinate of the goal cell.
+	 * @return The path.
+	 * @throws std::out_of_range if a start or goal cell is outside the map.
+	 */
+	Result planPath(const int& startX, const int& startY, const int& goalX, const int& goalY);
+
+	/**
+	 * @brief Notifies the planner that the occupancy of a cell has changed.
+	 * @param x The x coordinate of the cell.
+	 * @param y The y coordinate of the cell.
+	 * @throws std::out_of_range if the cell is outside the map.
+	 */
+	void invalidateCell(const int& x, const int& y);
+
+	/**
+	 * @brief Recomputes the outdated parts of the abstraction.
+	 *
+	 * This is done automatically by planPath(), but can be called earlier to build the
+	 * abstraction in advance.
+	 */
+	void update();
+
+	/**
+	 * @brief Returns the number of nodes of the abstract graph.
+	 * @return The number of nodes.
+	 */
+	size_t getNumAbstractNodes() const;
+
+	/**
+	 * @brief Returns the number of clusters whose nodes and edges have been computed so far.
+	 * @return The number of cluster updates, counting repeated updates of the same cluster.
+	 */
+	size_t getNumClusterUpdates() const {
+		return numClusterUpdates;
+	}
+
+	const size_t clusterSize;  ///< The width and height of the clusters in cells.
+
+private:
+	HierarchicalPlanning(const HierarchicalPlanning&);
+	HierarchicalPlanning& operator=(const HierarchicalPlanning&);
+
+	/**
+	 * @brief A pair of adjacent free cells in two different clusters.
+	 */
+	struct Transition {
+		uint32_t first;   ///< The cell in the left or upper cluster.
+		uint32_t second;  ///< The cell in the right or lower cluster.
+		double costs;
+	};
+
+	/**
+	 * @brief An edge from a node to a node of another cluster.
+	 */
+	struct Link {
+		uint32_t cell;
+		double costs;
+	};
+
+	struct Cluster {
+		std::vector<uint32_t> nodes;             ///< The cells of the nodes.
+		std::vector<std::vector<Link> > links;   ///< The edges to other clusters for each node.
+		std::vector<double> costs;               ///< The intra-cluster costs between all pairs of nodes, infinity if not connected.
+		bool outdated;
+		Cluster() : outdated(true) {};
+	};
+
+	size_t clusterOf(const uint32_t& cell) const {
+		return ((cell / map.width) / clusterSize) * clustersX + (cell % map.width) / clusterSize;
+	}
+	int localNode(const Cluster& cluster, const uint32_t& cell) const;
+
+	void computeVerticalBorder(const size_t& cx, const size_t& cy);
+	void computeHorizontalBorder(const size_t& cx, const size_t& cy);
+	void computeCorner(const size_t& cx, const size_t& cy);
+	void addTransition(std::vector<Transition>& transitions, const int& x1, const int& y1, const int& x2, const int& y2);
+	void computeCluster(const size_t& cx, const size_t& cy);
+
+	size_t searchCluster(const uint32_t& source, const size_t& cluster, const uint32_t& target);
+	double getLocalCosts(const uint32_t& cell) const;
+	void appendLocalPath(const uint32_t& target, std::vector<std::pair<int, int> >& path) const;
+
+	const GridMap& map;
+	size_t clustersX;
+	size_t clustersY;
+	std::vector<Cluster> clusters;
+	std::vector<std::vector<Transition> > verticalBorders;    ///< Border to the right of each cluster.
+	std::vector<std::vector<Transition> > horizontalBorders;  ///< Border below each cluster.
+	std::vector<std::vector<Transition> > corners;            ///< Corner at the bottom right of each cluster.
+	std::vector<bool> outdatedVertical;
+	std::vector<bool> outdatedHorizontal;
+	std::vector<bool> outdatedCorners;
+	bool outdated;
+	size_t numClusterUpdates;
+
+	// state of the search within a cluster, indexed by the position within the cluster
+	size_t localX;
+	size_t localY;
+	std::vector<double> localCosts;
+	std::vector<uint32_t> localPredecessors;
+	std::vector<uint32_t> localGenerations;
+	uint32_t localGeneration;
+	std::vector<std::pair<double, uint32_t> > localHeap;
+};
+
+}  // namespace path_planning
+
+#endif /* PATH_PLANNING_HIERARCHICALPLANNING_H_ */
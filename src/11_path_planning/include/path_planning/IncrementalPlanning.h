@@ -0,0 +1,173 @@
+#ifndef PATH_PLANNING_INCREMENTALPLANNING_H_
+#define PATH_PLANNING_INCREMENTALPLANNING_H_
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+#include <path_planning/GridMap.h>
+
+namespace path_planning {
+
+/**
+ * @brief Incremental path planning with D* Lite for grid maps whose cells change over time.
+ *
+ * The planner searches backwards from the goal to the start, with the same 8-connectivity and
+ * Euclidean step costs as GridPathPlanning, and keeps its search state between queries: for
+ * each cell the costs g to the goal and the one-step lookahead rhs = min(c(s, s') + g(s')). After
+ * the occupancy of some cells has changed, updateCells() only recomputes rhs for these cells and
+ * their neighbors, and the next call to planPath() propagates the changes until the start is
+ * consistent again. The work of a replanning step is therefore proportional to the number of
+ * cells whose costs to the goal have changed, not to the size of the map.
+ *
+ * The start can move along the path (e.g. with the robot) with setStart(), which keeps the
+ * search state as well: the keys of the queued cells stay valid because the heuristic is
+ * corrected by the key modifier km (the summed heuristic distances between the starts). Only
+ * setGoal() discards the search state.
+ *
+ * The heuristic is the octile distance, which is the exact distance on an empty map. The search
+ * state is kept in dense arrays indexed by cell, which are reset lazily with a generation
+ * counter, and the priority queue is a 4-ary heap that supports removing arbitrary cells.
+ *
+ * The planner is not thread-safe.
+ */
+class IncrementalPlanning {
+public:
+	/**
+	 * @brief The answer to a path query.
+	 */
+	struct Result {
+		std::vector<std::pair<int, int> > path;  ///< The cells of the path from start to goal, empty if there is none.
+		double costs;                            ///< The costs of the path, 0 if there is none.
+		size_t expansions;                       ///< The number of cells expanded since the previous query.
+
+		Result() : costs(0.0), expansions(0) {};
+	};
+
+	/**
+	 * @brief Creates a planner for a grid map.
+	 * @param map The grid map, which must outlive the planner.
+	 * @param startX The x coordinate of the start cell.
+	 * @param startY The y coordinate of the start cell.
+	 * @param goalX The x coordinate of the goal cell.
+	 * @param goalY The y coordinate of the goal cell.
+	 * @throws std::out_of_range if the start or the goal cell is outside the map.
+	 * @throws std::length_error if the map has 2^32 - 1 or more cells.
+	 */
+	IncrementalPlanning(const GridMap& map, const int& startX, const int& startY, const int& goalX, const int& goalY);
+	virtual ~IncrementalPlanning() {};
+
+	/**
+	 * @brief Moves the start cell, keeping the search state.
+	 * @param x The x coordinate of the new start cell.
+	 * @param y The y coordinate of the new start cell.
+	 * @throws std::out_of_range if the cell is outside the map.
+	 */
+	void setStart(const int& x, const int& y);
+
+	/**
+	 * @brief Changes the goal cell, which starts a new search from scratch.
+	 * @param x The x coordinate of the new goal cell.
+	 * @param y The y coordinate of the new goal cell.
+	 * @throws std::out_of_range if the cell is outside the map.
+	 */
+	void setGoal(const int& x, const int& y);
+
+	/**
+	 * @brief Notifies the planner that the occupancy of some cells has changed.
+	 * @param cells The (x, y) coordinates of the changed cells.
+	 * @throws std::out_of_range if a cell is outside the map.
+	 *
+	 * The map must already contain the new occupancy. Cells whose occupancy has not actually
+	 * changed may be included, they only cost a few operations.
+	 */
+	void updateCells(const std::vector<std::pair<int, int> >& cells);
+
+	/**
+	 * @brief Repairs the search state and returns the current path from start to goal.
+	 * @return The path.
+	 */
+	Result planPath();
+
+	/**
+	 * @brief Returns the number of cells expanded since the planner was created or the goal was changed.
+	 * @return The number of expanded cells.
+	 */
+	size_t getTotalExpansions() const {
+		return totalExpansions;
+	}
+
+private:
+	IncrementalPlanning(const IncrementalPlanning&);
+	IncrementalPlanning& operator=(const IncrementalPlanning&);
+
+	static const uint32_t NONE = 0xFFFFFFFFu;  ///< Heap position of cells that are not queued.
+	static const size_t ARITY = 4;             ///< Number of children per node of the heap.
+
+	/**
+	 * @brief The priority of a queued cell, compared lexicographically.
+	 *
+	 * First components that only differ by rounding errors count as equal. Otherwise, cells on
+	 * an optimal path whose first component is as large as that of the start could be left
+	 * unexpanded, and the path would be extracted through their outdated costs.
+	 */
+	struct Key {
+		double first;   ///< min(g, rhs) + h + km
+		double second;  ///< min(g, rhs)
+
+		bool operator<(const Key& other) const {
+			if (std::fabs(first - other.first) <= 1e-9 * (1.0 + std::min(std::fabs(first), std::fabs(other.first)))) {
+				return second < other.second;
+			}
+			return first < other.first;
+		}
+	};
+
+	/**
+	 * @brief The search state of a cell, valid iff generation equals the planner's generation.
+	 */
+	struct Cell {
+		double g;
+		double rhs;
+		uint32_t heapIndex;
+		uint32_t generation;
+		Cell() : g(0.0), rhs(0.0), heapIndex(NONE), generation(0) {};
+	};
+
+	struct Entry {
+		Key key;
+		uint32_t index;
+	};
+
+	Cell& cell(const uint32_t& index);
+	double heuristic(const uint32_t& from, const uint32_t& to) const;
+	Key calculateKey(const uint32_t& index);
+	void computeRhs(const uint32_t& index);
+	void updateVertex(const uint32_t& index);
+	void computeShortestPath();
+
+	void push(const uint32_t& index, const Key& key);
+	void remove(const uint32_t& index);
+	void update(const uint32_t& index, const Key& key);
+	void siftUp(size_t position, const Entry entry);
+	void siftDown(size_t position, const Entry entry);
+	void place(const size_t position, const Entry entry) {
+		heap[position] = entry;
+		cells[entry.index].heapIndex = static_cast<uint32_t>(position);
+	}
+
+	const GridMap& map;
+	uint32_t start;
+	uint32_t goal;
+	double km;            ///< The key modifier.
+	std::vector<Cell> cells;
+	std::vector<Entry> heap;
+	uint32_t generation;
+	size_t numExpansions;
+	size_t totalExpansions;
+};
+
+}  // namespace path_planning
+
+#endif /* PATH_PLANNING_INCREMENTALPLANNING_H_ */
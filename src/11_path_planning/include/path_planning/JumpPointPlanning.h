@@ -0,0 +1,138 @@
+#ifndef PATH_PLANNING_JUMPPOINTPLANNING_H_
+#define PATH_PLANNING_JUMPPOINTPLANNING_H_
+
+#include <vector>
+#include <stdint.h>
+#include <path_planning/PathPlanning.h>
+
+namespace path_planning {
+
+/**
+ * @brief Precomputed straight jump distances for Jump Point Search on a grid map (JPS+).
+ *
+ * For every cell and each of the four straight directions, the table stores how far a straight
+ * jump travels: a positive value k means that the cell k steps away is a jump point, a value
+ * -k <= 0 means that there is no jump point in that direction and that the jump runs over k free
+ * cells before it hits an obstacle or the map border.
+ *
+ * The table only depends on the map, so it can be computed once and shared by all queries.
+ */
+class JumpPointTable {
+public:
+	/**
+	 * @brief The four straight directions.
+	 */
+	enum Direction { EAST = 0, WEST = 1, SOUTH = 2, NORTH = 3 };
+
+	/**
+	 * @brief Computes the jump distances for a map.
+	 * @param map The grid map.
+	 */
+	explicit JumpPointTable(const GridMap& map);
+	virtual ~JumpPointTable() {};
+
+	/**
+	 * @brief Returns the jump distance from a cell in a straight direction.
+	 * @param x The x coordinate of the cell, must be inside the map.
+	 * @param y The y coordinate of the cell, must be inside the map.
+	 * @param direction The direction.
+	 * @return The jump distance as described in the class documentation.
+	 */
+	int32_t getDistance(const int& x, const int& y, const Direction& direction) const {
+		return distances[(static_cast<size_t>(y) * width + x) * 4 + direction];
+	}
+
+	/**
+	 * @brief Returns the direction constant for a straight step.
+	 * @param dx The step in x direction (-1, 0 or 1).
+	 * @param dy The step in y direction (-1, 0 or 1), one of dx and dy must be 0.
+	 * @return The direction.
+	 */
+	static Direction direction(const int& dx, const int& dy) {
+		if (dx > 0) return EAST;
+		if (dx < 0) return WEST;
+		return dy > 0 ? SOUTH : NORTH;
+	}
+
+	const size_t width;   ///< The width of the map.
+	const size_t height;  ///< The height of the map.
+
+private:
+	std::vector<int32_t> distances;
+};
+
+/**
+ * @brief Jump Point Search (JPS) for uniform-cost 8-connected grid maps.
+ *
+ * Instead of adding all free neighbors of a node to the open list, JPS prunes the neighbors
+ * that can be reached at least as cheaply without passing through the node and then "jumps"
+ * along each remaining direction until it finds a node with a forced neighbor, the goal, or an
+ * obstacle. Only these jump points are put onto the open list, which removes most of the
+ * symmetric paths in open areas. The costs of the returned paths are the same as with
+ * GridPathPlanning.
+ *
+ * The planner reuses the A* implementation of PathPlanning: getNeighborNodes() returns the
+ * jump points reachable from a node, and followPath() fills in the cells between consecutive
+ * jump points, so the returned path contains every cell like the one of GridPathPlanning.
+ *
+ * Optionally, a JumpPointTable can be passed in to replace the straight scans by table
+ * lookups (JPS+).
+ */
+class JumpPointPlanning : public GridPathPlanning {
+public:
+	/**
+	 * @brief Constructs a JPS planner for a given grid map and heuristic.
+	 * @param map The grid map for which a plan should be generated.
+	 * @param heuristic The heuristic to use.
+	 * @param table Precomputed jump distances for the map, or NULL to scan the map.
+	 */
+	JumpPointPlanning(const GridMap& map, const GridHeuristic& heuristic, const JumpPointTable * const table = NULL);
+	/**
+	 * @brief Constructs a JPS planner that takes its nodes from a node arena.
+	 * @param map The grid map for which a plan should be generated.
+	 * @param heuristic The heuristic to use.
+	 * @param arena The node arena for the map, which must outlive the planner.
+	 * @param table Precomputed jump distances for the map, or NULL to scan the map.
+	 */
+	JumpPointPlanning(const GridMap& map, const GridHeuristic& heuristic, GridNodeArena& arena, const JumpPointTable * const table = NULL);
+	virtual ~JumpPointPlanning() {};
+
+	/**
+	 * @brief Plans a path from a start node to a goal node.
+	 * @param startNode The start node.
+	 * @param goalNode The goal node.
+	 * @return The optimal path from the start node to the end node.
+	 * @throws std::invalid_argument if one of the arguments is NULL.
+	 * @throws std::runtime_error if bidirectional search is enabled, which JPS does not support.
+	 */
+	virtual std::deque<const AbstractNode*> planPath(const AbstractNode * const startNode, const AbstractNode * const goalNode);
+	virtual std::deque<const AbstractNode*> followPath(const AbstractNode * const node);
+
+	/**
+	 * @brief Returns the jump point successors of a node.
+	 * @param[in] currentNode The current node, its predecessor determines the direction of travel.
+	 * @return The jump points that are reachable from the current node.
+	 * @throws std::invalid_argument if currentNode is NULL.
+	 */
+	virtual std::vector<AbstractNode *> getNeighborNodes(const AbstractNode * const currentNode);
+
+private:
+	bool isFree(const int& x, const int& y) const {
+		return map_.isInside(x, y) && !map_.isOccupiedUnchecked(x, y);
+	}
+	bool isBlocked(const int& x, const int& y) const {
+		return !isFree(x, y);
+	}
+	bool jumpStraight(const int& x, const int& y, const int& dx, const int& dy, int& jx, int& jy) const;
+	bool jumpDiagonal(const int& x, const int& y, const int& dx, const int& dy, int& jx, int& jy) const;
+	bool jump(const int& x, const int& y, const int& dx, const int& dy, int& jx, int& jy) const;
+
+	const JumpPointTable * const table_;
+	const AbstractNode *startNode;
+	int goalX;
+	int goalY;
+};
+
+}  // namespace path_planning
+
+#endif /* PATH_PLANNING_JUMPPOINTPLANNING_H_ */
@@ -0,0 +1,130 @@
+#ifndef PATH_PLANNING_LANDMARKHEURISTIC_H_
+#define PATH_PLANNING_LANDMARKHEURISTIC_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+#include <path_planning/PathPlanning.h>
+
+namespace path_planning {
+
+/**
+ * @brief ALT heuristic (A*, landmarks and the triangle inequality) for grid maps.
+ *
+ * For a few landmark cells L, the costs d(L, n) of the shortest paths to all cells n are
+ * precomputed with one Dijkstra search per landmark. Since the paths on the grid are
+ * symmetric, the triangle inequality gives |d(L, g) - d(L, n)| <= d(n, g) for every cell n and
+ * goal g, and the heuristic is the maximum of these bounds and the straight line distance.
+ * Unlike the straight line distance, it accounts for walls between n and g, so A* expands far
+ * fewer nodes in maze-like maps. The heuristic is admissible and consistent.
+ *
+ * The distances are stored as 16-bit integers cell by cell, so the bounds of all landmarks for
+ * a cell are read from one cache line. Each landmark has its own integer costs S for a straight
+ * step, chosen such that its largest distance fits, and a diagonal step costs floor(S * sqrt(2)).
+ * The integer distances are exact shortest paths for these step costs, which never exceed S
+ * times the real ones, so the bounds divided by S keep the heuristic admissible and consistent
+ * despite the quantization. A landmark that is more than 65534 steps away from some cell is
+ * dropped. The landmarks are placed near the boundary of the free space, spread evenly around
+ * the center of the map, and the searches run in parallel.
+ *
+ * The table is tied to the occupancy of the map it was computed for: save() stores a hash of
+ * the occupancy, and load() rejects tables of other maps. After the map has changed, the table
+ * has to be recomputed. Without a table, the heuristic equals StraightLineDistanceHeuristic.
+ *
+ * heuristic() only reads the table and can be called from several threads at the same time,
+ * e.g. by BatchPlanning.
+ */
+class LandmarkHeuristic : public GridHeuristic {
+public:
+	/**
+	 * @brief Creates a heuristic without landmarks.
+	 * @param map The grid map, which must outlive the heuristic.
+	 */
+	explicit LandmarkHeuristic(const GridMap& map);
+	virtual ~LandmarkHeuristic() {};
+
+	using GridHeuristic::heuristic;
+	double heuristic(const GridNode * const currentNode, const GridNode * const goalNode) const;
+
+	/**
+	 * @brief Places landmarks and computes their distance tables.
+	 * @param numLandmarks The number of landmarks, at most the number of free cells.
+	 * @param numThreads The number of threads, 0 to use one per hardware thread.
+	 * @throws std::invalid_argument if numLandmarks is 0 or larger than the number of free cells.
+	 */
+	void compute(const size_t& numLandmarks = 16, const size_t& numThreads = 0);
+
+	/**
+	 * @brief Computes the distance tables for given landmarks.
+	 * @param landmarks The (x, y) coordinates of the landmarks.
+	 * @param numThreads The number of threads, 0 to use one per hardware thread.
+	 * @throws std::invalid_argument if there are no landmarks or a landmark is occupied.
+	 * @throws std::out_of_range if a landmark is outside the map.
+	 */
+	void compute(const std::vector<std::pair<int, int> >& landmarks, const size_t& numThreads = 0);
+
+	/**
+	 * @brief Writes the landmarks and their distance tables to a file.
+	 * @param filename The filename of the table file.
+	 * @return True iff the file was written successfully.
+	 */
+	bool save(const std::string& filename) const;
+
+	/**
+	 * @brief Reads the landmarks and their distance tables from a file written by save().
+	 * @param filename The filename of the table file.
+	 * @return True iff the file could be read and belongs to a map of the same size and occupancy.
+	 *
+	 * The current table is kept if the file cannot be used.
+	 */
+	bool load(const std::string& filename);
+
+	/**
+	 * @brief Returns the landmarks.
+	 * @return The (x, y) coordinates of the landmarks, empty if no table has been computed or loaded.
+	 */
+	const std::vector<std::pair<int, int> >& getLandmarks() const {
+		return landmarks;
+	}
+
+	/**
+	 * @brief Returns the costs of the shortest path between a landmark and a cell as stored in the table.
+	 * @param landmark The index of the landmark.
+	 * @param x The x coordinate of the cell.
+	 * @param y The y coordinate of the cell.
+	 * @return The integer distance divided by the costs of a straight step, which is at most the
+	 *         exact costs, or infinity if the cell cannot be reached from the landmark.
+	 * @throws std::out_of_range if the landmark or the cell does not exist.
+	 */
+	double getDistance(const size_t& landmark, const int& x, const int& y) const;
+
+	/**
+	 * @brief Returns the size of the distance table.
+	 * @return The size in bytes.
+	 */
+	size_t getMemoryUsage() const {
+		return (table.size() + straightCosts.size()) * sizeof(uint16_t);
+	}
+
+	/**
+	 * @brief Computes a hash of the size and the occupancy of a map.
+	 * @param map The grid map.
+	 * @return The 64-bit FNV-1a hash.
+	 */
+	static uint64_t hashMap(const GridMap& map);
+
+private:
+	static const uint16_t UNREACHABLE = 0xFFFFu;  ///< Quantized distance of cells that cannot be reached.
+
+	uint16_t computeDistances(const std::pair<int, int>& landmark, std::vector<uint32_t>& distances) const;
+
+	const GridMap& map;
+	std::vector<std::pair<int, int> > landmarks;
+	std::vector<uint16_t> straightCosts;  ///< The integer costs of a straight step for each landmark.
+	std::vector<uint16_t> table;          ///< The integer distances, landmarks.size() entries per cell.
+};
+
+}  // namespace path_planning
+
+#endif /* PATH_PLANNING_LANDMARKHEURISTIC_H_ */
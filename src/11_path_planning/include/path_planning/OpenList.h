@@ -5,23 +5,60 @@
 #include <set>
 #include <queue>
 #include <path_planning/FileIO.h>
+#include <path_planning/TraceLogger.h>
 #include <path_planning/AbstractNode.h>
 
 namespace path_planning {
 
 /**
- * @brief Implements an "open list" for A* based on a binomial heap priority queue.
+ * @brief Implements an "open list" for A* based on a heap priority queue.
+ *
+ * Three queue implementations are available:
+ * - INDEXED_HEAP: a d-ary heap that stores the heap position of each node in the per-cell
+ *   data, so updateCosts() is a real decrease-key and no memory is allocated per operation.
+ * - LAZY_DELETION: a std::priority_queue that inserts a copy of a node on every update and
+ *   skips outdated entries in removeMin(). Costs can only be decreased with this queue.
+ * - RADIX_HEAP: a monotone radix heap on the costs rounded to multiples of 1 / RADIX_SCALE.
+ *   Entries are sorted into buckets by the highest bit in which their key differs from the
+ *   last removed key, so enqueue() and updateCosts() are O(1) and removeMin() is amortized
+ *   O(log C), where C is the largest difference between two keys in the queue, and there
+ *   are no comparisons of doubles. Updates insert a new entry like LAZY_DELETION and can
+ *   increase the costs as well. The queue is monotone: costs below the costs of the last
+ *   removed node are treated as equal to them, which is never the case in A* with a
+ *   consistent heuristic. Costs must not be negative.
  */
 class OpenList {
 public:
-	OpenList();
+	/**
+	 * @brief The queue implementation used by an open list.
+	 */
+	enum QueueType { INDEXED_HEAP, LAZY_DELETION, RADIX_HEAP };
+
+	static const unsigned int RADIX_SCALE = 1024;  ///< RADIX_HEAP rounds costs to multiples of 1 / RADIX_SCALE.
+
+	/**
+	 * @brief Creates an empty open list for the map OpenList::map.
+	 * @param queueType The queue implementation.
+	 * @param arity The number of children per heap node (only used by INDEXED_HEAP).
+	 * @throws std::invalid_argument if arity is smaller than 2.
+	 * @throws std::runtime_error if OpenList::map is not set.
+	 */
+	OpenList(const QueueType& queueType = defaultQueueType, const unsigned int& arity = defaultArity);
+	/**
+	 * @brief Creates an empty open list for a given map.
+	 * @param map The grid map, which must outlive the open list.
+	 * @param queueType The queue implementation.
+	 * @param arity The number of children per heap node (only used by INDEXED_HEAP).
+	 * @throws std::invalid_argument if arity is smaller than 2.
+	 */
+	explicit OpenList(const GridMap& map, const QueueType& queueType = defaultQueueType, const unsigned int& arity = defaultArity);
 	virtual ~OpenList();
 
 	/**
 	 * @brief Adds a node to the priority queue.
 	 * @param node The node to add.
 	 * @param costs The costs of the node.
-	 * @throws std::invalid_argument if node is NULL.
+	 * @throws std::invalid_argument if node is NULL, or if costs is negative with RADIX_HEAP.
 	 */
 	void enqueue(const AbstractNode * const node, const double costs);
 	/**
@@ -30,14 +67,27 @@ public:
 	 * @throws std::runtime_error if the queue is empty.
 	 */
 	const AbstractNode * removeMin();
+	/**
+	 * @brief Returns the minimum costs in the priority queue without removing the node.
+	 * @return The costs of the node that removeMin() would return next.
+	 * @throws std::runtime_error if the queue is empty.
+	 */
+	double getMinCosts() const;
 	/**
 	 * @brief Updates the costs of a node.
 	 * @param node The node which should be updated.
 	 * @param costs The new costs.
-	 * @throws std::invalid_argument if node is NULL.
+	 * @throws std::invalid_argument if node is NULL, or if costs is negative with RADIX_HEAP.
 	 * @throws std::runtime_error if node is not contained in the priority queue.
 	 */
 	void updateCosts(const AbstractNode * const node, const double costs);
+	/**
+	 * @brief Returns the number of nodes in the priority queue.
+	 * @return The number of open nodes, not counting outdated copies of LAZY_DELETION and RADIX_HEAP.
+	 */
+	size_t size() const {
+		return numOpen;
+	}
 	/**
 	 * @brief Tests if the priority queue is empty.
 	 * @return True iff the queue is empty.
@@ -58,6 +108,15 @@ public:
 	 * @throws std::runtime_error if node is not contained in the priority queue.
 	 */
 	double getCosts(const AbstractNode * const node) const;
+	/**
+	 * @brief Enables or disables logging for this open list.
+	 * @param enabled If false, the list ignores OpenList::fileIO and OpenList::logToStdout.
+	 *
+	 * Logging is enabled by default. Lists used by concurrent searches should disable it.
+	 */
+	void setLogging(const bool& enabled) {
+		logging = enabled;
+	}
 
 protected:
 	struct NodeWrapper;
@@ -107,18 +166,52 @@ protected:
 
 public:
 	static FileIO *fileIO;  ///< Helper for logging data.
+	static TraceLogger *traceLogger;  ///< Asynchronous binary logger for open events.
 	static bool logToStdout;      ///< Write log messages to stdout.
 	static const GridMap *map;
+	static QueueType defaultQueueType;  ///< Queue implementation used by default-constructed open lists.
+	static unsigned int defaultArity;   ///< Heap arity used by default-constructed open lists.
 
 private:
 	struct OpenListData {
 	    enum { NEW, OPEN, CLOSED } state;
 	    double cost;
-	    OpenListData() : state(NEW), cost(0.0) {}
+	    const AbstractNode *node;  ///< The node of the cell (INDEXED_HEAP and RADIX_HEAP only).
+	    size_t heapIndex;          ///< Position of the cell in the heap while it is open (INDEXED_HEAP), or its current key (RADIX_HEAP).
+	    OpenListData() : state(NEW), cost(0.0), node(NULL), heapIndex(0) {}
 	};
+	const GridMap * const gridMap;
+	bool logging;
 	mutable std::vector<OpenListData> data;
+	size_t getIndex(const AbstractNode * const node) const;
 	OpenListData& getData(AbstractNode * node);
 	OpenListData& getData(const AbstractNode * const node) const;
+
+	const QueueType queueType;
+	const size_t arity;
+	std::vector<size_t> heap;  ///< Cell indices ordered as a d-ary min-heap (INDEXED_HEAP only).
+	void heapPush(const size_t& cell);
+	size_t heapPop();
+	void siftUp(size_t position);
+	void siftDown(size_t position);
+	void heapSet(const size_t& position, const size_t& cell) {
+		heap[position] = cell;
+		data[cell].heapIndex = position;
+	}
+
+	/**
+	 * @brief An entry of the radix heap, outdated if the key differs from the current key of the cell.
+	 */
+	struct RadixEntry {
+		size_t key;
+		size_t cell;
+	};
+	static const size_t NUM_RADIX_BUCKETS = 65;  ///< Bucket 0 and one bucket per bit of a 64-bit key.
+	mutable std::vector<RadixEntry> radixBuckets[NUM_RADIX_BUCKETS];  ///< Bucket i holds keys whose highest bit that differs from radixLast is i - 1 (RADIX_HEAP only).
+	mutable size_t radixLast;  ///< The key of the last removed node (RADIX_HEAP only).
+	size_t numOpen;            ///< The number of open nodes.
+	void radixPush(const size_t& cell, const double& costs);
+	size_t radixTop() const;
 };
 
 }  // namespace planning
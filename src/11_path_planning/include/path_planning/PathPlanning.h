@@ -5,6 +5,7 @@
 
 #include <path_planning/AbstractNode.h>
 #include <path_planning/GridNode.h>
+#include <path_planning/GridNodeArena.h>
 #include <path_planning/GridMap.h>
 #include <path_planning/Heuristic.h>
 #include "ClosedList.h"
@@ -64,13 +65,35 @@ public:
 	double heuristic(const GridNode * const currentNode, const GridNode * const goalNode) const;
 };
 
+/**
+ * @brief Octile distance heuristic: the costs of the shortest path with 8-connectivity on an empty map.
+ *
+ * The octile distance is larger than the straight line distance, but still admissible and
+ * consistent for the costs of GridPathPlanning. With fixed-point costs, diagonal steps cost
+ * GridPathPlanning::FIXED_POINT_DIAGONAL / OpenList::RADIX_SCALE as in the integer cost mode of
+ * GridPathPlanning, so the heuristic is exact on an empty map in that mode and all costs in the
+ * open list are multiples of 1 / OpenList::RADIX_SCALE.
+ */
+class OctileDistanceHeuristic : public GridHeuristic {
+public:
+	/**
+	 * @brief Constructor
+	 * @param fixedPoint True to use the fixed-point costs of diagonal steps.
+	 */
+	explicit OctileDistanceHeuristic(const bool& fixedPoint = false) : fixedPoint(fixedPoint) {};
+	virtual ~OctileDistanceHeuristic() {};
+	double heuristic(const GridNode * const currentNode, const GridNode * const goalNode) const;
+
+	const bool fixedPoint;  ///< True iff diagonal steps have fixed-point costs.
+};
+
 /**
  * @brief Abstract superclass for A* planning.
  */
 class PathPlanning
 {
 public:
-	PathPlanning() {};
+	PathPlanning() : numExpansions(0), peakOpenListSize(0) {};
    	virtual ~PathPlanning() {};
    	virtual std::deque<const AbstractNode*> planPath(const AbstractNode * const startNode, const AbstractNode * const goalNode);
    	virtual std::deque<const AbstractNode*> followPath(const AbstractNode * const node);
@@ -111,6 +134,39 @@ public:
 	 * @throws std::invalid_argument if one of the arguments is NULL.
 	 */
 	virtual bool isCloseToGoal(const AbstractNode * const currentNode, const AbstractNode * const goalNode) = 0;
+
+	/**
+	 * @brief Returns the number of nodes that were expanded by the last call to planPath().
+	 * @return The number of expanded nodes.
+	 */
+	size_t getNumExpansions() const {
+		return numExpansions;
+	}
+
+	/**
+	 * @brief Returns the largest number of open nodes during the last call to planPath().
+	 * @return The peak size of the open list, summed over both directions of a bidirectional search.
+	 */
+	size_t getPeakOpenListSize() const {
+		return peakOpenListSize;
+	}
+
+protected:
+	/**
+	 * @brief Runs the A* search with caller-provided open and closed lists.
+	 * @param[in] startNode The start node.
+	 * @param[in] goalNode The goal node.
+	 * @param[in,out] openList An empty list for the open nodes.
+	 * @param[in,out] closedList An empty list for the closed nodes.
+	 * @return The optimal path from the start node to the end node.
+	 *
+	 * planPath() calls this method with default-constructed lists.
+	 */
+	std::deque<const AbstractNode*> search(const AbstractNode * const startNode, const AbstractNode * const goalNode,
+			OpenList& openList, ClosedList& closedList);
+
+	size_t numExpansions;     ///< Number of nodes expanded by the last call to planPath().
+	size_t peakOpenListSize;  ///< Largest number of open nodes during the last call to planPath().
 };
 
 /**
@@ -122,12 +178,98 @@ class GridPathPlanning : public PathPlanning {
 public:
 	/**
 	 * @brief Constructs an A* planner for a given grid map and heuristic.
-	 * @param map The grid map for which a plan should be generated.
+	 * @param map The grid map for which a plan should be generated, which is copied.
+	 * @param heuristic The heuristic to use.
+	 */
+	GridPathPlanning(const GridMap& map, const GridHeuristic& heuristic) : mapCopy_(map), map_(mapCopy_), heuristic_(heuristic), arena_(NULL), logging_(true), bidirectional_(false), integerCosts_(false), closedList_(map), backwardClosedList_(map), labelGeneration_(0) {};
+	/**
+	 * @brief Constructs an A* planner that takes its nodes from a node arena.
+	 * @param map The grid map for which a plan should be generated, which is copied.
 	 * @param heuristic The heuristic to use.
+	 * @param arena The node arena for the map, which must outlive the planner.
+	 *
+	 * The arena is reset at the beginning of each call to planPath(), so start and goal
+	 * nodes have to be taken from the same arena.
 	 */
-	GridPathPlanning(const GridMap& map, const GridHeuristic& heuristic) : map_(map), heuristic_(heuristic) {};
+	GridPathPlanning(const GridMap& map, const GridHeuristic& heuristic, GridNodeArena& arena) : mapCopy_(map), map_(mapCopy_), heuristic_(heuristic), arena_(&arena), logging_(true), bidirectional_(false), integerCosts_(false), closedList_(map), backwardClosedList_(map), labelGeneration_(0) {};
 	virtual ~GridPathPlanning() {};
 
+	/**
+	 * @brief Provides access to a grid cell of the planner's map.
+	 * @param x The x coordinate of the grid cell.
+	 * @param y The y coordinate of the grid cell.
+	 * @return The node from the arena if one is used, otherwise GridNode::get(x, y).
+	 */
+	GridNode* getNode(const int& x, const int& y) {
+		return arena_ ? arena_->get(x, y) : GridNode::get(x, y);
+	}
+
+	virtual std::deque<const AbstractNode*> planPath(const AbstractNode * const startNode, const AbstractNode * const goalNode);
+
+	/**
+	 * @brief Enables or disables logging of the open and closed lists of this planner.
+	 * @param enabled If false, the searches ignore the static FileIO and stdout logging options.
+	 *
+	 * Planners that run concurrently in different threads should disable logging.
+	 */
+	void setLogging(const bool& enabled) {
+		logging_ = enabled;
+	}
+
+	/**
+	 * @brief Enables or disables bidirectional search.
+	 * @param enabled If true, planPath() searches from the start and from the goal at the same time.
+	 *
+	 * The forward search is guided by the heuristic towards the goal and the backward search by
+	 * the heuristic towards the start (front-to-end). In each step, the direction with fewer open
+	 * nodes is expanded. Every node that is reached from both sides is a candidate for the meeting
+	 * node, and the search stops as soon as the minimum costs in one of the open lists are not
+	 * smaller than the costs of the best candidate path. Nodes that cannot lead to a cheaper path
+	 * are not added to the open lists, and nodes that both directions have closed are not expanded
+	 * (as in BS*). The path is optimal under the same conditions as with unidirectional search.
+	 * getNumExpansions() counts the expansions of both directions.
+	 *
+	 * The costs must be symmetric, since the backward search uses getNeighborNodes() and
+	 * getCosts() in the reverse direction.
+	 */
+	void setBidirectional(const bool& enabled) {
+		bidirectional_ = enabled;
+	}
+
+	/**
+	 * @brief Enables or disables integer costs.
+	 * @param enabled If true, the costs are fixed-point numbers and the open lists are radix heaps.
+	 *
+	 * In the integer cost mode, a straight step costs 1 and a diagonal step costs
+	 * FIXED_POINT_DIAGONAL / OpenList::RADIX_SCALE, which is sqrt(2) rounded up, so the costs of
+	 * a path are at most 0.06% higher than with exact costs, and every heuristic that is
+	 * admissible for the exact costs stays admissible. getCosts() returns the octile distance
+	 * with these step costs. The open lists are of type OpenList::RADIX_HEAP, which rounds the
+	 * costs in the open list to the same fixed-point resolution. With OctileDistanceHeuristic
+	 * with fixed-point costs, no rounding is necessary and no costs are compared as doubles.
+	 */
+	void setIntegerCosts(const bool& enabled) {
+		integerCosts_ = enabled;
+	}
+
+	/**
+	 * @brief Tests if the integer cost mode is enabled.
+	 * @return True iff the costs are fixed-point numbers.
+	 */
+	bool hasIntegerCosts() const {
+		return integerCosts_;
+	}
+
+	static const int FIXED_POINT_DIAGONAL = 1449;  ///< The costs of a diagonal step in the integer cost mode, in units of 1 / OpenList::RADIX_SCALE.
+
+	/**
+	 * @brief Tests if bidirectional search is enabled.
+	 * @return True iff planPath() runs a bidirectional search.
+	 */
+	bool isBidirectional() const {
+		return bidirectional_;
+	}
+
 	// Overloaded methods for convenience
 	double getCosts(const GridNode * const currentNode, const GridNode * const successorNode) const;
 	std::vector<AbstractNode *> getNeighborNodes(const GridNode * const currentNode, const GridMap& map);
@@ -169,9 +311,58 @@ public:
 	}
 
 
-private:
-   	const GridMap map_;
+protected:
+	/**
+	 * @brief Runs the bidirectional search (see setBidirectional()).
+	 * @param[in] startNode The start node.
+	 * @param[in] goalNode The goal node.
+	 * @return The optimal path from the start node to the end node.
+	 */
+	std::deque<const AbstractNode*> searchBidirectional(const AbstractNode * const startNode, const AbstractNode * const goalNode);
+
+   	const GridMap mapCopy_;  ///< The copy of the map, empty if the map is shared.
+   	const GridMap& map_;     ///< The map of the searches, mapCopy_ unless the map is shared.
    	const GridHeuristic& heuristic_;
+   	GridNodeArena *arena_;
+   	bool logging_;
+   	bool bidirectional_;
+   	bool integerCosts_;
+   	ClosedList closedList_;  ///< Reused by all queries, cleared at the beginning of planPath().
+   	ClosedList backwardClosedList_;  ///< Closed list of the backward direction of bidirectional search.
+
+private:
+	friend class BatchPlanning;
+
+	// map_ may refer to mapCopy_, which a copy would not update
+	GridPathPlanning(const GridPathPlanning&);
+	GridPathPlanning& operator=(const GridPathPlanning&);
+
+	/**
+	 * @brief Selects the constructor that shares the map instead of copying it.
+	 */
+	struct SharedMap {};
+
+	/**
+	 * @brief Constructs an A* planner that uses a map without copying it.
+	 * @param map The grid map, which must outlive the planner.
+	 * @param heuristic The heuristic to use.
+	 * @param arena The node arena for the map, which must outlive the planner.
+	 *
+	 * BatchPlanning creates a planner per worker and batch, which all read the same map.
+	 */
+	GridPathPlanning(const GridMap& map, const GridHeuristic& heuristic, GridNodeArena& arena, SharedMap) : mapCopy_(0, 0, std::vector<bool>()), map_(map), heuristic_(heuristic), arena_(&arena), logging_(true), bidirectional_(false), integerCosts_(false), closedList_(map), backwardClosedList_(map), labelGeneration_(0) {};
+
+	/**
+	 * @brief Costs and predecessor of a cell in one direction of bidirectional search.
+	 */
+	struct Label {
+		double costs;
+		AbstractNode *predecessor;  ///< Towards the start (forward) or the goal (backward).
+		uint32_t generation;        ///< The label is valid iff this equals labelGeneration_.
+		Label() : costs(0.0), predecessor(NULL), generation(0) {};
+	};
+	std::vector<Label> labels_[2];  ///< Labels of the forward and backward direction, indexed by y * width + x.
+	uint32_t labelGeneration_;
 };
 
 }  // namespace path_planning
@@ -0,0 +1,284 @@
+#ifndef PATH_PLANNING_SEARCHKERNEL_H_
+#define PATH_PLANNING_SEARCHKERNEL_H_
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <stdint.h>
+
+namespace path_planning {
+
+/**
+ * @brief A* search that is specialized at compile time for a state space, costs and a heuristic.
+ *
+ * In contrast to PathPlanning, the kernel calls its policies directly instead of through virtual
+ * methods and keeps its search state in dense arrays indexed by the state index, so no
+ * dynamic_cast or map lookup is needed and the compiler can inline the whole expansion loop.
+ * The arrays are reused by all searches of a kernel: a generation counter marks which entries
+ * belong to the current search, so starting a search does not touch the whole state space.
+ *
+ * The template parameters have to provide the following members:
+ * - Space::State: the state type, which should be cheap to copy.
+ * - size_t Space::size() const: the number of states.
+ * - size_t Space::index(const State& state) const: a unique index smaller than size().
+ * - State Space::state(const size_t& index) const: the inverse of index().
+ * - bool Space::isGoal(const State& state, const State& goal) const: the goal test.
+ * - template <class Visitor> void Space::forEachSuccessor(const State& state, Visitor& visitor) const:
+ *   calls visitor(successor) for each state that can be reached from state.
+ * - double Costs::operator()(const State& from, const State& to) const: the costs of a transition.
+ * - double Heuristic::operator()(const State& state, const State& goal) const: the heuristic.
+ *
+ * With a weight w > 1, the kernel runs weighted A* (f = g + w * h), the search that ARA*
+ * repeats with decreasing weights. The costs of the path are then at most w times the optimal
+ * costs if the heuristic is admissible.
+ */
+template <class Space, class Costs, class Heuristic>
+class SearchKernel {
+public:
+	typedef typename Space::State State;
+
+	/**
+	 * @brief Creates a kernel for a state space.
+	 * @param space The state space, which must outlive the kernel.
+	 * @param costs The cost policy (copied).
+	 * @param heuristic The heuristic policy (copied).
+	 */
+	SearchKernel(const Space& space, const Costs& costs = Costs(), const Heuristic& heuristic = Heuristic()) :
+		space(space), costs(costs), heuristic(heuristic), generation(0), goalIndex(NONE), numExpansions(0) {};
+
+	/**
+	 * @brief Searches a path from a start state to a goal state.
+	 * @param start The start state.
+	 * @param goal The goal state.
+	 * @param weight The weight of the heuristic.
+	 * @return True iff a path has been found.
+	 * @throws std::invalid_argument if weight is smaller than 1.
+	 * @throws std::length_error if the state space has 2^32 - 1 or more states.
+	 */
+	bool search(const State& start, const State& goal, const double& weight = 1.0);
+
+	/**
+	 * @brief Returns the path found by the last call to search().
+	 * @param[out] path The states from the start to the goal, empty if no path has been found.
+	 */
+	void getPath(std::vector<State>& path) const;
+
+	/**
+	 * @brief Returns the costs of the path found by the last call to search().
+	 * @return The path costs, or infinity if no path has been found.
+	 */
+	double getPathCosts() const {
+		return goalIndex == NONE ? std::numeric_limits<double>::infinity() : cells[goalIndex].g;
+	}
+
+	/**
+	 * @brief Returns the number of states that were expanded by the last call to search().
+	 * @return The number of expanded states.
+	 */
+	size_t getNumExpansions() const {
+		return numExpansions;
+	}
+
+private:
+	static const uint32_t NONE = 0xFFFFFFFFu;    ///< Invalid state index.
+	static const uint32_t CLOSED = 0xFFFFFFFFu;  ///< Heap position of closed states.
+	static const size_t ARITY = 4;               ///< Number of children per node of the open list heap.
+
+	/**
+	 * @brief The search state of one state, valid iff generation equals the kernel's generation.
+	 */
+	struct Cell {
+		double g;
+		uint32_t predecessor;
+		uint32_t heapIndex;   ///< Position in the heap while open, CLOSED after expansion.
+		uint32_t generation;
+		Cell() : g(0.0), predecessor(NONE), heapIndex(CLOSED), generation(0) {};
+	};
+
+	/**
+	 * @brief An entry of the open list, which keeps the key next to the index for cache locality.
+	 */
+	struct Entry {
+		double f;
+		uint32_t index;
+	};
+
+	/**
+	 * @brief Relaxes the transitions to the successors of the expanded state.
+	 */
+	struct Expander {
+		SearchKernel& kernel;
+		const State& current;
+		const uint32_t currentIndex;
+		const double currentG;
+		const State& goal;
+		const double weight;
+
+		Expander(SearchKernel& kernel, const State& current, const uint32_t currentIndex, const State& goal, const double weight) :
+			kernel(kernel), current(current), currentIndex(currentIndex), currentG(kernel.cells[currentIndex].g), goal(goal), weight(weight) {};
+
+		void operator()(const State& successor) {
+			kernel.relax(current, currentIndex, currentG, successor, goal, weight);
+		}
+	};
+
+	SearchKernel(const SearchKernel&);
+	SearchKernel& operator=(const SearchKernel&);
+
+	void relax(const State& current, const uint32_t currentIndex, const double currentG,
+			const State& successor, const State& goal, const double weight);
+	void push(const uint32_t index, const double f);
+	uint32_t pop();
+	void siftUp(size_t position, const Entry entry);
+	void siftDown(size_t position, const Entry entry);
+	void place(const size_t position, const Entry entry) {
+		heap[position] = entry;
+		cells[entry.index].heapIndex = static_cast<uint32_t>(position);
+	}
+
+	const Space& space;
+	Costs costs;
+	Heuristic heuristic;
+	std::vector<Cell> cells;
+	std::vector<Entry> heap;
+	uint32_t generation;
+	uint32_t goalIndex;
+	size_t numExpansions;
+};
+
+template <class Space, class Costs, class Heuristic>
+bool SearchKernel<Space, Costs, Heuristic>::search(const State& start, const State& goal, const double& weight) {
+	if (!(weight >= 1.0)) {
+		throw std::invalid_argument("SearchKernel::search(): weight must be at least 1");
+	}
+	if (space.size() >= NONE) {
+		throw std::length_error("SearchKernel::search(): the state space is too large");
+	}
+	if (cells.size() != space.size()) {
+		cells.assign(space.size(), Cell());
+		generation = 0;
+	}
+	if (++generation == 0) {
+		// the counter wrapped around, so old stamps could be mistaken for current ones
+		for (size_t i = 0; i < cells.size(); ++i) {
+			cells[i].generation = 0;
+		}
+		generation = 1;
+	}
+	heap.clear();
+	goalIndex = NONE;
+	numExpansions = 0;
+
+	const uint32_t startIndex = static_cast<uint32_t>(space.index(start));
+	Cell& startCell = cells[startIndex];
+	startCell.g = 0.0;
+	startCell.predecessor = NONE;
+	startCell.generation = generation;
+	push(startIndex, weight * heuristic(start, goal));
+
+	while (!heap.empty()) {
+		const uint32_t index = pop();
+		++numExpansions;
+		const State current = space.state(index);
+		if (space.isGoal(current, goal)) {
+			goalIndex = index;
+			return true;
+		}
+		Expander expander(*this, current, index, goal, weight);
+		space.forEachSuccessor(current, expander);
+	}
+	return false;
+}
+
+template <class Space, class Costs, class Heuristic>
+void SearchKernel<Space, Costs, Heuristic>::relax(const State& current, const uint32_t currentIndex, const double currentG,
+		const State& successor, const State& goal, const double weight) {
+	const uint32_t index = static_cast<uint32_t>(space.index(successor));
+	Cell& cell = cells[index];
+	const double g = currentG + costs(current, successor);
+	if (cell.generation == generation) {
+		if (cell.heapIndex == CLOSED || g >= cell.g) {
+			// closed, or already reached on a path that is at least as short
+			return;
+		}
+		cell.g = g;
+		cell.predecessor = currentIndex;
+		const Entry entry = { g + weight * heuristic(successor, goal), index };
+		siftUp(cell.heapIndex, entry);
+		return;
+	}
+	cell.generation = generation;
+	cell.g = g;
+	cell.predecessor = currentIndex;
+	push(index, g + weight * heuristic(successor, goal));
+}
+
+template <class Space, class Costs, class Heuristic>
+void SearchKernel<Space, Costs, Heuristic>::getPath(std::vector<State>& path) const {
+	path.clear();
+	for (uint32_t index = goalIndex; index != NONE; index = cells[index].predecessor) {
+		path.push_back(space.state(index));
+	}
+	std::reverse(path.begin(), path.end());
+}
+
+template <class Space, class Costs, class Heuristic>
+void SearchKernel<Space, Costs, Heuristic>::push(const uint32_t index, const double f) {
+	const Entry entry = { f, index };
+	heap.push_back(entry);
+	siftUp(heap.size() - 1, entry);
+}
+
+template <class Space, class Costs, class Heuristic>
+uint32_t SearchKernel<Space, Costs, Heuristic>::pop() {
+	const uint32_t index = heap.front().index;
+	cells[index].heapIndex = CLOSED;
+	const Entry last = heap.back();
+	heap.pop_back();
+	if (!heap.empty()) {
+		siftDown(0, last);
+	}
+	return index;
+}
+
+template <class Space, class Costs, class Heuristic>
+void SearchKernel<Space, Costs, Heuristic>::siftUp(size_t position, const Entry entry) {
+	while (position > 0) {
+		const size_t parent = (position - 1) / ARITY;
+		if (!(entry.f < heap[parent].f)) {
+			break;
+		}
+		place(position, heap[parent]);
+		position = parent;
+	}
+	place(position, entry);
+}
+
+template <class Space, class Costs, class Heuristic>
+void SearchKernel<Space, Costs, Heuristic>::siftDown(size_t position, const Entry entry) {
+	const size_t size = heap.size();
+	while (true) {
+		const size_t first = position * ARITY + 1;
+		if (first >= size) {
+			break;
+		}
+		const size_t end = first + ARITY < size ? first + ARITY : size;
+		size_t best = first;
+		for (size_t child = first + 1; child < end; ++child) {
+			if (heap[child].f < heap[best].f) {
+				best = child;
+			}
+		}
+		if (!(heap[best].f < entry.f)) {
+			break;
+		}
+		place(position, heap[best]);
+		position = best;
+	}
+	place(position, entry);
+}
+
+}  // namespace path_planning
+
+#endif /* PATH_PLANNING_SEARCHKERNEL_H_ */
@@ -0,0 +1,148 @@
+#ifndef PATH_PLANNING_TRACELOGGER_H_
+#define PATH_PLANNING_TRACELOGGER_H_
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+#include <path_planning/AbstractNode.h>
+#include <path_planning/GridMap.h>
+
+namespace path_planning {
+
+/**
+ * @brief Asynchronous binary logger for the open and close events of a search.
+ *
+ * The search thread appends fixed-size records to a lock-free single-producer/single-consumer
+ * ring buffer, and a background thread writes them to a binary trace file in large blocks.
+ * Logging an event therefore only costs a few stores instead of formatting and flushing a
+ * line of text. convertToText() turns a trace file into the text format written by FileIO.
+ *
+ * The trace file starts with the 8 bytes "PPTRACE1", followed by the width and the height of
+ * the map as uint32 values and the records, all in native byte order.
+ *
+ * Only one thread may log events at a time. If the ring buffer is full, the logging thread
+ * waits until the writer has made room, so no events are lost.
+ */
+class TraceLogger {
+public:
+	/**
+	 * @brief The event types.
+	 */
+	enum Event { OPEN = 0, CLOSE = 1 };
+
+	/**
+	 * @brief One record of the trace file.
+	 */
+	struct Record {
+		uint64_t timestamp;  ///< Nanoseconds since the trace file was opened.
+		uint32_t cell;       ///< The index y * width + x of the cell.
+		uint32_t event;      ///< The event type (see Event).
+		float f;             ///< The costs in the open list (f = g + h), NaN for close events.
+		float g;             ///< The costs from the start (g).
+	};
+
+	/**
+	 * @brief Creates a logger without a trace file.
+	 * @param capacity The number of records in the ring buffer, rounded up to a power of two.
+	 */
+	explicit TraceLogger(const size_t& capacity = 1 << 16);
+
+	/**
+	 * @brief Writes the remaining records and closes the trace file.
+	 */
+	virtual ~TraceLogger();
+
+	/**
+	 * @brief Opens a trace file and starts the writer thread.
+	 * @param filename The filename of the trace file.
+	 * @param map The map on which the searches run, used for computing cell indices.
+	 * @return True iff the file could be opened successfully.
+	 *
+	 * A trace file that is still open is closed first.
+	 */
+	bool open(const std::string& filename, const GridMap& map);
+
+	/**
+	 * @brief Writes the remaining records, stops the writer thread and closes the trace file.
+	 */
+	void close();
+
+	/**
+	 * @brief Tests if a trace file is open.
+	 * @return True iff events are currently being written.
+	 */
+	bool isOpen() const {
+		return running;
+	}
+
+	/**
+	 * @brief Logs an "open node" event.
+	 * @param node The node that is added to the open list.
+	 * @param f The costs with which the node is added.
+	 * @throws std::invalid_argument if node is NULL or not a grid node inside the map.
+	 */
+	void logOpenNode(const AbstractNode * const node, const double& f) {
+		log(node, OPEN, f);
+	}
+
+	/**
+	 * @brief Logs a "close node" event.
+	 * @param node The node that is added to the closed list.
+	 * @throws std::invalid_argument if node is NULL or not a grid node inside the map.
+	 */
+	void logCloseNode(const AbstractNode * const node);
+
+	/**
+	 * @brief Returns the number of records logged since the trace file was opened.
+	 * @return The number of records.
+	 */
+	uint64_t getNumRecords() const {
+		return head.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Converts a trace file into the text format of FileIO::logOpenNode() and FileIO::logCloseNode().
+	 * @param traceFilename The filename of the binary trace file.
+	 * @param textFilename The filename of the text file to write.
+	 * @return True iff the conversion was successful.
+	 */
+	static bool convertToText(const std::string& traceFilename, const std::string& textFilename);
+
+	/**
+	 * @brief Reads all records of a trace file.
+	 * @param[in] traceFilename The filename of the binary trace file.
+	 * @param[out] width The width of the map.
+	 * @param[out] height The height of the map.
+	 * @param[out] records The records.
+	 * @return True iff the file could be read successfully.
+	 */
+	static bool readTrace(const std::string& traceFilename, size_t& width, size_t& height, std::vector<Record>& records);
+
+private:
+	TraceLogger(const TraceLogger&);
+	TraceLogger& operator=(const TraceLogger&);
+
+	typedef std::chrono::steady_clock Clock;
+
+	void log(const AbstractNode * const node, const Event& event, const double& f);
+	void writeLoop();
+
+	std::vector<Record> ring;
+	size_t mask;                        ///< ring.size() - 1
+	std::atomic<uint64_t> head;         ///< Number of records pushed by the logging thread.
+	std::atomic<uint64_t> tail;         ///< Number of records written by the writer thread.
+	std::atomic<bool> running;
+	std::thread writer;
+	std::ofstream file;
+	size_t width;
+	size_t height;
+	Clock::time_point start;
+};
+
+}  // namespace path_planning
+
+#endif /* PATH_PLANNING_TRACELOGGER_H_ */
@@ -0,0 +1,162 @@
+#include <path_planning/BatchPlanning.h>
+
+namespace path_planning {
+
+BatchPlanning::BatchPlanning(const GridHeuristic& heuristic, const size_t& numThreads) :
+		heuristic(heuristic),
+		generation(0),
+		numActive(0),
+		stopping(false),
+		map(NULL),
+		queries(NULL),
+		results(NULL)
+{
+	size_t n = numThreads;
+	if (n == 0) {
+		n = std::thread::hardware_concurrency();
+		if (n == 0) {
+			n = 1;
+		}
+	}
+	workers.reserve(n);
+	for (size_t i = 0; i < n; ++i) {
+		workers.push_back(new Worker());
+	}
+	for (size_t i = 0; i < n; ++i) {
+		workers[i]->thread = std::thread(&BatchPlanning::run, this, i);
+	}
+}
+
+BatchPlanning::~BatchPlanning() {
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		stopping = true;
+	}
+	batchStarted.notify_all();
+	for (size_t i = 0; i < workers.size(); ++i) {
+		workers[i]->thread.join();
+		delete workers[i]->arena;
+		delete workers[i];
+	}
+}
+
+std::vector<BatchPlanning::Result> BatchPlanning::planBatch(const GridMap& map, const std::vector<Query>& queries) {
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const Query& q = queries[i];
+		if (!map.isInside(q.startX, q.startY) || !map.isInside(q.goalX, q.goalY)) {
+			throw std::out_of_range("BatchPlanning::planBatch(): query is outside the map bounds");
+		}
+	}
+	std::vector<Result> results(queries.size());
+	if (queries.empty()) {
+		return results;
+	}
+
+	std::lock_guard<std::mutex> batchLock(batchMutex);
+	for (size_t i = 0; i < queries.size(); ++i) {
+		Worker& worker = *workers[i % workers.size()];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		worker.tasks.push_back(i);
+	}
+
+	std::unique_lock<std::mutex> lock(stateMutex);
+	this->map = &map;
+	this->queries = &queries;
+	this->results = &results;
+	error = std::exception_ptr();
+	numActive = workers.size();
+	++generation;
+	batchStarted.notify_all();
+	batchFinished.wait(lock, [this] { return numActive == 0; });
+	this->map = NULL;
+	this->queries = NULL;
+	this->results = NULL;
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	return results;
+}
+
+void BatchPlanning::run(const size_t& workerIndex) {
+	Worker& worker = *workers[workerIndex];
+	unsigned long seenGeneration = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(stateMutex);
+			batchStarted.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+			if (stopping) {
+				return;
+			}
+			seenGeneration = generation;
+		}
+
+		try {
+			if (!worker.arena || worker.arena->width != map->width || worker.arena->height != map->height) {
+				delete worker.arena;
+				worker.arena = NULL;
+				worker.arena = new GridNodeArena(*map);
+			}
+			GridPathPlanning planner(*map, heuristic, *worker.arena, GridPathPlanning::SharedMap());
+			planner.setLogging(false);
+			size_t task;
+			while (nextTask(workerIndex, task)) {
+				solve(planner, *worker.arena, task);
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(stateMutex);
+			if (!error) {
+				error = std::current_exception();
+			}
+			// drop the remaining tasks of this worker, the others may still steal from it
+			std::lock_guard<std::mutex> taskLock(worker.mutex);
+			worker.tasks.clear();
+		}
+
+		std::lock_guard<std::mutex> lock(stateMutex);
+		if (--numActive == 0) {
+			batchFinished.notify_all();
+		}
+	}
+}
+
+bool BatchPlanning::nextTask(const size_t& workerIndex, size_t& task) {
+	{
+		Worker& own = *workers[workerIndex];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty()) {
+			task = own.tasks.front();
+			own.tasks.pop_front();
+			return true;
+		}
+	}
+	// steal from the back of the other queues
+	for (size_t i = 1; i < workers.size(); ++i) {
+		Worker& victim = *workers[(workerIndex + i) % workers.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.tasks.empty()) {
+			task = victim.tasks.back();
+			victim.tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+void BatchPlanning::solve(GridPathPlanning& planner, GridNodeArena& arena, const size_t& task) {
+	const Query& query = (*queries)[task];
+	Result& result = (*results)[task];
+	const GridNode * const startNode = arena.get(query.startX, query.startY);
+	const GridNode * const goalNode = arena.get(query.goalX, query.goalY);
+	const std::deque<const AbstractNode *> path = planner.planPath(startNode, goalNode);
+	result.expansions = planner.getNumExpansions();
+	result.path.reserve(path.size());
+	for (std::deque<const AbstractNode *>::const_iterator it = path.begin(); it != path.end(); ++it) {
+		const GridNode * const node = static_cast<const GridNode *>(*it);
+		result.path.push_back(std::make_pair(node->x, node->y));
+	}
+	if (!path.empty()) {
+		result.costs = path.back()->costs;
+	}
+}
+
+}  // namespace path_planning
@@ -2,42 +2,87 @@
 #include <path_planning/FileIO.h>
 #include <path_planning/AbstractNode.h>
 #include <path_planning/FileIO.h>
+#include <path_planning/GridNode.h>
+#include <algorithm>
 #include <iostream>
 
 namespace path_planning {
 
 FileIO *ClosedList::fileIO = NULL;
+TraceLogger *ClosedList::traceLogger = NULL;
 bool ClosedList::logToStdout = false;
 
-ClosedList::ClosedList() : duplicateWarning(false) {
+ClosedList::ClosedList() : width(0), height(0), generation(1), duplicateWarning(false), logging(true) {
+}
+
+ClosedList::ClosedList(const GridMap& map) :
+		width(map.width),
+		height(map.height),
+		stamps(map.width * map.height, 0),
+		generation(1),
+		duplicateWarning(false),
+		logging(true)
+{
 }
 
 ClosedList::~ClosedList() {
 }
 
+size_t ClosedList::getIndex(const AbstractNode * const node) const {
+	const GridNode * const g = dynamic_cast<const GridNode * const>(node);
+	if (!g) {
+		throw std::invalid_argument("Used ClosedList of a grid map with a node that is not an instance of GridNode");
+	}
+	if (g->x < 0 || g->x >= static_cast<int>(width) || g->y < 0 || g->y >= static_cast<int>(height)) {
+		throw std::invalid_argument("Used ClosedList with a grid node that is outside the map");
+	}
+	return static_cast<size_t>(g->y) * width + g->x;
+}
 
 void ClosedList::add(const AbstractNode * const node) {
 	if (!node) {
 		throw std::invalid_argument("ClosedList::add() called with NULL argument");
 	}
-	if (fileIO) {
+	if (logging && fileIO) {
 		fileIO->logCloseNode(node);
 	}
-	if (logToStdout) {
+	if (logging && logToStdout) {
 		std::cout << "close " << node->toString() << std::endl;
 	}
-	if (!duplicateWarning && list.find(node) != list.end()) {
+	if (logging && traceLogger) {
+		traceLogger->logCloseNode(node);
+	}
+	bool isDuplicate;
+	if (stamps.empty()) {
+		isDuplicate = !list.insert(node).second;
+	} else {
+		uint32_t& stamp = stamps[getIndex(node)];
+		isDuplicate = (stamp == generation);
+		stamp = generation;
+	}
+	if (!duplicateWarning && isDuplicate) {
 		std::cerr << "Warning: adding node " << node->toString()
 				<< " multiple times to the closed list." << std::endl;
 		duplicateWarning = true;
 	}
-	list.insert(node);
 }
 bool ClosedList::contains(const AbstractNode * const node) const {
 	if (!node) {
 		throw std::invalid_argument("ClosedList::contains() called with NULL argument");
 	}
-	return list.find(node) != list.end();
+	if (stamps.empty()) {
+		return list.find(node) != list.end();
+	}
+	return stamps[getIndex(node)] == generation;
+}
+
+void ClosedList::clear() {
+	list.clear();
+	if (++generation == 0) {
+		// the counter wrapped around: old stamps could match again
+		std::fill(stamps.begin(), stamps.end(), 0);
+		generation = 1;
+	}
 }
 
 }  // namespace path_planning
@@ -1,8 +1,215 @@
 #include <path_planning/FileIO.h>
+#include <file-helpers.h>
+#include <cctype>
+#include <cstring>
 #include <iostream>
+#include <limits>
 
 namespace path_planning {
 
+namespace {
+
+const char BINARY_MAP_MAGIC[8] = { 'G', 'R', 'I', 'D', 'M', 'A', 'P', '1' };
+const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+/**
+ * @brief The header of a binary map file, see FileIO::saveBinaryMap().
+ */
+struct BinaryMapHeader {
+	char magic[8];
+	uint32_t byteOrder;
+	uint32_t numLayers;
+	uint64_t width;
+	uint64_t height;
+};
+
+/**
+ * @brief The largest width and height of a map, since cells are addressed by int coordinates.
+ */
+const size_t MAX_SIZE = static_cast<size_t>(std::numeric_limits<int>::max());
+
+const uint64_t LOW_BITS = 0x0101010101010101ull;   ///< Bit 0 of each byte.
+const uint64_t GATHER_BITS = 0x0102040810204080ull;  ///< Multiplying by it moves bit 0 of byte i to bit 56 + i.
+
+bool isLittleEndian() {
+	const uint16_t one = 1;
+	return *reinterpret_cast<const unsigned char *>(&one) == 1;
+}
+
+/**
+ * @brief Reads a decimal number of the header of a PBM or PGM image, skipping whitespace and comments.
+ */
+bool readHeaderNumber(const char *& p, const char * const end, size_t& value) {
+	while (p < end && (std::isspace(static_cast<unsigned char>(*p)) || *p == '#')) {
+		if (*p == '#') {
+			while (p < end && *p != '\n') {
+				++p;
+			}
+		} else {
+			++p;
+		}
+	}
+	if (p == end || *p < '0' || *p > '9') {
+		return false;
+	}
+	value = 0;
+	while (p < end && *p >= '0' && *p <= '9') {
+		if (value > (std::numeric_limits<size_t>::max() - 9) / 10) {
+			return false;
+		}
+		value = value * 10 + static_cast<size_t>(*p - '0');
+		++p;
+	}
+	return true;
+}
+
+/**
+ * @brief Sets the occupancy of the eight cells (x, y) to (x + 7, y), where x is a multiple of eight.
+ */
+inline void setCells(std::vector<uint64_t>& tiles, const size_t& tilesPerRow, const size_t& x, const size_t& y, const unsigned int& bits) {
+	tiles[(y / GridMap::TILE_SIZE) * tilesPerRow + x / GridMap::TILE_SIZE] |= static_cast<uint64_t>(bits) << ((y % GridMap::TILE_SIZE) * GridMap::TILE_SIZE);
+}
+
+/**
+ * @brief Decodes the raster of a plain PBM image, where each cell is the character '0' or '1'.
+ */
+bool decodePlainBitmap(const char *p, const char * const end, const size_t& width, const size_t& height, std::vector<uint64_t>& tiles) {
+	const size_t tilesPerRow = (width + GridMap::TILE_SIZE - 1) / GridMap::TILE_SIZE;
+	const bool wordwise = isLittleEndian();
+	size_t x = 0, y = 0;
+	while (y < height && p < end) {
+		if (wordwise && x % GridMap::TILE_SIZE == 0 && x + 8 <= width && end - p >= 8) {
+			uint64_t word;
+			std::memcpy(&word, p, sizeof(word));
+			if (((word ^ 0x3030303030303030ull) & ~LOW_BITS) == 0) {
+				// eight digits in a row: gather their lowest bits into one byte
+				setCells(tiles, tilesPerRow, x, y, static_cast<unsigned int>(((word & LOW_BITS) * GATHER_BITS) >> 56));
+				p += 8;
+				x += 8;
+				if (x == width) {
+					x = 0;
+					++y;
+				}
+				continue;
+			}
+		}
+		const char c = *p++;
+		if (c == '0' || c == '1') {
+			if (c == '1') {
+				setCells(tiles, tilesPerRow, x & ~static_cast<size_t>(7), y, 1u << (x % 8));
+			}
+			if (++x == width) {
+				x = 0;
+				++y;
+			}
+		}
+	}
+	return y == height;
+}
+
+/**
+ * @brief Lookup table that reverses the order of the bits of a byte.
+ */
+struct ReversedBits {
+	unsigned char table[256];
+	ReversedBits() {
+		for (unsigned int b = 0; b < 256; ++b) {
+			unsigned int r = 0;
+			for (unsigned int i = 0; i < 8; ++i) {
+				r |= ((b >> i) & 1u) << (7 - i);
+			}
+			table[b] = static_cast<unsigned char>(r);
+		}
+	}
+};
+
+/**
+ * @brief Decodes the raster of a raw PBM image, where the cells are packed into bytes, eight per byte.
+ */
+bool decodeRawBitmap(const char *p, const char * const end, const size_t& width, const size_t& height, std::vector<uint64_t>& tiles) {
+	const size_t bytesPerRow = (width + 7) / 8;
+	if (static_cast<size_t>(end - p) / bytesPerRow < height) {
+		return false;
+	}
+	// the first cell of a byte is its most significant bit, but the lowest bit in a tile
+	static const ReversedBits reversed;
+	// one byte covers exactly the cells of one row of a tile
+	const unsigned int lastMask = width % 8 == 0 ? 0xFFu : (1u << (width % 8)) - 1u;
+	for (size_t y = 0; y < height; ++y) {
+		const unsigned char * const row = reinterpret_cast<const unsigned char *>(p + y * bytesPerRow);
+		for (size_t b = 0; b + 1 < bytesPerRow; ++b) {
+			if (row[b]) {
+				setCells(tiles, bytesPerRow, b * 8, y, reversed.table[row[b]]);
+			}
+		}
+		setCells(tiles, bytesPerRow, (bytesPerRow - 1) * 8, y, reversed.table[row[bytesPerRow - 1]] & lastMask);
+	}
+	return true;
+}
+
+/**
+ * @brief Decodes the raster of a raw PGM image with 8-bit values, where dark cells are occupied.
+ */
+bool decodeGraymap(const char *p, const char * const end, const size_t& width, const size_t& height, const size_t& maxValue, std::vector<uint64_t>& tiles) {
+	if (static_cast<size_t>(end - p) / width < height) {
+		return false;
+	}
+	const size_t tilesPerRow = (width + GridMap::TILE_SIZE - 1) / GridMap::TILE_SIZE;
+	const bool wordwise = maxValue == 255 && isLittleEndian();
+	for (size_t y = 0; y < height; ++y) {
+		const unsigned char * const row = reinterpret_cast<const unsigned char *>(p + y * width);
+		size_t x = 0;
+		if (wordwise) {
+			for (; x + 8 <= width; x += 8) {
+				uint64_t word;
+				std::memcpy(&word, row + x, sizeof(word));
+				// values below 128 have a clear highest bit
+				const uint64_t dark = (~word >> 7) & LOW_BITS;
+				if (dark) {
+					setCells(tiles, tilesPerRow, x, y, static_cast<unsigned int>((dark * GATHER_BITS) >> 56));
+				}
+			}
+		}
+		for (; x < width; ++x) {
+			if (2 * static_cast<size_t>(row[x]) < maxValue) {
+				setCells(tiles, tilesPerRow, x & ~static_cast<size_t>(7), y, 1u << (x % 8));
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Copies the occupancy of a binary map file into a grid map.
+ */
+const GridMap * loadBinaryMap(const file_helpers::MappedFile& file, const std::string& filename) {
+	BinaryMapHeader header;
+	if (file.size() < sizeof(header)) {
+		std::cerr << "Error: binary map file " << filename << " is truncated" << std::endl;
+		return NULL;
+	}
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (header.byteOrder != BYTE_ORDER_MARK) {
+		std::cerr << "Error: binary map file " << filename << " was written with a different byte order" << std::endl;
+		return NULL;
+	}
+	if (header.width == 0 || header.height == 0 || header.width > MAX_SIZE || header.height > MAX_SIZE) {
+		std::cerr << "Error: binary map file " << filename << " has invalid dimensions" << std::endl;
+		return NULL;
+	}
+	const uint64_t numTiles = GridMap::getNumTiles(header.width, header.height);
+	const uint64_t layerSize = (header.width * header.height + 7) & ~static_cast<uint64_t>(7);
+	const uint64_t tilesEnd = sizeof(header) + numTiles * sizeof(uint64_t);
+	if (file.size() < tilesEnd || (file.size() - tilesEnd) % layerSize != 0 || (file.size() - tilesEnd) / layerSize != header.numLayers) {
+		std::cerr << "Error: binary map file " << filename << " does not have the size given by its header" << std::endl;
+		return NULL;
+	}
+	// the header keeps the tiles aligned to eight bytes within the page-aligned mapping
+	return new GridMap(header.width, header.height, reinterpret_cast<const uint64_t *>(file.data() + sizeof(header)));
+}
+
+}  // namespace
+
 FileIO::FileIO() {}
 
 FileIO::~FileIO()  {
@@ -39,7 +246,7 @@ void FileIO::logOpenNode(const AbstractNode* const node) {
 		throw std::invalid_argument("node is NULL");
 	}
 	if (logfile.good()) {
-		logfile << node->toLogString() << " open" << std::endl;
+		logfile << node->toLogString() << " open\n";
 	}
 }
 
@@ -48,45 +255,81 @@ void FileIO::logCloseNode(const AbstractNode* const node) {
 		throw std::invalid_argument("node is NULL");
 	}
 	if (logfile.good()) {
-		logfile << node->toLogString() << " close" << std::endl;
+		logfile << node->toLogString() << " close\n";
 	}
 }
 
 const GridMap * FileIO::loadMap(const std::string& filename) {
-	std::ifstream ifs(filename.c_str());
-	if (!ifs.good()) {
+	file_helpers::MappedFile file;
+	if (!file.open(filename)) {
 		std::cerr << "Could not open map file " << filename << std::endl;
 		return NULL;
 	}
-	std::string header;
-	ifs >> header;
-	if (header != "P1") {
-		std::cerr << "Error: map file is not in PBM format" << std::endl;
+	const char *p = file.data();
+	const char * const end = p + file.size();
+	if (file.size() >= sizeof(BINARY_MAP_MAGIC) && std::memcmp(p, BINARY_MAP_MAGIC, sizeof(BINARY_MAP_MAGIC)) == 0) {
+		return loadBinaryMap(file, filename);
+	}
+	if (file.size() < 2 || p[0] != 'P' || (p[1] != '1' && p[1] != '4' && p[1] != '5')) {
+		std::cerr << "Error: map file is not in PBM or PGM format" << std::endl;
 		return NULL;
 	}
+	const char format = p[1];
+	p += 2;
 
-	size_t width = 0, height = 0;
-	ifs >> width >> height;
-	if (width > 100 || height > 100) {
-		throw std::runtime_error("Map is too big");
+	size_t width = 0, height = 0, maxValue = 1;
+	if (!readHeaderNumber(p, end, width) || !readHeaderNumber(p, end, height)
+			|| (format == '5' && !readHeaderNumber(p, end, maxValue))) {
+		std::cerr << "Error: map file " << filename << " has an invalid header" << std::endl;
+		return NULL;
 	}
-
-	std::vector<bool> data;
-	data.reserve(width * height);
-	char c;
-	while (ifs.get(c)) {
-		switch (c) {
-		case '0': data.push_back(false); break;
-		case '1': data.push_back(true); break;
-		default: //ignore
-			break;
-		}
+	if (width == 0 || height == 0 || width > MAX_SIZE || height > MAX_SIZE) {
+		std::cerr << "Error: map file " << filename << " has invalid dimensions " << width << " x " << height << std::endl;
+		return NULL;
+	}
+	if (maxValue == 0 || maxValue > 255) {
+		std::cerr << "Error: map file " << filename << " has unsupported depth " << maxValue << std::endl;
+		return NULL;
+	}
+	// a single whitespace character separates the header from the raster
+	if (p < end) {
+		++p;
 	}
 
-	ifs.close();
+	std::vector<uint64_t> tiles(GridMap::getNumTiles(width, height), 0);
+	bool success;
+	if (format == '1') {
+		success = decodePlainBitmap(p, end, width, height, tiles);
+	} else if (format == '4') {
+		success = decodeRawBitmap(p, end, width, height, tiles);
+	} else {
+		success = decodeGraymap(p, end, width, height, maxValue, tiles);
+	}
+	if (!success) {
+		std::cerr << "Error: map file " << filename << " has fewer than " << width << " x " << height << " cells" << std::endl;
+		return NULL;
+	}
+	return new GridMap(width, height, &tiles[0]);
+}
 
-	return new GridMap(width, height, data);
+bool FileIO::saveBinaryMap(const std::string& filename, const GridMap& map) {
+	std::ofstream ofs(filename.c_str(), std::ios::binary);
+	if (!ofs.is_open()) {
+		std::cerr << "Error: Could not open " << filename << " for writing the map." << std::endl;
+		return false;
+	}
+	BinaryMapHeader header;
+	std::memcpy(header.magic, BINARY_MAP_MAGIC, sizeof(BINARY_MAP_MAGIC));
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.numLayers = 0;
+	header.width = map.width;
+	header.height = map.height;
+	ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	const std::vector<uint64_t>& tiles = map.getTiles();
+	if (!tiles.empty()) {
+		ofs.write(reinterpret_cast<const char *>(&tiles[0]), tiles.size() * sizeof(uint64_t));
+	}
+	return ofs.good();
 }
 
 } /* namespace path_planning */
-
@@ -0,0 +1,50 @@
+#include <path_planning/GridMap.h>
+
+namespace path_planning {
+
+const int GridMap::NEIGHBOR_DX[8] = { -1,  0,  1, -1, 1, -1, 0, 1 };
+const int GridMap::NEIGHBOR_DY[8] = { -1, -1, -1,  0, 0,  1, 1, 1 };
+
+GridMap::GridMap(const size_t& width, const size_t& height, const std::vector<bool>& data) :
+		width(width),
+		height(height),
+		tilesPerRow((width + TILE_SIZE - 1) / TILE_SIZE),
+		tiles(tilesPerRow * ((height + TILE_SIZE - 1) / TILE_SIZE), 0)
+{
+	if (data.size() < width * height) {
+		throw std::invalid_argument("GridMap: the occupancy data is smaller than the map");
+	}
+	for (size_t y = 0; y < height; ++y) {
+		for (size_t x = 0; x < width; ++x) {
+			if (data[y * width + x]) {
+				tiles[(y / TILE_SIZE) * tilesPerRow + x / TILE_SIZE] |= static_cast<uint64_t>(1) << bit(x, y);
+			}
+		}
+	}
+}
+
+GridMap::GridMap(const size_t& width, const size_t& height, const uint64_t * const tiles) :
+		width(width),
+		height(height),
+		tilesPerRow((width + TILE_SIZE - 1) / TILE_SIZE),
+		tiles(tiles, tiles + getNumTiles(width, height))
+{
+	// clear the cells beyond the map bounds in the last column and row of tiles
+	const uint64_t allCells = ~static_cast<uint64_t>(0);
+	const int columns = static_cast<int>((width - 1) % TILE_SIZE) + 1;
+	const int rows = static_cast<int>((height - 1) % TILE_SIZE) + 1;
+	const uint64_t rowMask = columns == TILE_SIZE ? 0xFFu : (1u << columns) - 1u;
+	uint64_t columnMask = 0;
+	for (int y = 0; y < TILE_SIZE; ++y) {
+		columnMask |= rowMask << (y * TILE_SIZE);
+	}
+	const uint64_t lastRowMask = rows == TILE_SIZE ? allCells : (static_cast<uint64_t>(1) << (rows * TILE_SIZE)) - 1u;
+	for (size_t i = tilesPerRow - 1; i < this->tiles.size(); i += tilesPerRow) {
+		this->tiles[i] &= columnMask;
+	}
+	for (size_t i = this->tiles.size() - tilesPerRow; i < this->tiles.size(); ++i) {
+		this->tiles[i] &= lastRowMask;
+	}
+}
+
+}  // namespace path_planning
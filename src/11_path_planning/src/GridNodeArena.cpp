@@ -0,0 +1,31 @@
+#include <path_planning/GridNodeArena.h>
+
+namespace path_planning {
+
+GridNodeArena::GridNodeArena(const GridMap& map) :
+		width(map.width),
+		height(map.height),
+		touchedFlags(map.width * map.height, false)
+{
+	nodes.reserve(width * height);
+	for (size_t y = 0; y < height; ++y) {
+		for (size_t x = 0; x < width; ++x) {
+			nodes.push_back(GridNode(static_cast<int>(x), static_cast<int>(y)));
+		}
+	}
+}
+
+GridNodeArena::~GridNodeArena() {
+}
+
+void GridNodeArena::reset() {
+	for (std::vector<size_t>::const_iterator it = touched.begin(); it != touched.end(); ++it) {
+		GridNode& node = nodes[*it];
+		node.costs = 0.0;
+		node.setPredecessor(NULL);
+		touchedFlags[*it] = false;
+	}
+	touched.clear();
+}
+
+}  // namespace path_planning
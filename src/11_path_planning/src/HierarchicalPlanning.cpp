@@ -0,0 +1,600 @@
+#include <path_planning/HierarchicalPlanning.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace path_planning {
+
+namespace {
+
+const uint32_t NONE = 0xFFFFFFFFu;
+const double INFINITE_COSTS = std::numeric_limits<double>::infinity();
+
+/**
+ * @brief Returns the costs of a path with dx x dy cells on an obstacle-free map.
+ */
+double octileDistance(const int& dx, const int& dy) {
+	const int ax = std::abs(dx);
+	const int ay = std::abs(dy);
+	return std::sqrt(2.0) * std::min(ax, ay) + std::abs(ax - ay);
+}
+
+/**
+ * @brief The search state of a node of the abstract graph.
+ */
+struct AbstractState {
+	double costs;
+	uint32_t predecessor;
+	bool closed;
+	AbstractState() : costs(INFINITE_COSTS), predecessor(NONE), closed(false) {};
+};
+
+/**
+ * @brief Replaces the transitions of a border and tests if they have changed.
+ */
+template <class Transition>
+bool replaceTransitions(std::vector<Transition>& transitions, const std::vector<Transition>& newTransitions) {
+	bool changed = transitions.size() != newTransitions.size();
+	for (size_t i = 0; !changed && i < transitions.size(); ++i) {
+		changed = transitions[i].first != newTransitions[i].first || transitions[i].second != newTransitions[i].second;
+	}
+	transitions = newTransitions;
+	return changed;
+}
+
+typedef std::pair<double, uint32_t> QueueEntry;
+typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > Queue;
+
+}  // namespace
+
+HierarchicalPlanning::HierarchicalPlanning(const GridMap& map, const size_t& clusterSize) :
+		clusterSize(clusterSize),
+		map(map),
+		clustersX(0),
+		clustersY(0),
+		outdated(true),
+		numClusterUpdates(0),
+		localX(0),
+		localY(0),
+		localGeneration(0)
+{
+	if (clusterSize < 2) {
+		throw std::invalid_argument("HierarchicalPlanning: the cluster size must be at least 2");
+	}
+	clustersX = (map.width + clusterSize - 1) / clusterSize;
+	clustersY = (map.height + clusterSize - 1) / clusterSize;
+	const size_t numClusters = clustersX * clustersY;
+	clusters.resize(numClusters);
+	verticalBorders.resize(numClusters);
+	horizontalBorders.resize(numClusters);
+	corners.resize(numClusters);
+	outdatedVertical.assign(numClusters, true);
+	outdatedHorizontal.assign(numClusters, true);
+	outdatedCorners.assign(numClusters, true);
+	localCosts.resize(clusterSize * clusterSize);
+	localPredecessors.resize(clusterSize * clusterSize);
+	localGenerations.assign(clusterSize * clusterSize, 0);
+}
+
+void HierarchicalPlanning::invalidateCell(const int& x, const int& y) {
+	if (!map.isInside(x, y)) {
+		throw std::out_of_range("HierarchicalPlanning::invalidateCell(): cell is outside the map");
+	}
+	const size_t cx = x / clusterSize;
+	const size_t cy = y / clusterSize;
+	const size_t lx = x % clusterSize;
+	const size_t ly = y % clusterSize;
+	const bool left = (lx == 0 && cx > 0);
+	const bool right = (lx == clusterSize - 1 && cx + 1 < clustersX);
+	const bool top = (ly == 0 && cy > 0);
+	const bool bottom = (ly == clusterSize - 1 && cy + 1 < clustersY);
+
+	clusters[cy * clustersX + cx].outdated = true;
+	// the borders are indexed by the cluster to their left or above them
+	if (left) {
+		outdatedVertical[cy * clustersX + cx - 1] = true;
+	}
+	if (right) {
+		outdatedVertical[cy * clustersX + cx] = true;
+	}
+	if (top) {
+		outdatedHorizontal[(cy - 1) * clustersX + cx] = true;
+	}
+	if (bottom) {
+		outdatedHorizontal[cy * clustersX + cx] = true;
+	}
+	if (left && top) {
+		outdatedCorners[(cy - 1) * clustersX + cx - 1] = true;
+	}
+	if (right && top) {
+		outdatedCorners[(cy - 1) * clustersX + cx] = true;
+	}
+	if (left && bottom) {
+		outdatedCorners[cy * clustersX + cx - 1] = true;
+	}
+	if (right && bottom) {
+		outdatedCorners[cy * clustersX + cx] = true;
+	}
+	outdated = true;
+}
+
+void HierarchicalPlanning::update() {
+	if (!outdated) {
+		return;
+	}
+	for (size_t cy = 0; cy < clustersY; ++cy) {
+		for (size_t cx = 0; cx < clustersX; ++cx) {
+			const size_t index = cy * clustersX + cx;
+			if (outdatedVertical[index]) {
+				computeVerticalBorder(cx, cy);
+			}
+			if (outdatedHorizontal[index]) {
+				computeHorizontalBorder(cx, cy);
+			}
+			if (outdatedCorners[index]) {
+				computeCorner(cx, cy);
+			}
+		}
+	}
+	for (size_t cy = 0; cy < clustersY; ++cy) {
+		for (size_t cx = 0; cx < clustersX; ++cx) {
+			if (clusters[cy * clustersX + cx].outdated) {
+				computeCluster(cx, cy);
+			}
+		}
+	}
+	outdated = false;
+}
+
+void HierarchicalPlanning::addTransition(std::vector<Transition>& transitions, const int& x1, const int& y1, const int& x2, const int& y2) {
+	Transition transition;
+	transition.first = static_cast<uint32_t>(y1 * map.width + x1);
+	transition.second = static_cast<uint32_t>(y2 * map.width + x2);
+	transition.costs = (x1 != x2 && y1 != y2) ? std::sqrt(2.0) : 1.0;
+	transitions.push_back(transition);
+}
+
+/**
+ * @brief Computes the transitions between cluster (cx, cy) and the cluster to its right.
+ */
+void HierarchicalPlanning::computeVerticalBorder(const size_t& cx, const size_t& cy) {
+	const size_t index = cy * clustersX + cx;
+	std::vector<Transition> transitions;
+	outdatedVertical[index] = false;
+	if (cx + 1 >= clustersX) {
+		return;
+	}
+	const int x = static_cast<int>((cx + 1) * clusterSize);  // first column of the right cluster
+	const int begin = static_cast<int>(cy * clusterSize);
+	const int end = static_cast<int>(std::min((cy + 1) * clusterSize, map.height));
+	std::vector<bool> straight(end - begin);
+	for (int y = begin; y < end; ++y) {
+		straight[y - begin] = !map.isOccupiedUnchecked(x - 1, y) && !map.isOccupiedUnchecked(x, y);
+	}
+	for (int y = begin; y < end; ) {
+		if (!straight[y - begin]) {
+			++y;
+			continue;
+		}
+		int runEnd = y;
+		while (runEnd < end && straight[runEnd - begin]) {
+			++runEnd;
+		}
+		if (runEnd - y < 6) {
+			const int middle = y + (runEnd - y - 1) / 2;
+			addTransition(transitions, x - 1, middle, x, middle);
+		} else {
+			addTransition(transitions, x - 1, y, x, y);
+			addTransition(transitions, x - 1, runEnd - 1, x, runEnd - 1);
+		}
+		y = runEnd;
+	}
+	for (int y = begin; y + 1 < end; ++y) {
+		if (straight[y - begin] || straight[y + 1 - begin]) {
+			continue;
+		}
+		if (!map.isOccupiedUnchecked(x - 1, y) && !map.isOccupiedUnchecked(x, y + 1)) {
+			addTransition(transitions, x - 1, y, x, y + 1);
+		}
+		if (!map.isOccupiedUnchecked(x - 1, y + 1) && !map.isOccupiedUnchecked(x, y)) {
+			addTransition(transitions, x - 1, y + 1, x, y);
+		}
+	}
+	// the nodes of the clusters on both sides change with the transitions
+	if (replaceTransitions(verticalBorders[index], transitions)) {
+		clusters[index].outdated = true;
+		clusters[index + 1].outdated = true;
+	}
+}
+
+/**
+ * @brief Computes the transitions between cluster (cx, cy) and the cluster below it.
+ */
+void HierarchicalPlanning::computeHorizontalBorder(const size_t& cx, const size_t& cy) {
+	const size_t index = cy * clustersX + cx;
+	std::vector<Transition> transitions;
+	outdatedHorizontal[index] = false;
+	if (cy + 1 >= clustersY) {
+		return;
+	}
+	const int y = static_cast<int>((cy + 1) * clusterSize);  // first row of the lower cluster
+	const int begin = static_cast<int>(cx * clusterSize);
+	const int end = static_cast<int>(std::min((cx + 1) * clusterSize, map.width));
+	std::vector<bool> straight(end - begin);
+	for (int x = begin; x < end; ++x) {
+		straight[x - begin] = !map.isOccupiedUnchecked(x, y - 1) && !map.isOccupiedUnchecked(x, y);
+	}
+	for (int x = begin; x < end; ) {
+		if (!straight[x - begin]) {
+			++x;
+			continue;
+		}
+		int runEnd = x;
+		while (runEnd < end && straight[runEnd - begin]) {
+			++runEnd;
+		}
+		if (runEnd - x < 6) {
+			const int middle = x + (runEnd - x - 1) / 2;
+			addTransition(transitions, middle, y - 1, middle, y);
+		} else {
+			addTransition(transitions, x, y - 1, x, y);
+			addTransition(transitions, runEnd - 1, y - 1, runEnd - 1, y);
+		}
+		x = runEnd;
+	}
+	for (int x = begin; x + 1 < end; ++x) {
+		if (straight[x - begin] || straight[x + 1 - begin]) {
+			continue;
+		}
+		if (!map.isOccupiedUnchecked(x, y - 1) && !map.isOccupiedUnchecked(x + 1, y)) {
+			addTransition(transitions, x, y - 1, x + 1, y);
+		}
+		if (!map.isOccupiedUnchecked(x + 1, y - 1) && !map.isOccupiedUnchecked(x, y)) {
+			addTransition(transitions, x + 1, y - 1, x, y);
+		}
+	}
+	// the nodes of the clusters on both sides change with the transitions
+	if (replaceTransitions(horizontalBorders[index], transitions)) {
+		clusters[index].outdated = true;
+		clusters[index + clustersX].outdated = true;
+	}
+}
+
+/**
+ * @brief Computes the diagonal transitions at the corner to the bottom right of cluster (cx, cy).
+ */
+void HierarchicalPlanning::computeCorner(const size_t& cx, const size_t& cy) {
+	const size_t index = cy * clustersX + cx;
+	std::vector<Transition> transitions;
+	outdatedCorners[index] = false;
+	if (cx + 1 >= clustersX || cy + 1 >= clustersY) {
+		return;
+	}
+	const int x = static_cast<int>((cx + 1) * clusterSize);
+	const int y = static_cast<int>((cy + 1) * clusterSize);
+	if (!map.isOccupiedUnchecked(x - 1, y - 1) && !map.isOccupiedUnchecked(x, y)) {
+		addTransition(transitions, x - 1, y - 1, x, y);
+	}
+	if (!map.isOccupiedUnchecked(x, y - 1) && !map.isOccupiedUnchecked(x - 1, y)) {
+		addTransition(transitions, x, y - 1, x - 1, y);
+	}
+	// the nodes of the clusters on both sides change with the transitions
+	if (replaceTransitions(corners[index], transitions)) {
+		clusters[index].outdated = true;
+		clusters[index + 1].outdated = true;
+		clusters[index + clustersX].outdated = true;
+		clusters[index + clustersX + 1].outdated = true;
+	}
+}
+
+int HierarchicalPlanning::localNode(const Cluster& cluster, const uint32_t& cell) const {
+	for (size_t i = 0; i < cluster.nodes.size(); ++i) {
+		if (cluster.nodes[i] == cell) {
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief Collects the nodes of cluster (cx, cy) from the transitions on its borders and computes the intra-cluster edges.
+ */
+void HierarchicalPlanning::computeCluster(const size_t& cx, const size_t& cy) {
+	const size_t index = cy * clustersX + cx;
+	Cluster& cluster = clusters[index];
+	cluster.nodes.clear();
+	cluster.links.clear();
+
+	// all borders and corners that the cluster touches
+	const std::vector<Transition> *borders[8];
+	size_t numBorders = 0;
+	borders[numBorders++] = &verticalBorders[index];
+	borders[numBorders++] = &horizontalBorders[index];
+	borders[numBorders++] = &corners[index];
+	if (cx > 0) {
+		borders[numBorders++] = &verticalBorders[index - 1];
+		borders[numBorders++] = &corners[index - 1];
+	}
+	if (cy > 0) {
+		borders[numBorders++] = &horizontalBorders[index - clustersX];
+		borders[numBorders++] = &corners[index - clustersX];
+	}
+	if (cx > 0 && cy > 0) {
+		borders[numBorders++] = &corners[index - clustersX - 1];
+	}
+	for (size_t b = 0; b < numBorders; ++b) {
+		const std::vector<Transition>& transitions = *borders[b];
+		for (size_t t = 0; t < transitions.size(); ++t) {
+			const Transition& transition = transitions[t];
+			for (int side = 0; side < 2; ++side) {
+				const uint32_t cell = side == 0 ? transition.first : transition.second;
+				if (clusterOf(cell) != index) {
+					continue;
+				}
+				int node = localNode(cluster, cell);
+				if (node < 0) {
+					node = static_cast<int>(cluster.nodes.size());
+					cluster.nodes.push_back(cell);
+					cluster.links.push_back(std::vector<Link>());
+				}
+				Link link;
+				link.cell = side == 0 ? transition.second : transition.first;
+				link.costs = transition.costs;
+				cluster.links[node].push_back(link);
+			}
+		}
+	}
+
+	const size_t numNodes = cluster.nodes.size();
+	cluster.costs.assign(numNodes * numNodes, INFINITE_COSTS);
+	for (size_t i = 0; i < numNodes; ++i) {
+		searchCluster(cluster.nodes[i], index, NONE);
+		for (size_t j = 0; j < numNodes; ++j) {
+			cluster.costs[i * numNodes + j] = getLocalCosts(cluster.nodes[j]);
+		}
+	}
+	cluster.outdated = false;
+	++numClusterUpdates;
+}
+
+/**
+ * @brief Searches the cells of one cluster, starting from a source cell.
+ * @param source The source cell, which must belong to the cluster.
+ * @param cluster The index of the cluster.
+ * @param target The cell at which the search stops, or NONE to reach all cells of the cluster.
+ * @return The number of expanded cells.
+ *
+ * The costs and predecessors can be read with getLocalCosts() and appendLocalPath() until the
+ * next search.
+ */
+size_t HierarchicalPlanning::searchCluster(const uint32_t& source, const size_t& cluster, const uint32_t& target) {
+	localX = (cluster % clustersX) * clusterSize;
+	localY = (cluster / clustersX) * clusterSize;
+	const int x0 = static_cast<int>(localX);
+	const int y0 = static_cast<int>(localY);
+	const int x1 = static_cast<int>(std::min(localX + clusterSize, map.width));
+	const int y1 = static_cast<int>(std::min(localY + clusterSize, map.height));
+	const int targetX = target == NONE ? 0 : static_cast<int>(target % map.width);
+	const int targetY = target == NONE ? 0 : static_cast<int>(target / map.width);
+
+	if (++localGeneration == 0) {
+		std::fill(localGenerations.begin(), localGenerations.end(), 0);
+		localGeneration = 1;
+	}
+	const int sourceX = static_cast<int>(source % map.width);
+	const int sourceY = static_cast<int>(source / map.width);
+	const size_t sourceIndex = (sourceY - y0) * clusterSize + (sourceX - x0);
+	localCosts[sourceIndex] = 0.0;
+	localPredecessors[sourceIndex] = NONE;
+	localGenerations[sourceIndex] = localGeneration;
+	localHeap.clear();
+	localHeap.push_back(QueueEntry(0.0, source));
+
+	size_t expansions = 0;
+	while (!localHeap.empty()) {
+		std::pop_heap(localHeap.begin(), localHeap.end(), std::greater<QueueEntry>());
+		const QueueEntry entry = localHeap.back();
+		localHeap.pop_back();
+		const int x = static_cast<int>(entry.second % map.width);
+		const int y = static_cast<int>(entry.second / map.width);
+		const size_t local = (y - y0) * clusterSize + (x - x0);
+		const double costs = localCosts[local];
+		const double f = costs + (target == NONE ? 0.0 : octileDistance(x - targetX, y - targetY));
+		if (entry.first > f) {
+			// outdated entry
+			continue;
+		}
+		++expansions;
+		if (entry.second == target) {
+			break;
+		}
+		unsigned int freeNeighbors = map.getFreeNeighbors(x, y);
+		for (int i = 0; freeNeighbors; ++i, freeNeighbors >>= 1) {
+			if (!(freeNeighbors & 1u)) {
+				continue;
+			}
+			const int nx = x + GridMap::NEIGHBOR_DX[i];
+			const int ny = y + GridMap::NEIGHBOR_DY[i];
+			if (nx < x0 || nx >= x1 || ny < y0 || ny >= y1) {
+				continue;
+			}
+			const size_t neighbor = (ny - y0) * clusterSize + (nx - x0);
+			const double neighborCosts = costs + (nx != x && ny != y ? std::sqrt(2.0) : 1.0);
+			if (localGenerations[neighbor] == localGeneration && neighborCosts >= localCosts[neighbor]) {
+				continue;
+			}
+			localCosts[neighbor] = neighborCosts;
+			localPredecessors[neighbor] = entry.second;
+			localGenerations[neighbor] = localGeneration;
+			const double h = target == NONE ? 0.0 : octileDistance(nx - targetX, ny - targetY);
+			localHeap.push_back(QueueEntry(neighborCosts + h, static_cast<uint32_t>(ny * map.width + nx)));
+			std::push_heap(localHeap.begin(), localHeap.end(), std::greater<QueueEntry>());
+		}
+	}
+	return expansions;
+}
+
+double HierarchicalPlanning::getLocalCosts(const uint32_t& cell) const {
+	const size_t local = (cell / map.width - localY) * clusterSize + (cell % map.width - localX);
+	return localGenerations[local] == localGeneration ? localCosts[local] : INFINITE_COSTS;
+}
+
+void HierarchicalPlanning::appendLocalPath(const uint32_t& target, std::vector<std::pair<int, int> >& path) const {
+	const size_t begin = path.size();
+	// the source of the search is the last cell of the path already
+	for (uint32_t cell = target; ; ) {
+		const size_t local = (cell / map.width - localY) * clusterSize + (cell % map.width - localX);
+		const uint32_t predecessor = localPredecessors[local];
+		if (predecessor == NONE) {
+			break;
+		}
+		path.push_back(std::make_pair(static_cast<int>(cell % map.width), static_cast<int>(cell / map.width)));
+		cell = predecessor;
+	}
+	std::reverse(path.begin() + begin, path.end());
+}
+
+size_t HierarchicalPlanning::getNumAbstractNodes() const {
+	size_t numNodes = 0;
+	for (size_t i = 0; i < clusters.size(); ++i) {
+		numNodes += clusters[i].nodes.size();
+	}
+	return numNodes;
+}
+
+HierarchicalPlanning::Result HierarchicalPlanning::planPath(const int& startX, const int& startY, const int& goalX, const int& goalY) {
+	if (!map.isInside(startX, startY) || !map.isInside(goalX, goalY)) {
+		throw std::out_of_range("HierarchicalPlanning::planPath(): start or goal is outside the map");
+	}
+	Result result;
+	result.lowerBound = octileDistance(goalX - startX, goalY - startY);
+	if (map.isOccupied(startX, startY) || map.isOccupied(goalX, goalY)) {
+		return result;
+	}
+	update();
+
+	const uint32_t start = static_cast<uint32_t>(startY * map.width + startX);
+	const uint32_t goal = static_cast<uint32_t>(goalY * map.width + goalX);
+	const size_t startCluster = clusterOf(start);
+	const size_t goalCluster = clusterOf(goal);
+
+	// connect the start and the goal to the nodes of their clusters
+	std::vector<Link> startLinks;
+	result.expansions += searchCluster(start, startCluster, NONE);
+	const Cluster& first = clusters[startCluster];
+	for (size_t i = 0; i < first.nodes.size(); ++i) {
+		const double costs = getLocalCosts(first.nodes[i]);
+		if (costs < INFINITE_COSTS) {
+			const Link link = { first.nodes[i], costs };
+			startLinks.push_back(link);
+		}
+	}
+	if (startCluster == goalCluster && getLocalCosts(goal) < INFINITE_COSTS) {
+		const Link link = { goal, getLocalCosts(goal) };
+		startLinks.push_back(link);
+	}
+	const Cluster& last = clusters[goalCluster];
+	std::vector<double> goalCosts(last.nodes.size());
+	result.expansions += searchCluster(goal, goalCluster, NONE);
+	for (size_t i = 0; i < last.nodes.size(); ++i) {
+		goalCosts[i] = getLocalCosts(last.nodes[i]);
+	}
+
+	// A* on the abstract graph
+	std::unordered_map<uint32_t, AbstractState> states;
+	Queue queue;
+	states[start].costs = 0.0;
+	queue.push(QueueEntry(result.lowerBound, start));
+	bool found = false;
+	while (!queue.empty()) {
+		const uint32_t cell = queue.top().second;
+		queue.pop();
+		AbstractState& state = states[cell];
+		if (state.closed) {
+			continue;
+		}
+		state.closed = true;
+		++result.abstractExpansions;
+		if (cell == goal) {
+			found = true;
+			break;
+		}
+		const double costs = state.costs;
+
+		std::vector<Link> successors;
+		if (cell == start) {
+			successors = startLinks;
+		}
+		const size_t clusterIndex = clusterOf(cell);
+		const Cluster& cluster = clusters[clusterIndex];
+		const int node = localNode(cluster, cell);
+		if (node >= 0) {
+			const size_t numNodes = cluster.nodes.size();
+			for (size_t j = 0; j < numNodes; ++j) {
+				const double edgeCosts = cluster.costs[node * numNodes + j];
+				if (static_cast<int>(j) != node && edgeCosts < INFINITE_COSTS) {
+					const Link link = { cluster.nodes[j], edgeCosts };
+					successors.push_back(link);
+				}
+			}
+			successors.insert(successors.end(), cluster.links[node].begin(), cluster.links[node].end());
+			if (clusterIndex == goalCluster && goalCosts[node] < INFINITE_COSTS) {
+				const Link link = { goal, goalCosts[node] };
+				successors.push_back(link);
+			}
+		}
+		for (size_t i = 0; i < successors.size(); ++i) {
+			const Link& link = successors[i];
+			AbstractState& successor = states[link.cell];
+			const double successorCosts = costs + link.costs;
+			if (successor.closed || successorCosts >= successor.costs) {
+				continue;
+			}
+			successor.costs = successorCosts;
+			successor.predecessor = cell;
+			const int x = static_cast<int>(link.cell % map.width);
+			const int y = static_cast<int>(link.cell / map.width);
+			queue.push(QueueEntry(successorCosts + octileDistance(goalX - x, goalY - y), link.cell));
+		}
+	}
+	result.expansions += result.abstractExpansions;
+	if (!found) {
+		return result;
+	}
+
+	// refine the abstract path
+	std::vector<uint32_t> abstractPath;
+	for (uint32_t cell = goal; cell != NONE; cell = states[cell].predecessor) {
+		abstractPath.push_back(cell);
+	}
+	std::reverse(abstractPath.begin(), abstractPath.end());
+	result.path.push_back(std::make_pair(startX, startY));
+	for (size_t i = 1; i < abstractPath.size(); ++i) {
+		const uint32_t from = abstractPath[i - 1];
+		const uint32_t to = abstractPath[i];
+		const size_t fromCluster = clusterOf(from);
+		if (from == to) {
+			continue;
+		}
+		if (fromCluster != clusterOf(to)) {
+			// the cells of a transition are adjacent
+			result.path.push_back(std::make_pair(static_cast<int>(to % map.width), static_cast<int>(to / map.width)));
+			continue;
+		}
+		result.expansions += searchCluster(from, fromCluster, to);
+		appendLocalPath(to, result.path);
+	}
+	for (size_t i = 1; i < result.path.size(); ++i) {
+		const int dx = result.path[i].first - result.path[i - 1].first;
+		const int dy = result.path[i].second - result.path[i - 1].second;
+		result.costs += (dx != 0 && dy != 0) ? std::sqrt(2.0) : 1.0;
+	}
+	return result;
+}
+
+}  // namespace path_planning
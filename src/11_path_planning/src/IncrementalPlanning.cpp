@@ -0,0 +1,319 @@
+#include <path_planning/IncrementalPlanning.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace path_planning {
+
+namespace {
+
+const double INFINITE_COSTS = std::numeric_limits<double>::infinity();
+const double SQRT2 = std::sqrt(2.0);
+
+/**
+ * @brief Returns the costs of a step to neighbor i (see GridMap::NEIGHBOR_DX).
+ */
+inline double stepCosts(const int& i) {
+	return GridMap::NEIGHBOR_DX[i] != 0 && GridMap::NEIGHBOR_DY[i] != 0 ? SQRT2 : 1.0;
+}
+
+}  // namespace
+
+IncrementalPlanning::IncrementalPlanning(const GridMap& map, const int& startX, const int& startY, const int& goalX, const int& goalY) :
+		map(map),
+		start(0),
+		goal(0),
+		km(0.0),
+		generation(0),
+		numExpansions(0),
+		totalExpansions(0)
+{
+	if (map.width * map.height >= NONE) {
+		throw std::length_error("IncrementalPlanning: the map is too large");
+	}
+	cells.resize(map.width * map.height);
+	setStart(startX, startY);
+	setGoal(goalX, goalY);
+}
+
+void IncrementalPlanning::setStart(const int& x, const int& y) {
+	if (!map.isInside(x, y)) {
+		throw std::out_of_range("IncrementalPlanning::setStart(): the start is outside the map");
+	}
+	const uint32_t index = static_cast<uint32_t>(y * map.width + x);
+	// the heuristic values of all queued keys decrease by at most h(start, index)
+	km += heuristic(start, index);
+	start = index;
+}
+
+void IncrementalPlanning::setGoal(const int& x, const int& y) {
+	if (!map.isInside(x, y)) {
+		throw std::out_of_range("IncrementalPlanning::setGoal(): the goal is outside the map");
+	}
+	if (++generation == 0) {
+		// the counter wrapped around, so old stamps could be mistaken for current ones
+		for (size_t i = 0; i < cells.size(); ++i) {
+			cells[i].generation = 0;
+		}
+		generation = 1;
+	}
+	heap.clear();
+	km = 0.0;
+	totalExpansions = 0;
+	goal = static_cast<uint32_t>(y * map.width + x);
+	computeRhs(goal);
+	updateVertex(goal);
+}
+
+void IncrementalPlanning::updateCells(const std::vector<std::pair<int, int> >& changedCells) {
+	for (size_t c = 0; c < changedCells.size(); ++c) {
+		const int x = changedCells[c].first;
+		const int y = changedCells[c].second;
+		if (!map.isInside(x, y)) {
+			throw std::out_of_range("IncrementalPlanning::updateCells(): a cell is outside the map");
+		}
+		const uint32_t index = static_cast<uint32_t>(y * map.width + x);
+		computeRhs(index);
+		updateVertex(index);
+		// the edges between the cell and its neighbors have appeared or disappeared
+		unsigned int freeNeighbors = map.getFreeNeighbors(x, y);
+		while (freeNeighbors) {
+			const int i = __builtin_ctz(freeNeighbors);
+			freeNeighbors &= freeNeighbors - 1;
+			const uint32_t neighbor = static_cast<uint32_t>((y + GridMap::NEIGHBOR_DY[i]) * map.width + x + GridMap::NEIGHBOR_DX[i]);
+			computeRhs(neighbor);
+			updateVertex(neighbor);
+		}
+	}
+}
+
+IncrementalPlanning::Result IncrementalPlanning::planPath() {
+	Result result;
+	numExpansions = 0;
+	const int startX = static_cast<int>(start % map.width);
+	const int startY = static_cast<int>(start / map.width);
+	if (!map.isOccupiedUnchecked(startX, startY)) {
+		computeShortestPath();
+	}
+	result.expansions = numExpansions;
+	if (map.isOccupiedUnchecked(startX, startY) || cell(start).g == INFINITE_COSTS) {
+		return result;
+	}
+
+	// follow the steepest descent of c(s, s') + g(s') from the start to the goal
+	uint32_t current = start;
+	result.path.push_back(std::make_pair(startX, startY));
+	while (current != goal && result.path.size() <= cells.size()) {
+		const int x = static_cast<int>(current % map.width);
+		const int y = static_cast<int>(current / map.width);
+		double bestCosts = INFINITE_COSTS;
+		double bestStep = 0.0;
+		uint32_t best = NONE;
+		unsigned int freeNeighbors = map.getFreeNeighbors(x, y);
+		while (freeNeighbors) {
+			const int i = __builtin_ctz(freeNeighbors);
+			freeNeighbors &= freeNeighbors - 1;
+			const uint32_t neighbor = static_cast<uint32_t>((y + GridMap::NEIGHBOR_DY[i]) * map.width + x + GridMap::NEIGHBOR_DX[i]);
+			const double costs = stepCosts(i) + cell(neighbor).g;
+			if (costs < bestCosts) {
+				bestCosts = costs;
+				bestStep = stepCosts(i);
+				best = neighbor;
+			}
+		}
+		if (best == NONE) {
+			break;
+		}
+		current = best;
+		result.costs += bestStep;
+		result.path.push_back(std::make_pair(static_cast<int>(current % map.width), static_cast<int>(current / map.width)));
+	}
+	if (current != goal) {
+		// cannot happen with a consistent start, but never return a broken path
+		result.path.clear();
+		result.costs = 0.0;
+	}
+	return result;
+}
+
+IncrementalPlanning::Cell& IncrementalPlanning::cell(const uint32_t& index) {
+	Cell& c = cells[index];
+	if (c.generation != generation) {
+		c.g = INFINITE_COSTS;
+		c.rhs = INFINITE_COSTS;
+		c.heapIndex = NONE;
+		c.generation = generation;
+	}
+	return c;
+}
+
+double IncrementalPlanning::heuristic(const uint32_t& from, const uint32_t& to) const {
+	const int dx = std::abs(static_cast<int>(from % map.width) - static_cast<int>(to % map.width));
+	const int dy = std::abs(static_cast<int>(from / map.width) - static_cast<int>(to / map.width));
+	return std::max(dx, dy) + (SQRT2 - 1.0) * std::min(dx, dy);
+}
+
+IncrementalPlanning::Key IncrementalPlanning::calculateKey(const uint32_t& index) {
+	const Cell& c = cell(index);
+	const double costs = std::min(c.g, c.rhs);
+	const Key key = { costs + heuristic(start, index) + km, costs };
+	return key;
+}
+
+void IncrementalPlanning::computeRhs(const uint32_t& index) {
+	Cell& c = cell(index);
+	const int x = static_cast<int>(index % map.width);
+	const int y = static_cast<int>(index / map.width);
+	if (map.isOccupiedUnchecked(x, y)) {
+		c.rhs = INFINITE_COSTS;
+		return;
+	}
+	if (index == goal) {
+		c.rhs = 0.0;
+		return;
+	}
+	double rhs = INFINITE_COSTS;
+	unsigned int freeNeighbors = map.getFreeNeighbors(x, y);
+	while (freeNeighbors) {
+		const int i = __builtin_ctz(freeNeighbors);
+		freeNeighbors &= freeNeighbors - 1;
+		const uint32_t neighbor = static_cast<uint32_t>((y + GridMap::NEIGHBOR_DY[i]) * map.width + x + GridMap::NEIGHBOR_DX[i]);
+		rhs = std::min(rhs, stepCosts(i) + cell(neighbor).g);
+	}
+	cells[index].rhs = rhs;
+}
+
+void IncrementalPlanning::updateVertex(const uint32_t& index) {
+	const Cell& c = cell(index);
+	if (c.g != c.rhs) {
+		if (c.heapIndex == NONE) {
+			push(index, calculateKey(index));
+		} else {
+			update(index, calculateKey(index));
+		}
+	} else if (c.heapIndex != NONE) {
+		remove(index);
+	}
+}
+
+void IncrementalPlanning::computeShortestPath() {
+	while (!heap.empty()) {
+		const Cell& startCell = cell(start);
+		if (!(heap.front().key < calculateKey(start)) && startCell.rhs == startCell.g) {
+			break;
+		}
+		const uint32_t index = heap.front().index;
+		const Key oldKey = heap.front().key;
+		const Key newKey = calculateKey(index);
+		if (oldKey < newKey) {
+			// the key was computed for an earlier start
+			update(index, newKey);
+			continue;
+		}
+		++numExpansions;
+		++totalExpansions;
+		Cell& u = cells[index];
+		const int x = static_cast<int>(index % map.width);
+		const int y = static_cast<int>(index / map.width);
+		// occupied cells have no edges, but their neighbors may still depend on the old g
+		unsigned int freeNeighbors = map.getFreeNeighbors(x, y);
+		if (u.g > u.rhs) {
+			// overconsistent: the costs have decreased, which can only improve the neighbors
+			u.g = u.rhs;
+			remove(index);
+			while (freeNeighbors) {
+				const int i = __builtin_ctz(freeNeighbors);
+				freeNeighbors &= freeNeighbors - 1;
+				const uint32_t neighbor = static_cast<uint32_t>((y + GridMap::NEIGHBOR_DY[i]) * map.width + x + GridMap::NEIGHBOR_DX[i]);
+				Cell& s = cell(neighbor);
+				if (neighbor != goal) {
+					s.rhs = std::min(s.rhs, stepCosts(i) + u.g);
+				}
+				updateVertex(neighbor);
+			}
+		} else {
+			// underconsistent: the costs have increased, so recompute the neighbors that used them
+			const double oldG = u.g;
+			u.g = INFINITE_COSTS;
+			while (freeNeighbors) {
+				const int i = __builtin_ctz(freeNeighbors);
+				freeNeighbors &= freeNeighbors - 1;
+				const uint32_t neighbor = static_cast<uint32_t>((y + GridMap::NEIGHBOR_DY[i]) * map.width + x + GridMap::NEIGHBOR_DX[i]);
+				if (cell(neighbor).rhs == stepCosts(i) + oldG) {
+					computeRhs(neighbor);
+				}
+				updateVertex(neighbor);
+			}
+			computeRhs(index);
+			updateVertex(index);
+		}
+	}
+}
+
+void IncrementalPlanning::push(const uint32_t& index, const Key& key) {
+	const Entry entry = { key, index };
+	heap.push_back(entry);
+	siftUp(heap.size() - 1, entry);
+}
+
+void IncrementalPlanning::remove(const uint32_t& index) {
+	const size_t position = cells[index].heapIndex;
+	cells[index].heapIndex = NONE;
+	const Entry last = heap.back();
+	heap.pop_back();
+	if (position < heap.size()) {
+		// move the last entry into the gap, in whichever direction restores the heap
+		if (position > 0 && last.key < heap[(position - 1) / ARITY].key) {
+			siftUp(position, last);
+		} else {
+			siftDown(position, last);
+		}
+	}
+}
+
+void IncrementalPlanning::update(const uint32_t& index, const Key& key) {
+	const size_t position = cells[index].heapIndex;
+	const Entry entry = { key, index };
+	if (key < heap[position].key) {
+		siftUp(position, entry);
+	} else {
+		siftDown(position, entry);
+	}
+}
+
+void IncrementalPlanning::siftUp(size_t position, const Entry entry) {
+	while (position > 0) {
+		const size_t parent = (position - 1) / ARITY;
+		if (!(entry.key < heap[parent].key)) {
+			break;
+		}
+		place(position, heap[parent]);
+		position = parent;
+	}
+	place(position, entry);
+}
+
+void IncrementalPlanning::siftDown(size_t position, const Entry entry) {
+	const size_t size = heap.size();
+	while (true) {
+		const size_t first = position * ARITY + 1;
+		if (first >= size) {
+			break;
+		}
+		const size_t end = first + ARITY < size ? first + ARITY : size;
+		size_t best = first;
+		for (size_t child = first + 1; child < end; ++child) {
+			if (heap[child].key < heap[best].key) {
+				best = child;
+			}
+		}
+		if (!(heap[best].key < entry.key)) {
+			break;
+		}
+		place(position, heap[best]);
+		position = best;
+	}
+	place(position, entry);
+}
+
+}  // namespace path_planning
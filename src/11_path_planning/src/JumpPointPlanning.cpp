@@ -0,0 +1,275 @@
+#include <path_planning/JumpPointPlanning.h>
+
+namespace path_planning {
+
+namespace {
+
+bool isFree(const GridMap& map, const int& x, const int& y) {
+	return map.isInside(x, y) && !map.isOccupiedUnchecked(x, y);
+}
+
+int sign(const int& value) {
+	return (value > 0) - (value < 0);
+}
+
+/*
+ * A cell reached by a straight step (dx, dy) has a forced neighbor if one of the two cells beside
+ * it is blocked while the cell diagonally ahead on that side is free.
+ */
+bool hasForcedNeighborStraight(const GridMap& map, const int& x, const int& y, const int& dx, const int& dy) {
+	return (!isFree(map, x + dy, y + dx) && isFree(map, x + dy + dx, y + dx + dy))
+			|| (!isFree(map, x - dy, y - dx) && isFree(map, x - dy + dx, y - dx + dy));
+}
+
+bool hasForcedNeighborDiagonal(const GridMap& map, const int& x, const int& y, const int& dx, const int& dy) {
+	return (!isFree(map, x - dx, y) && isFree(map, x - dx, y + dy))
+			|| (!isFree(map, x, y - dy) && isFree(map, x + dx, y - dy));
+}
+
+}  // namespace
+
+JumpPointTable::JumpPointTable(const GridMap& map) :
+		width(map.width),
+		height(map.height),
+		distances(map.width * map.height * 4, 0)
+{
+	const int w = static_cast<int>(width);
+	const int h = static_cast<int>(height);
+	// Each scan runs against the direction of travel, so the distance of the next cell is known.
+	for (int y = 0; y < h; ++y) {
+		for (int x = w - 1; x >= 0; --x) {
+			int32_t& d = distances[(static_cast<size_t>(y) * width + x) * 4 + EAST];
+			if (!isFree(map, x + 1, y)) {
+				d = 0;
+			} else if (hasForcedNeighborStraight(map, x + 1, y, 1, 0)) {
+				d = 1;
+			} else {
+				const int32_t next = getDistance(x + 1, y, EAST);
+				d = next > 0 ? next + 1 : next - 1;
+			}
+		}
+		for (int x = 0; x < w; ++x) {
+			int32_t& d = distances[(static_cast<size_t>(y) * width + x) * 4 + WEST];
+			if (!isFree(map, x - 1, y)) {
+				d = 0;
+			} else if (hasForcedNeighborStraight(map, x - 1, y, -1, 0)) {
+				d = 1;
+			} else {
+				const int32_t next = getDistance(x - 1, y, WEST);
+				d = next > 0 ? next + 1 : next - 1;
+			}
+		}
+	}
+	for (int x = 0; x < w; ++x) {
+		for (int y = h - 1; y >= 0; --y) {
+			int32_t& d = distances[(static_cast<size_t>(y) * width + x) * 4 + SOUTH];
+			if (!isFree(map, x, y + 1)) {
+				d = 0;
+			} else if (hasForcedNeighborStraight(map, x, y + 1, 0, 1)) {
+				d = 1;
+			} else {
+				const int32_t next = getDistance(x, y + 1, SOUTH);
+				d = next > 0 ? next + 1 : next - 1;
+			}
+		}
+		for (int y = 0; y < h; ++y) {
+			int32_t& d = distances[(static_cast<size_t>(y) * width + x) * 4 + NORTH];
+			if (!isFree(map, x, y - 1)) {
+				d = 0;
+			} else if (hasForcedNeighborStraight(map, x, y - 1, 0, -1)) {
+				d = 1;
+			} else {
+				const int32_t next = getDistance(x, y - 1, NORTH);
+				d = next > 0 ? next + 1 : next - 1;
+			}
+		}
+	}
+}
+
+JumpPointPlanning::JumpPointPlanning(const GridMap& map, const GridHeuristic& heuristic, const JumpPointTable * const table) :
+		GridPathPlanning(map, heuristic), table_(table), startNode(NULL), goalX(0), goalY(0)
+{
+	if (table && (table->width != map.width || table->height != map.height)) {
+		throw std::invalid_argument("JumpPointPlanning: the jump point table does not match the map");
+	}
+}
+
+JumpPointPlanning::JumpPointPlanning(const GridMap& map, const GridHeuristic& heuristic, GridNodeArena& arena, const JumpPointTable * const table) :
+		GridPathPlanning(map, heuristic, arena), table_(table), startNode(NULL), goalX(0), goalY(0)
+{
+	if (table && (table->width != map.width || table->height != map.height)) {
+		throw std::invalid_argument("JumpPointPlanning: the jump point table does not match the map");
+	}
+}
+
+std::deque<const AbstractNode*> JumpPointPlanning::planPath(const AbstractNode * const startNode, const AbstractNode * const goalNode) {
+	if (!startNode) {
+		throw std::invalid_argument("JumpPointPlanning::planPath(): startNode is NULL");
+	}
+	if (!goalNode) {
+		throw std::invalid_argument("JumpPointPlanning::planPath(): goalNode is NULL");
+	}
+	if (isBidirectional()) {
+		// the jump point successors depend on the direction of travel
+		throw std::runtime_error("JumpPointPlanning::planPath(): bidirectional search is not supported");
+	}
+	const GridNode * const goal = static_cast<const GridNode *>(goalNode);
+	this->startNode = startNode;
+	goalX = goal->x;
+	goalY = goal->y;
+	return GridPathPlanning::planPath(startNode, goalNode);
+}
+
+std::deque<const AbstractNode*> JumpPointPlanning::followPath(const AbstractNode * const node) {
+	const std::deque<const AbstractNode*> jumpPoints = PathPlanning::followPath(node);
+	std::deque<const AbstractNode*> path;
+	for (size_t i = 0; i < jumpPoints.size(); ++i) {
+		const GridNode * const to = static_cast<const GridNode *>(jumpPoints[i]);
+		if (i > 0) {
+			// fill in the cells between two consecutive jump points
+			const GridNode * const from = static_cast<const GridNode *>(jumpPoints[i - 1]);
+			int x = from->x;
+			int y = from->y;
+			while (true) {
+				x += sign(to->x - x);
+				y += sign(to->y - y);
+				if (x == to->x && y == to->y) {
+					break;
+				}
+				path.push_back(getNode(x, y));
+			}
+		}
+		path.push_back(to);
+	}
+	return path;
+}
+
+bool JumpPointPlanning::jumpStraight(const int& x, const int& y, const int& dx, const int& dy, int& jx, int& jy) const {
+	if (table_) {
+		const int32_t d = table_->getDistance(x, y, JumpPointTable::direction(dx, dy));
+		const int32_t reach = d > 0 ? d : -d;
+		const int32_t goalSteps = (dx != 0) ? (goalX - x) * dx : (goalY - y) * dy;
+		const bool goalOnRay = (dx != 0) ? (goalY == y) : (goalX == x);
+		if (goalOnRay && goalSteps > 0 && goalSteps <= reach) {
+			jx = goalX;
+			jy = goalY;
+			return true;
+		}
+		if (d > 0) {
+			jx = x + d * dx;
+			jy = y + d * dy;
+			return true;
+		}
+		return false;
+	}
+	int cx = x;
+	int cy = y;
+	while (true) {
+		cx += dx;
+		cy += dy;
+		if (!isFree(cx, cy)) {
+			return false;
+		}
+		if ((cx == goalX && cy == goalY) || hasForcedNeighborStraight(map_, cx, cy, dx, dy)) {
+			jx = cx;
+			jy = cy;
+			return true;
+		}
+	}
+}
+
+bool JumpPointPlanning::jumpDiagonal(const int& x, const int& y, const int& dx, const int& dy, int& jx, int& jy) const {
+	int cx = x;
+	int cy = y;
+	int sx, sy;
+	while (true) {
+		cx += dx;
+		cy += dy;
+		if (!isFree(cx, cy)) {
+			return false;
+		}
+		if ((cx == goalX && cy == goalY)
+				|| hasForcedNeighborDiagonal(map_, cx, cy, dx, dy)
+				|| jumpStraight(cx, cy, dx, 0, sx, sy)
+				|| jumpStraight(cx, cy, 0, dy, sx, sy)) {
+			jx = cx;
+			jy = cy;
+			return true;
+		}
+	}
+}
+
+bool JumpPointPlanning::jump(const int& x, const int& y, const int& dx, const int& dy, int& jx, int& jy) const {
+	if (dx != 0 && dy != 0) {
+		return jumpDiagonal(x, y, dx, dy, jx, jy);
+	}
+	return jumpStraight(x, y, dx, dy, jx, jy);
+}
+
+std::vector<AbstractNode *> JumpPointPlanning::getNeighborNodes(const AbstractNode * const currentNode) {
+	if (!currentNode) {
+		throw std::invalid_argument("JumpPointPlanning::getNeighborNodes(): currentNode is NULL");
+	}
+	const GridNode * const node = static_cast<const GridNode *>(currentNode);
+	const int x = node->x;
+	const int y = node->y;
+
+	// Collect the directions that survive the pruning rules.
+	int directions[8][2];
+	int numDirections = 0;
+	const GridNode * const predecessor = static_cast<const GridNode *>(node->getPredecessor());
+	if (currentNode == startNode || !predecessor) {
+		for (int i = 0; i < 8; ++i) {
+			directions[numDirections][0] = GridMap::NEIGHBOR_DX[i];
+			directions[numDirections][1] = GridMap::NEIGHBOR_DY[i];
+			++numDirections;
+		}
+	} else {
+		const int dx = sign(x - predecessor->x);
+		const int dy = sign(y - predecessor->y);
+		if (dx != 0 && dy != 0) {
+			const int natural[3][2] = { { dx, 0 }, { 0, dy }, { dx, dy } };
+			for (int i = 0; i < 3; ++i) {
+				directions[numDirections][0] = natural[i][0];
+				directions[numDirections][1] = natural[i][1];
+				++numDirections;
+			}
+			if (isBlocked(x - dx, y)) {
+				directions[numDirections][0] = -dx;
+				directions[numDirections][1] = dy;
+				++numDirections;
+			}
+			if (isBlocked(x, y - dy)) {
+				directions[numDirections][0] = dx;
+				directions[numDirections][1] = -dy;
+				++numDirections;
+			}
+		} else {
+			directions[numDirections][0] = dx;
+			directions[numDirections][1] = dy;
+			++numDirections;
+			// perpendicular sides of the direction of travel
+			if (isBlocked(x + dy, y + dx)) {
+				directions[numDirections][0] = dx + dy;
+				directions[numDirections][1] = dy + dx;
+				++numDirections;
+			}
+			if (isBlocked(x - dy, y - dx)) {
+				directions[numDirections][0] = dx - dy;
+				directions[numDirections][1] = dy - dx;
+				++numDirections;
+			}
+		}
+	}
+
+	std::vector<AbstractNode *> result;
+	int jx, jy;
+	for (int i = 0; i < numDirections; ++i) {
+		if (jump(x, y, directions[i][0], directions[i][1], jx, jy)) {
+			result.push_back(getNode(jx, jy));
+		}
+	}
+	return result;
+}
+
+}  // namespace path_planning
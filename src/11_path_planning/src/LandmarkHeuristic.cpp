@@ -0,0 +1,354 @@
+#include <path_planning/LandmarkHeuristic.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace path_planning {
+
+namespace {
+
+const char MAGIC[8] = { 'P', 'P', 'L', 'M', 'A', 'R', 'K', '1' };
+
+const uint32_t INFINITE_DISTANCE = 0xFFFFFFFFu;
+
+}  // namespace
+
+LandmarkHeuristic::LandmarkHeuristic(const GridMap& map) : map(map) {}
+
+double LandmarkHeuristic::heuristic(const GridNode * const currentNode, const GridNode * const goalNode) const {
+	const double dx = currentNode->x - goalNode->x;
+	const double dy = currentNode->y - goalNode->y;
+	double result = std::sqrt(dx * dx + dy * dy);
+	const size_t numLandmarks = landmarks.size();
+	if (numLandmarks == 0) {
+		return result;
+	}
+	const uint16_t * const current = &table[(static_cast<size_t>(currentNode->y) * map.width + currentNode->x) * numLandmarks];
+	const uint16_t * const goal = &table[(static_cast<size_t>(goalNode->y) * map.width + goalNode->x) * numLandmarks];
+	for (size_t i = 0; i < numLandmarks; ++i) {
+		if (current[i] == UNREACHABLE || goal[i] == UNREACHABLE) {
+			// the landmark is not connected to both cells, so it gives no bound
+			continue;
+		}
+		const int difference = std::abs(static_cast<int>(goal[i]) - static_cast<int>(current[i]));
+		result = std::max(result, difference / static_cast<double>(straightCosts[i]));
+	}
+	return result;
+}
+
+void LandmarkHeuristic::compute(const size_t& numLandmarks, const size_t& numThreads) {
+	if (numLandmarks == 0) {
+		throw std::invalid_argument("LandmarkHeuristic::compute(): numLandmarks must be positive");
+	}
+	const double centerX = 0.5 * (map.width - 1);
+	const double centerY = 0.5 * (map.height - 1);
+	const double pi = std::acos(-1.0);
+
+	// the free cell farthest from the center in each of numLandmarks sectors of equal angle
+	std::vector<std::pair<int, int> > chosen;
+	std::vector<double> bestDistance(numLandmarks, -1.0);
+	std::vector<std::pair<int, int> > best(numLandmarks);
+	size_t numFree = 0;
+	for (size_t y = 0; y < map.height; ++y) {
+		for (size_t x = 0; x < map.width; ++x) {
+			if (map.isOccupiedUnchecked(x, y)) {
+				continue;
+			}
+			++numFree;
+			const double dx = x - centerX;
+			const double dy = y - centerY;
+			const double angle = std::atan2(dy, dx) + pi;
+			const size_t sector = std::min(static_cast<size_t>(angle / (2.0 * pi) * numLandmarks), numLandmarks - 1);
+			const double distance = dx * dx + dy * dy;
+			if (distance > bestDistance[sector]) {
+				bestDistance[sector] = distance;
+				best[sector] = std::make_pair(static_cast<int>(x), static_cast<int>(y));
+			}
+		}
+	}
+	if (numLandmarks > numFree) {
+		throw std::invalid_argument("LandmarkHeuristic::compute(): more landmarks than free cells");
+	}
+	for (size_t i = 0; i < numLandmarks; ++i) {
+		if (bestDistance[i] >= 0.0) {
+			chosen.push_back(best[i]);
+		}
+	}
+
+	// fill empty sectors with the free cells that are farthest from the landmarks so far
+	while (chosen.size() < numLandmarks) {
+		double farthest = -1.0;
+		std::pair<int, int> cell;
+		for (size_t y = 0; y < map.height; ++y) {
+			for (size_t x = 0; x < map.width; ++x) {
+				if (map.isOccupiedUnchecked(x, y)) {
+					continue;
+				}
+				double distance = std::numeric_limits<double>::max();
+				for (size_t i = 0; i < chosen.size(); ++i) {
+					const double dx = static_cast<double>(x) - chosen[i].first;
+					const double dy = static_cast<double>(y) - chosen[i].second;
+					distance = std::min(distance, dx * dx + dy * dy);
+				}
+				if (distance > farthest) {
+					farthest = distance;
+					cell = std::make_pair(static_cast<int>(x), static_cast<int>(y));
+				}
+			}
+		}
+		chosen.push_back(cell);
+	}
+	compute(chosen, numThreads);
+}
+
+void LandmarkHeuristic::compute(const std::vector<std::pair<int, int> >& landmarks, const size_t& numThreads) {
+	if (landmarks.empty()) {
+		throw std::invalid_argument("LandmarkHeuristic::compute(): no landmarks given");
+	}
+	for (size_t i = 0; i < landmarks.size(); ++i) {
+		if (map.isOccupied(landmarks[i].first, landmarks[i].second)) {
+			throw std::invalid_argument("LandmarkHeuristic::compute(): a landmark is occupied");
+		}
+	}
+	if (map.width * map.height >= INFINITE_DISTANCE) {
+		throw std::length_error("LandmarkHeuristic::compute(): the map is too large");
+	}
+
+	size_t n = numThreads;
+	if (n == 0) {
+		n = std::thread::hardware_concurrency();
+		if (n == 0) {
+			n = 1;
+		}
+	}
+	n = std::min(n, landmarks.size());
+
+	const size_t numLandmarks = landmarks.size();
+	std::vector<uint16_t> newTable(map.width * map.height * numLandmarks);
+	std::vector<uint16_t> newStraightCosts(numLandmarks);
+	std::atomic<size_t> next(0);
+	std::mutex errorMutex;
+	std::exception_ptr error;
+
+	// each thread takes the next landmark and writes its column of the table
+	const auto work = [&]() {
+		try {
+			std::vector<uint32_t> distances;
+			size_t i;
+			while ((i = next.fetch_add(1)) < numLandmarks) {
+				newStraightCosts[i] = computeDistances(landmarks[i], distances);
+				for (size_t cell = 0; cell < distances.size(); ++cell) {
+					newTable[cell * numLandmarks + i] = distances[cell] == INFINITE_DISTANCE ? UNREACHABLE : static_cast<uint16_t>(distances[cell]);
+				}
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	for (size_t t = 1; t < n; ++t) {
+		threads.push_back(std::thread(work));
+	}
+	work();
+	for (size_t t = 0; t < threads.size(); ++t) {
+		threads[t].join();
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+
+	// landmarks whose distances do not fit into 16 bits even in whole steps give no bounds
+	std::vector<std::pair<int, int> > usedLandmarks;
+	std::vector<size_t> used;
+	for (size_t i = 0; i < numLandmarks; ++i) {
+		if (newStraightCosts[i] > 0) {
+			usedLandmarks.push_back(landmarks[i]);
+			used.push_back(i);
+		}
+	}
+	if (used.size() < numLandmarks) {
+		std::vector<uint16_t> compacted(map.width * map.height * used.size());
+		std::vector<uint16_t> compactedCosts(used.size());
+		for (size_t j = 0; j < used.size(); ++j) {
+			compactedCosts[j] = newStraightCosts[used[j]];
+		}
+		for (size_t cell = 0; cell < map.width * map.height; ++cell) {
+			for (size_t j = 0; j < used.size(); ++j) {
+				compacted[cell * used.size() + j] = newTable[cell * numLandmarks + used[j]];
+			}
+		}
+		newTable.swap(compacted);
+		newStraightCosts.swap(compactedCosts);
+	}
+	this->landmarks.swap(usedLandmarks);
+	table.swap(newTable);
+	straightCosts.swap(newStraightCosts);
+}
+
+uint16_t LandmarkHeuristic::computeDistances(const std::pair<int, int>& landmark, std::vector<uint32_t>& distances) const {
+	const size_t size = map.width * map.height;
+	// initial guess for the costs of a straight step, such that typical distances fit into 16 bits
+	uint32_t straight = std::max<uint32_t>(1, std::min<uint32_t>(256, UNREACHABLE / (2 * (map.width + map.height))));
+	std::vector<std::vector<uint32_t> > buckets;
+	while (true) {
+		// the costs of a diagonal step are rounded down, so that the distances never overestimate
+		const uint32_t diagonal = static_cast<uint32_t>(std::floor(straight * std::sqrt(2.0)));
+		distances.assign(size, INFINITE_DISTANCE);
+
+		// Dijkstra with a ring of buckets (Dial's algorithm), since the step costs are small integers
+		buckets.assign(diagonal + 1, std::vector<uint32_t>());
+		const uint32_t source = static_cast<uint32_t>(landmark.second * map.width + landmark.first);
+		distances[source] = 0;
+		buckets[0].push_back(source);
+		size_t numQueued = 1;
+		uint32_t maxDistance = 0;
+		for (uint32_t distance = 0; numQueued > 0; ++distance) {
+			std::vector<uint32_t>& bucket = buckets[distance % buckets.size()];
+			// entries are only appended to other buckets, so the bucket can be processed by index
+			for (size_t b = 0; b < bucket.size(); ++b) {
+				const uint32_t cell = bucket[b];
+				if (distances[cell] != distance) {
+					// reached on a shorter path after this entry was queued
+					continue;
+				}
+				maxDistance = distance;
+				const int x = static_cast<int>(cell % map.width);
+				const int y = static_cast<int>(cell / map.width);
+				unsigned int freeNeighbors = map.getFreeNeighbors(x, y);
+				while (freeNeighbors) {
+					const int i = __builtin_ctz(freeNeighbors);
+					freeNeighbors &= freeNeighbors - 1;
+					const uint32_t neighbor = static_cast<uint32_t>((y + GridMap::NEIGHBOR_DY[i]) * map.width + x + GridMap::NEIGHBOR_DX[i]);
+					const uint32_t neighborDistance = distance + (GridMap::NEIGHBOR_DX[i] != 0 && GridMap::NEIGHBOR_DY[i] != 0 ? diagonal : straight);
+					if (neighborDistance < distances[neighbor]) {
+						distances[neighbor] = neighborDistance;
+						buckets[neighborDistance % buckets.size()].push_back(neighbor);
+						++numQueued;
+					}
+				}
+			}
+			numQueued -= bucket.size();
+			bucket.clear();
+		}
+
+		if (maxDistance < UNREACHABLE) {
+			return static_cast<uint16_t>(straight);
+		}
+		if (straight == 1) {
+			// the landmark is too far from some cells even when counting steps
+			return 0;
+		}
+		// shrink the step costs such that the largest distance fits
+		straight = std::max<uint32_t>(1, static_cast<uint32_t>(static_cast<uint64_t>(straight) * (UNREACHABLE - 1) / maxDistance));
+	}
+}
+
+double LandmarkHeuristic::getDistance(const size_t& landmark, const int& x, const int& y) const {
+	if (landmark >= landmarks.size() || !map.isInside(x, y)) {
+		throw std::out_of_range("LandmarkHeuristic::getDistance(): landmark or cell does not exist");
+	}
+	const uint16_t distance = table[(static_cast<size_t>(y) * map.width + x) * landmarks.size() + landmark];
+	if (distance == UNREACHABLE) {
+		return std::numeric_limits<double>::infinity();
+	}
+	return distance / static_cast<double>(straightCosts[landmark]);
+}
+
+bool LandmarkHeuristic::save(const std::string& filename) const {
+	std::ofstream ofs(filename.c_str(), std::ios::binary);
+	if (!ofs.good()) {
+		std::cerr << "Error: Could not open " << filename << " for writing the landmark table." << std::endl;
+		return false;
+	}
+	const uint32_t header[3] = { static_cast<uint32_t>(map.width), static_cast<uint32_t>(map.height), static_cast<uint32_t>(landmarks.size()) };
+	const uint64_t hash = hashMap(map);
+	ofs.write(MAGIC, sizeof(MAGIC));
+	ofs.write(reinterpret_cast<const char *>(header), sizeof(header));
+	ofs.write(reinterpret_cast<const char *>(&hash), sizeof(hash));
+	for (size_t i = 0; i < landmarks.size(); ++i) {
+		const int32_t landmark[3] = { landmarks[i].first, landmarks[i].second, straightCosts[i] };
+		ofs.write(reinterpret_cast<const char *>(landmark), sizeof(landmark));
+	}
+	if (!table.empty()) {
+		ofs.write(reinterpret_cast<const char *>(&table[0]), table.size() * sizeof(uint16_t));
+	}
+	return ofs.good();
+}
+
+bool LandmarkHeuristic::load(const std::string& filename) {
+	std::ifstream ifs(filename.c_str(), std::ios::binary);
+	char magic[sizeof(MAGIC)];
+	uint32_t header[3];
+	uint64_t hash;
+	if (!ifs.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+			|| !ifs.read(reinterpret_cast<char *>(header), sizeof(header))
+			|| !ifs.read(reinterpret_cast<char *>(&hash), sizeof(hash))) {
+		std::cerr << "Error: " << filename << " is not a landmark table." << std::endl;
+		return false;
+	}
+	if (header[0] != map.width || header[1] != map.height || hash != hashMap(map)) {
+		std::cerr << "Error: The landmark table " << filename << " belongs to a different map." << std::endl;
+		return false;
+	}
+	std::vector<std::pair<int, int> > newLandmarks(header[2]);
+	std::vector<uint16_t> newStraightCosts(header[2]);
+	for (size_t i = 0; i < newLandmarks.size(); ++i) {
+		int32_t landmark[3];
+		if (!ifs.read(reinterpret_cast<char *>(landmark), sizeof(landmark)) || !map.isInside(landmark[0], landmark[1])
+				|| landmark[2] <= 0 || landmark[2] > UNREACHABLE) {
+			std::cerr << "Error: The landmark table " << filename << " is corrupt." << std::endl;
+			return false;
+		}
+		newLandmarks[i] = std::make_pair(landmark[0], landmark[1]);
+		newStraightCosts[i] = static_cast<uint16_t>(landmark[2]);
+	}
+	std::vector<uint16_t> newTable(map.width * map.height * newLandmarks.size());
+	if (!newTable.empty() && !ifs.read(reinterpret_cast<char *>(&newTable[0]), newTable.size() * sizeof(uint16_t))) {
+		std::cerr << "Error: The landmark table " << filename << " is truncated." << std::endl;
+		return false;
+	}
+	landmarks.swap(newLandmarks);
+	straightCosts.swap(newStraightCosts);
+	table.swap(newTable);
+	return true;
+}
+
+uint64_t LandmarkHeuristic::hashMap(const GridMap& map) {
+	uint64_t hash = 14695981039346656037ull;
+	const uint64_t prime = 1099511628211ull;
+	const uint64_t dimensions[2] = { map.width, map.height };
+	for (size_t i = 0; i < 2; ++i) {
+		for (int b = 0; b < 8; ++b) {
+			hash = (hash ^ ((dimensions[i] >> (8 * b)) & 0xFFu)) * prime;
+		}
+	}
+	// the occupancy is hashed in bytes of eight consecutive cells
+	uint8_t byte = 0;
+	int bits = 0;
+	for (size_t y = 0; y < map.height; ++y) {
+		for (size_t x = 0; x < map.width; ++x) {
+			byte = static_cast<uint8_t>((byte << 1) | (map.isOccupiedUnchecked(x, y) ? 1u : 0u));
+			if (++bits == 8) {
+				hash = (hash ^ byte) * prime;
+				byte = 0;
+				bits = 0;
+			}
+		}
+	}
+	if (bits > 0) {
+		hash = (hash ^ byte) * prime;
+	}
+	return hash;
+}
+
+}  // namespace path_planning
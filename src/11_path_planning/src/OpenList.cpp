@@ -1,56 +1,105 @@
 #include <path_planning/OpenList.h>
 #include <iostream>
+#include <stdint.h>
 
 namespace path_planning {
 
+namespace {
+
+/**
+ * @brief Returns the radix heap bucket of a key: 0 if it equals the last removed key, otherwise
+ * the position of the highest bit in which they differ plus 1.
+ *
+ * The keys are widened to 64 bits, since unsigned long has only 32 bits on Windows.
+ */
+inline size_t radixBucket(const size_t& key, const size_t& radixLast) {
+	return key == radixLast ? 0 : 64 - __builtin_clzll(static_cast<uint64_t>(key ^ radixLast));
+}
+
+}  // namespace
+
 FileIO *OpenList::fileIO = NULL;
+TraceLogger *OpenList::traceLogger = NULL;
 bool OpenList::logToStdout = false;
+OpenList::QueueType OpenList::defaultQueueType = OpenList::INDEXED_HEAP;
+unsigned int OpenList::defaultArity = 4;
 
 const GridMap *OpenList::map = NULL;
-OpenList::OpenList() :
+OpenList::OpenList(const QueueType& queueType, const unsigned int& arity) :
 		duplicateWarning(false),
 		reinsertWarning(false),
-		data(map->width * map->height)
+		gridMap(map),
+		logging(true),
+		queueType(queueType),
+		arity(arity),
+		radixLast(0),
+		numOpen(0)
 {
+	if (!map) {
+		throw std::runtime_error("OpenList: OpenList::map has to be set before creating an open list");
+	}
+	if (arity < 2) {
+		throw std::invalid_argument("OpenList: the heap arity must be at least 2");
+	}
+	data.resize(map->width * map->height);
 }
 
-OpenList::~OpenList() {
+OpenList::OpenList(const GridMap& map, const QueueType& queueType, const unsigned int& arity) :
+		duplicateWarning(false),
+		reinsertWarning(false),
+		gridMap(&map),
+		logging(true),
+		data(map.width * map.height),
+		queueType(queueType),
+		arity(arity),
+		radixLast(0),
+		numOpen(0)
+{
+	if (arity < 2) {
+		throw std::invalid_argument("OpenList: the heap arity must be at least 2");
+	}
 }
 
-OpenList::OpenListData& OpenList::getData(AbstractNode * node) {
-	GridNode * g = dynamic_cast<GridNode *>(node);
-	if (!g) {
-		throw std::invalid_argument("Used OpenList with a node that is not an instance of GridNode");
-	}
-	const int c = g->y * map->width + g->x;
-	if (c < 0 || c > data.size()) {
-		throw std::invalid_argument("Used OpenList with a grid node that is outside the map");
+OpenList::~OpenList() {
+	while (!openList.empty()) {
+		delete openList.top();
+		openList.pop();
 	}
-	return data[c];
 }
 
-OpenList::OpenListData& OpenList::getData(const AbstractNode * const node) const {
+size_t OpenList::getIndex(const AbstractNode * const node) const {
 	const GridNode * const g = dynamic_cast<const GridNode * const>(node);
 	if (!g) {
 		throw std::invalid_argument("Used OpenList with a node that is not an instance of GridNode");
 	}
-	const int c = g->y * map->width + g->x;
-	if (c < 0 || c > data.size()) {
+	if (!gridMap->isInside(g->x, g->y)) {
 		throw std::invalid_argument("Used OpenList with a grid node that is outside the map");
 	}
-	return data[c];
+	return static_cast<size_t>(g->y) * gridMap->width + g->x;
+}
+
+OpenList::OpenListData& OpenList::getData(AbstractNode * node) {
+	return data[getIndex(node)];
+}
+
+OpenList::OpenListData& OpenList::getData(const AbstractNode * const node) const {
+	return data[getIndex(node)];
 }
 
 void OpenList::enqueue(const AbstractNode * const node, const double costs) {
 	if (!node) {
 		throw std::invalid_argument("OpenList::enqueue(): node is NULL");
 	}
-	if (fileIO) {
+	if (logging && fileIO) {
 		fileIO->logOpenNode(node);
-	} else if (logToStdout) {
+	} else if (logging && logToStdout) {
 		std::cout << "enqueue " << node->toString() << std::endl;
 	}
-	OpenList::OpenListData& d = getData(node);
+	if (logging && traceLogger) {
+		traceLogger->logOpenNode(node, costs);
+	}
+	const size_t cell = getIndex(node);
+	OpenList::OpenListData& d = data[cell];
 	if (!duplicateWarning && d.state == OpenListData::OPEN) {
 		std::cerr << "Warning: adding node " << node->toString()
 				<< " multiple times to the open list. Use updateCosts() instead for changing the costs of a node."
@@ -63,12 +112,56 @@ void OpenList::enqueue(const AbstractNode * const node, const double costs) {
 				<< std::endl;
 			reinsertWarning = true;
 	}
+	if (d.state != OpenListData::OPEN) {
+		++numOpen;
+	}
+	if (queueType == RADIX_HEAP) {
+		d.state = OpenListData::OPEN;
+		d.cost = costs;
+		d.node = node;
+		radixPush(cell, costs);
+		return;
+	}
+	if (queueType == INDEXED_HEAP) {
+		const bool wasOpen = (d.state == OpenListData::OPEN);
+		const double oldCosts = d.cost;
+		d.state = OpenListData::OPEN;
+		d.cost = costs;
+		d.node = node;
+		if (!wasOpen) {
+			heapPush(cell);
+		} else if (costs < oldCosts) {
+			siftUp(d.heapIndex);
+		} else {
+			siftDown(d.heapIndex);
+		}
+		return;
+	}
 	d.state = OpenListData::OPEN;
 	d.cost = costs;
 	NodeWrapper *wrapper = new NodeWrapper(node, costs);
 	openList.push(wrapper);
 }
 const AbstractNode * OpenList::removeMin() {
+	if (queueType == RADIX_HEAP) {
+		if (numOpen == 0) {
+			throw std::runtime_error("OpenList::removeMin() is called but the queue is empty");
+		}
+		OpenList::OpenListData& d = data[radixTop()];
+		radixBuckets[0].pop_back();
+		d.state = OpenListData::CLOSED;
+		--numOpen;
+		return d.node;
+	}
+	if (queueType == INDEXED_HEAP) {
+		if (heap.empty()) {
+			throw std::runtime_error("OpenList::removeMin() is called but the queue is empty");
+		}
+		OpenList::OpenListData& d = data[heapPop()];
+		d.state = OpenListData::CLOSED;
+		--numOpen;
+		return d.node;
+	}
 	while (!openList.empty()) {
 		NodeWrapper *wrapper = openList.top();
 		const AbstractNode *node = wrapper->node;
@@ -77,12 +170,26 @@ const AbstractNode * OpenList::removeMin() {
 		OpenList::OpenListData& d = getData(node);
 		if (d.state == OpenListData::OPEN) {
 			d.state = OpenListData::CLOSED;
+			--numOpen;
 			return node;
 		}
 		// here updated nodes are deleted (lazy deletion)
 	}
 	throw std::runtime_error("OpenList::removeMin() is called but the queue is empty");
 }
+double OpenList::getMinCosts() const {
+	if (isEmpty()) {
+		throw std::runtime_error("OpenList::getMinCosts() is called but the queue is empty");
+	}
+	if (queueType == INDEXED_HEAP) {
+		return data[heap.front()].cost;
+	}
+	if (queueType == RADIX_HEAP) {
+		return data[radixTop()].cost;
+	}
+	// costs only decrease, so the top entry of an open node is never outdated
+	return openList.top()->costs;
+}
 void OpenList::updateCosts(const AbstractNode * const node, const double costs) {
 	if (!node) {
 		throw std::invalid_argument("OpenList::updateCosts(): node is NULL");
@@ -92,7 +199,20 @@ void OpenList::updateCosts(const AbstractNode * const node, const double costs)
 		throw std::runtime_error(
 				"Tried to update the costs for a node that has not been enqueued to the open list.");
 	}
+	const double oldCosts = d.cost;
 	d.cost = costs;
+	if (queueType == RADIX_HEAP) {
+		radixPush(getIndex(node), costs);
+		return;
+	}
+	if (queueType == INDEXED_HEAP) {
+		if (costs < oldCosts) {
+			siftUp(d.heapIndex);
+		} else {
+			siftDown(d.heapIndex);
+		}
+		return;
+	}
 	// lazy deletion: insert copy now, delete later
 	NodeWrapper *wrapper = new NodeWrapper(node, costs) ;
 	openList.push(wrapper);
@@ -111,8 +231,15 @@ double OpenList::getCosts(const AbstractNode * const node) const {
 }
 
 bool OpenList::isEmpty() const {
+	if (queueType == INDEXED_HEAP) {
+		return heap.empty();
+	}
+	if (queueType == RADIX_HEAP) {
+		return numOpen == 0;
+	}
 	// do lazy deletion
 	while(!openList.empty() && getData(openList.top()->node).state == OpenListData::CLOSED) {
+		delete openList.top();
 		openList.pop();
 	}
 	return openList.empty();
@@ -124,4 +251,122 @@ bool OpenList::contains(const AbstractNode * const node) const {
 	return getData(node).state == OpenListData::OPEN;
 }
 
+void OpenList::heapPush(const size_t& cell) {
+	heap.push_back(cell);
+	data[cell].heapIndex = heap.size() - 1;
+	siftUp(heap.size() - 1);
+}
+
+size_t OpenList::heapPop() {
+	const size_t top = heap.front();
+	const size_t last = heap.back();
+	heap.pop_back();
+	if (!heap.empty()) {
+		heapSet(0, last);
+		siftDown(0);
+	}
+	return top;
+}
+
+void OpenList::siftUp(size_t position) {
+	const size_t cell = heap[position];
+	const double costs = data[cell].cost;
+	while (position > 0) {
+		const size_t parent = (position - 1) / arity;
+		if (!(costs < data[heap[parent]].cost)) {
+			break;
+		}
+		heapSet(position, heap[parent]);
+		position = parent;
+	}
+	heapSet(position, cell);
+}
+
+void OpenList::siftDown(size_t position) {
+	const size_t cell = heap[position];
+	const double costs = data[cell].cost;
+	const size_t size = heap.size();
+	while (true) {
+		const size_t first = position * arity + 1;
+		if (first >= size) {
+			break;
+		}
+		const size_t end = (first + arity < size) ? first + arity : size;
+		size_t best = first;
+		double bestCosts = data[heap[first]].cost;
+		for (size_t child = first + 1; child < end; ++child) {
+			const double childCosts = data[heap[child]].cost;
+			if (childCosts < bestCosts) {
+				best = child;
+				bestCosts = childCosts;
+			}
+		}
+		if (!(bestCosts < costs)) {
+			break;
+		}
+		heapSet(position, heap[best]);
+		position = best;
+	}
+	heapSet(position, cell);
+}
+
+void OpenList::radixPush(const size_t& cell, const double& costs) {
+	if (!(costs >= 0.0)) {
+		throw std::invalid_argument("OpenList: the radix heap only supports non-negative costs");
+	}
+	size_t key = static_cast<size_t>(costs * RADIX_SCALE + 0.5);
+	if (key < radixLast) {
+		// the queue is monotone, see RADIX_HEAP
+		key = radixLast;
+	}
+	data[cell].heapIndex = key;
+	const RadixEntry entry = { key, cell };
+	const size_t bucket = radixBucket(key, radixLast);
+	radixBuckets[bucket].push_back(entry);
+}
+
+size_t OpenList::radixTop() const {
+	while (true) {
+		// bucket 0 only contains keys equal to radixLast, so any current entry is a minimum
+		std::vector<RadixEntry>& first = radixBuckets[0];
+		while (!first.empty()) {
+			const RadixEntry& entry = first.back();
+			const OpenListData& d = data[entry.cell];
+			if (d.state == OpenListData::OPEN && d.heapIndex == entry.key) {
+				return entry.cell;
+			}
+			first.pop_back();
+		}
+
+		size_t i = 1;
+		while (i < NUM_RADIX_BUCKETS && radixBuckets[i].empty()) {
+			++i;
+		}
+		if (i == NUM_RADIX_BUCKETS) {
+			throw std::runtime_error("OpenList: the radix heap is empty");
+		}
+		// the minimum of the first non-empty bucket becomes radixLast, and the entries of the
+		// bucket move to lower buckets, since they now differ from radixLast in lower bits
+		std::vector<RadixEntry>& bucket = radixBuckets[i];
+		size_t minKey = static_cast<size_t>(-1);
+		for (size_t j = 0; j < bucket.size(); ++j) {
+			const OpenListData& d = data[bucket[j].cell];
+			if (d.state == OpenListData::OPEN && d.heapIndex == bucket[j].key && bucket[j].key < minKey) {
+				minKey = bucket[j].key;
+			}
+		}
+		if (minKey != static_cast<size_t>(-1)) {
+			radixLast = minKey;
+			for (size_t j = 0; j < bucket.size(); ++j) {
+				const RadixEntry& entry = bucket[j];
+				const OpenListData& d = data[entry.cell];
+				if (d.state == OpenListData::OPEN && d.heapIndex == entry.key) {
+					radixBuckets[radixBucket(entry.key, radixLast)].push_back(entry);
+				}
+			}
+		}
+		bucket.clear();
+	}
+}
+
 }  // namespace planning
@@ -1,5 +1,8 @@
 ﻿#include <path_planning/PathPlanning.h>
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <limits>
 
 namespace path_planning {
 
@@ -19,6 +22,13 @@ double GridPathPlanning::getCosts(const GridNode * const currentNode, const Grid
 	 * - node->x: the x index of the cell
 	 * - node->y: the y index of the cell
 	 */
+	if (integerCosts_) {
+		// octile distance in fixed point, see setIntegerCosts()
+		const int dx = std::abs(currentNode->x - successorNode->x);
+		const int dy = std::abs(currentNode->y - successorNode->y);
+		const int diagonal = std::min(dx, dy);
+		return static_cast<double>((std::max(dx, dy) - diagonal) * static_cast<int>(OpenList::RADIX_SCALE) + diagonal * FIXED_POINT_DIAGONAL) / OpenList::RADIX_SCALE;
+	}
 	result = sqrt((pow((currentNode->x - successorNode->x), 2)) + (pow((currentNode->y - successorNode->y), 2)));
 
 	return result;
@@ -67,6 +77,23 @@ double ManhattanDistanceHeuristic::heuristic(const GridNode* const currentNode,
 	return result;
 }
 
+/**
+ * @brief Calculates the octile distance between the current node and the goal.
+ * @param[in] currentNode The current grid cell.
+ * @param[in] goalNode The goal grid cell.
+ * @return The costs of the shortest path between the cells with 8-connectivity on an empty map.
+ */
+double OctileDistanceHeuristic::heuristic(const GridNode* const currentNode, const GridNode* const goalNode) const {
+	const int dx = std::abs(currentNode->x - goalNode->x);
+	const int dy = std::abs(currentNode->y - goalNode->y);
+	const int diagonal = std::min(dx, dy);
+	if (fixedPoint) {
+		return static_cast<double>((std::max(dx, dy) - diagonal) * static_cast<int>(OpenList::RADIX_SCALE)
+				+ diagonal * GridPathPlanning::FIXED_POINT_DIAGONAL) / OpenList::RADIX_SCALE;
+	}
+	return std::max(dx, dy) - diagonal + diagonal * std::sqrt(2.0);
+}
+
 /**
  * @brief Returns a vector of neighbor nodes of the current node where the robot can travel to.
  * @param[in] currentNode The current grid cell.
@@ -86,62 +113,16 @@ std::vector<AbstractNode *> GridPathPlanning::getNeighborNodes(const GridNode *
 	 * - map.width: width of the map in cells
 	 * - map.height: height of the map in cells
 	 * - map.isOccupied(int x, int y): returns true iff the cell is occupied by an obstacle
-	 * - GridNode::get(int x, int y): creates and returns a new node representing a cell.
+	 * - map.getFreeNeighbors(int x, int y): returns a bit mask of the free cells among the eight neighbors
+	 * - getNode(int x, int y): returns the node representing a cell.
 	 */
-	if (currentNode->x - 1 >= 0 && currentNode->y - 1 >= 0 && currentNode->x -1 < map.width && currentNode->y - 1< map.height)
-	{
-		if (!(map.isOccupied(currentNode->x - 1, currentNode->y - 1)))
-		{
-			result.push_back(GridNode::get(currentNode->x - 1, currentNode->y - 1));
-		}
-	}
-	if (currentNode->x - 1 >= 0 && currentNode->y >= 0 && currentNode->x - 1< map.width && currentNode->y < map.height)
-	{
-		if (!(map.isOccupied(currentNode->x - 1, currentNode->y)))
-		{
-			result.push_back(GridNode::get(currentNode->x - 1, currentNode->y));
-		}
-	}
-	if (currentNode->x - 1 >= 0 && currentNode->y + 1 >= 0 && currentNode->x - 1 < map.width && currentNode->y + 1< map.height)
-	{
-		if (!(map.isOccupied(currentNode->x - 1, currentNode->y + 1)))
-		{
-			result.push_back(GridNode::get(currentNode->x - 1, currentNode->y + 1));
-		}
-	}
-	if (currentNode->x  >= 0 && currentNode->y - 1 >= 0 && currentNode->x  < map.width && currentNode->y - 1 < map.height)
-	{
-		if (!(map.isOccupied(currentNode->x, currentNode->y - 1)))
-		{
-			result.push_back(GridNode::get(currentNode->x, currentNode->y - 1));
-		}
-	}
-	if (currentNode->x >= 0 && currentNode->y + 1 >= 0 && currentNode->x < map.width && currentNode->y + 1 < map.height)
-	{
-		if (!(map.isOccupied(currentNode->x, currentNode->y + 1)))
-		{
-			result.push_back(GridNode::get(currentNode->x, currentNode->y + 1));
-		}
-	}
-	if (currentNode->x + 1 >= 0 && currentNode->y  >= 0 && currentNode->x + 1 < map.width && currentNode->y < map.height)
-	{
-		if (!(map.isOccupied(currentNode->x + 1, currentNode->y )))
-		{
-			result.push_back(GridNode::get(currentNode->x + 1, currentNode->y ));
-		}
-	}
-	if (currentNode->x + 1 >= 0 && currentNode->y + 1 >= 0 && currentNode->x + 1 < map.width && currentNode->y +1< map.height)
-	{
-		if (!(map.isOccupied(currentNode->x + 1, currentNode->y + 1)))
-		{
-			result.push_back(GridNode::get(currentNode->x + 1, currentNode->y + 1));
-		}
-	}
-	if (currentNode->x + 1 >= 0 && currentNode->y - 1 >= 0 && currentNode->x + 1 < map.width && currentNode->y - 1 < map.height)
+	const unsigned int freeNeighbors = map.getFreeNeighbors(currentNode->x, currentNode->y);
+	result.reserve(8);
+	for (int i = 0; i < 8; ++i)
 	{
-		if (!(map.isOccupied(currentNode->x + 1, currentNode->y - 1)))
+		if (freeNeighbors & (1u << i))
 		{
-			result.push_back(GridNode::get(currentNode->x + 1, currentNode->y - 1));
+			result.push_back(getNode(currentNode->x + GridMap::NEIGHBOR_DX[i], currentNode->y + GridMap::NEIGHBOR_DY[i]));
 		}
 	}
 
@@ -189,15 +170,18 @@ void PathPlanning::expandNode(const AbstractNode* const currentNode, const Abstr
 		double cost = currentNode->costs + getCosts(currentNode, possibleNeighbourCells[i]);
 		if (!closedList.contains(possibleNeighbourCells[i]))
 		{
-			if (!(openList.contains(possibleNeighbourCells[i]) && cost > possibleNeighbourCells[i]->costs))
+			const bool isOpen = openList.contains(possibleNeighbourCells[i]);
+			if (isOpen && cost >= possibleNeighbourCells[i]->costs)
 			{
-				possibleNeighbourCells[i]->setPredecessor(currentNode);
-				possibleNeighbourCells[i]->costs = cost;
+				// the node already has a path that is at least as short
+				continue;
 			}
+			possibleNeighbourCells[i]->setPredecessor(currentNode);
+			possibleNeighbourCells[i]->costs = cost;
 
 			//adding heuristics as well
 			double h = cost + heuristic(possibleNeighbourCells[i], goalNode);
-			if (openList.contains(possibleNeighbourCells[i]))
+			if (isOpen)
 			{
 				openList.updateCosts(possibleNeighbourCells[i], h);
 			} 
@@ -232,7 +216,20 @@ std::deque<const AbstractNode*> PathPlanning::planPath(const AbstractNode * cons
 	// Create empty lists for open nodes and closed nodes
    	OpenList openList;
    	ClosedList closedList;
+   	return search(startNode, goalNode, openList, closedList);
+}
+
 
+/**
+ * @brief Plans a path from a start node to a goal node using the given open and closed lists.
+ * @param[in] startNode The start node.
+ * @param[in] goalNode The goal node.
+ * @param[in,out] openList An empty list for the open nodes.
+ * @param[in,out] closedList An empty list for the closed nodes.
+ * @return The optimal path from the start node to the end node.
+ */
+std::deque<const AbstractNode*> PathPlanning::search(const AbstractNode * const startNode, const AbstractNode * const goalNode,
+		OpenList& openList, ClosedList& closedList) {
    	std::deque<const AbstractNode*> resultPath;
 	/* TODO: Fill resultPath by planning a path from the startNode to the goalNode */
 
@@ -250,8 +247,11 @@ std::deque<const AbstractNode*> PathPlanning::planPath(const AbstractNode * cons
      *     to the current node by following the chain of predecessors.
    	 */
 
+	numExpansions = 0;
+
 	//add the start node to the open list
 	openList.enqueue(startNode, 0.0);
+	peakOpenListSize = openList.size();
 
 	//∙ process the open list in a loop by removing the node with minimum costs,
 	while (!openList.isEmpty())
@@ -260,6 +260,7 @@ std::deque<const AbstractNode*> PathPlanning::planPath(const AbstractNode * cons
 
 		//∙ expand that nodeand put it onto the closed list,
 		closedList.add(newNode);
+		++numExpansions;
 		
 		//∙ check if the goal has been reached using isCloseToGoal(),
 		if (isCloseToGoal(newNode, goalNode))
@@ -270,6 +271,7 @@ std::deque<const AbstractNode*> PathPlanning::planPath(const AbstractNode * cons
 		
 		//∙ call followPath for extracting the final path once the goal has been reached
 		expandNode(newNode, goalNode, openList, closedList);
+		peakOpenListSize = std::max(peakOpenListSize, openList.size());
 
 	}
 
@@ -277,6 +279,166 @@ std::deque<const AbstractNode*> PathPlanning::planPath(const AbstractNode * cons
 }
 
 
+/**
+ * @brief Plans a path from a start node to a goal node.
+ * @param[in] startNode The start node.
+ * @param[in] goalNode The goal node.
+ * @return The optimal path from the start node to the end node.
+ *
+ * If the planner uses a node arena, the search state of the previous query is cleared first.
+ * The open list is created for the planner's map, so OpenList::map does not have to be set.
+ * The closed list of the planner is reused and only cleared.
+ */
+std::deque<const AbstractNode*> GridPathPlanning::planPath(const AbstractNode * const startNode, const AbstractNode * const goalNode) {
+	if (arena_) {
+		arena_->reset();
+	}
+	if (bidirectional_) {
+		return searchBidirectional(startNode, goalNode);
+	}
+	OpenList openList(map_, integerCosts_ ? OpenList::RADIX_HEAP : OpenList::defaultQueueType);
+	openList.setLogging(logging_);
+	closedList_.clear();
+	closedList_.setLogging(logging_);
+	return search(startNode, goalNode, openList, closedList_);
+}
+
+
+/**
+ * @brief Plans a path by searching from the start node and from the goal node.
+ * @param[in] startNode The start node.
+ * @param[in] goalNode The goal node.
+ * @return The optimal path from the start node to the end node.
+ *
+ * The costs and predecessors of the nodes are only set for the returned path: the meeting
+ * node is connected to the goal by reversing the predecessors of the backward direction.
+ */
+std::deque<const AbstractNode*> GridPathPlanning::searchBidirectional(const AbstractNode * const startNode, const AbstractNode * const goalNode) {
+	if (!startNode) {
+		throw std::invalid_argument("GridPathPlanning::planPath(): startNode is NULL");
+	}
+	if (!goalNode) {
+		throw std::invalid_argument("GridPathPlanning::planPath(): goalNode is NULL");
+	}
+	const size_t numCells = map_.width * map_.height;
+	for (int d = 0; d < 2; ++d) {
+		if (labels_[d].size() != numCells) {
+			labels_[d].assign(numCells, Label());
+			labelGeneration_ = 0;
+		}
+	}
+	if (++labelGeneration_ == 0) {
+		for (int d = 0; d < 2; ++d) {
+			labels_[d].assign(numCells, Label());
+		}
+		labelGeneration_ = 1;
+	}
+
+	const OpenList::QueueType queueType = integerCosts_ ? OpenList::RADIX_HEAP : OpenList::defaultQueueType;
+	OpenList forwardOpenList(map_, queueType), backwardOpenList(map_, queueType);
+	OpenList * const openLists[2] = { &forwardOpenList, &backwardOpenList };
+	ClosedList * const closedLists[2] = { &closedList_, &backwardClosedList_ };
+	// the search sets the costs and predecessors of the nodes on the path, including start and goal
+	AbstractNode * const roots[2] = { const_cast<AbstractNode *>(startNode), const_cast<AbstractNode *>(goalNode) };
+	for (int d = 0; d < 2; ++d) {
+		openLists[d]->setLogging(logging_);
+		closedLists[d]->clear();
+		closedLists[d]->setLogging(logging_);
+		const GridNode * const root = static_cast<const GridNode *>(roots[d]);
+		Label& label = labels_[d][static_cast<size_t>(root->y) * map_.width + root->x];
+		label.costs = 0.0;
+		label.predecessor = NULL;
+		label.generation = labelGeneration_;
+		openLists[d]->enqueue(roots[d], heuristic(roots[d], roots[1 - d]));
+	}
+
+	numExpansions = 0;
+	peakOpenListSize = 2;
+	double bestCosts = std::numeric_limits<double>::infinity();
+	AbstractNode *meetingNode = NULL;
+	if (isCloseToGoal(startNode, goalNode)) {
+		bestCosts = 0.0;
+		meetingNode = roots[0];
+	}
+
+	while (!forwardOpenList.isEmpty() && !backwardOpenList.isEmpty()) {
+		// expand the direction with the smaller frontier
+		const int d = forwardOpenList.size() <= backwardOpenList.size() ? 0 : 1;
+		// every path that is cheaper than the best one passes an open node of each direction
+		// whose costs (f = g + h) do not exceed the path costs
+		if (std::max(forwardOpenList.getMinCosts(), backwardOpenList.getMinCosts()) >= bestCosts) {
+			break;
+		}
+		const AbstractNode * const currentNode = openLists[d]->removeMin();
+		closedLists[d]->add(currentNode);
+		if (closedLists[1 - d]->contains(currentNode)) {
+			// the paths through a node that both directions have closed are already known
+			continue;
+		}
+		++numExpansions;
+
+		const GridNode * const current = static_cast<const GridNode *>(currentNode);
+		const double costs = labels_[d][static_cast<size_t>(current->y) * map_.width + current->x].costs;
+		const std::vector<AbstractNode *> neighbors = getNeighborNodes(currentNode);
+		for (size_t i = 0; i < neighbors.size(); ++i) {
+			AbstractNode * const neighborNode = neighbors[i];
+			if (closedLists[d]->contains(neighborNode)) {
+				continue;
+			}
+			const GridNode * const neighbor = static_cast<const GridNode *>(neighborNode);
+			const size_t cell = static_cast<size_t>(neighbor->y) * map_.width + neighbor->x;
+			Label& label = labels_[d][cell];
+			const double neighborCosts = costs + getCosts(currentNode, neighborNode);
+			if (label.generation == labelGeneration_ && neighborCosts >= label.costs) {
+				continue;
+			}
+			label.costs = neighborCosts;
+			label.predecessor = const_cast<AbstractNode *>(currentNode);
+			label.generation = labelGeneration_;
+
+			const Label& other = labels_[1 - d][cell];
+			if (other.generation == labelGeneration_ && neighborCosts + other.costs < bestCosts) {
+				bestCosts = neighborCosts + other.costs;
+				meetingNode = neighborNode;
+			}
+			// nodes that cannot lead to a cheaper path are not added to the open list
+			const double f = neighborCosts + heuristic(neighborNode, roots[1 - d]);
+			if (openLists[d]->contains(neighborNode)) {
+				openLists[d]->updateCosts(neighborNode, f);
+			} else if (f < bestCosts) {
+				openLists[d]->enqueue(neighborNode, f);
+			}
+		}
+		peakOpenListSize = std::max(peakOpenListSize, forwardOpenList.size() + backwardOpenList.size());
+	}
+
+	std::deque<const AbstractNode*> resultPath;
+	if (!meetingNode) {
+		return resultPath;
+	}
+	// link the backward part of the path to the forward part
+	const GridNode * const meeting = static_cast<const GridNode *>(meetingNode);
+	const size_t meetingCell = static_cast<size_t>(meeting->y) * map_.width + meeting->x;
+	for (AbstractNode *node = meetingNode; node != NULL; ) {
+		const GridNode * const g = static_cast<const GridNode *>(node);
+		const Label& label = labels_[0][static_cast<size_t>(g->y) * map_.width + g->x];
+		node->costs = label.costs;
+		node->setPredecessor(label.predecessor);
+		node = label.predecessor;
+	}
+	AbstractNode *last = meetingNode;
+	for (AbstractNode *node = labels_[1][meetingCell].predecessor; node != NULL; ) {
+		const GridNode * const g = static_cast<const GridNode *>(node);
+		AbstractNode * const next = labels_[1][static_cast<size_t>(g->y) * map_.width + g->x].predecessor;
+		node->costs = last->costs + getCosts(last, node);
+		node->setPredecessor(last);
+		last = node;
+		node = next;
+	}
+	return followPath(last);
+}
+
+
 /**
  * @brief Extracts the path from the currentNode back to the start node.
  * @param[in] node The current node.
@@ -0,0 +1,157 @@
+#include <path_planning/TraceLogger.h>
+#include <path_planning/GridNode.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace path_planning {
+
+namespace {
+
+const char MAGIC[8] = { 'P', 'P', 'T', 'R', 'A', 'C', 'E', '1' };
+
+}  // namespace
+
+TraceLogger::TraceLogger(const size_t& capacity) :
+		mask(0),
+		head(0),
+		tail(0),
+		running(false),
+		width(0),
+		height(0)
+{
+	size_t size = 1;
+	while (size < capacity) {
+		size <<= 1;
+	}
+	ring.resize(size);
+	mask = size - 1;
+}
+
+TraceLogger::~TraceLogger() {
+	close();
+}
+
+bool TraceLogger::open(const std::string& filename, const GridMap& map) {
+	close();
+	file.open(filename.c_str(), std::ios::binary);
+	if (!file.is_open()) {
+		std::cerr << "Error: Could not open " << filename << " for writing the trace file." << std::endl;
+		return false;
+	}
+	width = map.width;
+	height = map.height;
+	const uint32_t dimensions[2] = { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+	file.write(MAGIC, sizeof(MAGIC));
+	file.write(reinterpret_cast<const char *>(dimensions), sizeof(dimensions));
+	head.store(0);
+	tail.store(0);
+	start = Clock::now();
+	running.store(true);
+	writer = std::thread(&TraceLogger::writeLoop, this);
+	return true;
+}
+
+void TraceLogger::close() {
+	if (!running.load()) {
+		return;
+	}
+	running.store(false, std::memory_order_release);
+	writer.join();
+	file.close();
+}
+
+void TraceLogger::logCloseNode(const AbstractNode * const node) {
+	log(node, CLOSE, std::numeric_limits<double>::quiet_NaN());
+}
+
+void TraceLogger::log(const AbstractNode * const node, const Event& event, const double& f) {
+	if (!node) {
+		throw std::invalid_argument("TraceLogger::log(): node is NULL");
+	}
+	if (!running.load(std::memory_order_relaxed)) {
+		return;
+	}
+	const GridNode * const g = dynamic_cast<const GridNode *>(node);
+	if (!g || g->x < 0 || g->x >= static_cast<int>(width) || g->y < 0 || g->y >= static_cast<int>(height)) {
+		throw std::invalid_argument("TraceLogger::log(): node is not a grid node inside the map");
+	}
+
+	const uint64_t h = head.load(std::memory_order_relaxed);
+	while (h - tail.load(std::memory_order_acquire) > mask) {
+		// the ring buffer is full, wait for the writer
+		std::this_thread::yield();
+	}
+	Record& record = ring[h & mask];
+	record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+	record.cell = static_cast<uint32_t>(static_cast<size_t>(g->y) * width + g->x);
+	record.event = event;
+	record.f = static_cast<float>(f);
+	record.g = static_cast<float>(node->costs);
+	head.store(h + 1, std::memory_order_release);
+}
+
+void TraceLogger::writeLoop() {
+	uint64_t t = tail.load(std::memory_order_relaxed);
+	while (true) {
+		const bool stop = !running.load(std::memory_order_acquire);
+		const uint64_t h = head.load(std::memory_order_acquire);
+		if (t == h) {
+			if (stop) {
+				break;
+			}
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+			continue;
+		}
+		// write the pending records in at most two contiguous blocks
+		while (t < h) {
+			const size_t begin = static_cast<size_t>(t & mask);
+			const size_t count = std::min(static_cast<size_t>(h - t), ring.size() - begin);
+			file.write(reinterpret_cast<const char *>(&ring[begin]), count * sizeof(Record));
+			t += count;
+		}
+		tail.store(t, std::memory_order_release);
+	}
+	file.flush();
+}
+
+bool TraceLogger::readTrace(const std::string& traceFilename, size_t& width, size_t& height, std::vector<Record>& records) {
+	std::ifstream ifs(traceFilename.c_str(), std::ios::binary);
+	char magic[sizeof(MAGIC)];
+	uint32_t dimensions[2];
+	if (!ifs.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+			|| !ifs.read(reinterpret_cast<char *>(dimensions), sizeof(dimensions))) {
+		std::cerr << "Error: " << traceFilename << " is not a trace file." << std::endl;
+		return false;
+	}
+	width = dimensions[0];
+	height = dimensions[1];
+	records.clear();
+	Record record;
+	while (ifs.read(reinterpret_cast<char *>(&record), sizeof(record))) {
+		records.push_back(record);
+	}
+	return true;
+}
+
+bool TraceLogger::convertToText(const std::string& traceFilename, const std::string& textFilename) {
+	size_t width, height;
+	std::vector<Record> records;
+	if (!readTrace(traceFilename, width, height, records)) {
+		return false;
+	}
+	std::ofstream ofs(textFilename.c_str());
+	if (!ofs.good()) {
+		std::cerr << "Error: Could not open " << textFilename << " for writing the log file." << std::endl;
+		return false;
+	}
+	for (size_t i = 0; i < records.size(); ++i) {
+		const Record& record = records[i];
+		ofs << record.cell % width << " " << record.cell / width
+				<< (record.event == OPEN ? " open" : " close") << "\n";
+	}
+	return ofs.good();
+}
+
+}  // namespace path_planning
@@ -1,5 +1,18 @@
 #include <gtest/gtest.h>
 #include <path_planning/PathPlanning.h>
+#include <path_planning/FileIO.h>
+#include <path_planning/JumpPointPlanning.h>
+#include <path_planning/BatchPlanning.h>
+#include <path_planning/GridSearch.h>
+#include <path_planning/HierarchicalPlanning.h>
+#include <path_planning/IncrementalPlanning.h>
+#include <path_planning/LandmarkHeuristic.h>
+#include <path_planning/TraceLogger.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
 #include <math.h>
 
 using namespace path_planning;
@@ -418,6 +431,1082 @@ TEST(PathPlanning, followPath) {
 	}
 }
 
+TEST(PathPlanning, gridNodeArena) {
+	const char mapchar[101] =
+			"# ##      "
+			"  ##      "
+			"  ##      "
+			"          "
+			" ###  ##  "
+			"   #  ### "
+			"   ##    #"
+			"  ## #    "
+			"#      # #"
+			" #      ##";
+	std::vector<bool> data;
+	makeMap(mapchar, data);
+
+	GridMap map(10, 10, data);
+	OpenList::map = &map;
+	StraightLineDistanceHeuristic heuristic;
+	GridNodeArena arena(map);
+	GridPathPlanning planner(map, heuristic, arena);
+
+	EXPECT_EQ(arena.size(), 100u);
+	EXPECT_EQ(arena.get(7, 9), arena.get(7, 9));
+	EXPECT_EQ(arena.get(7, 9), arena.get(arena.index(arena.get(7, 9))));
+	EXPECT_NE(arena.get(7, 9), GridNode::get(7, 9));
+	EXPECT_THROW(arena.get(10, 0), std::out_of_range);
+	EXPECT_THROW(arena.get(0, 10), std::out_of_range);
+
+	GridNode *start = arena.get(7, 9);
+	GridNode *goal = arena.get(0, 4);
+	std::deque<const AbstractNode*> path = planner.planPath(start, goal);
+	ASSERT_EQ(path.size(), 10u);
+	EXPECT_EQ(path.front(), start);
+	EXPECT_EQ(path.back(), goal);
+	const double costs = goal->costs;
+	EXPECT_NEAR(costs, 6. + 3. * sqrt(2.), 1e-9);
+	EXPECT_GT(arena.numTouched(), 0u);
+
+	// A second query on the same arena must not see the state of the first one.
+	std::deque<const AbstractNode*> path2 = planner.planPath(start, goal);
+	EXPECT_EQ(path, path2);
+	EXPECT_DOUBLE_EQ(goal->costs, costs);
+
+	arena.reset();
+	EXPECT_EQ(arena.numTouched(), 0u);
+	EXPECT_DOUBLE_EQ(goal->costs, 0.0);
+	EXPECT_TRUE(goal->getPredecessor() == NULL);
+}
+TEST(PathPlanning, openListQueueTypes) {
+	std::vector<bool> data(100, false);
+	GridMap map(10, 10, data);
+	OpenList::map = &map;
+
+	const OpenList::QueueType types[5] = { OpenList::LAZY_DELETION, OpenList::INDEXED_HEAP, OpenList::INDEXED_HEAP, OpenList::INDEXED_HEAP, OpenList::RADIX_HEAP };
+	const unsigned int arities[5] = { 2, 2, 4, 8, 2 };
+	for (size_t t = 0; t < 5; ++t) {
+		OpenList openList(types[t], arities[t]);
+		std::vector<double> costs(100);
+		unsigned int seed = 42;
+		for (int i = 0; i < 100; ++i) {
+			seed = seed * 1103515245u + 12345u;
+			costs[i] = (seed >> 16) % 1000;
+			openList.enqueue(GridNode::get(i % 10, i / 10), costs[i]);
+		}
+		// decrease the costs of some nodes, the indexed and the radix heap also support increasing them
+		for (int i = 0; i < 100; i += 3) {
+			const GridNode * const node = GridNode::get(i % 10, i / 10);
+			costs[i] = (i % 2 == 0 || types[t] == OpenList::LAZY_DELETION) ? costs[i] / 2.0 : costs[i] + 500.0;
+			openList.updateCosts(node, costs[i]);
+			EXPECT_DOUBLE_EQ(openList.getCosts(node), costs[i]);
+		}
+		// outdated copies of updated nodes are not counted
+		EXPECT_EQ(openList.size(), 100u);
+		std::vector<bool> removed(100, false);
+		double lastCosts = -1.0;
+		size_t count = 0;
+		while (!openList.isEmpty()) {
+			const GridNode * const node = static_cast<const GridNode *>(openList.removeMin());
+			const int index = node->y * 10 + node->x;
+			EXPECT_FALSE(removed[index]) << "Node " << node->toString() << " removed twice";
+			EXPECT_GE(costs[index], lastCosts);
+			EXPECT_FALSE(openList.contains(node));
+			EXPECT_EQ(openList.size(), 99u - count);
+			removed[index] = true;
+			lastCosts = costs[index];
+			++count;
+		}
+		EXPECT_EQ(count, 100u);
+		EXPECT_THROW(openList.removeMin(), std::runtime_error);
+	}
+
+	for (size_t t = 0; t < 4; ++t) {
+		OpenList openList(types[t], arities[t]);
+		for (int i = 0; i < 50; ++i) {
+			openList.enqueue(GridNode::get(i % 10, i / 10), static_cast<double>((i * 37) % 50));
+		}
+		openList.updateCosts(GridNode::get(9, 4), -1.0);
+		EXPECT_EQ(openList.removeMin(), GridNode::get(9, 4));
+		for (int expected = 0; expected < 50; ++expected) {
+			if (expected == (49 * 37) % 50) {
+				continue;
+			}
+			const GridNode * const node = static_cast<const GridNode *>(openList.removeMin());
+			EXPECT_EQ((node->y * 10 + node->x) * 37 % 50, expected);
+		}
+		EXPECT_TRUE(openList.isEmpty());
+	}
+	EXPECT_THROW(OpenList(OpenList::INDEXED_HEAP, 1), std::invalid_argument);
+
+	// the radix heap is monotone and rounds the costs to its fixed-point resolution
+	OpenList radixHeap(map, OpenList::RADIX_HEAP);
+	radixHeap.enqueue(GridNode::get(0, 0), 5.0);
+	radixHeap.enqueue(GridNode::get(1, 0), 5.0 + 0.4 / OpenList::RADIX_SCALE);
+	radixHeap.enqueue(GridNode::get(2, 0), 7.25);
+	EXPECT_NEAR(radixHeap.getMinCosts(), 5.0, 1.0 / OpenList::RADIX_SCALE);
+	// both costs have the same key, so they are removed in any order
+	const AbstractNode * const first = radixHeap.removeMin();
+	const AbstractNode * const second = radixHeap.removeMin();
+	EXPECT_TRUE((first == GridNode::get(0, 0) && second == GridNode::get(1, 0)) || (first == GridNode::get(1, 0) && second == GridNode::get(0, 0)));
+	// costs below the last removed minimum are raised to it
+	radixHeap.enqueue(GridNode::get(3, 0), 1.0);
+	EXPECT_EQ(radixHeap.removeMin(), GridNode::get(3, 0));
+	EXPECT_EQ(radixHeap.removeMin(), GridNode::get(2, 0));
+	EXPECT_TRUE(radixHeap.isEmpty());
+	EXPECT_THROW(radixHeap.enqueue(GridNode::get(4, 0), -1.0), std::invalid_argument);
+}
+TEST(PathPlanning, gridMap) {
+	const size_t width = 19, height = 13;
+	std::vector<bool> data(width * height);
+	unsigned int seed = 7;
+	for (size_t i = 0; i < data.size(); ++i) {
+		seed = seed * 1103515245u + 12345u;
+		data[i] = ((seed >> 16) % 3) == 0;
+	}
+	GridMap map(width, height, data);
+
+	for (int y = 0; y < static_cast<int>(height); ++y) {
+		for (int x = 0; x < static_cast<int>(width); ++x) {
+			ASSERT_EQ(map.isOccupied(x, y), data[y * width + x]) << "(" << x << ", " << y << ")";
+			unsigned int expected = 0;
+			for (int i = 0; i < 8; ++i) {
+				const int nx = x + GridMap::NEIGHBOR_DX[i];
+				const int ny = y + GridMap::NEIGHBOR_DY[i];
+				if (nx >= 0 && ny >= 0 && nx < static_cast<int>(width) && ny < static_cast<int>(height) && !data[ny * width + nx]) {
+					expected |= 1u << i;
+				}
+			}
+			ASSERT_EQ(map.getFreeNeighbors(x, y), expected) << "(" << x << ", " << y << ")";
+		}
+	}
+	EXPECT_THROW(map.isOccupied(0, static_cast<int>(height)), std::out_of_range);
+	EXPECT_THROW(map.isOccupied(static_cast<int>(width), 0), std::out_of_range);
+	EXPECT_THROW(map.isOccupied(-1, 0), std::out_of_range);
+	EXPECT_THROW(map.getFreeNeighbors(0, -1), std::out_of_range);
+	EXPECT_THROW(GridMap(10, 10, std::vector<bool>(99)), std::invalid_argument);
+}
+
+TEST(PathPlanning, loadMap) {
+	const size_t width = 29, height = 19;
+	std::vector<bool> data(width * height);
+	unsigned int seed = 11;
+	for (size_t i = 0; i < data.size(); ++i) {
+		seed = seed * 1103515245u + 12345u;
+		data[i] = ((seed >> 16) % 3) == 0;
+	}
+	const std::string dir = std::string(PROJECT_SOURCE_DIR) + "/data/";
+	std::vector<std::string> filenames;
+
+	// plain PBM with a comment, rows of different lengths and whitespace between some cells
+	filenames.push_back(dir + "test-map-plain.pbm");
+	std::ofstream ofs(filenames.back().c_str());
+	ofs << "P1\n# comment\n" << width << " " << height << "\n";
+	for (size_t i = 0; i < data.size(); ++i) {
+		ofs << (data[i] ? '1' : '0') << (i % 23 == 22 ? "\n" : (i % 31 == 5 ? " " : ""));
+	}
+	ofs.close();
+
+	// raw PBM, whose rows are padded to full bytes
+	filenames.push_back(dir + "test-map-raw.pbm");
+	ofs.open(filenames.back().c_str(), std::ios::binary);
+	ofs << "P4\n" << width << " " << height << "\n";
+	for (size_t y = 0; y < height; ++y) {
+		for (size_t x = 0; x < width; x += 8) {
+			unsigned char byte = 0;
+			for (size_t i = 0; i < 8; ++i) {
+				// set the padding bits as well, they have to be ignored
+				if (x + i >= width || data[y * width + x + i]) {
+					byte |= static_cast<unsigned char>(0x80u >> i);
+				}
+			}
+			ofs.put(static_cast<char>(byte));
+		}
+	}
+	ofs.close();
+
+	// raw PGMs with 8 bits and with a smaller maximum value
+	const size_t maxValues[2] = { 255, 15 };
+	for (int m = 0; m < 2; ++m) {
+		std::ostringstream filename;
+		filename << dir << "test-map-" << maxValues[m] << ".pgm";
+		filenames.push_back(filename.str());
+		ofs.open(filenames.back().c_str(), std::ios::binary);
+		ofs << "P5 " << width << " " << height << " " << maxValues[m] << "\n";
+		for (size_t i = 0; i < data.size(); ++i) {
+			seed = seed * 1103515245u + 12345u;
+			const size_t half = (maxValues[m] + 1) / 2;
+			ofs.put(static_cast<char>(data[i] ? (seed >> 16) % half : half + (seed >> 16) % half));
+		}
+		ofs.close();
+	}
+
+	GridMap map(width, height, data);
+	filenames.push_back(dir + "test-map.bin");
+	ASSERT_TRUE(FileIO::saveBinaryMap(filenames.back(), map));
+
+	for (size_t f = 0; f < filenames.size(); ++f) {
+		const GridMap * const loaded = FileIO::loadMap(filenames[f]);
+		ASSERT_TRUE(loaded != NULL) << filenames[f];
+		ASSERT_EQ(loaded->width, width);
+		ASSERT_EQ(loaded->height, height);
+		EXPECT_EQ(loaded->getTiles(), map.getTiles()) << filenames[f];
+		delete loaded;
+	}
+
+	// truncated files and other formats are rejected
+	const std::string truncated = dir + "test-map-truncated.pbm";
+	std::ifstream ifs(filenames[1].c_str(), std::ios::binary);
+	std::string contents((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+	ifs.close();
+	ofs.open(truncated.c_str(), std::ios::binary);
+	ofs << contents.substr(0, contents.size() - 1);
+	ofs.close();
+	EXPECT_TRUE(FileIO::loadMap(truncated) == NULL);
+	ofs.open(truncated.c_str(), std::ios::binary);
+	ofs << "P2\n2 2\n1\n0 1 1 0\n";
+	ofs.close();
+	EXPECT_TRUE(FileIO::loadMap(truncated) == NULL);
+	std::remove(truncated.c_str());
+	for (size_t f = 0; f < filenames.size(); ++f) {
+		std::remove(filenames[f].c_str());
+	}
+	EXPECT_TRUE(FileIO::loadMap(dir + "does-not-exist.pbm") == NULL);
+
+	// the map of the exercise is larger than the former limit of 100 x 100 cells when scaled
+	const GridMap * const original = FileIO::loadMap(dir + "map.pbm");
+	ASSERT_TRUE(original != NULL);
+	const size_t factor = 15;
+	std::vector<bool> scaled(original->width * factor * original->height * factor);
+	for (size_t y = 0; y < original->height * factor; ++y) {
+		for (size_t x = 0; x < original->width * factor; ++x) {
+			scaled[y * original->width * factor + x] = original->isOccupied(x / factor, y / factor);
+		}
+	}
+	const std::string large = dir + "test-map-large.pbm";
+	ofs.open(large.c_str());
+	ofs << "P1\n" << original->width * factor << " " << original->height * factor << "\n";
+	for (size_t i = 0; i < scaled.size(); ++i) {
+		ofs << (scaled[i] ? '1' : '0');
+	}
+	ofs.close();
+	const GridMap * const loaded = FileIO::loadMap(large);
+	std::remove(large.c_str());
+	ASSERT_TRUE(loaded != NULL);
+	EXPECT_EQ(loaded->getTiles(), GridMap(original->width * factor, original->height * factor, scaled).getTiles());
+	delete loaded;
+	delete original;
+}
+
+double pathLength(const std::deque<const AbstractNode*>& path, const GridMap& map) {
+	double length = 0.0;
+	for (size_t i = 0; i < path.size(); ++i) {
+		const GridNode * const node = static_cast<const GridNode*>(path[i]);
+		EXPECT_FALSE(map.isOccupied(node->x, node->y)) << "The path leads through an occupied cell.";
+		if (i > 0) {
+			const GridNode * const last = static_cast<const GridNode*>(path[i - 1]);
+			const int dx = abs(node->x - last->x);
+			const int dy = abs(node->y - last->y);
+			EXPECT_TRUE(dx <= 1 && dy <= 1 && dx + dy > 0) << "The path is not connected.";
+			length += sqrt(static_cast<double>(dx * dx + dy * dy));
+		}
+	}
+	return length;
+}
+
+TEST(PathPlanning, closedList) {
+	GridMap map(6, 4, std::vector<bool>(24, false));
+	OpenList::map = &map;
+	GridNodeArena arena(map);
+	ClosedList gridList(map);
+	ClosedList setList;
+	ClosedList * const lists[2] = { &gridList, &setList };
+	for (int l = 0; l < 2; ++l) {
+		ClosedList& list = *lists[l];
+		for (int round = 0; round < 3; ++round) {
+			for (int y = 0; y < 4; ++y) {
+				for (int x = 0; x < 6; ++x) {
+					EXPECT_FALSE(list.contains(arena.get(x, y)));
+				}
+			}
+			for (int x = round; x < 6; x += 2) {
+				list.add(arena.get(x, 3));
+			}
+			for (int x = 0; x < 6; ++x) {
+				EXPECT_EQ(list.contains(arena.get(x, 3)), x >= round && (x - round) % 2 == 0);
+				EXPECT_FALSE(list.contains(arena.get(x, 2)));
+			}
+			list.clear();
+		}
+		EXPECT_THROW(list.add(NULL), std::invalid_argument);
+		EXPECT_THROW(list.contains(NULL), std::invalid_argument);
+	}
+	GridMap other(7, 4, std::vector<bool>(28, false));
+	GridNodeArena otherArena(other);
+	EXPECT_THROW(gridList.contains(otherArena.get(6, 0)), std::invalid_argument);
+}
+
+TEST(PathPlanning, jumpPointPlanning) {
+	const size_t width = 40, height = 30;
+	const int densities[3] = { 10, 25, 40 };
+	unsigned int seed = 3;
+	size_t expansionsAStar = 0, expansionsJPS = 0;
+	for (int d = 0; d < 3; ++d) {
+		std::vector<bool> data(width * height);
+		for (size_t i = 0; i < data.size(); ++i) {
+			seed = seed * 1103515245u + 12345u;
+			data[i] = static_cast<int>((seed >> 16) % 100) < densities[d];
+		}
+		GridMap map(width, height, data);
+		OpenList::map = &map;
+		StraightLineDistanceHeuristic heuristic;
+		GridNodeArena arenaAStar(map), arenaJPS(map), arenaJPSPlus(map);
+		JumpPointTable table(map);
+		GridPathPlanning aStar(map, heuristic, arenaAStar);
+		JumpPointPlanning jps(map, heuristic, arenaJPS);
+		JumpPointPlanning jpsPlus(map, heuristic, arenaJPSPlus, &table);
+
+		for (int q = 0; q < 20; ++q) {
+			int coords[4];
+			for (int c = 0; c < 4; ++c) {
+				do {
+					seed = seed * 1103515245u + 12345u;
+					coords[c] = static_cast<int>((seed >> 16) % (c % 2 == 0 ? width : height));
+				} while (c % 2 == 1 && map.isOccupied(coords[c - 1], coords[c]));
+			}
+			std::deque<const AbstractNode*> expected = aStar.planPath(arenaAStar.get(coords[0], coords[1]), arenaAStar.get(coords[2], coords[3]));
+			std::deque<const AbstractNode*> path = jps.planPath(arenaJPS.get(coords[0], coords[1]), arenaJPS.get(coords[2], coords[3]));
+			std::deque<const AbstractNode*> pathPlus = jpsPlus.planPath(arenaJPSPlus.get(coords[0], coords[1]), arenaJPSPlus.get(coords[2], coords[3]));
+			ASSERT_EQ(path.empty(), expected.empty());
+			ASSERT_EQ(pathPlus.empty(), expected.empty());
+			if (expected.empty()) {
+				continue;
+			}
+			EXPECT_EQ(path.front(), arenaJPS.get(coords[0], coords[1]));
+			EXPECT_EQ(path.back(), arenaJPS.get(coords[2], coords[3]));
+			const double length = pathLength(expected, map);
+			EXPECT_NEAR(pathLength(path, map), length, 1e-9);
+			EXPECT_NEAR(pathLength(pathPlus, map), length, 1e-9);
+			EXPECT_EQ(jpsPlus.getNumExpansions(), jps.getNumExpansions());
+			expansionsAStar += aStar.getNumExpansions();
+			expansionsJPS += jps.getNumExpansions();
+		}
+	}
+	EXPECT_LT(expansionsJPS, expansionsAStar);
+}
+
+TEST(PathPlanning, batchPlanning) {
+	const size_t width = 40, height = 30;
+	unsigned int seed = 11;
+	std::vector<bool> data(width * height);
+	for (size_t i = 0; i < data.size(); ++i) {
+		seed = seed * 1103515245u + 12345u;
+		data[i] = ((seed >> 16) % 100) < 25;
+	}
+	GridMap map(width, height, data);
+	StraightLineDistanceHeuristic heuristic;
+
+	std::vector<BatchPlanning::Query> queries;
+	for (int q = 0; q < 60; ++q) {
+		int coords[4];
+		for (int c = 0; c < 4; ++c) {
+			seed = seed * 1103515245u + 12345u;
+			coords[c] = static_cast<int>((seed >> 16) % (c % 2 == 0 ? width : height));
+		}
+		queries.push_back(BatchPlanning::Query(coords[0], coords[1], coords[2], coords[3]));
+	}
+
+	GridNodeArena arena(map);
+	GridPathPlanning serial(map, heuristic, arena);
+	BatchPlanning batch(heuristic, 4);
+	BatchPlanning single(heuristic, 1);
+	EXPECT_EQ(batch.getNumThreads(), 4u);
+	const std::vector<BatchPlanning::Result> results = batch.planBatch(map, queries);
+	const std::vector<BatchPlanning::Result> singleResults = single.planBatch(map, queries);
+	ASSERT_EQ(results.size(), queries.size());
+	ASSERT_EQ(singleResults.size(), queries.size());
+	for (size_t q = 0; q < queries.size(); ++q) {
+		const BatchPlanning::Query& query = queries[q];
+		const std::deque<const AbstractNode*> expected = serial.planPath(arena.get(query.startX, query.startY), arena.get(query.goalX, query.goalY));
+		ASSERT_EQ(results[q].path.size(), expected.size()) << "query " << q;
+		for (size_t i = 0; i < expected.size(); ++i) {
+			const GridNode * const node = static_cast<const GridNode *>(expected[i]);
+			EXPECT_EQ(results[q].path[i], std::make_pair(node->x, node->y));
+		}
+		EXPECT_DOUBLE_EQ(results[q].costs, expected.empty() ? 0.0 : expected.back()->costs);
+		EXPECT_EQ(results[q].expansions, serial.getNumExpansions());
+		EXPECT_EQ(singleResults[q].path, results[q].path);
+		EXPECT_EQ(singleResults[q].expansions, results[q].expansions);
+	}
+
+	// the pool is reused for further batches, also on maps of a different size
+	GridMap small(5, 5, std::vector<bool>(25, false));
+	const std::vector<BatchPlanning::Result> smallResults = batch.planBatch(small, std::vector<BatchPlanning::Query>(3, BatchPlanning::Query(0, 0, 4, 4)));
+	ASSERT_EQ(smallResults.size(), 3u);
+	EXPECT_EQ(smallResults[2].path.size(), 5u);
+	EXPECT_NEAR(smallResults[2].costs, 4.0 * sqrt(2.0), 1e-9);
+	EXPECT_TRUE(batch.planBatch(small, std::vector<BatchPlanning::Query>()).empty());
+	EXPECT_THROW(batch.planBatch(small, std::vector<BatchPlanning::Query>(1, BatchPlanning::Query(0, 0, 5, 4))), std::out_of_range);
+
+	// only the workers share the map, a planner copies it and can be constructed from a temporary
+	GridNodeArena smallArena(small);
+	GridPathPlanning copying(GridMap(5, 5, std::vector<bool>(25, false)), heuristic, smallArena);
+	copying.setLogging(false);
+	EXPECT_EQ(copying.planPath(smallArena.get(0, 0), smallArena.get(4, 4)).size(), 5u);
+}
+
+TEST(PathPlanning, traceLogger) {
+	const size_t width = 30, height = 20;
+	unsigned int seed = 5;
+	std::vector<bool> data(width * height);
+	for (size_t i = 0; i < data.size(); ++i) {
+		seed = seed * 1103515245u + 12345u;
+		data[i] = ((seed >> 16) % 100) < 20;
+	}
+	data[0] = data[width * height - 1] = false;
+	GridMap map(width, height, data);
+	StraightLineDistanceHeuristic heuristic;
+	GridNodeArena arena(map);
+	GridPathPlanning planner(map, heuristic, arena);
+
+	const std::string dir = std::string(PROJECT_SOURCE_DIR) + "/data/";
+	const std::string textLog = dir + "test-trace.txt";
+	const std::string traceFile = dir + "test-trace.bin";
+	const std::string convertedLog = dir + "test-trace-converted.txt";
+
+	{
+		FileIO fileIO;
+		ASSERT_TRUE(fileIO.openLogfile(textLog));
+		OpenList::fileIO = &fileIO;
+		ClosedList::fileIO = &fileIO;
+		planner.planPath(arena.get(0, 0), arena.get(width - 1, height - 1));
+		OpenList::fileIO = NULL;
+		ClosedList::fileIO = NULL;
+	}
+
+	// a tiny ring buffer makes the logging thread wait for the writer
+	TraceLogger logger(16);
+	ASSERT_TRUE(logger.open(traceFile, map));
+	OpenList::traceLogger = &logger;
+	ClosedList::traceLogger = &logger;
+	planner.planPath(arena.get(0, 0), arena.get(width - 1, height - 1));
+	OpenList::traceLogger = NULL;
+	ClosedList::traceLogger = NULL;
+	const uint64_t numRecords = logger.getNumRecords();
+	logger.close();
+	EXPECT_FALSE(logger.isOpen());
+
+	size_t traceWidth, traceHeight;
+	std::vector<TraceLogger::Record> records;
+	ASSERT_TRUE(TraceLogger::readTrace(traceFile, traceWidth, traceHeight, records));
+	EXPECT_EQ(traceWidth, width);
+	EXPECT_EQ(traceHeight, height);
+	ASSERT_EQ(records.size(), numRecords);
+	ASSERT_FALSE(records.empty());
+	EXPECT_EQ(records.front().cell, 0u);
+	EXPECT_EQ(records.front().event, static_cast<uint32_t>(TraceLogger::OPEN));
+	EXPECT_FLOAT_EQ(records.front().g, 0.f);
+	EXPECT_EQ(records.back().cell, width * height - 1);
+	EXPECT_EQ(records.back().event, static_cast<uint32_t>(TraceLogger::CLOSE));
+	for (size_t i = 1; i < records.size(); ++i) {
+		EXPECT_LE(records[i - 1].timestamp, records[i].timestamp);
+		if (records[i].event == TraceLogger::OPEN) {
+			EXPECT_GE(records[i].f, records[i].g);
+		}
+	}
+
+	ASSERT_TRUE(TraceLogger::convertToText(traceFile, convertedLog));
+	std::ifstream expected(textLog.c_str()), converted(convertedLog.c_str());
+	std::stringstream expectedText, convertedText;
+	expectedText << expected.rdbuf();
+	convertedText << converted.rdbuf();
+	EXPECT_FALSE(expectedText.str().empty());
+	EXPECT_EQ(convertedText.str(), expectedText.str());
+	EXPECT_FALSE(TraceLogger::convertToText(textLog, convertedLog));
+
+	std::remove(textLog.c_str());
+	std::remove(traceFile.c_str());
+	std::remove(convertedLog.c_str());
+}
+
+TEST(PathPlanning, bidirectionalSearch) {
+	const size_t width = 40, height = 30;
+	const int densities[3] = { 0, 20, 35 };
+	unsigned int seed = 17;
+	for (int d = 0; d < 3; ++d) {
+		std::vector<bool> data(width * height);
+		for (size_t i = 0; i < data.size(); ++i) {
+			seed = seed * 1103515245u + 12345u;
+			data[i] = static_cast<int>((seed >> 16) % 100) < densities[d];
+		}
+		GridMap map(width, height, data);
+		OpenList::map = &map;
+		StraightLineDistanceHeuristic heuristic;
+		GridNodeArena arena(map), bidirectionalArena(map);
+		GridPathPlanning aStar(map, heuristic, arena);
+		GridPathPlanning bidirectional(map, heuristic, bidirectionalArena);
+		bidirectional.setBidirectional(true);
+		EXPECT_FALSE(aStar.isBidirectional());
+		EXPECT_TRUE(bidirectional.isBidirectional());
+
+		for (int q = 0; q < 25; ++q) {
+			int coords[4];
+			for (int c = 0; c < 4; c += 2) {
+				do {
+					seed = seed * 1103515245u + 12345u;
+					coords[c] = static_cast<int>((seed >> 16) % width);
+					seed = seed * 1103515245u + 12345u;
+					coords[c + 1] = static_cast<int>((seed >> 16) % height);
+				} while (map.isOccupied(coords[c], coords[c + 1]));
+			}
+			if (q == 0) {
+				coords[2] = coords[0];
+				coords[3] = coords[1];
+			}
+			const std::deque<const AbstractNode*> expected = aStar.planPath(arena.get(coords[0], coords[1]), arena.get(coords[2], coords[3]));
+			const std::deque<const AbstractNode*> path = bidirectional.planPath(bidirectionalArena.get(coords[0], coords[1]), bidirectionalArena.get(coords[2], coords[3]));
+			ASSERT_EQ(path.empty(), expected.empty()) << "density " << densities[d] << ", query " << q;
+			if (expected.empty()) {
+				continue;
+			}
+			EXPECT_EQ(path.front(), bidirectionalArena.get(coords[0], coords[1]));
+			EXPECT_EQ(path.back(), bidirectionalArena.get(coords[2], coords[3]));
+			const double length = pathLength(expected, map);
+			EXPECT_NEAR(pathLength(path, map), length, 1e-9);
+			EXPECT_NEAR(path.back()->costs, length, 1e-9);
+			EXPECT_EQ(bidirectional.followPath(path.back()), path);
+			EXPECT_GE(aStar.getPeakOpenListSize(), 1u);
+			EXPECT_LE(aStar.getPeakOpenListSize(), width * height);
+			EXPECT_GE(bidirectional.getPeakOpenListSize(), 2u);
+			EXPECT_LE(bidirectional.getPeakOpenListSize(), 2 * width * height);
+			if (q == 0) {
+				EXPECT_EQ(path.size(), 1u);
+			}
+		}
+	}
+
+	GridMap map(6, 4, std::vector<bool>(24, false));
+	StraightLineDistanceHeuristic heuristic;
+	GridNodeArena arena(map);
+	JumpPointPlanning jps(map, heuristic, arena);
+	jps.setBidirectional(true);
+	EXPECT_THROW(jps.planPath(arena.get(0, 0), arena.get(5, 3)), std::runtime_error);
+}
+
+/**
+ * @brief Checks that a path of a HierarchicalPlanning result is connected, free and has the given costs.
+ */
+void checkHierarchicalPath(const HierarchicalPlanning::Result& result, const GridMap& map) {
+	double costs = 0.0;
+	for (size_t i = 0; i < result.path.size(); ++i) {
+		EXPECT_FALSE(map.isOccupied(result.path[i].first, result.path[i].second)) << "The path leads through an occupied cell.";
+		if (i > 0) {
+			const int dx = abs(result.path[i].first - result.path[i - 1].first);
+			const int dy = abs(result.path[i].second - result.path[i - 1].second);
+			EXPECT_TRUE(dx <= 1 && dy <= 1 && dx + dy > 0) << "The path is not connected.";
+			costs += sqrt(static_cast<double>(dx * dx + dy * dy));
+		}
+	}
+	EXPECT_NEAR(result.costs, costs, 1e-9);
+}
+
+TEST(PathPlanning, hierarchicalPlanning) {
+	const size_t width = 70, height = 50;
+	const int densities[3] = { 0, 20, 35 };
+	unsigned int seed = 19;
+	for (int d = 0; d < 3; ++d) {
+		std::vector<bool> data(width * height);
+		for (size_t i = 0; i < data.size(); ++i) {
+			seed = seed * 1103515245u + 12345u;
+			data[i] = static_cast<int>((seed >> 16) % 100) < densities[d];
+		}
+		GridMap map(width, height, data);
+		OpenList::map = &map;
+		StraightLineDistanceHeuristic heuristic;
+		GridNodeArena arena(map);
+		GridPathPlanning aStar(map, heuristic, arena);
+		HierarchicalPlanning hpa(map, 8);
+		hpa.update();
+		EXPECT_EQ(hpa.getNumClusterUpdates(), 9u * 7u);
+		EXPECT_GT(hpa.getNumAbstractNodes(), 0u);
+
+		for (int q = 0; q < 60; ++q) {
+			int coords[4];
+			for (int c = 0; c < 4; c += 2) {
+				do {
+					seed = seed * 1103515245u + 12345u;
+					coords[c] = static_cast<int>((seed >> 16) % width);
+					seed = seed * 1103515245u + 12345u;
+					coords[c + 1] = static_cast<int>((seed >> 16) % height);
+				} while (map.isOccupied(coords[c], coords[c + 1]));
+			}
+			if (q % 20 == 19) {
+				// change some cells between the queries
+				for (int i = 0; i < 20; ++i) {
+					seed = seed * 1103515245u + 12345u;
+					const int x = static_cast<int>((seed >> 16) % width);
+					seed = seed * 1103515245u + 12345u;
+					const int y = static_cast<int>((seed >> 16) % height);
+					if ((x != coords[0] || y != coords[1]) && (x != coords[2] || y != coords[3])) {
+						map.setOccupied(x, y, !map.isOccupied(x, y));
+						hpa.invalidateCell(x, y);
+					}
+				}
+			}
+			const std::deque<const AbstractNode*> expected = aStar.planPath(arena.get(coords[0], coords[1]), arena.get(coords[2], coords[3]));
+			const HierarchicalPlanning::Result result = hpa.planPath(coords[0], coords[1], coords[2], coords[3]);
+			ASSERT_EQ(result.path.empty(), expected.empty()) << "density " << densities[d] << ", query " << q;
+			if (expected.empty()) {
+				continue;
+			}
+			EXPECT_EQ(result.path.front(), std::make_pair(coords[0], coords[1]));
+			EXPECT_EQ(result.path.back(), std::make_pair(coords[2], coords[3]));
+			checkHierarchicalPath(result, map);
+			const double optimalCosts = expected.back()->costs;
+			EXPECT_GE(result.costs, optimalCosts - 1e-9);
+			EXPECT_LE(result.lowerBound, optimalCosts + 1e-9);
+			EXPECT_GE(result.getSuboptimalityBound() + 1e-9, result.costs / std::max(optimalCosts, 1.0));
+			EXPECT_LE(result.abstractExpansions, result.expansions);
+		}
+	}
+
+	// only the clusters next to a changed cell are recomputed
+	GridMap map(64, 64, std::vector<bool>(64 * 64, false));
+	HierarchicalPlanning hpa(map, 16);
+	EXPECT_EQ(hpa.planPath(0, 0, 63, 63).path.size(), 64u);
+	const size_t numUpdates = hpa.getNumClusterUpdates();
+	EXPECT_EQ(numUpdates, 16u);
+	map.setOccupied(20, 20, true);
+	hpa.invalidateCell(20, 20);
+	hpa.update();
+	EXPECT_EQ(hpa.getNumClusterUpdates(), numUpdates + 1);
+	// a cell on a border changes the transitions of both clusters
+	map.setOccupied(15, 40, true);
+	hpa.invalidateCell(15, 40);
+	hpa.update();
+	EXPECT_EQ(hpa.getNumClusterUpdates(), numUpdates + 3);
+	for (int y = 0; y < 64; ++y) {
+		map.setOccupied(31, y, true);
+		hpa.invalidateCell(31, y);
+	}
+	EXPECT_TRUE(hpa.planPath(0, 0, 63, 63).path.empty());
+	EXPECT_FALSE(hpa.planPath(0, 0, 30, 63).path.empty());
+
+	EXPECT_THROW(hpa.planPath(0, 0, 64, 0), std::out_of_range);
+	EXPECT_THROW(hpa.invalidateCell(-1, 0), std::out_of_range);
+	EXPECT_THROW(HierarchicalPlanning(map, 1), std::invalid_argument);
+}
+
+TEST(PathPlanning, landmarkHeuristic) {
+	// walls with alternating gaps at the top and the bottom, and some random obstacles
+	const size_t width = 60, height = 40;
+	unsigned int seed = 23;
+	std::vector<bool> data(width * height);
+	for (size_t y = 0; y < height; ++y) {
+		for (size_t x = 0; x < width; ++x) {
+			seed = seed * 1103515245u + 12345u;
+			const bool wall = x % 10 == 5 && ((x / 10) % 2 == 0 ? y < height - 3 : y > 2);
+			data[y * width + x] = wall || ((seed >> 16) % 100) < 10;
+		}
+	}
+	GridMap map(width, height, data);
+	OpenList::map = &map;
+	GridNodeArena arena(map);
+	StraightLineDistanceHeuristic straightLine;
+	LandmarkHeuristic landmarks(map);
+	EXPECT_TRUE(landmarks.getLandmarks().empty());
+	EXPECT_DOUBLE_EQ(landmarks.heuristic(arena.get(0, 0), arena.get(3, 4)), 5.0);
+	landmarks.compute(8, 3);
+	ASSERT_EQ(landmarks.getLandmarks().size(), 8u);
+	EXPECT_EQ(landmarks.getMemoryUsage(), (width * height * 8 + 8) * sizeof(uint16_t));
+	for (size_t i = 0; i < landmarks.getLandmarks().size(); ++i) {
+		EXPECT_EQ(landmarks.getDistance(i, landmarks.getLandmarks()[i].first, landmarks.getLandmarks()[i].second), 0.0);
+	}
+
+	GridPathPlanning aStar(map, straightLine, arena);
+	aStar.setLogging(false);
+	GridPathPlanning alt(map, landmarks, arena);
+	alt.setLogging(false);
+	size_t straightLineExpansions = 0, landmarkExpansions = 0;
+	for (int q = 0; q < 40; ++q) {
+		int coords[4];
+		for (int c = 0; c < 4; c += 2) {
+			do {
+				seed = seed * 1103515245u + 12345u;
+				coords[c] = static_cast<int>((seed >> 16) % width);
+				seed = seed * 1103515245u + 12345u;
+				coords[c + 1] = static_cast<int>((seed >> 16) % height);
+			} while (map.isOccupied(coords[c], coords[c + 1]));
+		}
+		const std::deque<const AbstractNode*> expected = aStar.planPath(arena.get(coords[0], coords[1]), arena.get(coords[2], coords[3]));
+		straightLineExpansions += aStar.getNumExpansions();
+		const double expectedCosts = expected.empty() ? -1.0 : expected.back()->costs;
+		const std::deque<const AbstractNode*> path = alt.planPath(arena.get(coords[0], coords[1]), arena.get(coords[2], coords[3]));
+		landmarkExpansions += alt.getNumExpansions();
+		ASSERT_EQ(path.empty(), expected.empty());
+		if (path.empty()) {
+			continue;
+		}
+		EXPECT_NEAR(path.back()->costs, expectedCosts, 1e-9);
+		// the heuristic never overestimates the remaining costs along the optimal path
+		for (size_t i = 0; i < path.size(); ++i) {
+			EXPECT_LE(landmarks.heuristic(path[i], path.back()), path.back()->costs - path[i]->costs + 1e-9);
+		}
+	}
+	EXPECT_LT(landmarkExpansions, straightLineExpansions);
+
+	// consistency for one goal
+	const GridNode * const goal = arena.get(landmarks.getLandmarks()[0].first, landmarks.getLandmarks()[0].second);
+	for (size_t y = 0; y < height; ++y) {
+		for (size_t x = 0; x < width; ++x) {
+			if (map.isOccupied(x, y)) {
+				continue;
+			}
+			const unsigned int neighbors = map.getFreeNeighbors(x, y);
+			for (int i = 0; i < 8; ++i) {
+				if (neighbors & (1u << i)) {
+					const double costs = sqrt(static_cast<double>(GridMap::NEIGHBOR_DX[i] * GridMap::NEIGHBOR_DX[i] + GridMap::NEIGHBOR_DY[i] * GridMap::NEIGHBOR_DY[i]));
+					EXPECT_LE(landmarks.heuristic(arena.get(x, y), goal),
+							costs + landmarks.heuristic(arena.get(x + GridMap::NEIGHBOR_DX[i], y + GridMap::NEIGHBOR_DY[i]), goal) + 1e-9);
+				}
+			}
+		}
+	}
+
+	// the table can be saved and loaded, but only for the same map
+	const std::string filename = std::string(PROJECT_SOURCE_DIR) + "/data/test-landmarks.bin";
+	ASSERT_TRUE(landmarks.save(filename));
+	LandmarkHeuristic loaded(map);
+	ASSERT_TRUE(loaded.load(filename));
+	EXPECT_EQ(loaded.getLandmarks(), landmarks.getLandmarks());
+	for (int i = 0; i < 100; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		const GridNode * const a = arena.get((seed >> 16) % width, (seed >> 8) % height);
+		seed = seed * 1103515245u + 12345u;
+		const GridNode * const b = arena.get((seed >> 16) % width, (seed >> 8) % height);
+		EXPECT_EQ(loaded.heuristic(a, b), landmarks.heuristic(a, b));
+	}
+	GridMap changedMap(width, height, data);
+	changedMap.setOccupied(0, 0, !changedMap.isOccupied(0, 0));
+	LandmarkHeuristic other(changedMap);
+	EXPECT_FALSE(other.load(filename));
+	EXPECT_TRUE(other.getLandmarks().empty());
+	EXPECT_FALSE(other.load(filename + ".missing"));
+	std::remove(filename.c_str());
+
+	std::vector<std::pair<int, int> > given;
+	EXPECT_THROW(landmarks.compute(given), std::invalid_argument);
+	given.push_back(std::make_pair(5, 0));
+	EXPECT_THROW(landmarks.compute(given), std::invalid_argument);
+	given[0] = std::make_pair(-1, 0);
+	EXPECT_THROW(landmarks.compute(given), std::out_of_range);
+	EXPECT_THROW(landmarks.compute(0), std::invalid_argument);
+	EXPECT_THROW(landmarks.compute(width * height), std::invalid_argument);
+	EXPECT_THROW(landmarks.getDistance(8, 0, 0), std::out_of_range);
+}
+
+TEST(PathPlanning, incrementalPlanning) {
+	const size_t width = 50, height = 40;
+	unsigned int seed = 29;
+	std::vector<bool> data(width * height);
+	for (size_t i = 0; i < data.size(); ++i) {
+		seed = seed * 1103515245u + 12345u;
+		data[i] = ((seed >> 16) % 100) < 25;
+	}
+	data[0] = data[width * height - 1] = false;
+	GridMap map(width, height, data);
+	GridNodeArena arena(map);
+	StraightLineDistanceHeuristic heuristic;
+	GridPathPlanning aStar(map, heuristic, arena);
+	aStar.setLogging(false);
+
+	IncrementalPlanning planner(map, 0, 0, width - 1, height - 1);
+	IncrementalPlanning::Result result = planner.planPath();
+	const size_t initialExpansions = result.expansions;
+	EXPECT_GT(initialExpansions, 0u);
+	EXPECT_EQ(planner.getTotalExpansions(), initialExpansions);
+	// nothing to repair
+	EXPECT_EQ(planner.planPath().expansions, 0u);
+
+	int startX = 0, startY = 0;
+	for (int round = 0; round < 30; ++round) {
+		const std::deque<const AbstractNode*> expected = aStar.planPath(arena.get(startX, startY), arena.get(width - 1, height - 1));
+		ASSERT_EQ(result.path.empty(), expected.empty()) << "round " << round;
+		if (!expected.empty()) {
+			EXPECT_NEAR(result.costs, expected.back()->costs, 1e-9) << "round " << round;
+			EXPECT_EQ(result.path.front(), std::make_pair(startX, startY));
+			EXPECT_EQ(result.path.back(), std::make_pair(static_cast<int>(width) - 1, static_cast<int>(height) - 1));
+			for (size_t i = 1; i < result.path.size(); ++i) {
+				EXPECT_FALSE(map.isOccupied(result.path[i].first, result.path[i].second));
+				EXPECT_LE(abs(result.path[i].first - result.path[i - 1].first), 1);
+				EXPECT_LE(abs(result.path[i].second - result.path[i - 1].second), 1);
+			}
+		}
+
+		// move a few steps along the path
+		if (result.path.size() > 4 && round % 3 == 0) {
+			startX = result.path[3].first;
+			startY = result.path[3].second;
+			planner.setStart(startX, startY);
+		}
+
+		// block cells on the path and toggle some random cells
+		std::vector<std::pair<int, int> > changed;
+		for (size_t i = 2; i + 2 < result.path.size() && changed.size() < 3; i += result.path.size() / 3) {
+			changed.push_back(result.path[i]);
+			map.setOccupied(result.path[i].first, result.path[i].second, true);
+		}
+		for (int i = 0; i < 5; ++i) {
+			seed = seed * 1103515245u + 12345u;
+			const int x = static_cast<int>((seed >> 16) % width);
+			seed = seed * 1103515245u + 12345u;
+			const int y = static_cast<int>((seed >> 16) % height);
+			if ((x != startX || y != startY) && (x != static_cast<int>(width) - 1 || y != static_cast<int>(height) - 1)) {
+				map.setOccupied(x, y, !map.isOccupied(x, y));
+				changed.push_back(std::make_pair(x, y));
+			}
+		}
+		planner.updateCells(changed);
+		result = planner.planPath();
+		EXPECT_LT(result.expansions, width * height);
+	}
+	EXPECT_GT(planner.getTotalExpansions(), initialExpansions);
+
+	// a new goal starts from scratch
+	planner.setGoal(startX, startY);
+	EXPECT_EQ(planner.getTotalExpansions(), 0u);
+	result = planner.planPath();
+	ASSERT_EQ(result.path.size(), 1u);
+	EXPECT_EQ(result.costs, 0.0);
+
+	// an occupied start has no path
+	map.setOccupied(startX, startY, true);
+	planner.updateCells(std::vector<std::pair<int, int> >(1, std::make_pair(startX, startY)));
+	EXPECT_TRUE(planner.planPath().path.empty());
+
+	EXPECT_THROW(planner.setStart(-1, 0), std::out_of_range);
+	EXPECT_THROW(planner.setGoal(0, height), std::out_of_range);
+	EXPECT_THROW(planner.updateCells(std::vector<std::pair<int, int> >(1, std::make_pair(width, 0))), std::out_of_range);
+	EXPECT_THROW(IncrementalPlanning(map, 0, 0, width, 0), std::out_of_range);
+}
+
+TEST(PathPlanning, integerCosts) {
+	const size_t width = 60, height = 40;
+	unsigned int seed = 31;
+	const int densities[2] = { 0, 30 };
+	for (int d = 0; d < 2; ++d) {
+		std::vector<bool> data(width * height);
+		for (size_t i = 0; i < data.size(); ++i) {
+			seed = seed * 1103515245u + 12345u;
+			data[i] = static_cast<int>((seed >> 16) % 100) < densities[d];
+		}
+		GridMap map(width, height, data);
+		GridNodeArena arena(map);
+		StraightLineDistanceHeuristic straightLine;
+		OctileDistanceHeuristic octile;
+		OctileDistanceHeuristic fixedPointOctile(true);
+		GridPathPlanning exact(map, straightLine, arena);
+		exact.setLogging(false);
+		GridPathPlanning exactOctile(map, octile, arena);
+		exactOctile.setLogging(false);
+		GridPathPlanning integer(map, fixedPointOctile, arena);
+		integer.setLogging(false);
+		integer.setIntegerCosts(true);
+		EXPECT_TRUE(integer.hasIntegerCosts());
+		GridPathPlanning integerStraightLine(map, straightLine, arena);
+		integerStraightLine.setLogging(false);
+		integerStraightLine.setIntegerCosts(true);
+		JumpPointPlanning integerJps(map, fixedPointOctile, arena);
+		integerJps.setLogging(false);
+		integerJps.setIntegerCosts(true);
+
+		for (int q = 0; q < 30; ++q) {
+			int coords[4];
+			for (int c = 0; c < 4; c += 2) {
+				do {
+					seed = seed * 1103515245u + 12345u;
+					coords[c] = static_cast<int>((seed >> 16) % width);
+					seed = seed * 1103515245u + 12345u;
+					coords[c + 1] = static_cast<int>((seed >> 16) % height);
+				} while (map.isOccupied(coords[c], coords[c + 1]));
+			}
+			const std::deque<const AbstractNode*> expected = exact.planPath(arena.get(coords[0], coords[1]), arena.get(coords[2], coords[3]));
+			const double expectedCosts = expected.empty() ? -1.0 : expected.back()->costs;
+			std::deque<const AbstractNode*> path = exactOctile.planPath(arena.get(coords[0], coords[1]), arena.get(coords[2], coords[3]));
+			ASSERT_EQ(path.empty(), expected.empty());
+			if (expected.empty()) {
+				continue;
+			}
+			EXPECT_NEAR(path.back()->costs, expectedCosts, 1e-9);
+
+			GridPathPlanning * const planners[3] = { &integer, &integerStraightLine, &integerJps };
+			double integerCosts = -1.0;
+			for (int p = 0; p < 3; ++p) {
+				path = planners[p]->planPath(arena.get(coords[0], coords[1]), arena.get(coords[2], coords[3]));
+				ASSERT_FALSE(path.empty());
+				const double costs = path.back()->costs;
+				// the costs are exact multiples of the fixed-point resolution
+				EXPECT_DOUBLE_EQ(costs * OpenList::RADIX_SCALE, floor(costs * OpenList::RADIX_SCALE + 0.5));
+				EXPECT_GE(costs, expectedCosts - 1e-9);
+				EXPECT_LE(costs, expectedCosts * (1.0 + 6e-4));
+				if (p == 0) {
+					integerCosts = costs;
+				} else {
+					EXPECT_DOUBLE_EQ(costs, integerCosts);
+				}
+			}
+		}
+	}
+
+	GridMap map(10, 10, std::vector<bool>(100, false));
+	StraightLineDistanceHeuristic straightLine;
+	GridPathPlanning planner(map, straightLine);
+	planner.setIntegerCosts(true);
+	EXPECT_DOUBLE_EQ(planner.getCosts(GridNode::get(2, 3), GridNode::get(5, 3)), 3.0);
+	EXPECT_DOUBLE_EQ(planner.getCosts(GridNode::get(2, 3), GridNode::get(4, 7)), 2.0 + 2.0 * GridPathPlanning::FIXED_POINT_DIAGONAL / OpenList::RADIX_SCALE);
+	EXPECT_GT(GridPathPlanning::FIXED_POINT_DIAGONAL / static_cast<double>(OpenList::RADIX_SCALE), sqrt(2.0));
+	OctileDistanceHeuristic octile;
+	EXPECT_DOUBLE_EQ(octile.heuristic(GridNode::get(2, 3), GridNode::get(4, 7)), 2.0 + 2.0 * sqrt(2.0));
+}
+
+/**
+ * @brief Grid cells with one of four headings: the robot drives forward or turns on the spot.
+ */
+struct HeadingSpace {
+	struct State {
+		int x, y, heading;
+		State(const int x = 0, const int y = 0, const int heading = 0) : x(x), y(y), heading(heading) {};
+	};
+	const GridMap& map;
+	explicit HeadingSpace(const GridMap& map) : map(map) {};
+	size_t size() const {
+		return map.width * map.height * 4;
+	}
+	size_t index(const State& s) const {
+		return (static_cast<size_t>(s.y) * map.width + s.x) * 4 + s.heading;
+	}
+	State state(const size_t& index) const {
+		return State(static_cast<int>(index / 4 % map.width), static_cast<int>(index / 4 / map.width), static_cast<int>(index % 4));
+	}
+	bool isGoal(const State& s, const State& goal) const {
+		return s.x == goal.x && s.y == goal.y;
+	}
+	template <class Visitor>
+	void forEachSuccessor(const State& s, Visitor& visitor) const {
+		static const int dx[4] = { 1, 0, -1, 0 };
+		static const int dy[4] = { 0, 1, 0, -1 };
+		const int x = s.x + dx[s.heading];
+		const int y = s.y + dy[s.heading];
+		if (map.isInside(x, y) && !map.isOccupied(x, y)) {
+			visitor(State(x, y, s.heading));
+		}
+		visitor(State(s.x, s.y, (s.heading + 1) % 4));
+		visitor(State(s.x, s.y, (s.heading + 3) % 4));
+	}
+};
+
+struct HeadingCosts {
+	double operator()(const HeadingSpace::State& from, const HeadingSpace::State& to) const {
+		return from.heading == to.heading ? 1.0 : 0.5;
+	}
+};
+
+struct HeadingHeuristic {
+	double operator()(const HeadingSpace::State& s, const HeadingSpace::State& goal) const {
+		return std::abs(s.x - goal.x) + std::abs(s.y - goal.y);
+	}
+};
+
+struct ZeroHeuristic {
+	template <class State>
+	double operator()(const State&, const State&) const {
+		return 0.0;
+	}
+};
+
+TEST(PathPlanning, searchKernel) {
+	const size_t width = 40, height = 30;
+	unsigned int seed = 13;
+	std::vector<bool> data(width * height);
+	for (size_t i = 0; i < data.size(); ++i) {
+		seed = seed * 1103515245u + 12345u;
+		data[i] = ((seed >> 16) % 100) < 25;
+	}
+	GridMap map(width, height, data);
+	OpenList::map = &map;
+	StraightLineDistanceHeuristic heuristic;
+	GridNodeArena arena(map), searchArena(map);
+	GridPathPlanning aStar(map, heuristic, arena);
+	GridSearch<> search(map);
+	GridSearch<ManhattanDistancePolicy> manhattanSearch(map);
+	GridSpace space(map);
+	SearchKernel<GridSpace, GridCosts, StraightLineDistancePolicy> weighted(space);
+	HeadingSpace headingSpace(map);
+	SearchKernel<HeadingSpace, HeadingCosts, HeadingHeuristic> heading(headingSpace);
+	SearchKernel<HeadingSpace, HeadingCosts, ZeroHeuristic> dijkstra(headingSpace);
+	size_t expansionsHeading = 0, expansionsDijkstra = 0;
+
+	for (int q = 0; q < 30; ++q) {
+		int coords[4];
+		for (int c = 0; c < 4; c += 2) {
+			do {
+				seed = seed * 1103515245u + 12345u;
+				coords[c] = static_cast<int>((seed >> 16) % width);
+				seed = seed * 1103515245u + 12345u;
+				coords[c + 1] = static_cast<int>((seed >> 16) % height);
+			} while (map.isOccupied(coords[c], coords[c + 1]));
+		}
+		const GridCell start(coords[0], coords[1]), goal(coords[2], coords[3]);
+		const std::deque<const AbstractNode*> expected = aStar.planPath(arena.get(start.x, start.y), arena.get(goal.x, goal.y));
+
+		std::vector<GridCell> cells;
+		const double costs = search.planPath(start, goal, cells);
+		const std::deque<const AbstractNode*> path = search.planPath(searchArena.get(start.x, start.y), searchArena.get(goal.x, goal.y), searchArena);
+		ASSERT_EQ(path.empty(), expected.empty()) << "query " << q;
+		ASSERT_EQ(cells.size(), path.size());
+		EXPECT_EQ(manhattanSearch.planPath(start, goal, cells) < std::numeric_limits<double>::infinity(), !expected.empty());
+		if (expected.empty()) {
+			EXPECT_EQ(costs, std::numeric_limits<double>::infinity());
+			continue;
+		}
+		EXPECT_EQ(path.front(), searchArena.get(start.x, start.y));
+		EXPECT_EQ(path.back(), searchArena.get(goal.x, goal.y));
+		EXPECT_EQ(aStar.followPath(path.back()), path);
+		const double length = pathLength(expected, map);
+		EXPECT_NEAR(costs, length, 1e-9);
+		EXPECT_NEAR(pathLength(path, map), length, 1e-9);
+		EXPECT_NEAR(path.back()->costs, length, 1e-9);
+
+		// weighted A* (as in ARA*) stays within the bound
+		ASSERT_TRUE(weighted.search(start, goal, 2.0));
+		EXPECT_GE(weighted.getPathCosts(), length - 1e-9);
+		EXPECT_LE(weighted.getPathCosts(), 2.0 * length + 1e-9);
+
+		// a state space with headings, where the goal test ignores the heading
+		const HeadingSpace::State headingStart(start.x, start.y, q % 4), headingGoal(goal.x, goal.y, 0);
+		const bool found = heading.search(headingStart, headingGoal);
+		ASSERT_EQ(found, dijkstra.search(headingStart, headingGoal));
+		expansionsHeading += heading.getNumExpansions();
+		expansionsDijkstra += dijkstra.getNumExpansions();
+		if (!found) {
+			// the diagonal moves of the grid path are not available here
+			continue;
+		}
+		EXPECT_NEAR(heading.getPathCosts(), dijkstra.getPathCosts(), 1e-9);
+		std::vector<HeadingSpace::State> states;
+		heading.getPath(states);
+		ASSERT_FALSE(states.empty());
+		EXPECT_EQ(states.back().x, goal.x);
+		EXPECT_EQ(states.back().y, goal.y);
+	}
+	EXPECT_LT(expansionsHeading, expansionsDijkstra);
+
+	std::vector<GridCell> cells;
+	EXPECT_THROW(search.planPath(GridCell(0, 0), GridCell(40, 0), cells), std::out_of_range);
+	EXPECT_THROW(weighted.search(GridCell(0, 0), GridCell(1, 1), 0.5), std::invalid_argument);
+	EXPECT_THROW(search.planPath(NULL, searchArena.get(0, 0), searchArena), std::invalid_argument);
+}
 
 int main(int argc, char *argv[]) {
 	::testing::InitGoogleTest(&argc, argv);
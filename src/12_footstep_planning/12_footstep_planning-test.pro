@@ -7,6 +7,10 @@ HEADERS = \
 	include/footstep_planning/Heuristic.h \
 	include/footstep_planning/FileIO.h \
 	include/footstep_planning/FootstepNode.h \
+	include/footstep_planning/AnytimeFootstepPlanning.h \
+	include/footstep_planning/ClearanceMaps.h \
+	include/footstep_planning/DijkstraHeuristic.h \
+	include/footstep_planning/FootstepLattice.h \
 	include/footstep_planning/FootstepPlanning.h \
 	include/footstep_planning/FootstepMap.h
 
@@ -14,7 +18,12 @@ SOURCES = \
     ../gtest/src/gtest-all.cc \
 	src/FootstepMap.cpp \
 	src/FootstepPlanning.cpp \
+	src/GridMap.cpp \
 	src/FootstepNode.cpp \
+	src/AnytimeFootstepPlanning.cpp \
+	src/ClearanceMaps.cpp \
+	src/DijkstraHeuristic.cpp \
+	src/FootstepLattice.cpp \
 	src/PathPlanning.cpp \
 	src/OpenList.cpp \
 	src/ClosedList.cpp \
@@ -28,6 +37,7 @@ INCLUDEPATH += ../gtest
 TEMPLATE = app
 CONFIG -= qt
 CONFIG -= app_bundle
+CONFIG += c++11
 TARGET = footstep_planning-test
 DEFINES += PROJECT_SOURCE_DIR=\\\"$$absolute_path(".")\\\"
 unix:QMAKE_LFLAGS += -pthread
@@ -7,13 +7,22 @@ HEADERS = \
 	include/footstep_planning/Heuristic.h \
 	include/footstep_planning/FileIO.h \
 	include/footstep_planning/FootstepNode.h \
+	include/footstep_planning/AnytimeFootstepPlanning.h \
+	include/footstep_planning/ClearanceMaps.h \
+	include/footstep_planning/DijkstraHeuristic.h \
+	include/footstep_planning/FootstepLattice.h \
 	include/footstep_planning/FootstepPlanning.h \
 	include/footstep_planning/FootstepMap.h
 
 SOURCES = \
 	src/FootstepMap.cpp \
 	src/FootstepPlanning.cpp \
+	src/GridMap.cpp \
 	src/FootstepNode.cpp \
+	src/AnytimeFootstepPlanning.cpp \
+	src/ClearanceMaps.cpp \
+	src/DijkstraHeuristic.cpp \
+	src/FootstepLattice.cpp \
 	src/PathPlanning.cpp \
 	src/OpenList.cpp \
 	src/ClosedList.cpp \
@@ -25,7 +34,9 @@ INCLUDEPATH += ../includes
 TEMPLATE = app
 CONFIG -= qt
 CONFIG -= app_bundle
+CONFIG += c++11
 TARGET = footstep_planning_node
+unix:QMAKE_LFLAGS += -pthread
 DEFINES += PROJECT_SOURCE_DIR=\\\"$$absolute_path(".")\\\"
 windows:{
     QMAKE_LFLAGS += -static
@@ -0,0 +1,355 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <benchmark-helpers.h>
+#include <footstep_planning/AnytimeFootstepPlanning.h>
+#include <footstep_planning/ClearanceMaps.h>
+#include <footstep_planning/DijkstraHeuristic.h>
+#include <footstep_planning/FileIO.h>
+#include <footstep_planning/FootstepMap.h>
+#include <footstep_planning/FootstepPlanning.h>
+
+using namespace footstep_planning;
+
+namespace {
+
+const double RESOLUTION = 0.01;  ///< The size of a map cell in meters, as in data/map.pbm.
+const double SCALE = 5.0;        ///< The factor of the distance map values, as in data/distance_*.pgm.
+const size_t CELL_SIZE = 10;     ///< The size of a cell of the synthetic maps in map cells.
+
+/**
+ * @brief Enlarges a synthetic map by CELL_SIZE and computes its distance maps.
+ *
+ * A single occupied map cell is no obstacle for the planner, which checks the foot steps but not
+ * the swing trajectories, so each cell of the synthetic map becomes a block of map cells. The
+ * distance maps hold the city block distance to the nearest occupied cell for all orientations.
+ */
+FootstepMap* createFootstepMap(const benchmark_helpers::SyntheticMap& syntheticMap) {
+	const size_t width = syntheticMap.width * CELL_SIZE;
+	const size_t height = syntheticMap.height * CELL_SIZE;
+	std::vector<bool> data(width * height);
+	std::vector<size_t> distances(width * height, static_cast<size_t>(-1));
+	std::vector<size_t> queue;
+	for (size_t y = 0; y < height; ++y) {
+		for (size_t x = 0; x < width; ++x) {
+			if (syntheticMap.isOccupied(x / CELL_SIZE, y / CELL_SIZE)) {
+				data[y * width + x] = true;
+				distances[y * width + x] = 0;
+				queue.push_back(y * width + x);
+			}
+		}
+	}
+	// breadth-first search from all obstacles at once
+	for (size_t i = 0; i < queue.size(); ++i) {
+		const size_t cell = queue[i];
+		const size_t x = cell % width;
+		const size_t neighbors[4] = { x > 0 ? cell - 1 : cell, x + 1 < width ? cell + 1 : cell,
+				cell >= width ? cell - width : cell, cell + width < data.size() ? cell + width : cell };
+		for (int n = 0; n < 4; ++n) {
+			if (distances[neighbors[n]] == static_cast<size_t>(-1)) {
+				distances[neighbors[n]] = distances[cell] + 1;
+				queue.push_back(neighbors[n]);
+			}
+		}
+	}
+	std::vector<unsigned char> distanceMap(width * height);
+	for (size_t i = 0; i < distanceMap.size(); ++i) {
+		distanceMap[i] = static_cast<unsigned char>(std::min<double>(255.0, distances[i] * SCALE));
+	}
+	return new FootstepMap(width, height, data, std::vector<std::vector<unsigned char> >(12, distanceMap), RESOLUTION, SCALE);
+}
+
+/**
+ * @brief Returns the position of the center of a synthetic map cell in meters.
+ */
+void cellCenter(const int& cellX, const int& cellY, const size_t& height, double& x, double& y) {
+	x = (cellX * CELL_SIZE + CELL_SIZE / 2) * RESOLUTION;
+	// FootstepMap counts y from the bottom row upwards
+	y = (height - cellY * CELL_SIZE - CELL_SIZE / 2) * RESOLUTION;
+}
+
+double pathLength(const std::deque<const AbstractNode*>& path) {
+	double length = 0.0;
+	for (size_t i = 1; i < path.size(); ++i) {
+		const FootstepNode * const a = static_cast<const FootstepNode *>(path[i - 1]);
+		const FootstepNode * const b = static_cast<const FootstepNode *>(path[i]);
+		length += std::sqrt((a->x - b->x) * (a->x - b->x) + (a->y - b->y) * (a->y - b->y));
+	}
+	return length;
+}
+
+/**
+ * @brief Plans all queries on a map and returns the statistics.
+ * @param heuristic The heuristic, or NULL for the Euclidean distance.
+ */
+benchmark_helpers::BenchmarkResult runQueries(const std::string& planner, FootstepPlanning& planning, FootstepHeuristic * const heuristic,
+		const benchmark_helpers::SyntheticMap& syntheticMap, const FootstepMap& map, const std::vector<benchmark_helpers::Query>& queries) {
+	planning.setHeuristic(heuristic);
+	benchmark_helpers::BenchmarkResult result(planner, syntheticMap);
+	result.width = map.width;
+	result.height = map.height;
+	for (size_t i = 0; i < queries.size(); ++i) {
+		double startX, startY, goalX, goalY;
+		cellCenter(queries[i].startX, queries[i].startY, map.height, startX, startY);
+		cellCenter(queries[i].goalX, queries[i].goalY, map.height, goalX, goalY);
+		const FootstepNode * const start = planning.getLattice().get(startX, startY, 0.0, LEFT);
+		const FootstepNode * const goal = planning.getLattice().get(goalX, goalY, 0.0, RIGHT);
+		const benchmark_helpers::Stopwatch stopwatch;
+		const std::deque<const AbstractNode*> path = planning.planPath(start, goal);
+		const double milliseconds = stopwatch.milliseconds();
+		result.add(milliseconds, planning.getNumExpansions(), planning.getPeakOpenListSize(),
+				path.empty() ? -1.0 : pathLength(path));
+	}
+	return result;
+}
+
+/**
+ * @brief Runs A* with the Euclidean distance and the 2D Dijkstra heuristic on synthetic maps of
+ * increasing size (random obstacles, mazes, rooms and corridors) and writes the statistics as JSON.
+ *
+ * The times of the Dijkstra heuristic include its search from the goal, but not the computation
+ * of the passable cells, which is done once per map.
+ */
+void benchmarkSuite(const size_t& maxSize, const size_t& numQueries, const size_t& maxQueryDistance) {
+	const size_t sizes[] = { 100, 200, 400, 800, 1600, 3200 };
+	std::vector<benchmark_helpers::BenchmarkResult> results;
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= maxSize; ++s) {
+		const size_t cells = sizes[s] / CELL_SIZE;
+		std::vector<benchmark_helpers::SyntheticMap> syntheticMaps;
+		syntheticMaps.push_back(benchmark_helpers::randomMap(cells, cells, 20, 1));
+		syntheticMaps.push_back(benchmark_helpers::mazeMap(cells, cells, 3, 3));
+		syntheticMaps.push_back(benchmark_helpers::roomsMap(cells, cells, 6, 4));
+		for (size_t m = 0; m < syntheticMaps.size(); ++m) {
+			const FootstepMap * const map = createFootstepMap(syntheticMaps[m]);
+			const std::vector<benchmark_helpers::Query> queries =
+					benchmark_helpers::randomQueries(syntheticMaps[m], numQueries, 42, maxQueryDistance);
+			FootstepPlanning planning(map);
+			DijkstraHeuristic dijkstraHeuristic(*map, planning);
+			results.push_back(runQueries("A*", planning, NULL, syntheticMaps[m], *map, queries));
+			results.push_back(runQueries("A* (2D Dijkstra heuristic)", planning, &dijkstraHeuristic, syntheticMaps[m], *map, queries));
+			delete map;
+		}
+	}
+	benchmark_helpers::writeJson(std::cout, "footstep_planning", results);
+}
+
+/**
+ * @brief Plans the query of footstep_planning_node on data/map.pbm repeatedly with both
+ * heuristics and prints the number of expanded foot steps per second.
+ */
+void benchmarkMap(const size_t& repetitions) {
+	const FileIO fileIO(PROJECT_SOURCE_DIR);
+	if (!fileIO.map) {
+		std::cerr << "Could not load the map from " << PROJECT_SOURCE_DIR << "/data" << std::endl;
+		return;
+	}
+	FootstepPlanning planning(fileIO.map);
+	DijkstraHeuristic dijkstraHeuristic(*fileIO.map, planning);
+	FootstepHeuristic * const heuristics[] = { NULL, &dijkstraHeuristic };
+	const char * const names[] = { "Euclidean", "2D Dijkstra" };
+	const FootstepNode * const start = planning.getLattice().get(1.0, 0.2, 0.0, LEFT);
+	const FootstepNode * const goal = planning.getLattice().get(2.0, 2.0, -0.5 * M_PI, RIGHT);
+	for (size_t h = 0; h < 2; ++h) {
+		planning.setHeuristic(heuristics[h]);
+		std::vector<double> milliseconds;
+		size_t expansions = 0;
+		double costs = -1.0;
+		for (size_t i = 0; i < repetitions; ++i) {
+			const benchmark_helpers::Stopwatch stopwatch;
+			const std::deque<const AbstractNode*> path = planning.planPath(start, goal);
+			milliseconds.push_back(stopwatch.milliseconds());
+			expansions = planning.getNumExpansions();
+			costs = path.empty() ? -1.0 : pathLength(path);
+		}
+		const double median = benchmark_helpers::percentile(milliseconds, 50.0);
+		std::cout << "map.pbm, " << names[h] << " heuristic: " << expansions << " expansions, path length " << costs
+				<< " m, median " << median << " ms, " << static_cast<size_t>(expansions / (median / 1000.0)) << " expansions/s" << std::endl;
+	}
+}
+
+/**
+ * @brief Computes the distance maps of data/map.pbm and of synthetic maps of increasing size, and
+ * updates them after toggling a block of 10 x 10 cells, and prints the median times.
+ */
+void benchmarkClearance(const size_t& repetitions) {
+	const FileIO fileIO(PROJECT_SOURCE_DIR);
+	if (!fileIO.map) {
+		std::cerr << "Could not load the map from " << PROJECT_SOURCE_DIR << "/data" << std::endl;
+		return;
+	}
+	std::vector<FootstepMap *> maps;
+	std::vector<std::string> names;
+	maps.push_back(new FootstepMap(*fileIO.map));
+	names.push_back("map.pbm");
+	const size_t sizes[] = { 800, 1600, 3200 };
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		const benchmark_helpers::SyntheticMap syntheticMap = benchmark_helpers::roomsMap(sizes[s] / CELL_SIZE, sizes[s] / CELL_SIZE, 6, 4);
+		maps.push_back(createFootstepMap(syntheticMap));
+		names.push_back("rooms-6 " + std::to_string(sizes[s]));
+	}
+	const ClearanceMaps clearanceMaps;
+	for (size_t m = 0; m < maps.size(); ++m) {
+		FootstepMap& map = *maps[m];
+		std::vector<double> computeMilliseconds, updateMilliseconds;
+		for (size_t i = 0; i < repetitions; ++i) {
+			benchmark_helpers::Stopwatch stopwatch;
+			clearanceMaps.compute(map);
+			computeMilliseconds.push_back(stopwatch.milliseconds());
+
+			const int x = static_cast<int>(map.width / 2), y = static_cast<int>(map.height / 2);
+			for (int dy = 0; dy < 10; ++dy) {
+				for (int dx = 0; dx < 10; ++dx) {
+					map.setOccupied(x + dx, y + dy, !map.isOccupied(x + dx, y + dy));
+				}
+			}
+			stopwatch = benchmark_helpers::Stopwatch();
+			clearanceMaps.update(map, x, y, 10, 10);
+			updateMilliseconds.push_back(stopwatch.milliseconds());
+		}
+		std::cout << names[m] << " (" << map.width << " x " << map.height << "): compute median "
+				<< benchmark_helpers::percentile(computeMilliseconds, 50.0) << " ms, update of 10 x 10 cells median "
+				<< benchmark_helpers::percentile(updateMilliseconds, 50.0) << " ms" << std::endl;
+		delete maps[m];
+	}
+}
+
+/**
+ * @brief Tests the foot steps of random batches of 12 successors on data/map.pbm for collisions
+ * one at a time and in batches, and prints the median time per foot step.
+ */
+void benchmarkCollisions(const size_t& repetitions) {
+	const FileIO fileIO(PROJECT_SOURCE_DIR);
+	if (!fileIO.map) {
+		std::cerr << "Could not load the map from " << PROJECT_SOURCE_DIR << "/data" << std::endl;
+		return;
+	}
+	const FootstepMap& map = *fileIO.map;
+	FootstepPlanning planning(&map);
+	const size_t batchSize = 12;
+	const size_t numSteps = 120000;
+	std::vector<const FootstepNode *> steps;
+	std::vector<double> x, y, theta;
+	unsigned int seed = 42;
+	for (size_t i = 0; i < numSteps; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		x.push_back(map.width * RESOLUTION * (seed >> 8) / 16777216.0);
+		seed = seed * 1103515245u + 12345u;
+		y.push_back(map.height * RESOLUTION * (seed >> 8) / 16777216.0);
+		seed = seed * 1103515245u + 12345u;
+		theta.push_back(2.0 * M_PI * (seed >> 8) / 16777216.0);
+		steps.push_back(planning.getLattice().get(x.back(), y.back(), theta.back(), LEFT));
+	}
+
+	std::vector<double> scalarMilliseconds, batchMilliseconds, nodeMilliseconds, nodeBatchMilliseconds;
+	size_t scalarCollisions = 0, batchCollisions = 0, nodeCollisions = 0, nodeBatchCollisions = 0;
+	for (size_t r = 0; r < repetitions; ++r) {
+		scalarCollisions = batchCollisions = nodeCollisions = nodeBatchCollisions = 0;
+		const benchmark_helpers::Stopwatch scalar;
+		for (size_t i = 0; i < numSteps; ++i) {
+			scalarCollisions += map.getDistanceToNearestObstacle(x[i], y[i], theta[i]) < 0.01;
+		}
+		scalarMilliseconds.push_back(scalar.milliseconds());
+		const benchmark_helpers::Stopwatch batch;
+		for (size_t i = 0; i < numSteps; i += batchSize) {
+			batchCollisions += __builtin_popcount(map.getCollisions(&x[i], &y[i], &theta[i], batchSize, 0.01));
+		}
+		batchMilliseconds.push_back(batch.milliseconds());
+		const benchmark_helpers::Stopwatch node;
+		for (size_t i = 0; i < numSteps; ++i) {
+			nodeCollisions += planning.isColliding(steps[i]);
+		}
+		nodeMilliseconds.push_back(node.milliseconds());
+		const benchmark_helpers::Stopwatch nodeBatch;
+		for (size_t i = 0; i < numSteps; i += batchSize) {
+			nodeBatchCollisions += __builtin_popcount(planning.getCollisions(&steps[i], batchSize));
+		}
+		nodeBatchMilliseconds.push_back(nodeBatch.milliseconds());
+	}
+	const double nanosecondsPerStep = 1e6 / numSteps;
+	std::cout << "FootstepMap::getDistanceToNearestObstacle(): " << benchmark_helpers::percentile(scalarMilliseconds, 50.0) * nanosecondsPerStep
+			<< " ns per foot step, " << scalarCollisions << " collisions" << std::endl;
+	std::cout << "FootstepMap::getCollisions(): " << benchmark_helpers::percentile(batchMilliseconds, 50.0) * nanosecondsPerStep
+			<< " ns per foot step, " << batchCollisions << " collisions" << std::endl;
+	std::cout << "FootstepPlanning::isColliding(): " << benchmark_helpers::percentile(nodeMilliseconds, 50.0) * nanosecondsPerStep
+			<< " ns per foot step, " << nodeCollisions << " collisions" << std::endl;
+	std::cout << "FootstepPlanning::getCollisions(): " << benchmark_helpers::percentile(nodeBatchMilliseconds, 50.0) * nanosecondsPerStep
+			<< " ns per foot step, " << nodeBatchCollisions << " collisions" << std::endl;
+}
+
+/**
+ * @brief Plans the query of footstep_planning_node on data/map.pbm with A* and with the anytime
+ * planner until the deadline, and prints the plans that the anytime planner has published.
+ */
+void benchmarkAnytime(const size_t& deadlineMilliseconds) {
+	const FileIO fileIO(PROJECT_SOURCE_DIR);
+	if (!fileIO.map) {
+		std::cerr << "Could not load the map from " << PROJECT_SOURCE_DIR << "/data" << std::endl;
+		return;
+	}
+	FootstepPlanning planning(fileIO.map);
+	const FootstepNode * const start = FootstepNode::get(1.0, 0.2, 0.0, LEFT);
+	const FootstepNode * const goal = FootstepNode::get(2.0, 2.0, -0.5 * M_PI, RIGHT);
+	const benchmark_helpers::Stopwatch stopwatch;
+	const std::deque<const AbstractNode*> path = planning.planPath(start, goal);
+	const double milliseconds = stopwatch.milliseconds();
+	std::cout << "A*: " << planning.getNumExpansions() << " expansions, costs " << (path.empty() ? -1.0 : path.back()->costs)
+			<< ", " << milliseconds << " ms" << std::endl;
+
+	AnytimeFootstepPlanning anytimePlanning(fileIO.map);
+	const AnytimeFootstepPlanning::Clock::time_point deadline = AnytimeFootstepPlanning::Clock::now()
+			+ std::chrono::milliseconds(deadlineMilliseconds);
+	anytimePlanning.planPath(start, goal, deadline, [](const AnytimeFootstepPlanning::Solution& solution) {
+		std::cout << "Anytime, epsilon " << solution.epsilon << ": bound " << solution.bound << ", " << solution.numExpansions
+				<< " expansions, costs " << solution.costs << ", " << solution.seconds * 1000.0 << " ms" << std::endl;
+	});
+	std::cout << "Anytime: " << anytimePlanning.getNumIterations() << " iterations, " << anytimePlanning.getNumExpansions()
+			<< " expansions, bound " << anytimePlanning.getBound() << std::endl;
+}
+
+}  // namespace
+
+/*
+ * Usage: footstep_planning-benchmark [largest map size] [number of queries] [largest query distance]
+ *        footstep_planning-benchmark --map [repetitions]
+ *        footstep_planning-benchmark --clearance [repetitions]
+ *        footstep_planning-benchmark --collisions [repetitions]
+ *        footstep_planning-benchmark --anytime [deadline in ms]
+ *
+ * Plans foot steps on synthetic maps from 100x100 cells (1 m x 1 m) up to the given size
+ * (default 800x800, at most 3200x3200) and writes the statistics to stdout as JSON. Start and goal of the queries
+ * (10 per map by default) are at most the given distance apart along each axis, in steps of
+ * 10 cm (default 10, i.e. 1 m).
+ *
+ * With --map, the query of footstep_planning_node is planned on data/map.pbm (5 times by
+ * default) with each heuristic, and the expansion rate of the median run is printed.
+ *
+ * With --clearance, the distance maps of data/map.pbm and of synthetic maps up to 3200x3200
+ * cells are computed and updated after a local change (5 times by default).
+ *
+ * With --collisions, random foot steps on data/map.pbm are tested for collisions one at a time
+ * and in batches of 12 (20 times by default).
+ *
+ * With --anytime, the query of footstep_planning_node is planned with A* and with the anytime
+ * planner, which stops at the deadline (10 s by default) or with an optimal plan.
+ */
+int main(int argc, char **argv) {
+	if (argc > 1 && std::string(argv[1]) == "--map") {
+		benchmarkMap(argc > 2 ? std::atoi(argv[2]) : 5);
+		return 0;
+	}
+	if (argc > 1 && std::string(argv[1]) == "--clearance") {
+		benchmarkClearance(argc > 2 ? std::atoi(argv[2]) : 5);
+		return 0;
+	}
+	if (argc > 1 && std::string(argv[1]) == "--collisions") {
+		benchmarkCollisions(argc > 2 ? std::atoi(argv[2]) : 20);
+		return 0;
+	}
+	if (argc > 1 && std::string(argv[1]) == "--anytime") {
+		benchmarkAnytime(argc > 2 ? std::atoi(argv[2]) : 10000);
+		return 0;
+	}
+	benchmarkSuite(argc > 1 ? std::atoi(argv[1]) : 800, argc > 2 ? std::atoi(argv[2]) : 10, argc > 3 ? std::atoi(argv[3]) : 10);
+	return 0;
+}
@@ -41,6 +41,16 @@ public:
    		return this->predecessor;
    	}
 
+   	/**
+   	 * @brief Clears the search state of the node: the costs, the predecessor and the state in the open list.
+   	 */
+   	void resetSearchState() {
+   		costs = 0.0;
+   		predecessor = NULL;
+   		openListData.state = OpenListData::NEW;
+   		openListData.cost = 0.0;
+   	}
+
    	/**
    	 * @brief Returns a string representation of the node for the program output.
    	 * @return The string representation.
@@ -53,15 +63,12 @@ public:
    	virtual std::string toLogString() const = 0;
 
 protected:
-	AbstractNode() : costs(0.0), predecessor(NULL), openListData(new OpenListData()) {};
-	virtual ~AbstractNode() {
-		delete openListData;
-		openListData = NULL;
-	};
+	AbstractNode() : costs(0.0), predecessor(NULL) {};
+	virtual ~AbstractNode() {};
 
 private:
 	const AbstractNode *predecessor;
-	OpenListData *openListData;
+	mutable OpenListData openListData;  ///< Stored in the node, so the open list needs no lookup table.
 	friend class OpenList;
 };
 
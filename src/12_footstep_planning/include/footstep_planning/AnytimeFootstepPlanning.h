@@ -0,0 +1,180 @@
+#ifndef FOOTSTEP_PLANNING_ANYTIMEFOOTSTEPPLANNING_H_
+#define FOOTSTEP_PLANNING_ANYTIMEFOOTSTEPPLANNING_H_
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <footstep_planning/FootstepPlanning.h>
+
+namespace footstep_planning {
+
+/**
+ * @brief Anytime foot step planning with a deadline (ARA*).
+ *
+ * The search starts as weighted A* with the heuristic inflated by initialEpsilon, which finds a
+ * first plan after few expansions, and lowers the inflation by epsilonDecrement per iteration
+ * down to 1, where the plan is optimal. Each iteration continues the previous one: the costs and
+ * predecessors of the foot steps are kept, and the open foot steps together with the closed ones
+ * whose costs have decreased since they were expanded (the INCONS list) are reordered for the new
+ * inflation, so that a foot step is expanded at most once per iteration.
+ *
+ * Every plan is passed to a callback together with its suboptimality bound, i.e. a factor by
+ * which its costs exceed the optimum at most, computed as in ARA* as the minimum of the inflation
+ * and the ratio of the costs to the smallest unweighted f-value of the open and inconsistent foot
+ * steps. The bound holds up to the goal tolerance of isCloseToGoal() for a consistent heuristic,
+ * like the optimality of A*. The search stops when the plan is optimal, at the deadline of a
+ * monotonic clock, or when a cancellation flag is set, which may happen from another thread.
+ *
+ * Like in A*, a plan ends at a foot step close to the goal (see isCloseToGoal()) that is taken
+ * from the open list, and such foot steps are not expanded. Their heuristic is 0, so that the
+ * search stops as soon as no other foot step can lead to a cheaper plan.
+ */
+class AnytimeFootstepPlanning : public FootstepPlanning {
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	/**
+	 * @brief A plan that the search has found.
+	 */
+	struct Solution {
+		std::deque<const AbstractNode*> path;  ///< The foot steps from the start to the goal.
+		double costs;                          ///< The costs at which the goal was reached, at least those of the path.
+		double epsilon;                        ///< The inflation of the heuristic of the iteration that found the path.
+		double bound;                          ///< The costs exceed the optimum by at most this factor.
+		size_t numExpansions;                  ///< The number of expansions of the query so far.
+		double seconds;                        ///< The time since the start of the query.
+	};
+
+	/**
+	 * @brief Receives the plans of a query, with decreasing bounds.
+	 */
+	typedef std::function<void(const Solution&)> Callback;
+
+	/**
+	 * @brief Constructs an anytime planner for a given foot step map.
+	 * @param footstepMap The foot step map.
+	 * @param initialEpsilon The inflation of the heuristic of the first iteration, at least 1.
+	 * @param epsilonDecrement The decrease of the inflation per iteration, positive.
+	 * @throws std::invalid_argument if initialEpsilon is less than 1 or epsilonDecrement is not positive.
+	 */
+	AnytimeFootstepPlanning(const FootstepMap * const footstepMap, const double& initialEpsilon = 3.0, const double& epsilonDecrement = 0.5);
+	virtual ~AnytimeFootstepPlanning() {};
+
+	/**
+	 * @brief Plans until the plan is optimal, the deadline has passed or the search is cancelled.
+	 * @param startNode The start foot step.
+	 * @param goalNode The goal foot step.
+	 * @param deadline The time at which the search stops.
+	 * @param callback Called with each plan that is better than the previous one, by costs or by bound.
+	 * @param cancel The search stops as soon as this flag becomes true, NULL for no cancellation.
+	 * @return The best plan, or an empty path if none has been found.
+	 * @throws std::invalid_argument if startNode or goalNode is NULL.
+	 *
+	 * The deadline and the flag are checked before each expansion. As with planPath(), start and
+	 * goal are mapped into the lattice of the planner, whose previous search state is reset.
+	 */
+	std::deque<const AbstractNode*> planPath(const AbstractNode * const startNode, const AbstractNode * const goalNode,
+			const Clock::time_point& deadline, const Callback& callback = Callback(), const std::atomic<bool> * const cancel = NULL);
+
+	/**
+	 * @brief Plans without a deadline, which returns an optimal plan.
+	 */
+	virtual std::deque<const AbstractNode*> planPath(const AbstractNode * const startNode, const AbstractNode * const goalNode) {
+		return planPath(startNode, goalNode, Clock::time_point::max());
+	}
+
+	/**
+	 * @brief Returns the suboptimality bound of the plan returned by the last query.
+	 * @return The bound, or infinity if no plan has been found.
+	 */
+	double getBound() const {
+		return bound;
+	}
+
+	/**
+	 * @brief Returns the number of iterations of the last query, including an interrupted one.
+	 * @return The number of inflations for which the search has run.
+	 */
+	size_t getNumIterations() const {
+		return numIterations;
+	}
+
+	const double initialEpsilon;    ///< The inflation of the heuristic of the first iteration.
+	const double epsilonDecrement;  ///< The decrease of the inflation per iteration.
+
+protected:
+	/**
+	 * @brief Allows the batched collision test for this class, which does not override isColliding().
+	 */
+	virtual bool hasDefaultCollisionTest() const;
+
+private:
+	/**
+	 * @brief The search state of a foot step that has been reached in the current query.
+	 *
+	 * The costs and the predecessor are stored in the node.
+	 */
+	struct State {
+		double h;          ///< The heuristic, not inflated.
+		double key;        ///< The priority of the foot step in the open list.
+		size_t closedIn;   ///< The iteration in which the foot step was expanded last, 0 if never.
+		bool open;         ///< True iff the foot step is in the open list.
+		bool inconsistent; ///< True iff the foot step is in the INCONS list.
+	};
+
+	/**
+	 * @brief An entry of the open list, outdated if the key differs from that of the state.
+	 */
+	struct Entry {
+		double key;
+		const AbstractNode *node;
+		bool operator<(const Entry& other) const {
+			// std::push_heap() builds a max-heap
+			return key > other.key;
+		}
+	};
+
+	/**
+	 * @brief Expands foot steps until the open list cannot improve the best plan.
+	 * @return False if the search was interrupted.
+	 */
+	bool improvePath(const AbstractNode * const goal, const double& epsilon, const Clock::time_point& deadline,
+			const std::atomic<bool> * const cancel);
+
+	/**
+	 * @brief Returns the smallest unweighted f-value of the open and the inconsistent foot steps.
+	 */
+	double getLowerBound() const;
+
+	/**
+	 * @brief Moves the inconsistent foot steps to the open list and orders it for a new inflation.
+	 */
+	void reorder(const double& epsilon);
+
+	/**
+	 * @brief Returns the heuristic of a foot step, 0 for foot steps that are close to the goal.
+	 */
+	double goalHeuristic(const AbstractNode * const node, const AbstractNode * const goal);
+
+	/**
+	 * @brief Inserts a foot step into the open list or updates its key.
+	 */
+	void push(const AbstractNode * const node, State& state, const double& key);
+
+	std::unordered_map<const AbstractNode *, State> states;
+	std::vector<Entry> openList;                     ///< A heap of the open foot steps, with outdated entries.
+	std::vector<const AbstractNode *> inconsistent;  ///< The INCONS list.
+	size_t numOpen;                                  ///< The number of open foot steps.
+	const AbstractNode *bestGoal;                    ///< The goal foot step of the best plan, NULL if there is none.
+	double bestCosts;
+	double bound;
+	size_t iteration;
+	size_t numIterations;
+};
+
+}  // namespace footstep_planning
+
+#endif /* FOOTSTEP_PLANNING_ANYTIMEFOOTSTEPPLANNING_H_ */
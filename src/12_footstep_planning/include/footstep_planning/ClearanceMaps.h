@@ -0,0 +1,82 @@
+#ifndef FOOTSTEP_PLANNING_CLEARANCEMAPS_H_
+#define FOOTSTEP_PLANNING_CLEARANCEMAPS_H_
+
+#include <vector>
+#include <footstep_planning/FootstepMap.h>
+
+namespace footstep_planning {
+
+/**
+ * @brief Computes the distance maps of a FootstepMap from its occupancy.
+ *
+ * The foot is a rectangle of footLength x footWidth meters centered at the foot position, whose
+ * long side points along the foot orientation. For the orientation theta, the occupied cells are
+ * dilated by the cells that the rotated rectangle overlaps at the center of a cell, and the value
+ * of a cell in the distance map of theta is the Euclidean distance from the cell to the nearest
+ * dilated cell, 0 if the foot overlaps an occupied cell. As in data/distance_<angle>.pgm, the
+ * distances are multiplied by the scale of the map and rounded down to a byte, so they saturate
+ * at 255 / scale cells, and map i holds the orientation i * 180 / n degrees (counterclockwise,
+ * the foot is symmetric).
+ *
+ * Per orientation, the occupied cells are dilated one row at a time with the runs of occupied
+ * cells, and the exact distance transform of Felzenszwalb and Huttenlocher takes one pass along
+ * the columns and one along the rows, each linear in the number of cells. The orientations and
+ * blocks of rows or columns are distributed over threads.
+ *
+ * After a change of the occupancy, update() recomputes the cells whose value can change, which
+ * are within the size of the foot plus the saturation distance of the changed cells.
+ */
+class ClearanceMaps {
+public:
+	/**
+	 * @brief Creates the generator of the distance maps for a foot.
+	 * @param footLength The length of the foot in meters.
+	 * @param footWidth The width of the foot in meters.
+	 * @param numThreads The number of threads, 0 to use one per hardware thread.
+	 * @throws std::invalid_argument if the length or the width of the foot is negative.
+	 *
+	 * With the default size, 98 % of the collisions agree with those of data/distance_<angle>.pgm.
+	 */
+	explicit ClearanceMaps(const double& footLength = 0.09, const double& footWidth = 0.07, const size_t& numThreads = 0);
+	virtual ~ClearanceMaps() {};
+
+	/**
+	 * @brief Replaces the distance maps of a map with ones computed from its occupancy.
+	 * @param map The foot step map.
+	 * @param numAngles The number of orientations.
+	 * @throws std::invalid_argument if numAngles is 0 or the scale of the map is less than 1.
+	 */
+	void compute(FootstepMap& map, const size_t& numAngles = 12) const;
+
+	/**
+	 * @brief Recomputes the distance maps of a map after the occupancy of some cells has changed.
+	 * @param map The foot step map, whose distance maps have been computed with compute().
+	 * @param x The smallest x coordinate of the changed cells.
+	 * @param y The smallest y coordinate of the changed cells.
+	 * @param width The width of the rectangle that contains all changed cells.
+	 * @param height The height of the rectangle that contains all changed cells.
+	 * @throws std::out_of_range if the rectangle is not inside the map.
+	 * @throws std::invalid_argument if the map has no distance maps or its scale is less than 1.
+	 *
+	 * The result is the same as that of compute().
+	 */
+	void update(FootstepMap& map, const int& x, const int& y, const int& width, const int& height) const;
+
+	const double footLength;  ///< The length of the foot in meters.
+	const double footWidth;   ///< The width of the foot in meters.
+	const size_t numThreads;  ///< The number of threads, 0 for one per hardware thread.
+
+private:
+	/**
+	 * @brief Computes the values of a rectangle of all distance maps.
+	 *
+	 * The distances are computed for the window [x0, x1) x [y0, y1), which has to extend the
+	 * rectangle [ox0, ox1) x [oy0, oy1) of the written values by the saturation distance.
+	 */
+	void computeWindow(FootstepMap& map, const int& x0, const int& y0, const int& x1, const int& y1,
+			const int& ox0, const int& oy0, const int& ox1, const int& oy1) const;
+};
+
+}  // namespace footstep_planning
+
+#endif /* FOOTSTEP_PLANNING_CLEARANCEMAPS_H_ */
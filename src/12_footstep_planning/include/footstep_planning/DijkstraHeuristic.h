@@ -0,0 +1,99 @@
+#ifndef FOOTSTEP_PLANNING_DIJKSTRAHEURISTIC_H_
+#define FOOTSTEP_PLANNING_DIJKSTRAHEURISTIC_H_
+
+#include <vector>
+#include <footstep_planning/FootstepMap.h>
+#include <footstep_planning/FootstepPlanning.h>
+
+namespace footstep_planning {
+
+/**
+ * @brief Obstacle-aware foot step heuristic based on the shortest 2D path to the goal.
+ *
+ * The map is divided into coarse cells of about cellSize meters. A coarse cell is passable if it
+ * lies within one step of a position where the foot fits in at least one orientation, i.e. where
+ * one of the distance maps of the FootstepMap shows no collision for FootstepPlanning. The foot
+ * steps may cross obstacles that are thinner than a step, since the swing of the foot is not
+ * checked, but the line through every second foot step of a path only crosses passable cells.
+ * The passable cells depend only on the map and are computed once in the constructor.
+ *
+ * setGoal() runs a backward Dijkstra search from the goal over the passable cells with
+ * 8-connectivity, once per query. For the distance D of the cell of the current foot step,
+ * heuristic() looks up
+ *
+ *     d = max(Euclidean distance, (D - sqrt(2) * cellSize) / 1.0824)
+ *
+ * The grid overestimates a straight line by at most 8.24 % (the octile distance at 22.5 degrees),
+ * which the division compensates, and the subtracted cell diagonal covers the discretization of
+ * the start and the goal. Two consecutive foot steps alternate sides and move the feet by at most
+ * 1 / costsPerMeter of their costs (see FootstepPlanning::getCostsPerMeter()), so the heuristic is
+ *
+ *     weight * max(0, costsPerMeter * d - (costsPerMeter - 1) * maxStepLength)
+ *
+ * where the last term accounts for an odd number of steps. With weight 1, it is admissible up to
+ * the goal tolerance of isCloseToGoal(), like the Euclidean distance, and up to one coarse cell per
+ * bend of the path around an obstacle (bounded inflation). Cells that the goal cannot be reached
+ * from get an infinite value, and the planners do not enqueue foot steps with an infinite
+ * heuristic. Outside the map, or before setGoal(), d is the Euclidean distance.
+ */
+class DijkstraHeuristic : public FootstepHeuristic {
+public:
+	/**
+	 * @brief Computes the passable cells of a map.
+	 * @param map The foot step map, which must outlive the heuristic.
+	 * @param planning The planner, whose foot step actions determine maxStepLength and costsPerMeter.
+	 * @param cellSize The size of the cells of the Dijkstra search in meters, rounded to a multiple of the map resolution.
+	 * @param weight The factor of the heuristic, > 1 to trade optimality for fewer expansions.
+	 * @throws std::invalid_argument if cellSize is negative or weight is not positive.
+	 */
+	DijkstraHeuristic(const FootstepMap& map, const FootstepPlanning& planning, const double& cellSize = 0.05, const double& weight = 1.0);
+	virtual ~DijkstraHeuristic() {};
+
+	using FootstepHeuristic::heuristic;
+	double heuristic(const FootstepNode * const currentFootstep, const FootstepNode * const goalFootstep) const;
+
+	/**
+	 * @brief Runs the Dijkstra search from the goal, unless the goal is in the same cell as in the previous call.
+	 * @param goalFootstep The goal foot step.
+	 */
+	void setGoal(const FootstepNode * const goalFootstep);
+
+	/**
+	 * @brief Returns the length of the shortest 2D path from a position to the goal.
+	 * @param x The x coordinate in meters.
+	 * @param y The y coordinate in meters.
+	 * @return The distance D in meters, infinity if the goal cannot be reached, or -1 outside the map.
+	 */
+	double getDistance(const double& x, const double& y) const;
+
+	/**
+	 * @brief Tests if the line through every second foot step of a path may cross a position.
+	 * @param x The x coordinate in meters.
+	 * @param y The y coordinate in meters.
+	 * @return True iff the position is inside the map and its cell is passable.
+	 */
+	bool isPassable(const double& x, const double& y) const;
+
+	const double cellSize;       ///< The size of the cells in meters, a multiple of the map resolution.
+	const double weight;         ///< The factor of the heuristic.
+	const double maxStepLength;  ///< The longest distance between two consecutive foot steps in meters.
+	const double costsPerMeter;  ///< The lowest costs of two consecutive foot steps per meter of displacement.
+
+private:
+	/**
+	 * @brief Returns the index of the cell of a position, or -1 outside the map.
+	 */
+	long cellIndex(const double& x, const double& y) const;
+
+	const FootstepMap& map;
+	const size_t cellsPerCell;     ///< The number of map cells along each side of a cell.
+	const size_t width;            ///< The width of the grid in cells.
+	const size_t height;           ///< The height of the grid in cells.
+	std::vector<bool> passable;    ///< One value per cell in row-major order, rows from the top as in the map.
+	std::vector<double> distances; ///< The distances D of the cells to the goal, empty without a goal.
+	long goalCell;                 ///< The cell of the goal of the last search, -1 if there is none.
+};
+
+}  // namespace footstep_planning
+
+#endif /* FOOTSTEP_PLANNING_DIJKSTRAHEURISTIC_H_ */
@@ -17,8 +17,17 @@ public:
 	/**
 	 * Loads a foot step map.
 	 * @param package_path The package path.
+	 * @param cacheMap If true, the loaded map is written to the binary map file data/map.bin.
+	 *
+	 * The occupancy is read from data/map.pbm and the distance maps from data/distance_<angle>.pgm.
+	 * If any of the distance map images is missing, all distance maps are computed from the
+	 * occupancy with ClearanceMaps instead, so after a change of the map it suffices to delete them.
+	 * Since decoding them takes a while for large maps, they can be cached together in the binary
+	 * map file data/map.bin (see saveBinaryMap()), which is used instead as long as it is newer
+	 * than all of them. Nothing is written unless cacheMap is set, so that the map can be loaded
+	 * from a read-only directory.
 	 */
-	FileIO(const std::string& package_path);
+	FileIO(const std::string& package_path, const bool& cacheMap = false);
 	virtual ~FileIO();
 	/**
 	 * @brief Opens the log file.
@@ -34,9 +43,37 @@ public:
 	 */
 	void logPath(const std::string& filename, std::deque<const AbstractNode *> path);
 
+	/**
+	 * @brief Loads a grid map from a file.
+	 * @param filename The filename of the map file.
+	 * @return Pointer to the newly allocated grid map, NULL if the file could not be read.
+	 *
+	 * The caller has to call "delete" in the end to free the map.
+	 *
+	 * The file can be a plain (P1) or raw (P4) PBM image, where black cells are occupied, a raw
+	 * PGM image with 8-bit values (P5), where cells darker than half the maximum value are
+	 * occupied, or a binary map file. The file is memory-mapped, and images are decoded eight
+	 * cells at a time into the tiles of the map (see GridMap::getTiles()), while the tiles of a
+	 * binary map file are copied as a whole.
+	 */
 	static const GridMap * loadMap(const std::string& filename);
 
-	const FootstepMap *map; ///< The footstep map.
+	/**
+	 * @brief Writes a footstep map with its distance maps to a binary map file.
+	 * @param filename The filename of the map file.
+	 * @param map The footstep map.
+	 * @return True iff the file was written successfully.
+	 *
+	 * The file consists of a 32-byte header (the magic "GRIDMAP1", the 32-bit byte order mark
+	 * 0x01020304, the 32-bit number of distance maps, and the 64-bit width and height), the
+	 * occupancy packed into one 64-bit word per 8x8 cells (bit (y % 8) * 8 + x % 8 of word
+	 * (y / 8) * ceil(width / 8) + x / 8), and the distance maps with one byte per cell in
+	 * row-major order, each padded to a multiple of eight bytes. All numbers are stored in the
+	 * byte order of the host. The format is the same as that of the path planning exercise.
+	 */
+	static bool saveBinaryMap(const std::string& filename, const FootstepMap& map);
+
+	const FootstepMap *map; ///< The footstep map, NULL if it could not be loaded.
 };
 
 } /* namespace footstep_planning */
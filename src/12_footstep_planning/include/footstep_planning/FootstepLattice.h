@@ -0,0 +1,91 @@
+#ifndef FOOTSTEP_PLANNING_FOOTSTEPLATTICE_H_
+#define FOOTSTEP_PLANNING_FOOTSTEPLATTICE_H_
+
+#include <vector>
+#include <stdint.h>
+#include <footstep_planning/FootstepNode.h>
+
+namespace footstep_planning {
+
+/**
+ * @brief The discretized state space of the foot step planner, which owns its nodes.
+ *
+ * A foot step (x, y, theta, foot) belongs to the lattice state whose x and y are rounded to
+ * multiples of the resolution and whose orientation is rounded to one of numThetaBins equally
+ * spaced bins. All foot steps of a state share one node, which keeps the pose of the first foot
+ * step that was requested for the state.
+ *
+ * The states are looked up in an open-addressing hash table with linear probing, whose keys
+ * pack the discrete coordinates without loss, so distinct states never share a node. The lattice
+ * covers +-2^23 cells in x and y (83 km at 1 cm) and grows with the number of states that have
+ * been requested, independently of the map size. The nodes are freed together with the lattice.
+ *
+ * Like GridNodeArena in path_planning, the lattice remembers the nodes handed out since the last
+ * call to reset(), so that their search state can be cleared between two queries.
+ */
+class FootstepLattice {
+public:
+	/**
+	 * @brief Creates an empty lattice.
+	 * @param resolution The spacing of the states in x and y in meters.
+	 * @param numThetaBins The number of orientations.
+	 * @throws std::invalid_argument if the resolution is not positive or numThetaBins is 0 or larger than 4096.
+	 */
+	explicit FootstepLattice(const double& resolution = 0.01, const size_t& numThetaBins = 20);
+	virtual ~FootstepLattice();
+
+	const double resolution;    ///< The spacing of the states in x and y in meters.
+	const size_t numThetaBins;  ///< The number of orientations.
+
+	/**
+	 * @brief Provides access to the node of a foot step.
+	 * @param x The x coordinate of the foot step in meters.
+	 * @param y The y coordinate of the foot step in meters.
+	 * @param theta The orientation of the foot step in radians.
+	 * @param foot The swing foot (LEFT or RIGHT).
+	 * @return The node of the lattice state of the foot step, allocated on the first request.
+	 * @throws std::out_of_range if the foot step is outside the lattice.
+	 */
+	FootstepNode* get(const double& x, const double& y, const double& theta, const Foot& foot);
+
+	/**
+	 * @brief Clears the costs, predecessors and open list states of all nodes handed out since the last reset.
+	 *
+	 * The runtime is proportional to the number of touched nodes. Pointers to nodes stay valid.
+	 */
+	void reset();
+
+	/**
+	 * @brief Deletes all nodes, which invalidates all pointers returned by get().
+	 */
+	void clear();
+
+	/**
+	 * @brief Returns the number of allocated nodes.
+	 * @return The number of lattice states that have been requested since the lattice was created or cleared.
+	 */
+	size_t size() const {
+		return nodes.size();
+	}
+
+private:
+	FootstepLattice(const FootstepLattice&);
+	FootstepLattice& operator=(const FootstepLattice&);
+
+	static const uint64_t EMPTY = ~static_cast<uint64_t>(0);  ///< Key of unused slots, which no state can have.
+
+	uint64_t key(const double& x, const double& y, const double& theta, const Foot& foot) const;
+	size_t slot(const uint64_t& key) const;
+	void grow();
+
+	std::vector<uint64_t> keys;       ///< The keys of the hash table, EMPTY for unused slots.
+	std::vector<uint32_t> indices;    ///< The index into nodes for each used slot.
+	std::vector<FootstepNode*> nodes;
+	std::vector<bool> touchedFlags;   ///< True for each node handed out since the last reset.
+	std::vector<uint32_t> touched;
+	unsigned int shift;               ///< 64 - log2 of the number of slots.
+};
+
+}  // namespace footstep_planning
+
+#endif /* FOOTSTEP_PLANNING_FOOTSTEPLATTICE_H_ */
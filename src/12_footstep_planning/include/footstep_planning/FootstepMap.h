@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <limits>
+#include <stdint.h>
 #include <footstep_planning/GridMap.h>
 #include <angles/angles.h>
 
@@ -18,13 +19,29 @@ public:
 	 * @param width The width of the map in cells.
 	 * @param height The height of the map in cells.
 	 * @param data The occupancy data in row-major order.
-	 * @param distanceMaps A vector of distance maps for fast distance to obstacle lookups.
+	 * @param distanceMaps A vector of distance maps for fast distance to obstacle lookups, which
+	 *        can be empty to compute them with ClearanceMaps::compute().
 	 * @param resolution The size of a grid cell in meters.
 	 * @param scale The multiplication factor for the values of the distance maps.
+	 * @throws std::invalid_argument if a distance map does not have width x height values.
 	 */
 	FootstepMap(const size_t& width, const size_t& height, const std::vector<bool>& data,
 			const std::vector<std::vector<unsigned char> >& distanceMaps,
 			const double& resolution, const double& scale);
+
+	/**
+	 * Constructs a grid map for footstep planning from occupancy data in the tile layout of GridMap::getTiles().
+	 * @param width The width of the map in cells.
+	 * @param height The height of the map in cells.
+	 * @param tiles GridMap::getNumTiles(width, height) words with the occupancy.
+	 * @param distanceMaps See above.
+	 * @param resolution The size of a grid cell in meters.
+	 * @param scale The multiplication factor for the values of the distance maps.
+	 * @throws std::invalid_argument if a distance map does not have width x height values.
+	 */
+	FootstepMap(const size_t& width, const size_t& height, const uint64_t * const tiles,
+			const std::vector<std::vector<unsigned char> >& distanceMaps,
+			const double& resolution, const double& scale);
 	virtual ~FootstepMap();
 
 	/**
@@ -32,14 +49,97 @@ public:
 	 * @param x Foot position in x direction in meters.
 	 * @param y Foot position in y direction in meters.
 	 * @param theta Foot orientation in radians.
-	 * @return The distance to the nearest obstacle in meters.
+	 * @return The distance to the nearest obstacle in meters, 0 outside the map or without distance maps.
 	 */
 	double getDistanceToNearestObstacle(const double& x, const double& y, const double& theta) const;
 
+	/**
+	 * Tests a batch of foot poses for collisions.
+	 * @param x The foot positions in x direction in meters.
+	 * @param y The foot positions in y direction in meters.
+	 * @param theta The foot orientations in radians.
+	 * @param n The number of poses, at most MAX_BATCH_SIZE.
+	 * @param minDistance The distance to the nearest obstacle below which a foot collides.
+	 * @return Bit i is set iff getDistanceToNearestObstacle(x[i], y[i], theta[i]) < minDistance.
+	 * @throws std::length_error if n is larger than MAX_BATCH_SIZE.
+	 *
+	 * The indices of the poses are computed two at a time with SSE2 instructions where they are
+	 * available, and the values are gathered from the distance maps, which are stored one after
+	 * another in a single array, and compared with the smallest value that does not collide.
+	 */
+	uint32_t getCollisions(const double * const x, const double * const y, const double * const theta,
+			const size_t& n, const double& minDistance) const;
+
+	static const size_t MAX_BATCH_SIZE = 32;  ///< The largest number of poses of getCollisions().
+
+	/**
+	 * Returns the number of distance maps.
+	 * @return The number of orientations, which are 180 / getNumDistanceMaps() degrees apart.
+	 */
+	size_t getNumDistanceMaps() const {
+		return numDistanceMaps;
+	}
+
+	/**
+	 * Returns a distance map.
+	 * @param i The index of the orientation, i * 180 / getNumDistanceMaps() degrees.
+	 * @return The width x height values of the distance map in row-major order.
+	 * @throws std::out_of_range if i is not less than getNumDistanceMaps().
+	 */
+	const unsigned char * getDistanceMap(const size_t& i) const {
+		if (i >= numDistanceMaps) {
+			throw std::out_of_range("Index out of bounds in call to getDistanceMap()");
+		}
+		return &distanceData[i * width * height];
+	}
+
+	/**
+	 * Returns all distance maps.
+	 * @return The distance maps one after another.
+	 */
+	const std::vector<unsigned char>& getDistanceData() const {
+		return distanceData;
+	}
+
+	/**
+	 * Returns the size of a grid cell.
+	 * @return The resolution in meters.
+	 */
+	double getResolution() const {
+		return resolution;
+	}
+
+	/**
+	 * Returns the multiplication factor for the values of the distance maps.
+	 * @return The value of a distance of one cell.
+	 */
+	double getScale() const {
+		return scale;
+	}
+
 private:
-	const std::vector<std::vector<unsigned char> > distanceMaps;
+	friend class ClearanceMaps;
+
+	/**
+	 * @brief Computes the index of the value of a foot pose in distanceData.
+	 * @return False if the position is outside the map or there are no distance maps.
+	 */
+	bool getIndex(const double& x, const double& y, const double& theta, size_t& index) const;
+
+	/**
+	 * @brief Returns the smallest value of the distance maps that stands for at least minDistance meters.
+	 */
+	unsigned int getThreshold(const double& minDistance) const;
+
+	/**
+	 * @brief Stores the distance maps one after another in distanceData.
+	 */
+	void setDistanceMaps(const std::vector<std::vector<unsigned char> >& distanceMaps);
+
 	const double resolution;
 	const double scale;
+	size_t numDistanceMaps;
+	std::vector<unsigned char> distanceData;  ///< The distance maps one after another.
 };
 
 }  // namespace footstep_planning
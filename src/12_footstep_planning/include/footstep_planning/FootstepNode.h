@@ -2,7 +2,6 @@
 #define FOOTSTEP_PLANNING_FOOTSTEPNODE_H_
 
 #include <footstep_planning/AbstractNode.h>
-#include <map>
 
 namespace footstep_planning {
 
@@ -27,11 +26,21 @@ public:
 	 * @param theta The orientation of the foot step in radians.
 	 * @param foot The swing foot (LEFT or RIGHT).
 	 * @return The foot step node.
+	 * @throws std::out_of_range if the foot step is more than 83 km away from the origin.
 	 *
-	 * The foot step is allocated lazily on request.
+	 * The foot step is allocated lazily on request in a process-wide FootstepLattice with the
+	 * default resolution. FootstepPlanning uses a lattice of its own, so nodes from here are
+	 * only used as start and goal poses.
 	 */
 	static FootstepNode* get(const double& x, const double&y, const double& theta, const Foot& foot);
 
+	/**
+	 * @brief Deletes all foot step nodes returned by get().
+	 *
+	 * All pointers returned by get() become invalid.
+	 */
+	static void clear();
+
 	/**
 	 * Compares this foot step to another footstep.
 	 * @param other The other foot steps.
@@ -52,15 +61,11 @@ public:
 	std::string toLogString() const;
 
 private:
-	typedef int IndexType;
-	typedef std::map<IndexType, FootstepNode*> MapType;
-	static MapType nodes;
+	friend class FootstepLattice;
 	FootstepNode(const double& x, const double& y, const double& theta, const Foot& foot);
 
 };
 
-int hash_value(const FootstepNode &node);
-
 }
 
 #endif /* FOOTSTEP_PLANNING_FOOTSTEPNODE_H_ */
@@ -3,16 +3,24 @@
 
 #include <stdexcept>
 #include <vector>
+#include <stdint.h>
 
 namespace footstep_planning {
 
 /**
  * @brief Represents a grid map.
+ *
+ * The occupancy is stored as one bit per cell. The cells are grouped into tiles of 8x8 cells,
+ * each of which is stored in a single 64-bit word (bit (y % 8) * 8 + (x % 8)), which is also the
+ * layout of the binary map files (see FileIO::saveBinaryMap()).
  */
 struct GridMap {
 public:
 	const size_t width;   ///< The width of the map.
 	const size_t height;  ///< The height of the map.
+
+	static const int TILE_SIZE = 8;  ///< Width and height of a tile in cells.
+
 	/**
 	 * @brief Tests if a grid cell is occupied.
 	 * @param x The x coordinate of the grid cell.
@@ -21,10 +29,28 @@ public:
 	 * @throws std::out_of_range The cell index is outside the map bounds.
 	 */
 	bool isOccupied(const int& x, const int& y) const {
-		if (x < 0 || x >= static_cast<int>(width) || y < 0 || y >= static_cast<int>(width)) {
+		if (x < 0 || x >= static_cast<int>(width) || y < 0 || y >= static_cast<int>(height)) {
 			throw std::out_of_range("Index out of bounds in call to isOccupied()");
 		}
-		return data[y * width + x];
+		return (tile(x, y) >> bit(x, y)) & 1u;
+	}
+
+	/**
+	 * @brief Changes the occupancy of a grid cell.
+	 * @param x The x coordinate of the grid cell.
+	 * @param y The y coordinate of the grid cell.
+	 * @param occupied True iff the cell is occupied.
+	 * @throws std::out_of_range The cell index is outside the map bounds.
+	 *
+	 * The distance maps of a FootstepMap have to be updated separately, see ClearanceMaps::update().
+	 */
+	void setOccupied(const int& x, const int& y, const bool& occupied) {
+		if (x < 0 || x >= static_cast<int>(width) || y < 0 || y >= static_cast<int>(height)) {
+			throw std::out_of_range("Index out of bounds in call to setOccupied()");
+		}
+		uint64_t& word = tiles[(y / TILE_SIZE) * tilesPerRow + x / TILE_SIZE];
+		const uint64_t mask = static_cast<uint64_t>(1) << bit(x, y);
+		word = occupied ? (word | mask) : (word & ~mask);
 	}
 
 	/**
@@ -32,11 +58,52 @@ public:
 	 * @param width The width of the map.
 	 * @param height The height of the map.
 	 * @param data The occupancy data in row-major order.
+	 * @throws std::invalid_argument if data contains fewer than width * height cells.
+	 */
+	GridMap(const size_t& width, const size_t& height, const std::vector<bool>& data);
+
+	/**
+	 * @brief Constructs a grid map from occupancy data in the internal tile layout.
+	 * @param width The width of the map.
+	 * @param height The height of the map.
+	 * @param tiles getNumTiles(width, height) words, see getTiles().
+	 *
+	 * The data is copied as a whole, so this is the fastest way to restore a map that was
+	 * stored with getTiles().
+	 */
+	GridMap(const size_t& width, const size_t& height, const uint64_t * const tiles);
+
+	/**
+	 * @brief Returns the occupancy data in the internal tile layout.
+	 * @return The tiles in row-major order, ceil(width / TILE_SIZE) per row. Bit (y % TILE_SIZE) *
+	 *         TILE_SIZE + (x % TILE_SIZE) of tile (y / TILE_SIZE) * ceil(width / TILE_SIZE) +
+	 *         x / TILE_SIZE is set iff cell (x, y) is occupied. The bits of cells beyond the map
+	 *         bounds are zero.
+	 */
+	const std::vector<uint64_t>& getTiles() const {
+		return tiles;
+	}
+
+	/**
+	 * @brief Returns the number of tiles of a map.
+	 * @param width The width of the map.
+	 * @param height The height of the map.
+	 * @return The number of 64-bit words of the tile layout.
 	 */
-	GridMap(const size_t& width, const size_t& height, const std::vector<bool>& data) : width(width), height(height), data(data) {};
+	static size_t getNumTiles(const size_t& width, const size_t& height) {
+		return ((width + TILE_SIZE - 1) / TILE_SIZE) * ((height + TILE_SIZE - 1) / TILE_SIZE);
+	}
 
 private:
-	const std::vector<bool> data;
+	size_t tilesPerRow;
+	std::vector<uint64_t> tiles;
+
+	const uint64_t& tile(const int& x, const int& y) const {
+		return tiles[(y / TILE_SIZE) * tilesPerRow + x / TILE_SIZE];
+	}
+	static int bit(const int& x, const int& y) {
+		return (y % TILE_SIZE) * TILE_SIZE + x % TILE_SIZE;
+	}
 };
 
 }  // namespace footstep_planning
@@ -38,6 +38,13 @@ public:
 	 * @throws std::runtime_error if node is not contained in the priority queue.
 	 */
 	void updateCosts(const AbstractNode * const node, const double costs);
+	/**
+	 * @brief Returns the number of nodes in the priority queue.
+	 * @return The number of open nodes, not counting outdated copies left by updateCosts().
+	 */
+	size_t size() const {
+		return numOpen;
+	}
 	/**
 	 * @brief Tests if the priority queue is empty.
 	 * @return True iff the queue is empty.
@@ -102,6 +109,7 @@ protected:
 	typedef std::map<const AbstractNode *, NodeWrapper*> HashMap;
 
 	mutable Queue openList;  ///< Priority queue for the open list.
+	size_t numOpen;          ///< The number of open nodes.
 	bool duplicateWarning;   ///< True if a node has been added twice to the open list.
 	bool reinsertWarning;    ///< True if a node has been inserted to the open list that has already been closed.
 
@@ -17,7 +17,7 @@ namespace footstep_planning {
 class PathPlanning
 {
 public:
-	PathPlanning() {};
+	PathPlanning() : numExpansions(0), peakOpenListSize(0) {};
    	virtual ~PathPlanning() {};
    	/**
    	 * @brief Plans a path from a start node to a goal node.
@@ -52,6 +52,17 @@ public:
    	 */
    	virtual std::vector<AbstractNode *> getNeighborNodes(const AbstractNode * const currentNode) = 0;
 
+   	/**
+   	 * @brief Writes the neighbor nodes of the current node into a buffer, which expandNode() reuses for all expansions.
+   	 * @param[in] currentNode The current node.
+   	 * @param[out] neighbors The neighbor nodes that are accessible to the robot, replacing the previous contents.
+   	 *
+   	 * The default implementation copies the result of getNeighborNodes(currentNode).
+   	 */
+   	virtual void getNeighborNodes(const AbstractNode * const currentNode, std::vector<AbstractNode *>& neighbors) {
+   		neighbors = getNeighborNodes(currentNode);
+   	}
+
    	/**
    	 * @brief Returns the heuristic (wraps an instance of the Heuristic class).
    	 * @param currentNode The node currently being expanded.
@@ -78,6 +89,27 @@ public:
 	 * @throws std::invalid_argument if one of the arguments is NULL.
 	 */
 	virtual bool isCloseToGoal(const AbstractNode * const currentNode, const AbstractNode * const goalNode) = 0;
+
+	/**
+	 * @brief Returns the number of nodes that were expanded by the last call to planPath().
+	 * @return The number of expanded nodes.
+	 */
+	size_t getNumExpansions() const {
+		return numExpansions;
+	}
+
+	/**
+	 * @brief Returns the largest number of open nodes during the last call to planPath().
+	 * @return The peak size of the open list.
+	 */
+	size_t getPeakOpenListSize() const {
+		return peakOpenListSize;
+	}
+
+protected:
+	size_t numExpansions;     ///< Number of nodes expanded by the last call to planPath().
+	size_t peakOpenListSize;  ///< Largest number of open nodes during the last call to planPath().
+	std::vector<AbstractNode *> neighborBuffer;  ///< The neighbors of the node expanded last.
 };
 
 }  // namespace footstep_planning
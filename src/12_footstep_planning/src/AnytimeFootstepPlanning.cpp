@@ -0,0 +1,226 @@
+#include <footstep_planning/AnytimeFootstepPlanning.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <typeinfo>
+
+namespace footstep_planning {
+
+namespace {
+
+const double INFINITE_COSTS = std::numeric_limits<double>::infinity();
+
+}  // namespace
+
+AnytimeFootstepPlanning::AnytimeFootstepPlanning(const FootstepMap * const footstepMap, const double& initialEpsilon,
+		const double& epsilonDecrement) :
+		FootstepPlanning(footstepMap),
+		initialEpsilon(initialEpsilon), epsilonDecrement(epsilonDecrement),
+		numOpen(0), bestGoal(NULL), bestCosts(INFINITE_COSTS), bound(INFINITE_COSTS), iteration(0), numIterations(0) {
+	if (!(initialEpsilon >= 1.0)) {
+		throw std::invalid_argument("AnytimeFootstepPlanning: initialEpsilon must be at least 1");
+	}
+	if (!(epsilonDecrement > 0.0)) {
+		throw std::invalid_argument("AnytimeFootstepPlanning: epsilonDecrement must be positive");
+	}
+}
+
+bool AnytimeFootstepPlanning::hasDefaultCollisionTest() const {
+	return typeid(*this) == typeid(AnytimeFootstepPlanning);
+}
+
+double AnytimeFootstepPlanning::goalHeuristic(const AbstractNode * const node, const AbstractNode * const goal) {
+	// the plan ends at a foot step close to the goal, whose remaining costs are 0
+	return isCloseToGoal(node, goal) ? 0.0 : heuristic(node, goal);
+}
+
+void AnytimeFootstepPlanning::push(const AbstractNode * const node, State& state, const double& key) {
+	if (!state.open) {
+		state.open = true;
+		++numOpen;
+	}
+	state.key = key;
+	Entry entry = { key, node };
+	openList.push_back(entry);
+	std::push_heap(openList.begin(), openList.end());
+}
+
+bool AnytimeFootstepPlanning::improvePath(const AbstractNode * const goal, const double& epsilon,
+		const Clock::time_point& deadline, const std::atomic<bool> * const cancel) {
+	while (!openList.empty()) {
+		const Entry top = openList.front();
+		State& state = states[top.node];
+		if (!state.open || state.key != top.key) {
+			// outdated by a later push() or a pop of the same foot step
+			std::pop_heap(openList.begin(), openList.end());
+			openList.pop_back();
+			continue;
+		}
+		if (top.key >= bestCosts) {
+			return true;
+		}
+		if ((cancel && cancel->load()) || Clock::now() >= deadline) {
+			return false;
+		}
+		std::pop_heap(openList.begin(), openList.end());
+		openList.pop_back();
+		state.open = false;
+		--numOpen;
+		state.closedIn = iteration;
+		const AbstractNode * const currentNode = top.node;
+		if (isCloseToGoal(currentNode, goal)) {
+			// like in A*, goal foot steps end a plan and are not expanded
+			if (currentNode->costs < bestCosts) {
+				bestCosts = currentNode->costs;
+				bestGoal = currentNode;
+			}
+			continue;
+		}
+		++numExpansions;
+
+		getNeighborNodes(currentNode, neighborBuffer);
+		for (std::vector<AbstractNode *>::const_iterator it = neighborBuffer.begin(); it != neighborBuffer.end(); ++it) {
+			AbstractNode * const successor = *it;
+			const double g = currentNode->costs + getCosts(currentNode, successor);
+			if (!(g < INFINITE_COSTS)) {
+				continue;
+			}
+			std::unordered_map<const AbstractNode *, State>::iterator found = states.find(successor);
+			if (found != states.end() && g >= successor->costs) {
+				continue;
+			}
+			if (found == states.end()) {
+				State newState = { goalHeuristic(successor, goal), 0.0, 0, false, false };
+				found = states.insert(std::make_pair(successor, newState)).first;
+			}
+			if (!(found->second.h < INFINITE_COSTS)) {
+				// the goal cannot be reached from the successor
+				continue;
+			}
+			successor->setPredecessor(currentNode);
+			successor->costs = g;
+			State& successorState = found->second;
+			if (successorState.closedIn == iteration) {
+				if (!successorState.inconsistent) {
+					successorState.inconsistent = true;
+					inconsistent.push_back(successor);
+				}
+			} else {
+				push(successor, successorState, g + epsilon * successorState.h);
+			}
+		}
+		peakOpenListSize = std::max(peakOpenListSize, numOpen);
+	}
+	return true;
+}
+
+double AnytimeFootstepPlanning::getLowerBound() const {
+	double result = INFINITE_COSTS;
+	for (std::unordered_map<const AbstractNode *, State>::const_iterator it = states.begin(); it != states.end(); ++it) {
+		if (it->second.open || it->second.inconsistent) {
+			result = std::min(result, it->first->costs + it->second.h);
+		}
+	}
+	return result;
+}
+
+void AnytimeFootstepPlanning::reorder(const double& epsilon) {
+	for (size_t i = 0; i < inconsistent.size(); ++i) {
+		State& state = states[inconsistent[i]];
+		state.inconsistent = false;
+		if (!state.open) {
+			state.open = true;
+			++numOpen;
+		}
+	}
+	inconsistent.clear();
+	openList.clear();
+	for (std::unordered_map<const AbstractNode *, State>::iterator it = states.begin(); it != states.end(); ++it) {
+		if (it->second.open) {
+			it->second.key = it->first->costs + epsilon * it->second.h;
+			Entry entry = { it->second.key, it->first };
+			openList.push_back(entry);
+		}
+	}
+	std::make_heap(openList.begin(), openList.end());
+}
+
+std::deque<const AbstractNode*> AnytimeFootstepPlanning::planPath(const AbstractNode * const startNode,
+		const AbstractNode * const goalNode, const Clock::time_point& deadline, const Callback& callback,
+		const std::atomic<bool> * const cancel) {
+	if (!startNode) {
+		throw std::invalid_argument("AnytimeFootstepPlanning::planPath(): startNode is NULL");
+	}
+	if (!goalNode) {
+		throw std::invalid_argument("AnytimeFootstepPlanning::planPath(): goalNode is NULL");
+	}
+	const Clock::time_point startTime = Clock::now();
+	lattice.reset();
+	states.clear();
+	openList.clear();
+	inconsistent.clear();
+	numOpen = 0;
+	bestGoal = NULL;
+	bestCosts = INFINITE_COSTS;
+	bound = INFINITE_COSTS;
+	iteration = 1;
+	numIterations = 0;
+	numExpansions = 0;
+	peakOpenListSize = 0;
+
+	const FootstepNode * const start = static_cast<const FootstepNode *>(startNode);
+	const FootstepNode * const goal = static_cast<const FootstepNode *>(goalNode);
+	FootstepNode * const latticeStart = lattice.get(start->x, start->y, start->theta, start->foot);
+	const FootstepNode * const latticeGoal = lattice.get(goal->x, goal->y, goal->theta, goal->foot);
+	(customHeuristic_ ? *customHeuristic_ : heuristic_).setGoal(latticeGoal);
+
+	double epsilon = initialEpsilon;
+	State startState = { goalHeuristic(latticeStart, latticeGoal), 0.0, 0, false, false };
+	push(latticeStart, states.insert(std::make_pair(latticeStart, startState)).first->second, epsilon * startState.h);
+	peakOpenListSize = numOpen;
+
+	double publishedCosts = INFINITE_COSTS;
+	double publishedBound = INFINITE_COSTS;
+	double completedEpsilon = INFINITE_COSTS;  // the inflation of the last iteration that has run to the end
+	while (true) {
+		++numIterations;
+		const bool completed = improvePath(latticeGoal, epsilon, deadline, cancel);
+		if (completed) {
+			completedEpsilon = epsilon;
+		}
+		if (!bestGoal) {
+			// the start is enclosed by collisions, or the search was interrupted before the first plan
+			break;
+		}
+		// no plan is cheaper than the smallest unweighted f-value of the foot steps that can still improve
+		const double lowerBound = getLowerBound();
+		bound = std::max(1.0, lowerBound > 0.0 ? std::min(completedEpsilon, bestCosts / lowerBound) : completedEpsilon);
+		if (bestCosts < publishedCosts || bound < publishedBound) {
+			publishedCosts = bestCosts;
+			publishedBound = bound;
+			if (callback) {
+				Solution solution;
+				solution.path = followPath(bestGoal);
+				solution.costs = bestCosts;
+				solution.epsilon = epsilon;
+				solution.bound = bound;
+				solution.numExpansions = numExpansions;
+				solution.seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+				callback(solution);
+			}
+		}
+		if (!completed || bound <= 1.0) {
+			break;
+		}
+		epsilon = std::max(1.0, epsilon - epsilonDecrement);
+		++iteration;
+		reorder(epsilon);
+	}
+	if (!bestGoal) {
+		return std::deque<const AbstractNode*>();
+	}
+	return followPath(bestGoal);
+}
+
+}  // namespace footstep_planning
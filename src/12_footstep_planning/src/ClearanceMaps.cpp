@@ -0,0 +1,325 @@
+#include <footstep_planning/ClearanceMaps.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace footstep_planning {
+
+namespace {
+
+const int BLOCK_SIZE = 16;          ///< The number of rows or columns of a work item.
+const unsigned char FREE = 255;     ///< The value of cells outside the dilated obstacles before the column pass.
+const double EPSILON = 1e-9;
+
+typedef std::pair<int, int> Run;    ///< The first and the last x coordinate of consecutive occupied cells of a row.
+
+/**
+ * @brief The cells covered by the rotated foot, as a range of x offsets for each y offset.
+ */
+struct Footprint {
+	int radius;              ///< The largest offset along x or y.
+	std::vector<int> first;  ///< The smallest x offset for the y offset i - radius, larger than last if there is none.
+	std::vector<int> last;   ///< The largest x offset for the y offset i - radius.
+};
+
+int footprintRadius(const double& halfLength, const double& halfWidth) {
+	return static_cast<int>(std::ceil(std::sqrt(halfLength * halfLength + halfWidth * halfWidth) + 0.5));
+}
+
+/**
+ * @brief Returns the offsets of the occupied cells that the foot at the cell (0, 0) overlaps.
+ * @param halfLength Half of the length of the foot in cells.
+ * @param halfWidth Half of the width of the foot in cells.
+ * @param theta The orientation of the foot in radians, counterclockwise with y upwards.
+ *
+ * The rectangle of the foot and the square of a cell overlap unless they are separated along
+ * one of the axes of the foot or of the map.
+ */
+Footprint footprintFor(const double& halfLength, const double& halfWidth, const double& theta) {
+	Footprint footprint;
+	footprint.radius = footprintRadius(halfLength, halfWidth);
+	const double c = std::cos(theta);
+	const double s = std::sin(theta);
+	// half of the extent of a cell along the axes of the foot, and of the foot along the axes of the map
+	const double cellExtent = 0.5 * (std::fabs(c) + std::fabs(s));
+	const double extentX = halfLength * std::fabs(c) + halfWidth * std::fabs(s);
+	const double extentY = halfLength * std::fabs(s) + halfWidth * std::fabs(c);
+	for (int dy = -footprint.radius; dy <= footprint.radius; ++dy) {
+		int first = footprint.radius + 1;
+		int last = -footprint.radius - 1;
+		for (int dx = -footprint.radius; dx <= footprint.radius; ++dx) {
+			// the rows of the map count downwards
+			const double along = dx * c - dy * s;
+			const double across = -dx * s - dy * c;
+			if (std::fabs(along) <= halfLength + cellExtent + EPSILON && std::fabs(across) <= halfWidth + cellExtent + EPSILON
+					&& std::abs(dx) <= extentX + 0.5 + EPSILON && std::abs(dy) <= extentY + 0.5 + EPSILON) {
+				first = std::min(first, dx);
+				last = std::max(last, dx);
+			}
+		}
+		footprint.first.push_back(first);
+		footprint.last.push_back(last);
+	}
+	return footprint;
+}
+
+/**
+ * @brief Returns the number of cells beyond which all distances saturate at 255.
+ */
+int saturationDistance(const double& scale) {
+	return static_cast<int>(std::ceil(255.0 / scale)) + 1;
+}
+
+/**
+ * @brief Calls work(i) for i = 0, ..., numItems - 1 on numThreads threads (0 for one per hardware thread).
+ *
+ * The first exception thrown by a call is rethrown after all threads have finished.
+ */
+template <typename Work>
+void parallelFor(const size_t& numItems, const size_t& numThreads, const Work& work) {
+	size_t n = numThreads;
+	if (n == 0) {
+		n = std::thread::hardware_concurrency();
+		if (n == 0) {
+			n = 1;
+		}
+	}
+	n = std::min(n, numItems);
+
+	std::atomic<size_t> next(0);
+	std::mutex errorMutex;
+	std::exception_ptr error;
+	const auto run = [&]() {
+		try {
+			size_t i;
+			while ((i = next.fetch_add(1)) < numItems) {
+				work(i);
+			}
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	for (size_t t = 1; t < n; ++t) {
+		threads.push_back(std::thread(run));
+	}
+	run();
+	for (size_t t = 0; t < threads.size(); ++t) {
+		threads[t].join();
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+}  // namespace
+
+ClearanceMaps::ClearanceMaps(const double& footLength, const double& footWidth, const size_t& numThreads) :
+		footLength(footLength), footWidth(footWidth), numThreads(numThreads)
+{
+	if (!(footLength >= 0.0) || !(footWidth >= 0.0)) {
+		throw std::invalid_argument("ClearanceMaps: the size of the foot must not be negative");
+	}
+}
+
+void ClearanceMaps::compute(FootstepMap& map, const size_t& numAngles) const {
+	if (numAngles == 0) {
+		throw std::invalid_argument("ClearanceMaps::compute(): numAngles is 0");
+	}
+	if (!(map.getScale() >= 1.0)) {
+		throw std::invalid_argument("ClearanceMaps::compute(): the scale of the map is less than 1");
+	}
+	map.numDistanceMaps = numAngles;
+	map.distanceData.assign(numAngles * map.width * map.height, 0);
+	const int width = static_cast<int>(map.width);
+	const int height = static_cast<int>(map.height);
+	computeWindow(map, 0, 0, width, height, 0, 0, width, height);
+}
+
+void ClearanceMaps::update(FootstepMap& map, const int& x, const int& y, const int& width, const int& height) const {
+	if (x < 0 || y < 0 || width < 0 || height < 0
+			|| static_cast<size_t>(x) + width > map.width || static_cast<size_t>(y) + height > map.height) {
+		throw std::out_of_range("ClearanceMaps::update(): the rectangle is outside the map");
+	}
+	if (map.numDistanceMaps == 0) {
+		throw std::invalid_argument("ClearanceMaps::update(): the map has no distance maps");
+	}
+	if (!(map.getScale() >= 1.0)) {
+		throw std::invalid_argument("ClearanceMaps::update(): the scale of the map is less than 1");
+	}
+	if (width == 0 || height == 0) {
+		return;
+	}
+
+	// the dilated obstacles change within the foot of the changed cells, and the distances
+	// change within the saturation distance of those
+	const int saturation = saturationDistance(map.getScale());
+	const int reach = footprintRadius(footLength / (2.0 * map.getResolution()), footWidth / (2.0 * map.getResolution())) + saturation;
+	const int mapWidth = static_cast<int>(map.width);
+	const int mapHeight = static_cast<int>(map.height);
+	const int ox0 = std::max(0, x - reach);
+	const int oy0 = std::max(0, y - reach);
+	const int ox1 = std::min(mapWidth, x + width + reach);
+	const int oy1 = std::min(mapHeight, y + height + reach);
+	computeWindow(map, std::max(0, ox0 - saturation), std::max(0, oy0 - saturation),
+			std::min(mapWidth, ox1 + saturation), std::min(mapHeight, oy1 + saturation), ox0, oy0, ox1, oy1);
+}
+
+void ClearanceMaps::computeWindow(FootstepMap& map, const int& x0, const int& y0, const int& x1, const int& y1,
+		const int& ox0, const int& oy0, const int& ox1, const int& oy1) const {
+	const size_t numAngles = map.numDistanceMaps;
+	unsigned char * const layers = &map.distanceData[0];
+	const int width = x1 - x0;
+	const int height = y1 - y0;
+	const int mapWidth = static_cast<int>(map.width);
+	const int mapHeight = static_cast<int>(map.height);
+
+	std::vector<Footprint> footprints;
+	for (size_t a = 0; a < numAngles; ++a) {
+		footprints.push_back(footprintFor(footLength / (2.0 * map.getResolution()), footWidth / (2.0 * map.getResolution()),
+				M_PI * static_cast<double>(a) / static_cast<double>(numAngles)));
+	}
+	const int radius = footprints[0].radius;
+
+	// the runs of occupied cells whose foot prints reach into the window
+	const int runsX0 = std::max(0, x0 - radius);
+	const int runsX1 = std::min(mapWidth, x1 + radius);
+	const int runsY0 = std::max(0, y0 - radius);
+	const int runsY1 = std::min(mapHeight, y1 + radius);
+	std::vector<std::vector<Run> > runs(runsY1 - runsY0);
+	parallelFor((runs.size() + BLOCK_SIZE - 1) / BLOCK_SIZE, numThreads, [&](const size_t& block) {
+		const int end = std::min(runsY1, static_cast<int>(runsY0 + (block + 1) * BLOCK_SIZE));
+		for (int row = runsY0 + static_cast<int>(block) * BLOCK_SIZE; row < end; ++row) {
+			std::vector<Run>& rowRuns = runs[row - runsY0];
+			for (int x = runsX0; x < runsX1; ++x) {
+				if (map.isOccupied(x, row)) {
+					if (!rowRuns.empty() && rowRuns.back().second == x - 1) {
+						rowRuns.back().second = x;
+					} else {
+						rowRuns.push_back(Run(x, x));
+					}
+				}
+			}
+		}
+	});
+
+	// the distance maps are computed in place if the window covers the map, otherwise in a copy of the window
+	const bool inPlace = (width == mapWidth && height == mapHeight);
+	std::vector<std::vector<unsigned char> > windows(inPlace ? 0 : numAngles, std::vector<unsigned char>(width * height));
+	std::vector<unsigned char *> buffers(numAngles);
+	for (size_t a = 0; a < numAngles; ++a) {
+		buffers[a] = inPlace ? layers + a * map.width * map.height : &windows[a][0];
+	}
+
+	// the values of the squared distances in cells below saturation
+	std::vector<unsigned char> values;
+	for (size_t squared = 0; ; ++squared) {
+		const double value = std::floor(std::sqrt(static_cast<double>(squared)) * map.getScale() + EPSILON);
+		if (value >= 255.0) {
+			break;
+		}
+		values.push_back(static_cast<unsigned char>(value));
+	}
+
+	// dilation: the cells of a row that are covered by the foot at an occupied cell become 0
+	const size_t rowBlocks = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	parallelFor(numAngles * rowBlocks, numThreads, [&](const size_t& item) {
+		const Footprint& footprint = footprints[item / rowBlocks];
+		unsigned char * const buffer = buffers[item / rowBlocks];
+		const int begin = y0 + static_cast<int>(item % rowBlocks) * BLOCK_SIZE;
+		for (int row = begin; row < std::min(y1, begin + BLOCK_SIZE); ++row) {
+			unsigned char * const cells = buffer + (row - y0) * width;
+			std::fill(cells, cells + width, FREE);
+			for (int dy = -footprint.radius; dy <= footprint.radius; ++dy) {
+				const int first = footprint.first[dy + footprint.radius];
+				const int last = footprint.last[dy + footprint.radius];
+				const int source = row - dy;
+				if (first > last || source < runsY0 || source >= runsY1) {
+					continue;
+				}
+				const std::vector<Run>& rowRuns = runs[source - runsY0];
+				for (size_t r = 0; r < rowRuns.size(); ++r) {
+					const int from = std::max(x0, rowRuns[r].first + first);
+					const int to = std::min(x1 - 1, rowRuns[r].second + last);
+					if (from <= to) {
+						std::fill(cells + (from - x0), cells + (to - x0 + 1), 0);
+					}
+				}
+			}
+		}
+	});
+
+	// column pass: the distance to the nearest dilated cell in the same column, at most 255
+	const size_t columnBlocks = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	parallelFor(numAngles * columnBlocks, numThreads, [&](const size_t& item) {
+		unsigned char * const buffer = buffers[item / columnBlocks];
+		const int begin = static_cast<int>(item % columnBlocks) * BLOCK_SIZE;
+		for (int x = begin; x < std::min(width, begin + BLOCK_SIZE); ++x) {
+			unsigned char * const column = buffer + x;
+			int distance = FREE;
+			for (int row = 0; row < height; ++row) {
+				distance = column[row * width] == 0 ? 0 : std::min<int>(FREE, distance + 1);
+				column[row * width] = static_cast<unsigned char>(distance);
+			}
+			for (int row = height - 2; row >= 0; --row) {
+				distance = std::min<int>(column[row * width], column[(row + 1) * width] + 1);
+				column[row * width] = static_cast<unsigned char>(distance);
+			}
+		}
+	});
+
+	// row pass: the lower envelope of the parabolas (x - q)^2 + f(q) with the squared column distances f
+	const size_t outputBlocks = (oy1 - oy0 + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	parallelFor(numAngles * outputBlocks, numThreads, [&](const size_t& item) {
+		const size_t a = item / outputBlocks;
+		std::vector<double> f(width);
+		std::vector<int> vertices(width);
+		std::vector<double> bounds(width + 1);
+		const int begin = oy0 + static_cast<int>(item % outputBlocks) * BLOCK_SIZE;
+		for (int row = begin; row < std::min(oy1, begin + BLOCK_SIZE); ++row) {
+			const unsigned char * const cells = buffers[a] + (row - y0) * width;
+			for (int q = 0; q < width; ++q) {
+				f[q] = static_cast<double>(cells[q]) * cells[q];
+			}
+			int k = 0;
+			vertices[0] = 0;
+			bounds[0] = -std::numeric_limits<double>::infinity();
+			bounds[1] = std::numeric_limits<double>::infinity();
+			for (int q = 1; q < width; ++q) {
+				double s;
+				while (true) {
+					const int p = vertices[k];
+					s = ((f[q] + static_cast<double>(q) * q) - (f[p] + static_cast<double>(p) * p)) / (2.0 * (q - p));
+					if (s > bounds[k]) {
+						break;
+					}
+					--k;
+				}
+				++k;
+				vertices[k] = q;
+				bounds[k] = s;
+				bounds[k + 1] = std::numeric_limits<double>::infinity();
+			}
+			unsigned char * const output = layers + (a * map.height + row) * map.width;
+			k = 0;
+			for (int x = ox0 - x0; x < ox1 - x0; ++x) {
+				while (bounds[k + 1] < x) {
+					++k;
+				}
+				const double squared = static_cast<double>(x - vertices[k]) * (x - vertices[k]) + f[vertices[k]];
+				output[x0 + x] = squared < values.size() ? values[static_cast<size_t>(squared)] : 255;
+			}
+		}
+	});
+}
+
+}  // namespace footstep_planning
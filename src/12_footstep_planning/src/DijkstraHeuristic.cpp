@@ -0,0 +1,195 @@
+#include <footstep_planning/DijkstraHeuristic.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace footstep_planning {
+
+namespace {
+
+const double INFINITE_COSTS = std::numeric_limits<double>::infinity();
+const double SQRT2 = std::sqrt(2.0);
+const double OCTILE_FACTOR = 1.0824;  ///< Upper bound of octile / Euclidean distance, sqrt(4 - 2 * sqrt(2)) = 1.08239.
+const double MIN_CLEARANCE = 0.01;    ///< The distance to the nearest obstacle below which FootstepPlanning::isColliding() reports a collision.
+
+/**
+ * @brief Returns the number of map cells along each side of a cell of about cellSize meters.
+ */
+size_t cellsPerCellFor(const double& cellSize, const double& resolution) {
+	return static_cast<size_t>(std::max(1.0, std::floor(cellSize / resolution + 0.5)));
+}
+
+/**
+ * @brief Sets each cell of a row-major grid to true if a cell at most radius cells away along x or y is true.
+ */
+void dilate(std::vector<bool>& grid, const size_t& width, const size_t& height, const size_t& radius) {
+	std::vector<bool> result(grid.size(), false);
+	// rows: the number of true cells in the window around x
+	for (size_t y = 0; y < height; ++y) {
+		const size_t row = y * width;
+		size_t count = 0;
+		for (size_t x = 0; x < std::min(radius, width); ++x) {
+			count += grid[row + x];
+		}
+		for (size_t x = 0; x < width; ++x) {
+			if (x + radius < width) {
+				count += grid[row + x + radius];
+			}
+			if (x > radius) {
+				count -= grid[row + x - radius - 1];
+			}
+			result[row + x] = count > 0;
+		}
+	}
+	// columns, on the result of the rows
+	grid.swap(result);
+	for (size_t x = 0; x < width; ++x) {
+		size_t count = 0;
+		for (size_t y = 0; y < std::min(radius, height); ++y) {
+			count += grid[y * width + x];
+		}
+		for (size_t y = 0; y < height; ++y) {
+			if (y + radius < height) {
+				count += grid[(y + radius) * width + x];
+			}
+			if (y > radius) {
+				count -= grid[(y - radius - 1) * width + x];
+			}
+			result[y * width + x] = count > 0;
+		}
+	}
+	grid.swap(result);
+}
+
+}  // namespace
+
+DijkstraHeuristic::DijkstraHeuristic(const FootstepMap& map, const FootstepPlanning& planning, const double& cellSize, const double& weight) :
+		cellSize(cellsPerCellFor(cellSize, map.getResolution()) * map.getResolution()),
+		weight(weight),
+		maxStepLength(planning.getMaxStepLength()),
+		costsPerMeter(planning.getCostsPerMeter()),
+		map(map),
+		cellsPerCell(cellsPerCellFor(cellSize, map.getResolution())),
+		width((map.width + cellsPerCell - 1) / cellsPerCell),
+		height((map.height + cellsPerCell - 1) / cellsPerCell),
+		passable(width * height, false),
+		goalCell(-1)
+{
+	if (cellSize < 0.0) {
+		throw std::invalid_argument("DijkstraHeuristic: cellSize must not be negative");
+	}
+	if (!(weight > 0.0)) {
+		throw std::invalid_argument("DijkstraHeuristic: weight must be positive");
+	}
+
+	// the cells that contain a position where the foot fits in some orientation
+	for (size_t t = 0; t < map.getNumDistanceMaps(); ++t) {
+		const unsigned char * const distanceMap = map.getDistanceMap(t);
+		for (size_t row = 0; row < map.height; ++row) {
+			const size_t cellRow = row / cellsPerCell * width;
+			for (size_t x = 0; x < map.width; ++x) {
+				// same comparison as FootstepPlanning::isColliding()
+				if (static_cast<double>(distanceMap[row * map.width + x]) / map.getScale() * map.getResolution() >= MIN_CLEARANCE) {
+					passable[cellRow + x / cellsPerCell] = true;
+				}
+			}
+		}
+	}
+	// the line between every second foot step stays within one step (plus the rounding of the
+	// foot position to a map cell) of a foot step
+	const double radius = maxStepLength + map.getResolution();
+	dilate(passable, width, height, static_cast<size_t>(std::ceil(radius / this->cellSize)));
+}
+
+long DijkstraHeuristic::cellIndex(const double& x, const double& y) const {
+	// the same rounding as FootstepMap::getDistanceToNearestObstacle(), whose rows start at the top
+	const double xs = std::floor(x / map.getResolution() + 0.5);
+	const double row = static_cast<double>(map.height) - std::floor(y / map.getResolution() + 0.5);
+	if (!(xs >= 0.0 && xs < map.width && row >= 0.0 && row < map.height)) {
+		return -1;
+	}
+	return static_cast<long>(static_cast<size_t>(row) / cellsPerCell * width + static_cast<size_t>(xs) / cellsPerCell);
+}
+
+void DijkstraHeuristic::setGoal(const FootstepNode * const goalFootstep) {
+	if (!goalFootstep) {
+		throw std::invalid_argument("DijkstraHeuristic::setGoal(): goalFootstep is NULL");
+	}
+	const long cell = cellIndex(goalFootstep->x, goalFootstep->y);
+	if (cell < 0) {
+		distances.clear();
+		goalCell = -1;
+		return;
+	}
+	if (cell == goalCell) {
+		return;
+	}
+	goalCell = cell;
+	distances.assign(width * height, INFINITE_COSTS);
+
+	typedef std::pair<double, size_t> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+	distances[cell] = 0.0;
+	queue.push(Entry(0.0, cell));
+	while (!queue.empty()) {
+		const Entry entry = queue.top();
+		queue.pop();
+		if (entry.first > distances[entry.second]) {
+			// outdated entry of a cell that has been reached on a shorter path
+			continue;
+		}
+		const long x = static_cast<long>(entry.second % width);
+		const long y = static_cast<long>(entry.second / width);
+		for (long dy = -1; dy <= 1; ++dy) {
+			for (long dx = -1; dx <= 1; ++dx) {
+				const long nx = x + dx;
+				const long ny = y + dy;
+				if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= static_cast<long>(width) || ny >= static_cast<long>(height)) {
+					continue;
+				}
+				const size_t neighbor = static_cast<size_t>(ny) * width + static_cast<size_t>(nx);
+				if (!passable[neighbor]) {
+					continue;
+				}
+				const double costs = entry.first + (dx != 0 && dy != 0 ? SQRT2 * cellSize : cellSize);
+				if (costs < distances[neighbor]) {
+					distances[neighbor] = costs;
+					queue.push(Entry(costs, neighbor));
+				}
+			}
+		}
+	}
+}
+
+double DijkstraHeuristic::getDistance(const double& x, const double& y) const {
+	const long cell = cellIndex(x, y);
+	if (cell < 0 || distances.empty()) {
+		return -1.0;
+	}
+	return distances[cell];
+}
+
+bool DijkstraHeuristic::isPassable(const double& x, const double& y) const {
+	const long cell = cellIndex(x, y);
+	return cell >= 0 && passable[cell];
+}
+
+double DijkstraHeuristic::heuristic(const FootstepNode * const currentFootstep, const FootstepNode * const goalFootstep) const {
+	const double euclidean = FootstepHeuristic::heuristic(currentFootstep, goalFootstep);
+	const long cell = cellIndex(currentFootstep->x, currentFootstep->y);
+	if (cell < 0 || distances.empty()) {
+		return weight * std::max(0.0, costsPerMeter * euclidean - (costsPerMeter - 1.0) * maxStepLength);
+	}
+	const double distance = distances[cell];
+	if (distance == INFINITE_COSTS) {
+		return INFINITE_COSTS;
+	}
+	const double d = std::max(euclidean, (distance - SQRT2 * cellSize) / OCTILE_FACTOR);
+	return weight * std::max(0.0, costsPerMeter * d - (costsPerMeter - 1.0) * maxStepLength);
+}
+
+}  // namespace footstep_planning
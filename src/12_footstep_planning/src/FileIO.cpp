@@ -1,88 +1,387 @@
 #include <footstep_planning/FileIO.h>
-#include <iostream>
+#include <footstep_planning/ClearanceMaps.h>
+#include <file-helpers.h>
+#include <cctype>
 #include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdint.h>
+#include <sys/stat.h>
 
 namespace footstep_planning {
 
-FileIO::FileIO(const std::string& package_path) {
-	const size_t angleStep = 15;
-	const std::string filename = package_path + "/data/map.pbm";
-	std::ifstream ifs(filename.c_str());
-	if (!ifs.good()) {
-		std::cerr << "Could not open map file " << filename << std::endl;
-		return;
+namespace {
+
+const char BINARY_MAP_MAGIC[8] = { 'G', 'R', 'I', 'D', 'M', 'A', 'P', '1' };
+const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+/**
+ * @brief The header of a binary map file, see FileIO::saveBinaryMap().
+ */
+struct BinaryMapHeader {
+	char magic[8];
+	uint32_t byteOrder;
+	uint32_t numLayers;
+	uint64_t width;
+	uint64_t height;
+};
+
+/**
+ * @brief The largest width and height of a map, since cells are addressed by int coordinates.
+ */
+const size_t MAX_SIZE = static_cast<size_t>(std::numeric_limits<int>::max());
+
+const uint64_t LOW_BITS = 0x0101010101010101ull;     ///< Bit 0 of each byte.
+const uint64_t GATHER_BITS = 0x0102040810204080ull;  ///< Multiplying by it moves bit 0 of byte i to bit 56 + i.
+
+bool isLittleEndian() {
+	const uint16_t one = 1;
+	return *reinterpret_cast<const unsigned char *>(&one) == 1;
+}
+
+/**
+ * @brief The header of a PBM or PGM image and the location of its raster.
+ */
+struct Image {
+	char format;      ///< '1', '4' or '5'
+	size_t width;
+	size_t height;
+	size_t maxValue;  ///< 1 for PBM images.
+	const char *raster;
+	const char *end;
+};
+
+/**
+ * @brief Reads a decimal number of the header of a PBM or PGM image, skipping whitespace and comments.
+ */
+bool readHeaderNumber(const char *& p, const char * const end, size_t& value) {
+	while (p < end && (std::isspace(static_cast<unsigned char>(*p)) || *p == '#')) {
+		if (*p == '#') {
+			while (p < end && *p != '\n') {
+				++p;
+			}
+		} else {
+			++p;
+		}
 	}
-	std::string header;
-	ifs >> header;
-	if (header != "P1") {
-		std::cerr << "Error: map file is not in PBM format" << std::endl;
-		return;
+	if (p == end || *p < '0' || *p > '9') {
+		return false;
+	}
+	value = 0;
+	while (p < end && *p >= '0' && *p <= '9') {
+		if (value > (std::numeric_limits<size_t>::max() - 9) / 10) {
+			return false;
+		}
+		value = value * 10 + static_cast<size_t>(*p - '0');
+		++p;
+	}
+	return true;
+}
+
+/**
+ * @brief Parses the header of a mapped PBM or PGM image.
+ */
+bool readImageHeader(const file_helpers::MappedFile& file, const std::string& filename, Image& image) {
+	const char *p = file.data();
+	image.end = p + file.size();
+	if (file.size() < 2 || p[0] != 'P' || (p[1] != '1' && p[1] != '4' && p[1] != '5')) {
+		std::cerr << "Error: " << filename << " is not in PBM or PGM format" << std::endl;
+		return false;
+	}
+	image.format = p[1];
+	image.maxValue = 1;
+	p += 2;
+	if (!readHeaderNumber(p, image.end, image.width) || !readHeaderNumber(p, image.end, image.height)
+			|| (image.format == '5' && !readHeaderNumber(p, image.end, image.maxValue))) {
+		std::cerr << "Error: " << filename << " has an invalid header" << std::endl;
+		return false;
+	}
+	if (image.width == 0 || image.height == 0 || image.width > MAX_SIZE || image.height > MAX_SIZE) {
+		std::cerr << "Error: " << filename << " has invalid dimensions " << image.width << " x " << image.height << std::endl;
+		return false;
 	}
+	if (image.maxValue == 0 || image.maxValue > 255) {
+		std::cerr << "Error: " << filename << " has unsupported depth " << image.maxValue << std::endl;
+		return false;
+	}
+	// a single whitespace character separates the header from the raster
+	image.raster = p < image.end ? p + 1 : p;
+	return true;
+}
+
+/**
+ * @brief Sets the occupancy of the eight cells (x, y) to (x + 7, y), where x is a multiple of eight.
+ */
+inline void setCells(std::vector<uint64_t>& tiles, const size_t& tilesPerRow, const size_t& x, const size_t& y, const unsigned int& bits) {
+	tiles[(y / GridMap::TILE_SIZE) * tilesPerRow + x / GridMap::TILE_SIZE] |= static_cast<uint64_t>(bits) << ((y % GridMap::TILE_SIZE) * GridMap::TILE_SIZE);
+}
 
-	int width = 0, height = 0;
-	ifs >> width >> height;
-	if (width > 1000 || height > 1000) {
-		throw std::runtime_error("Map is too big");
+/**
+ * @brief Lookup table that reverses the order of the bits of a byte.
+ */
+struct ReversedBits {
+	unsigned char table[256];
+	ReversedBits() {
+		for (unsigned int b = 0; b < 256; ++b) {
+			unsigned int r = 0;
+			for (unsigned int i = 0; i < 8; ++i) {
+				r |= ((b >> i) & 1u) << (7 - i);
+			}
+			table[b] = static_cast<unsigned char>(r);
+		}
 	}
+};
 
-	std::vector<bool> data;
-	data.reserve(width * height);
-	char c;
-	while (ifs.get(c)) {
-		switch (c) {
-		case '0': data.push_back(false); break;
-		case '1': data.push_back(true); break;
-		default: //ignore
-			break;
+/**
+ * @brief Decodes the occupancy of a PBM or PGM image into the tile layout of GridMap, eight cells at a time.
+ */
+bool decodeOccupancy(const Image& image, const std::string& filename, std::vector<uint64_t>& tiles) {
+	const size_t width = image.width;
+	const size_t height = image.height;
+	const size_t available = static_cast<size_t>(image.end - image.raster);
+	const size_t tilesPerRow = (width + GridMap::TILE_SIZE - 1) / GridMap::TILE_SIZE;
+	const bool wordwise = isLittleEndian();
+	tiles.assign(GridMap::getNumTiles(width, height), 0);
+	bool complete = true;
+	if (image.format == '1') {
+		// the cells are the characters '0' and '1', possibly separated by whitespace
+		const char *p = image.raster;
+		size_t x = 0, y = 0;
+		while (y < height && p < image.end) {
+			if (wordwise && x % GridMap::TILE_SIZE == 0 && x + 8 <= width && image.end - p >= 8) {
+				uint64_t word;
+				std::memcpy(&word, p, sizeof(word));
+				if (((word ^ 0x3030303030303030ull) & ~LOW_BITS) == 0) {
+					// eight digits in a row: gather their lowest bits into one byte
+					setCells(tiles, tilesPerRow, x, y, static_cast<unsigned int>(((word & LOW_BITS) * GATHER_BITS) >> 56));
+					p += 8;
+					x += 8;
+					if (x == width) {
+						x = 0;
+						++y;
+					}
+					continue;
+				}
+			}
+			const char c = *p++;
+			if (c == '0' || c == '1') {
+				if (c == '1') {
+					setCells(tiles, tilesPerRow, x & ~static_cast<size_t>(7), y, 1u << (x % 8));
+				}
+				if (++x == width) {
+					x = 0;
+					++y;
+				}
+			}
 		}
+		complete = (y == height);
+	} else if (image.format == '4') {
+		// the cells are packed into bytes, the first cell in the most significant bit, but the
+		// lowest bit in a tile, so that one byte covers exactly the cells of one row of a tile
+		static const ReversedBits reversed;
+		const size_t bytesPerRow = (width + 7) / 8;
+		const unsigned int lastMask = width % 8 == 0 ? 0xFFu : (1u << (width % 8)) - 1u;
+		complete = available / bytesPerRow >= height;
+		for (size_t y = 0; complete && y < height; ++y) {
+			const unsigned char * const row = reinterpret_cast<const unsigned char *>(image.raster + y * bytesPerRow);
+			for (size_t b = 0; b + 1 < bytesPerRow; ++b) {
+				if (row[b]) {
+					setCells(tiles, tilesPerRow, b * 8, y, reversed.table[row[b]]);
+				}
+			}
+			setCells(tiles, tilesPerRow, (bytesPerRow - 1) * 8, y, reversed.table[row[bytesPerRow - 1]] & lastMask);
+		}
+	} else {
+		// dark cells are occupied
+		complete = available / width >= height;
+		for (size_t y = 0; complete && y < height; ++y) {
+			const unsigned char * const row = reinterpret_cast<const unsigned char *>(image.raster + y * width);
+			size_t x = 0;
+			if (wordwise && image.maxValue == 255) {
+				for (; x + 8 <= width; x += 8) {
+					uint64_t word;
+					std::memcpy(&word, row + x, sizeof(word));
+					// values below 128 have a clear highest bit
+					const uint64_t dark = (~word >> 7) & LOW_BITS;
+					if (dark) {
+						setCells(tiles, tilesPerRow, x, y, static_cast<unsigned int>((dark * GATHER_BITS) >> 56));
+					}
+				}
+			}
+			for (; x < width; ++x) {
+				if (2 * static_cast<size_t>(row[x]) < image.maxValue) {
+					setCells(tiles, tilesPerRow, x & ~static_cast<size_t>(7), y, 1u << (x % 8));
+				}
+			}
+		}
+	}
+	if (!complete) {
+		std::cerr << "Error: " << filename << " has fewer than " << width << " x " << height << " cells" << std::endl;
+	}
+	return complete;
+}
+
+/**
+ * @brief Reads the occupancy and the distance maps of a mapped binary map file.
+ *
+ * The occupancy is stored in the tile layout of GridMap, so it is copied word by word.
+ */
+bool readBinaryMap(const file_helpers::MappedFile& file, const std::string& filename, size_t& width, size_t& height,
+		std::vector<uint64_t>& tiles, std::vector<std::vector<unsigned char> >& distanceMaps) {
+	BinaryMapHeader header;
+	if (file.size() < sizeof(header)) {
+		std::cerr << "Error: binary map file " << filename << " is truncated" << std::endl;
+		return false;
+	}
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (header.byteOrder != BYTE_ORDER_MARK) {
+		std::cerr << "Error: binary map file " << filename << " was written with a different byte order" << std::endl;
+		return false;
 	}
-	ifs.close();
+	if (header.width == 0 || header.height == 0 || header.width > MAX_SIZE || header.height > MAX_SIZE) {
+		std::cerr << "Error: binary map file " << filename << " has invalid dimensions" << std::endl;
+		return false;
+	}
+	width = static_cast<size_t>(header.width);
+	height = static_cast<size_t>(header.height);
+	const size_t numTiles = GridMap::getNumTiles(width, height);
+	const size_t layerSize = (width * height + 7) & ~static_cast<size_t>(7);
+	const size_t tilesEnd = sizeof(header) + numTiles * sizeof(uint64_t);
+	if (file.size() < tilesEnd || (file.size() - tilesEnd) % layerSize != 0 || (file.size() - tilesEnd) / layerSize != header.numLayers) {
+		std::cerr << "Error: binary map file " << filename << " does not have the size given by its header" << std::endl;
+		return false;
+	}
+
+	tiles.resize(numTiles);
+	std::memcpy(&tiles[0], file.data() + sizeof(header), numTiles * sizeof(uint64_t));
+	distanceMaps.resize(header.numLayers);
+	for (size_t i = 0; i < distanceMaps.size(); ++i) {
+		const unsigned char * const layer = reinterpret_cast<const unsigned char *>(file.data() + tilesEnd + i * layerSize);
+		distanceMaps[i].assign(layer, layer + width * height);
+	}
+	return true;
+}
+
+/**
+ * @brief Reads the occupancy of a mapped PBM, PGM or binary map file in the tile layout of GridMap.
+ */
+bool readOccupancy(const std::string& filename, size_t& width, size_t& height, std::vector<uint64_t>& tiles) {
+	file_helpers::MappedFile file;
+	if (!file.open(filename)) {
+		std::cerr << "Could not open map file " << filename << std::endl;
+		return false;
+	}
+	if (file.size() >= sizeof(BINARY_MAP_MAGIC) && std::memcmp(file.data(), BINARY_MAP_MAGIC, sizeof(BINARY_MAP_MAGIC)) == 0) {
+		std::vector<std::vector<unsigned char> > distanceMaps;
+		return readBinaryMap(file, filename, width, height, tiles, distanceMaps);
+	}
+	Image image;
+	if (!readImageHeader(file, filename, image) || !decodeOccupancy(image, filename, tiles)) {
+		return false;
+	}
+	width = image.width;
+	height = image.height;
+	return true;
+}
 
-	std::vector<std::vector<unsigned char> > distanceMaps(180 / angleStep);
+/**
+ * @brief Tests if a file exists.
+ */
+bool fileExists(const std::string& filename) {
+	struct stat status;
+	return stat(filename.c_str(), &status) == 0;
+}
 
-	const size_t bufferLength = package_path.length() + 25;
-	char *buffer = (char *) calloc(bufferLength, sizeof(char));
-	memset(buffer, 0, bufferLength);
+/**
+ * @brief Tests if a file has been modified after another one.
+ * @return True iff both files exist and the first is strictly newer.
+ */
+bool isNewer(const std::string& filename, const std::string& other) {
+	struct stat status, otherStatus;
+	return stat(filename.c_str(), &status) == 0 && stat(other.c_str(), &otherStatus) == 0
+			&& status.st_mtime > otherStatus.st_mtime;
+}
+
+}  // namespace
+
+FileIO::FileIO(const std::string& package_path, const bool& cacheMap) : map(NULL) {
+	const size_t angleStep = 15;
+	const std::string filename = package_path + "/data/map.pbm";
+	const std::string cacheFilename = package_path + "/data/map.bin";
+	std::vector<std::string> distanceFilenames;
+	bool cached = isNewer(cacheFilename, filename);
+	bool computed = false;
 	for (size_t angle = 0; angle < 180; angle += angleStep) {
-		size_t i = angle / angleStep;
-		snprintf(buffer, bufferLength, "%s/data/distance_%zu.pgm", package_path.c_str(), angle);
-		ifs.open(buffer, std::ios::binary);
-		if (!ifs.good()) {
-			std::cerr << "Could not load " << buffer << " for reading distance map." << std::endl;
+		std::ostringstream distanceFilename;
+		distanceFilename << package_path << "/data/distance_" << angle << ".pgm";
+		distanceFilenames.push_back(distanceFilename.str());
+		if (fileExists(distanceFilenames.back())) {
+			cached = cached && isNewer(cacheFilename, distanceFilenames.back());
+		} else {
+			computed = true;
+		}
+	}
+
+	size_t width = 0, height = 0;
+	std::vector<uint64_t> tiles;
+	std::vector<std::vector<unsigned char> > distanceMaps;
+	if (cached) {
+		file_helpers::MappedFile file;
+		if (file.open(cacheFilename) && readBinaryMap(file, cacheFilename, width, height, tiles, distanceMaps)
+				&& distanceMaps.size() == distanceFilenames.size()) {
+			map = new FootstepMap(width, height, &tiles[0], distanceMaps, 0.01, 5.0);
+			return;
+		}
+	}
+
+	if (!readOccupancy(filename, width, height, tiles)) {
+		return;
+	}
+	if (computed) {
+		FootstepMap * const computedMap = new FootstepMap(width, height, &tiles[0], distanceMaps, 0.01, 5.0);
+		ClearanceMaps().compute(*computedMap, distanceFilenames.size());
+		map = computedMap;
+		if (cacheMap) {
+			saveBinaryMap(cacheFilename, *map);
+		}
+		return;
+	}
+	distanceMaps.resize(distanceFilenames.size());
+	for (size_t i = 0; i < distanceFilenames.size(); ++i) {
+		file_helpers::MappedFile file;
+		if (!file.open(distanceFilenames[i])) {
+			std::cerr << "Could not load " << distanceFilenames[i] << " for reading distance map." << std::endl;
+			return;
+		}
+		Image image;
+		if (!readImageHeader(file, distanceFilenames[i], image)) {
 			return;
 		}
-		ifs >> header;
-		if (header != "P5") {
+		if (image.format != '5') {
 			std::cerr << "Error: distance map file is not in PGM format" << std::endl;
 			return;
 		}
-
-		int nwidth, nheight, depth;
-		ifs >> nwidth >> nheight >> depth;
-		if (width != nwidth || height != nheight) {
+		if (width != image.width || height != image.height) {
 			std::cerr << "Error: distance map does not have same dimensions as map" << std::endl;
 			return;
 		}
-		if (depth != 255) {
-			std::cerr << "Error: distance map has invalid depth " << depth << std::endl;
+		if (image.maxValue != 255) {
+			std::cerr << "Error: distance map has invalid depth " << image.maxValue << std::endl;
 			return;
 		}
-
-		distanceMaps[i].reserve(width * height);
-		ifs.get(c); // line break
-		while (ifs.get(c)) {
-			distanceMaps[i].push_back(c);
-		}
-		ifs.close();
-		if (distanceMaps[i].size() != static_cast<size_t>(width * height)) {
-			std::cerr << "Error: distance map has " << distanceMaps[i].size() << " elements, but expected " << width << " x " << height << " = " << width * height << " elements." << std::endl;
+		if (static_cast<size_t>(image.end - image.raster) / width < height) {
+			std::cerr << "Error: distance map has " << image.end - image.raster << " elements, but expected " << width << " x " << height << " = " << width * height << " elements." << std::endl;
 			return;
 		}
+		const unsigned char * const raster = reinterpret_cast<const unsigned char *>(image.raster);
+		distanceMaps[i].assign(raster, raster + width * height);
 	}
-	free(buffer);
-	buffer = NULL;
 
-	map = new FootstepMap(width, height, data, distanceMaps, 0.01, 5.0);
+	map = new FootstepMap(width, height, &tiles[0], distanceMaps, 0.01, 5.0);
+	if (cacheMap) {
+		saveBinaryMap(cacheFilename, *map);
+	}
 }
 
 FileIO::~FileIO()  {
@@ -104,40 +403,40 @@ void FileIO::logPath(const std::string& filename, std::deque<const AbstractNode*
 }
 
 const GridMap * FileIO::loadMap(const std::string& filename) {
-	std::ifstream ifs(filename.c_str());
-	if (!ifs.good()) {
-		std::cerr << "Could not open map file " << filename << std::endl;
-		return NULL;
-	}
-	std::string header;
-	ifs >> header;
-	if (header != "P1") {
-		std::cerr << "Error: map file is not in PBM format" << std::endl;
+	size_t width = 0, height = 0;
+	std::vector<uint64_t> tiles;
+	if (!readOccupancy(filename, width, height, tiles)) {
 		return NULL;
 	}
+	return new GridMap(width, height, &tiles[0]);
+}
 
-	size_t width = 0, height = 0;
-	ifs >> width >> height;
-	if (width > 100 || height > 100) {
-		throw std::runtime_error("Map is too big");
+bool FileIO::saveBinaryMap(const std::string& filename, const FootstepMap& map) {
+	std::ofstream ofs(filename.c_str(), std::ios::binary);
+	if (!ofs.is_open()) {
+		std::cerr << "Error: Could not open " << filename << " for writing the map." << std::endl;
+		return false;
 	}
+	BinaryMapHeader header;
+	std::memcpy(header.magic, BINARY_MAP_MAGIC, sizeof(BINARY_MAP_MAGIC));
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.numLayers = static_cast<uint32_t>(map.getNumDistanceMaps());
+	header.width = map.width;
+	header.height = map.height;
+	ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+	const std::vector<uint64_t>& tiles = map.getTiles();
+	ofs.write(reinterpret_cast<const char *>(&tiles[0]), tiles.size() * sizeof(uint64_t));
 
-	std::vector<bool> data;
-	data.reserve(width * height);
-	char c;
-	while (ifs.get(c)) {
-		switch (c) {
-		case '0': data.push_back(false); break;
-		case '1': data.push_back(true); break;
-		default: //ignore
-			break;
+	const size_t layerSize = (map.width * map.height + 7) & ~static_cast<size_t>(7);
+	const std::vector<char> padding(layerSize - map.width * map.height, 0);
+	for (size_t i = 0; i < map.getNumDistanceMaps(); ++i) {
+		ofs.write(reinterpret_cast<const char *>(map.getDistanceMap(i)), map.width * map.height);
+		if (!padding.empty()) {
+			ofs.write(&padding[0], padding.size());
 		}
 	}
-
-	ifs.close();
-
-	return new GridMap(width, height, data);
+	return ofs.good();
 }
 
 } /* namespace footstep_planning */
-
@@ -0,0 +1,128 @@
+#include <footstep_planning/FootstepLattice.h>
+#include <cmath>
+#include <stdexcept>
+#include <angles/angles.h>
+
+namespace footstep_planning {
+
+namespace {
+
+const size_t INITIAL_SLOTS = 1024;
+const unsigned int INITIAL_SHIFT = 64 - 10;
+const int64_t MAX_CELL = (static_cast<int64_t>(1) << 23) - 1;  ///< Largest absolute cell coordinate, 24 bits with sign.
+
+}  // namespace
+
+const uint64_t FootstepLattice::EMPTY;
+
+FootstepLattice::FootstepLattice(const double& resolution, const size_t& numThetaBins) :
+		resolution(resolution),
+		numThetaBins(numThetaBins),
+		keys(INITIAL_SLOTS, EMPTY),
+		indices(INITIAL_SLOTS),
+		shift(INITIAL_SHIFT)
+{
+	if (!(resolution > 0.0)) {
+		throw std::invalid_argument("FootstepLattice: the resolution must be positive");
+	}
+	if (numThetaBins == 0 || numThetaBins > 4096) {
+		throw std::invalid_argument("FootstepLattice: the number of orientations must be between 1 and 4096");
+	}
+}
+
+FootstepLattice::~FootstepLattice() {
+	clear();
+}
+
+uint64_t FootstepLattice::key(const double& x, const double& y, const double& theta, const Foot& foot) const {
+	const double cellX = std::floor(x / resolution + 0.5);
+	const double cellY = std::floor(y / resolution + 0.5);
+	if (!(std::fabs(cellX) <= MAX_CELL && std::fabs(cellY) <= MAX_CELL)) {
+		throw std::out_of_range("FootstepLattice::get(): the foot step is outside the lattice");
+	}
+	const double binSize = 2.0 * M_PI / numThetaBins;
+	const uint64_t bin = static_cast<uint64_t>(std::floor(angles::normalize_angle_positive(theta) / binSize + 0.5)) % numThetaBins;
+	// 24 bits for each coordinate (two's complement), 15 bits for the orientation and 1 bit for the foot
+	return ((static_cast<uint64_t>(static_cast<int64_t>(cellX)) & 0xFFFFFFu) << 40)
+			| ((static_cast<uint64_t>(static_cast<int64_t>(cellY)) & 0xFFFFFFu) << 16)
+			| (bin << 1) | static_cast<uint64_t>(foot);
+}
+
+size_t FootstepLattice::slot(const uint64_t& key) const {
+	return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+FootstepNode* FootstepLattice::get(const double& x, const double& y, const double& theta, const Foot& foot) {
+	const uint64_t k = key(x, y, theta, foot);
+	size_t s = slot(k);
+	while (keys[s] != EMPTY) {
+		if (keys[s] == k) {
+			const uint32_t index = indices[s];
+			if (!touchedFlags[index]) {
+				touchedFlags[index] = true;
+				touched.push_back(index);
+			}
+			return nodes[index];
+		}
+		s = (s + 1) & (keys.size() - 1);
+	}
+	if (nodes.size() >= 0xFFFFFFFFu) {
+		throw std::length_error("FootstepLattice::get(): too many nodes");
+	}
+	// keep the table at most half full, so the probe sequences stay short
+	if (2 * (nodes.size() + 1) > keys.size()) {
+		grow();
+		s = slot(k);
+		while (keys[s] != EMPTY) {
+			s = (s + 1) & (keys.size() - 1);
+		}
+	}
+	const uint32_t index = static_cast<uint32_t>(nodes.size());
+	keys[s] = k;
+	indices[s] = index;
+	nodes.push_back(new FootstepNode(x, y, theta, foot));
+	touchedFlags.push_back(true);
+	touched.push_back(index);
+	return nodes.back();
+}
+
+void FootstepLattice::grow() {
+	// swap in an empty table of twice the size and reinsert the old entries
+	std::vector<uint64_t> oldKeys(keys.size() * 2, EMPTY);
+	std::vector<uint32_t> oldIndices(indices.size() * 2);
+	oldKeys.swap(keys);
+	oldIndices.swap(indices);
+	--shift;
+	for (size_t i = 0; i < oldKeys.size(); ++i) {
+		if (oldKeys[i] != EMPTY) {
+			size_t s = slot(oldKeys[i]);
+			while (keys[s] != EMPTY) {
+				s = (s + 1) & (keys.size() - 1);
+			}
+			keys[s] = oldKeys[i];
+			indices[s] = oldIndices[i];
+		}
+	}
+}
+
+void FootstepLattice::reset() {
+	for (std::vector<uint32_t>::const_iterator it = touched.begin(); it != touched.end(); ++it) {
+		nodes[*it]->resetSearchState();
+		touchedFlags[*it] = false;
+	}
+	touched.clear();
+}
+
+void FootstepLattice::clear() {
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		delete nodes[i];
+	}
+	nodes.clear();
+	touchedFlags.clear();
+	touched.clear();
+	keys.assign(INITIAL_SLOTS, EMPTY);
+	indices.assign(INITIAL_SLOTS, 0);
+	shift = INITIAL_SHIFT;
+}
+
+}  // namespace footstep_planning
@@ -1,37 +1,148 @@
 #include <vector>
 #include <limits>
+#include <cmath>
 #include <angles/angles.h>
 #include <footstep_planning/GridMap.h>
 #include <footstep_planning/FootstepMap.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace footstep_planning {
+
+const size_t FootstepMap::MAX_BATCH_SIZE;
+
+namespace {
+
+#ifdef __SSE2__
+/**
+ * @brief Rounds two values down to integers, like floor().
+ */
+inline __m128d floor2(const __m128d& v) {
+	const __m128d signBit = _mm_set1_pd(-0.0);
+	const __m128d big = _mm_set1_pd(4503599627370496.0);  // 2^52, from which on all doubles are integers
+	const __m128d signedBig = _mm_or_pd(big, _mm_and_pd(v, signBit));
+	// adding and subtracting 2^52 rounds to the nearest integer
+	__m128d rounded = _mm_sub_pd(_mm_add_pd(v, signedBig), signedBig);
+	rounded = _mm_sub_pd(rounded, _mm_and_pd(_mm_cmpgt_pd(rounded, v), _mm_set1_pd(1.0)));
+	const __m128d isInteger = _mm_cmpge_pd(_mm_andnot_pd(signBit, v), big);
+	return _mm_or_pd(_mm_and_pd(isInteger, v), _mm_andnot_pd(isInteger, rounded));
+}
+#endif
+
+}  // namespace
+
 FootstepMap::FootstepMap(const size_t& width, const size_t& height,
 		const std::vector<bool>& data,
 		const std::vector<std::vector<unsigned char> >& distanceMaps,
 		const double& resolution, const double& scale) :
-		GridMap(width, height, data), distanceMaps(distanceMaps),
-		resolution(resolution), scale(scale) {
+		GridMap(width, height, data),
+		resolution(resolution), scale(scale), numDistanceMaps(distanceMaps.size()) {
+	setDistanceMaps(distanceMaps);
+}
+
+FootstepMap::FootstepMap(const size_t& width, const size_t& height,
+		const uint64_t * const tiles,
+		const std::vector<std::vector<unsigned char> >& distanceMaps,
+		const double& resolution, const double& scale) :
+		GridMap(width, height, tiles),
+		resolution(resolution), scale(scale), numDistanceMaps(distanceMaps.size()) {
+	setDistanceMaps(distanceMaps);
+}
+
+void FootstepMap::setDistanceMaps(const std::vector<std::vector<unsigned char> >& distanceMaps) {
+	distanceData.reserve(numDistanceMaps * width * height);
+	for (size_t i = 0; i < distanceMaps.size(); ++i) {
+		if (distanceMaps[i].size() != width * height) {
+			throw std::invalid_argument("FootstepMap: a distance map does not have the dimensions of the map");
+		}
+		distanceData.insert(distanceData.end(), distanceMaps[i].begin(), distanceMaps[i].end());
+	}
 }
 
 FootstepMap::~FootstepMap() {
 }
 
+bool FootstepMap::getIndex(const double& x, const double& y, const double& theta, size_t& index) const {
+	if (numDistanceMaps == 0) {
+		return false;
+	}
+	// the orientations theta and theta + 180 degrees share a map
+	const double numBins = static_cast<double>(numDistanceMaps);
+	const double bin = floor(theta * (numBins / M_PI) + 0.5);
+	const double ts = bin - floor(bin / numBins) * numBins;
+	const double xs = floor(x / resolution + 0.5);
+	const double ys = static_cast<double>(height) - floor(y / resolution + 0.5);
+	if (!(ts >= 0.0 && ts < numBins && xs >= 0.0 && xs < width && ys >= 0.0 && ys < height)) {
+		return false;
+	}
+	index = (static_cast<size_t>(ts) * height + static_cast<size_t>(ys)) * width + static_cast<size_t>(xs);
+	return true;
+}
+
+unsigned int FootstepMap::getThreshold(const double& minDistance) const {
+	// the same comparison as with the result of getDistanceToNearestObstacle()
+	unsigned int threshold = 0;
+	while (threshold < 256 && static_cast<double>(threshold) / scale * resolution < minDistance) {
+		++threshold;
+	}
+	return threshold;
+}
 
 double FootstepMap::getDistanceToNearestObstacle(const double& x, const double& y, const double& theta) const {
-	double t = angles::to_degrees(angles::normalize_angle_positive(theta));
-	if (t >= 180.) {
-		t -= 180.;
-	}
-	const size_t ts = static_cast<size_t>(floor(t / 15. + 0.5));
-	const size_t xs = static_cast<size_t>(floor(x / resolution + 0.5));
-	const size_t ys = height - static_cast<size_t>(floor(y / resolution + 0.5));
-	double distance;
-	if (ts < distanceMaps.size() && xs < width && ys < height) {
-		const unsigned char val = distanceMaps[ts][ys * width + xs];
-		distance = static_cast<double>(val) / scale * resolution;
-	} else {
-		distance = 0.0;
-	}
-	return distance;
+	size_t index;
+	if (!getIndex(x, y, theta, index)) {
+		return 0.0;
+	}
+	return static_cast<double>(distanceData[index]) / scale * resolution;
 }
+
+uint32_t FootstepMap::getCollisions(const double * const x, const double * const y, const double * const theta,
+		const size_t& n, const double& minDistance) const {
+	if (n > MAX_BATCH_SIZE) {
+		throw std::length_error("FootstepMap::getCollisions(): too many poses");
+	}
+	const unsigned int threshold = getThreshold(minDistance);
+	uint32_t collisions = 0;
+	size_t i = 0;
+#ifdef __SSE2__
+	if (numDistanceMaps > 0) {
+		// the same operations as getIndex(), two poses at a time
+		const double numBins = static_cast<double>(numDistanceMaps);
+		const __m128d binsPerRadian = _mm_set1_pd(numBins / M_PI);
+		const __m128d bins = _mm_set1_pd(numBins);
+		const __m128d half = _mm_set1_pd(0.5);
+		const __m128d zero = _mm_setzero_pd();
+		const __m128d res = _mm_set1_pd(resolution);
+		const __m128d w = _mm_set1_pd(static_cast<double>(width));
+		const __m128d h = _mm_set1_pd(static_cast<double>(height));
+		const unsigned char * const values = &distanceData[0];
+		for (; i + 2 <= n; i += 2) {
+			const __m128d bin = floor2(_mm_add_pd(_mm_mul_pd(_mm_loadu_pd(theta + i), binsPerRadian), half));
+			const __m128d ts = _mm_sub_pd(bin, _mm_mul_pd(floor2(_mm_div_pd(bin, bins)), bins));
+			const __m128d xs = floor2(_mm_add_pd(_mm_div_pd(_mm_loadu_pd(x + i), res), half));
+			const __m128d ys = _mm_sub_pd(h, floor2(_mm_add_pd(_mm_div_pd(_mm_loadu_pd(y + i), res), half)));
+			const __m128d inside = _mm_and_pd(_mm_and_pd(_mm_and_pd(_mm_cmpge_pd(ts, zero), _mm_cmplt_pd(ts, bins)),
+					_mm_and_pd(_mm_cmpge_pd(xs, zero), _mm_cmplt_pd(xs, w))), _mm_and_pd(_mm_cmpge_pd(ys, zero), _mm_cmplt_pd(ys, h)));
+			// the indices are integers below 2^53, which doubles represent exactly
+			double indices[2];
+			_mm_storeu_pd(indices, _mm_add_pd(_mm_mul_pd(_mm_add_pd(_mm_mul_pd(ts, h), ys), w), xs));
+			const int insideMask = _mm_movemask_pd(inside);
+			for (int lane = 0; lane < 2; ++lane) {
+				if (!((insideMask >> lane) & 1) || values[static_cast<size_t>(indices[lane])] < threshold) {
+					collisions |= static_cast<uint32_t>(1) << (i + lane);
+				}
+			}
+		}
+	}
+#endif
+	for (; i < n; ++i) {
+		size_t index;
+		if (!getIndex(x[i], y[i], theta[i], index) || distanceData[index] < threshold) {
+			collisions |= static_cast<uint32_t>(1) << i;
+		}
+	}
+	return collisions;
+}
+
 }  // namespace footstep_planning
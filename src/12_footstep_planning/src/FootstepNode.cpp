@@ -1,22 +1,22 @@
 #include <footstep_planning/FootstepNode.h>
+#include <footstep_planning/FootstepLattice.h>
 #include <cmath>
 #include <angles/angles.h>
 #include <sstream>
 
 namespace footstep_planning {
 
-FootstepNode::MapType FootstepNode::nodes;
+namespace {
 
-int footstep_hash_value(const double& x, const double& y, const double& theta, const Foot& foot) {
-	return    static_cast<int>(x * 100) * 1000000
-			+ static_cast<int>(y * 100) * 20
-			+ static_cast<int>(angles::normalize_angle_positive(theta) / M_PI * 180.0) / 18
-			+ static_cast<int>(foot);
+/**
+ * @brief Returns the lattice of the nodes returned by FootstepNode::get().
+ */
+FootstepLattice& defaultLattice() {
+	static FootstepLattice lattice;
+	return lattice;
 }
 
-int hash_value(const FootstepNode &node) {
-	return footstep_hash_value(node.x, node.y, node.theta, node.foot);
-}
+}  // namespace
 
 FootstepNode::FootstepNode(const double& x, const double& y, const double& theta, const Foot& foot)
 : x(x), y(y), theta(theta), foot(foot) {
@@ -27,16 +27,11 @@ FootstepNode::~FootstepNode() {}
 
 FootstepNode* FootstepNode::get(const double& x, const double&y,
 		const double& theta, const Foot& foot) {
-	FootstepNode *result = NULL;
-	IndexType index = footstep_hash_value(x, y, theta, foot);
-	MapType::const_iterator it = nodes.find(index);
-	if (it == nodes.end()) {
-		result = new FootstepNode(x, y, theta, foot);
-		nodes[index] = result;
-	} else {
-		result = it->second;
-	}
-	return result;
+	return defaultLattice().get(x, y, theta, foot);
+}
+
+void FootstepNode::clear() {
+	defaultLattice().clear();
 }
 
 std::string FootstepNode::toString() const {
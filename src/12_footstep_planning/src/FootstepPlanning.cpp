@@ -1,7 +1,10 @@
 #include <footstep_planning/FootstepPlanning.h>
+#include <typeinfo>
 
 namespace footstep_planning {
 
+const size_t FootstepPlanning::ACTION_ORIENTATIONS;
+
 /**
  * @brief Returns the costs for stepping from one footstep to the next footstep.
  * @param[in] currentFootstep The current foot step.
@@ -88,7 +91,7 @@ FootstepNode* FootstepPlanning::executeFootstep(const FootstepNode * const curre
 	 * action.dy: Sideways distance relative to the current foot (positive = left, negative = right)
 	 * action.dtheta: Orientation relative to the current foot (positive = counterclockwise)
 	 *
-	 * FootstepNode::get(x, y, theta, action.foot): Create a new foot step with the given world coordinates
+	 * lattice.get(x, y, theta, action.foot): Create a new foot step with the given world coordinates
 	 */
 
 	
@@ -97,7 +100,57 @@ FootstepNode* FootstepPlanning::executeFootstep(const FootstepNode * const curre
 	x = currentFootstep->x + action.dx*cos(currentFootstep->theta) + action.dy*sin(currentFootstep->theta);
 	y = currentFootstep->y - action.dx*sin(currentFootstep->theta) + action.dy*cos(currentFootstep->theta);
 
-	return FootstepNode::get(x, y, theta, action.foot);
+	return lattice.get(x, y, theta, action.foot);
+}
+
+std::deque<const AbstractNode*> FootstepPlanning::planPath(const AbstractNode * const startNode, const AbstractNode * const goalNode) {
+	if (!startNode) {
+		throw std::invalid_argument("FootstepPlanning::planPath(): startNode is NULL");
+	}
+	if (!goalNode) {
+		throw std::invalid_argument("FootstepPlanning::planPath(): goalNode is NULL");
+	}
+	lattice.reset();
+	const FootstepNode * const start = static_cast<const FootstepNode *>(startNode);
+	const FootstepNode * const goal = static_cast<const FootstepNode *>(goalNode);
+	const FootstepNode * const latticeGoal = lattice.get(goal->x, goal->y, goal->theta, goal->foot);
+	(customHeuristic_ ? *customHeuristic_ : heuristic_).setGoal(latticeGoal);
+	return PathPlanning::planPath(lattice.get(start->x, start->y, start->theta, start->foot), latticeGoal);
+}
+
+double FootstepPlanning::getMaxStepLength() const {
+	double result = 0.0;
+	for (size_t i = 0; i < leftFootActions.size(); ++i) {
+		result = std::max(result, sqrt(leftFootActions[i].dx * leftFootActions[i].dx + leftFootActions[i].dy * leftFootActions[i].dy));
+	}
+	for (size_t i = 0; i < rightFootActions.size(); ++i) {
+		result = std::max(result, sqrt(rightFootActions[i].dx * rightFootActions[i].dx + rightFootActions[i].dy * rightFootActions[i].dy));
+	}
+	return result;
+}
+
+double FootstepPlanning::getCostsPerMeter() const {
+	double ratio = 0.0;
+	for (int first = 0; first < 2; ++first) {
+		const std::vector<FootstepAction>& firstActions = first == 0 ? leftFootActions : rightFootActions;
+		const std::vector<FootstepAction>& secondActions = first == 0 ? rightFootActions : leftFootActions;
+		for (size_t i = 0; i < firstActions.size(); ++i) {
+			const FootstepAction& a = firstActions[i];
+			// the second action is relative to the foot placed by the first one, as in executeFootstep()
+			const double c = cos(a.dtheta);
+			const double s = sin(a.dtheta);
+			for (size_t j = 0; j < secondActions.size(); ++j) {
+				const FootstepAction& b = secondActions[j];
+				const double dx = a.dx + b.dx * c + b.dy * s;
+				const double dy = a.dy - b.dx * s + b.dy * c;
+				const double costs = sqrt(a.dx * a.dx + a.dy * a.dy) + sqrt(b.dx * b.dx + b.dy * b.dy);
+				if (costs > 0.0) {
+					ratio = std::max(ratio, sqrt(dx * dx + dy * dy) / costs);
+				}
+			}
+		}
+	}
+	return ratio > 0.0 ? 1.0 / ratio : 1.0;
 }
 
 /**
@@ -109,7 +162,7 @@ std::vector<AbstractNode*> FootstepPlanning::getNeighborNodes(const FootstepNode
 	std::vector<AbstractNode*> neighborNodes;
 	// Choose the right set of footsteps: If the robot has previously stepped with the left foot, then
 	// step with the right foot next (and vice-versa).
-	const std::vector<FootstepAction> footstepActions(currentFootstep->foot == LEFT ? rightFootActions : leftFootActions);
+	const std::vector<FootstepAction>& footstepActions = currentFootstep->foot == LEFT ? rightFootActions : leftFootActions;
 
 	for(int i=0;i<footstepActions.size();i++){
 		FootstepNode* nextStep = executeFootstep(currentFootstep,footstepActions[i]);
@@ -135,6 +188,85 @@ std::vector<AbstractNode*> FootstepPlanning::getNeighborNodes(const FootstepNode
 	return neighborNodes;
 }
 
+void FootstepPlanning::getNeighborNodes(const AbstractNode * const currentNode, std::vector<AbstractNode *>& neighbors) {
+	if (!currentNode) {
+		throw std::invalid_argument("FootstepPlanning::getNeighborNodes(): currentNode is NULL");
+	}
+	const FootstepNode * const currentFootstep = static_cast<const FootstepNode *>(currentNode);
+	const std::vector<FootstepAction>& rotatedActions = currentFootstep->foot == LEFT ? rotatedRightFootActions : rotatedLeftFootActions;
+	const size_t numActions = rotatedActions.size() / ACTION_ORIENTATIONS;
+	const size_t orientation = static_cast<size_t>(angles::normalize_angle_positive(currentFootstep->theta)
+			* (ACTION_ORIENTATIONS / (2.0 * M_PI)) + 0.5) % ACTION_ORIENTATIONS;
+	const FootstepAction * const actions = &rotatedActions[orientation * numActions];
+
+	neighbors.clear();
+	FootstepNode *steps[FootstepMap::MAX_BATCH_SIZE];
+	for (size_t first = 0; first < numActions; first += FootstepMap::MAX_BATCH_SIZE) {
+		const size_t n = std::min(FootstepMap::MAX_BATCH_SIZE, numActions - first);
+		for (size_t i = 0; i < n; ++i) {
+			const FootstepAction& action = actions[first + i];
+			steps[i] = lattice.get(currentFootstep->x + action.dx, currentFootstep->y + action.dy,
+					currentFootstep->theta + action.dtheta, action.foot);
+		}
+		const uint32_t collisions = getCollisions(steps, n);
+		for (size_t i = 0; i < n; ++i) {
+			if (!((collisions >> i) & 1)) {
+				neighbors.push_back(steps[i]);
+			}
+		}
+	}
+}
+
+uint32_t FootstepPlanning::getCollisions(const FootstepNode * const * const steps, const size_t& n) {
+	if (n > FootstepMap::MAX_BATCH_SIZE) {
+		throw std::length_error("FootstepPlanning::getCollisions(): too many foot steps");
+	}
+	uint32_t collisions = 0;
+	if (!footstepMap || !hasDefaultCollisionTest()) {
+		for (size_t i = 0; i < n; ++i) {
+			if (isColliding(steps[i])) {
+				collisions |= static_cast<uint32_t>(1) << i;
+			}
+		}
+		return collisions;
+	}
+	double x[FootstepMap::MAX_BATCH_SIZE];
+	double y[FootstepMap::MAX_BATCH_SIZE];
+	double theta[FootstepMap::MAX_BATCH_SIZE];
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = steps[i]->x;
+		y[i] = steps[i]->y;
+		theta[i] = steps[i]->theta;
+	}
+	// the same distance as in isColliding()
+	return footstepMap->getCollisions(x, y, theta, n, 0.01);
+}
+
+bool FootstepPlanning::hasDefaultCollisionTest() const {
+	return typeid(*this) == typeid(FootstepPlanning);
+}
+
+/**
+ * @brief Rotates foot step actions from the frame of the current foot into the world frame.
+ * @param[in] actions The foot step actions for one foot.
+ * @return For each of the ACTION_ORIENTATIONS orientations of the current foot, the displacements
+ *         of all actions in the same order, as applied by executeFootstep().
+ */
+std::vector<FootstepPlanning::FootstepAction> FootstepPlanning::rotateFootstepActions(const std::vector<FootstepAction>& actions) const {
+	std::vector<FootstepAction> result;
+	result.reserve(ACTION_ORIENTATIONS * actions.size());
+	for (size_t o = 0; o < ACTION_ORIENTATIONS; ++o) {
+		const double theta = o * (2.0 * M_PI / ACTION_ORIENTATIONS);
+		const double c = cos(theta);
+		const double s = sin(theta);
+		for (size_t i = 0; i < actions.size(); ++i) {
+			result.push_back(FootstepAction(actions[i].dx * c + actions[i].dy * s, -actions[i].dx * s + actions[i].dy * c,
+					actions[i].dtheta, actions[i].foot));
+		}
+	}
+	return result;
+}
+
 /**
  * @brief Tests whether the current footstep is close enough to the goal for ending the search.
  * @param[in] currentNode The current footstep node.
@@ -6,11 +6,16 @@ namespace footstep_planning {
 bool OpenList::logToStdout = false;
 
 OpenList::OpenList() :
+		numOpen(0),
 		duplicateWarning(false),
 		reinsertWarning(false) {
 }
 
 OpenList::~OpenList() {
+	while (!openList.empty()) {
+		delete openList.top();
+		openList.pop();
+	}
 }
 
 
@@ -21,20 +26,23 @@ void OpenList::enqueue(const AbstractNode * const node, const double costs) {
 	if (logToStdout) {
 		std::cout << "enqueue " << node->toString() << std::endl;
 	}
-	if (!duplicateWarning && node->openListData->state == OpenListData::OPEN) {
+	if (!duplicateWarning && node->openListData.state == OpenListData::OPEN) {
 		std::cerr << "Warning: adding node " << node->toString()
 				<< " multiple times to the open list. Use updateCosts() instead for changing the costs of a node."
 				<< std::endl;
 		duplicateWarning = true;
 	}
-	if (!reinsertWarning && node->openListData->state == OpenListData::CLOSED) {
+	if (!reinsertWarning && node->openListData.state == OpenListData::CLOSED) {
 		std::cerr << "Warning: re-adding node " << node->toString()
 				<< " that has already been removed from the open list."
 				<< std::endl;
 			reinsertWarning = true;
 	}
-	node->openListData->state = OpenListData::OPEN;
-	node->openListData->cost = costs;
+	if (node->openListData.state != OpenListData::OPEN) {
+		++numOpen;
+	}
+	node->openListData.state = OpenListData::OPEN;
+	node->openListData.cost = costs;
 	NodeWrapper *wrapper = new NodeWrapper(node, costs);
 	openList.push(wrapper);
 }
@@ -44,8 +52,9 @@ const AbstractNode * OpenList::removeMin() {
 		const AbstractNode *node = wrapper->node;
 		openList.pop();
 		delete wrapper;
-		if (node->openListData->state == OpenListData::OPEN) {
-			node->openListData->state = OpenListData::CLOSED;
+		if (node->openListData.state == OpenListData::OPEN) {
+			node->openListData.state = OpenListData::CLOSED;
+			--numOpen;
 			return node;
 		}
 		// here updated nodes are deleted (lazy deletion)
@@ -56,7 +65,7 @@ void OpenList::updateCosts(const AbstractNode * const node, const double costs)
 	if (!node) {
 		throw std::invalid_argument("OpenList::updateCosts(): node is NULL");
 	}
-	if (node->openListData->state != OpenListData::OPEN) {
+	if (node->openListData.state != OpenListData::OPEN) {
 		throw std::runtime_error(
 				"Tried to update the costs for a node that has not been enqueued to the open list.");
 	}
@@ -69,16 +78,17 @@ double OpenList::getCosts(const AbstractNode * const node) const {
 	if (!node) {
 		throw std::invalid_argument("OpenList::getCosts(): node is NULL");
 	}
-	if (node->openListData->state != OpenListData::OPEN) {
+	if (node->openListData.state != OpenListData::OPEN) {
 		throw std::runtime_error(
 				"Tried to get the costs for a node that has not been enqueued to the open list.");
 	}
-	return node->openListData->cost;
+	return node->openListData.cost;
 }
 
 bool OpenList::isEmpty() const {
 	// do lazy deletion
-	while(!openList.empty() && openList.top()->node->openListData->state == OpenListData::CLOSED) {
+	while(!openList.empty() && openList.top()->node->openListData.state == OpenListData::CLOSED) {
+		delete openList.top();
 		openList.pop();
 	}
 	return openList.empty();
@@ -87,7 +97,7 @@ bool OpenList::contains(const AbstractNode * const node) const {
 	if (!node) {
 		throw std::invalid_argument("OpenList::contains(): node is NULL");
 	}
-	return node->openListData->state == OpenListData::OPEN;
+	return node->openListData.state == OpenListData::OPEN;
 }
 
 }  // namespace planning
@@ -1,5 +1,7 @@
 #include <footstep_planning/PathPlanning.h>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace footstep_planning {
 
@@ -8,8 +10,8 @@ void PathPlanning::expandNode(const AbstractNode * const currentNode, const Abst
 
 	// Get the list of all neighbors of the cell
 	typedef std::vector<AbstractNode *> Neighbors;
-	Neighbors neighbors = getNeighborNodes(currentNode);
-	for (Neighbors::const_iterator neighborIt = neighbors.begin(); neighborIt != neighbors.end(); ++neighborIt) {
+	getNeighborNodes(currentNode, neighborBuffer);
+	for (Neighbors::const_iterator neighborIt = neighborBuffer.begin(); neighborIt != neighborBuffer.end(); ++neighborIt) {
 		// If the successor is already on the closed list: do nothing
 		if (closedList.contains(*neighborIt)) {
 			continue;
@@ -25,13 +27,18 @@ void PathPlanning::expandNode(const AbstractNode * const currentNode, const Abst
 			continue;
 		}
 
+		// Calculate the new f value (costs from start + heuristic to goal)
+		const double f = tentative_g + heuristic(*neighborIt, goalNode);
+
+		// If the goal cannot be reached through the successor (infinite costs or heuristic): do not enqueue it
+		if (!(f < std::numeric_limits<double>::infinity())) {
+			continue;
+		}
+
 		// Set predecessor and save new g value
 		(*neighborIt)->setPredecessor(currentNode);
 		(*neighborIt)->costs = tentative_g;
 
-		// Calculate the new f value (costs from start + heuristic to goal)
-		const double f = tentative_g + heuristic(*neighborIt, goalNode);
-
 		// Update f value of the node in the open list or insert the new node
 		if (openList.contains(*neighborIt)) {
 			openList.updateCosts(*neighborIt, f);
@@ -47,7 +54,9 @@ std::deque<const AbstractNode*> PathPlanning::planPath(const AbstractNode * cons
    	ClosedList closedList;
 
    	std::deque<const AbstractNode*> resultPath;
+	numExpansions = 0;
 	openList.enqueue(startNode, 0.0);
+	peakOpenListSize = openList.size();
 	while (!openList.isEmpty()) {
 		const AbstractNode * currentNode = openList.removeMin();
 		if (isCloseToGoal(currentNode, goalNode)) {
@@ -55,7 +64,9 @@ std::deque<const AbstractNode*> PathPlanning::planPath(const AbstractNode * cons
 			break;
 		}
 		closedList.add(currentNode);
+		++numExpansions;
 		expandNode(currentNode, goalNode, openList, closedList);
+		peakOpenListSize = std::max(peakOpenListSize, openList.size());
 	}
 
 	return resultPath;
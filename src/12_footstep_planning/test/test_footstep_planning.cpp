@@ -1,5 +1,14 @@
 #include <gtest/gtest.h>
+#include <footstep_planning/AnytimeFootstepPlanning.h>
+#include <footstep_planning/ClearanceMaps.h>
+#include <footstep_planning/DijkstraHeuristic.h>
+#include <footstep_planning/FileIO.h>
 #include <footstep_planning/FootstepPlanning.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 
 using namespace footstep_planning;
 
@@ -23,6 +32,65 @@ private:
 
 };
 
+/**
+ * @brief A planner with a map that regards every foot step as colliding.
+ */
+class CollidingFootstepPlanning : public FootstepPlanning {
+public:
+	CollidingFootstepPlanning(const FootstepMap * const footstepMap) : FootstepPlanning(footstepMap) {};
+	virtual ~CollidingFootstepPlanning() {};
+
+	bool isColliding(const FootstepNode * const /*step*/) {
+		return true;
+	}
+};
+
+/**
+ * @brief Compares the distance maps of a map with the distances to the cells where the foot
+ * overlaps an occupied cell, computed by brute force.
+ */
+void expectClearance(const FootstepMap& map, const double& halfLength, const double& halfWidth) {
+	const int width = static_cast<int>(map.width);
+	const int height = static_cast<int>(map.height);
+	for (size_t a = 0; a < map.getNumDistanceMaps(); ++a) {
+		const double theta = M_PI * a / map.getNumDistanceMaps();
+		std::vector<std::pair<int, int> > covered;
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				bool isCovered = false;
+				for (int oy = std::max(0, y - 7); oy < std::min(height, y + 8) && !isCovered; ++oy) {
+					for (int ox = std::max(0, x - 7); ox < std::min(width, x + 8) && !isCovered; ++ox) {
+						// the rows count downwards
+						const double c = std::fabs(std::cos(theta)), s = std::fabs(std::sin(theta));
+						const double along = (x - ox) * std::cos(theta) - (y - oy) * std::sin(theta);
+						const double across = -(x - ox) * std::sin(theta) - (y - oy) * std::cos(theta);
+						// separating axis test of the foot and the square of the cell
+						isCovered = map.isOccupied(ox, oy) && std::fabs(along) <= halfLength + 0.5 * (c + s) + 1e-9
+								&& std::fabs(across) <= halfWidth + 0.5 * (c + s) + 1e-9
+								&& std::abs(x - ox) <= halfLength * c + halfWidth * s + 0.5 + 1e-9
+								&& std::abs(y - oy) <= halfLength * s + halfWidth * c + 0.5 + 1e-9;
+					}
+				}
+				if (isCovered) {
+					covered.push_back(std::make_pair(x, y));
+				}
+			}
+		}
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				double squared = std::numeric_limits<double>::infinity();
+				for (size_t i = 0; i < covered.size(); ++i) {
+					const double dx = covered[i].first - x;
+					const double dy = covered[i].second - y;
+					squared = std::min(squared, dx * dx + dy * dy);
+				}
+				const double expected = std::min(255.0, std::floor(std::sqrt(squared) * map.getScale() + 1e-9));
+				ASSERT_EQ(map.getDistanceMap(a)[y * width + x], expected) << "at " << x << ", " << y << " for " << a * 180 / map.getNumDistanceMaps() << " degrees";
+			}
+		}
+	}
+}
+
 TEST(FootstepPlanning, getCosts) {
 	const double tolerance = 1e-5;
 	DummyFootstepPlanning ofp;
@@ -146,11 +214,437 @@ TEST(FootstepPlanning, getNeighborNodes) {
 		}
 	}
 
+	// the pre-rotated actions of the planner match executeFootstep() up to the table resolution
+	const FootstepNode * const turnedFootstep = FootstepNode::get(-1.0, 2.0, 0.7, RIGHT);
+	result = dfp.getNeighborNodes(turnedFootstep);
+	std::vector<AbstractNode *> buffer(3, NULL);
+	dfp.getNeighborNodes(static_cast<const AbstractNode *>(turnedFootstep), buffer);
+	ASSERT_EQ(buffer.size(), result.size());
+	for (size_t i = 0; i < buffer.size(); ++i) {
+		const FootstepNode * const expected = static_cast<FootstepNode *>(result[i]);
+		const FootstepNode * const footstep = static_cast<FootstepNode *>(buffer[i]);
+		EXPECT_NEAR(footstep->x, expected->x, 0.002);
+		EXPECT_NEAR(footstep->y, expected->y, 0.002);
+		EXPECT_NEAR(footstep->theta, expected->theta, 1e-9);
+		EXPECT_EQ(footstep->foot, LEFT);
+	}
+
 	dfp.setDistanceToNearestObstacle(0.0);
 	result = dfp.getNeighborNodes(currentFootstep);
 	if (!result.empty()) {
 		FAIL() << "The method returns footsteps that collide with obstacles. Use the method isColliding(FootstepNode *node) to check for collisions.";
 	}
+	dfp.getNeighborNodes(static_cast<const AbstractNode *>(currentFootstep), buffer);
+	EXPECT_TRUE(buffer.empty());
+}
+
+TEST(FootstepPlanning, fileIO) {
+	const std::string dir = std::string(PROJECT_SOURCE_DIR) + "/data/";
+	// reference: read the map and the distance maps byte by byte
+	std::ifstream ifs((dir + "map.pbm").c_str());
+	std::string header;
+	size_t width = 0, height = 0;
+	ifs >> header >> width >> height;
+	std::vector<bool> data;
+	char c;
+	while (ifs.get(c)) {
+		if (c == '0' || c == '1') {
+			data.push_back(c == '1');
+		}
+	}
+	ifs.close();
+	ASSERT_EQ(data.size(), width * height);
+
+	const FileIO fileIO(PROJECT_SOURCE_DIR);
+	ASSERT_TRUE(fileIO.map != NULL);
+	ASSERT_EQ(fileIO.map->width, width);
+	ASSERT_EQ(fileIO.map->height, height);
+	for (size_t y = 0; y < height; ++y) {
+		for (size_t x = 0; x < width; ++x) {
+			ASSERT_EQ(fileIO.map->isOccupied(x, y), data[y * width + x]) << "(" << x << ", " << y << ")";
+		}
+	}
+	ASSERT_EQ(fileIO.map->getNumDistanceMaps(), 12u);
+	for (size_t i = 0; i < fileIO.map->getNumDistanceMaps(); ++i) {
+		std::ostringstream filename;
+		filename << dir << "distance_" << i * 15 << ".pgm";
+		ifs.open(filename.str().c_str(), std::ios::binary);
+		int depth;
+		ifs >> header >> width >> height >> depth;
+		ifs.get(c);
+		std::vector<unsigned char> expected(width * height);
+		ifs.read(reinterpret_cast<char *>(&expected[0]), expected.size());
+		ifs.close();
+		EXPECT_TRUE(std::equal(expected.begin(), expected.end(), fileIO.map->getDistanceMap(i))) << filename.str();
+	}
+
+	// a binary map with the distance maps, and a raw PBM map that is not square
+	const std::string binaryFile = dir + "test-map.bin";
+	ASSERT_TRUE(FileIO::saveBinaryMap(binaryFile, *fileIO.map));
+	const GridMap * loaded = FileIO::loadMap(binaryFile);
+	std::remove(binaryFile.c_str());
+	ASSERT_TRUE(loaded != NULL);
+	ASSERT_EQ(loaded->width, fileIO.map->width);
+	for (size_t y = 0; y < loaded->height; ++y) {
+		for (size_t x = 0; x < loaded->width; ++x) {
+			ASSERT_EQ(loaded->isOccupied(x, y), fileIO.map->isOccupied(x, y)) << "(" << x << ", " << y << ")";
+		}
+	}
+	delete loaded;
+
+	const std::string rawFile = dir + "test-map.pbm";
+	std::ofstream ofs(rawFile.c_str(), std::ios::binary);
+	ofs << "P4\n# comment\n13 5\n";
+	for (int y = 0; y < 5; ++y) {
+		ofs.put(static_cast<char>(0x81u >> y));
+		ofs.put(static_cast<char>(0xFFu));
+	}
+	ofs.close();
+	loaded = FileIO::loadMap(rawFile);
+	std::remove(rawFile.c_str());
+	ASSERT_TRUE(loaded != NULL);
+	ASSERT_EQ(loaded->width, 13u);
+	ASSERT_EQ(loaded->height, 5u);
+	for (int y = 0; y < 5; ++y) {
+		for (int x = 0; x < 13; ++x) {
+			EXPECT_EQ(loaded->isOccupied(x, y), x == y || (x == 7 && y == 0) || x >= 8) << "(" << x << ", " << y << ")";
+		}
+	}
+	EXPECT_THROW(loaded->isOccupied(0, 5), std::out_of_range);
+	delete loaded;
+	EXPECT_TRUE(FileIO::loadMap(dir + "does-not-exist.pbm") == NULL);
+}
+
+TEST(FootstepPlanning, planPathStatistics) {
+	const size_t size = 100;
+	const std::vector<std::vector<unsigned char> > distanceMaps(12, std::vector<unsigned char>(size * size, 100));
+	const FootstepMap map(size, size, std::vector<bool>(size * size, false), distanceMaps, 0.01, 5.0);
+	FootstepPlanning planning(&map);
+	EXPECT_EQ(planning.getNumExpansions(), 0u);
+	EXPECT_EQ(planning.getPeakOpenListSize(), 0u);
+
+	std::deque<const AbstractNode *> path = planning.planPath(FootstepNode::get(0.3, 0.5, 0.0, LEFT), FootstepNode::get(0.6, 0.5, 0.0, RIGHT));
+	ASSERT_FALSE(path.empty());
+	const size_t expansions = planning.getNumExpansions();
+	EXPECT_GT(expansions, 0u);
+	EXPECT_GT(planning.getPeakOpenListSize(), 0u);
+
+	// the planner resets the search state of its nodes, so the same query starts from scratch
+	const size_t numNodes = planning.getLattice().size();
+	path = planning.planPath(FootstepNode::get(0.3, 0.5, 0.0, LEFT), FootstepNode::get(0.6, 0.5, 0.0, RIGHT));
+	ASSERT_FALSE(path.empty());
+	EXPECT_EQ(planning.getNumExpansions(), expansions);
+	EXPECT_EQ(planning.getLattice().size(), numNodes);
+	EXPECT_THROW(planning.planPath(NULL, FootstepNode::get(0.6, 0.5, 0.0, RIGHT)), std::invalid_argument);
+}
+
+TEST(FootstepPlanning, footstepLattice) {
+	EXPECT_THROW(FootstepLattice(0.0), std::invalid_argument);
+	EXPECT_THROW(FootstepLattice(0.01, 0), std::invalid_argument);
+
+	FootstepLattice lattice(0.01, 20);
+	FootstepNode * const node = lattice.get(2.0, 3.0, 0.0, LEFT);
+	EXPECT_EQ(lattice.get(2.0, 3.0, 0.0, LEFT), node);
+	// poses that round to the same state share the node, which keeps the first pose
+	EXPECT_EQ(lattice.get(2.004, 2.996, 0.1, LEFT), node);
+	EXPECT_EQ(lattice.get(2.0, 3.0, 2.0 * M_PI - 0.1, LEFT), node);
+	EXPECT_DOUBLE_EQ(node->x, 2.0);
+	EXPECT_EQ(lattice.size(), 1u);
+
+	// distinct states never share a node, neither the other foot, nor states whose old int hash collided
+	EXPECT_NE(lattice.get(2.0, 3.0, 0.0, RIGHT), node);
+	EXPECT_NE(lattice.get(2.0, 3.0, 0.2 * M_PI, LEFT), node);
+	EXPECT_NE(lattice.get(2.0, 3.01, 0.0, LEFT), node);
+	EXPECT_NE(lattice.get(2.0, 3.0, 0.1 * M_PI, RIGHT), lattice.get(2.0, 3.0, 0.2 * M_PI, LEFT));
+	EXPECT_NE(lattice.get(2.0, 3.0, 0.0, LEFT), lattice.get(2.01, 3.0 - 50000 * 0.01, 0.0, LEFT));
+	EXPECT_EQ(lattice.size(), 6u);
+
+	// maps beyond the 21 m of the old hash, and a table that grows many times
+	FootstepNode * const far = lattice.get(-25000.0, 40000.0, M_PI, RIGHT);
+	EXPECT_DOUBLE_EQ(far->y, 40000.0);
+	EXPECT_THROW(lattice.get(0.0, 1e6, 0.0, LEFT), std::out_of_range);
+	std::vector<FootstepNode *> grid;
+	for (int i = 0; i < 10000; ++i) {
+		grid.push_back(lattice.get(30.0 + 0.01 * (i % 100), 30.0 + 0.01 * (i / 100), 0.0, LEFT));
+	}
+	for (int i = 0; i < 10000; ++i) {
+		ASSERT_EQ(lattice.get(30.0 + 0.01 * (i % 100), 30.0 + 0.01 * (i / 100), 0.0, LEFT), grid[i]);
+	}
+	EXPECT_EQ(lattice.size(), 10007u);
+
+	// reset() clears the search state, but keeps the nodes
+	node->costs = 1.0;
+	node->setPredecessor(far);
+	lattice.reset();
+	EXPECT_EQ(node->costs, 0.0);
+	EXPECT_TRUE(node->getPredecessor() == NULL);
+	EXPECT_EQ(lattice.get(2.0, 3.0, 0.0, LEFT), node);
+	lattice.clear();
+	EXPECT_EQ(lattice.size(), 0u);
+}
+
+TEST(FootstepPlanning, dijkstraHeuristic) {
+	// 1.6 m x 1 m with a wall of 60 cm at 0.5 m < x < 1.1 m, which is open above y = 0.8 m
+	const size_t width = 160, height = 100;
+	std::vector<bool> data(width * height, false);
+	std::vector<unsigned char> distanceMap(width * height, 100);
+	for (size_t row = 0; row < height; ++row) {
+		for (size_t x = 0; x < width; ++x) {
+			if (row >= 20 && x >= 50 && x < 110) {
+				data[row * width + x] = true;
+			}
+			// the foot collides within 2 cells of the wall
+			if (row >= 18 && x >= 48 && x < 112) {
+				distanceMap[row * width + x] = 0;
+			}
+		}
+	}
+	const FootstepMap map(width, height, data, std::vector<std::vector<unsigned char> >(12, distanceMap), 0.01, 5.0);
+	FootstepPlanning planning(&map);
+	EXPECT_NEAR(planning.getMaxStepLength(), 0.16, 1e-9);
+	EXPECT_GT(planning.getCostsPerMeter(), 1.4);
+	EXPECT_LT(planning.getCostsPerMeter(), 1.6);
+	EXPECT_THROW(DijkstraHeuristic(map, planning, 0.05, 0.0), std::invalid_argument);
+
+	DijkstraHeuristic heuristic(map, planning);
+	EXPECT_DOUBLE_EQ(heuristic.cellSize, 0.05);
+	EXPECT_FALSE(heuristic.isPassable(0.8, 0.5));
+	EXPECT_TRUE(heuristic.isPassable(0.8, 0.9));
+	EXPECT_TRUE(heuristic.isPassable(0.6, 0.5));  // within a step of a foot step next to the wall
+	EXPECT_FALSE(heuristic.isPassable(-0.1, 0.5));
+
+	const FootstepNode * const start = planning.getLattice().get(0.2, 0.2, 0.0, LEFT);
+	const FootstepNode * const goal = planning.getLattice().get(1.4, 0.2, 0.0, RIGHT);
+	const FootstepHeuristic euclidean;
+	EXPECT_DOUBLE_EQ(heuristic.getDistance(0.2, 0.2), -1.0);
+	heuristic.setGoal(goal);
+	EXPECT_DOUBLE_EQ(heuristic.getDistance(1.4, 0.2), 0.0);
+	EXPECT_GT(heuristic.getDistance(0.2, 0.2), 1.5);  // around the wall, 1.2 m straight
+	EXPECT_GT(heuristic.heuristic(start, goal), planning.getCostsPerMeter() * euclidean.heuristic(start, goal));
+
+	// the heuristic stays below the costs of the path
+	planning.setHeuristic(&heuristic);
+	const std::deque<const AbstractNode *> path = planning.planPath(start, goal);
+	ASSERT_FALSE(path.empty());
+	EXPECT_LE(heuristic.heuristic(start, goal), path.back()->costs);
+	for (size_t i = 0; i < path.size(); ++i) {
+		const FootstepNode * const step = static_cast<const FootstepNode *>(path[i]);
+		EXPECT_TRUE(heuristic.isPassable(step->x, step->y));
+	}
+
+	// no goal inside the wall can be reached
+	heuristic.setGoal(planning.getLattice().get(0.8, 0.5, 0.0, RIGHT));
+	EXPECT_EQ(heuristic.getDistance(0.2, 0.2), std::numeric_limits<double>::infinity());
+	EXPECT_EQ(heuristic.heuristic(start, goal), std::numeric_limits<double>::infinity());
+
+	// the foot steps that cannot reach it are not enqueued, so only the start is expanded
+	EXPECT_TRUE(planning.planPath(start, planning.getLattice().get(0.8, 0.5, 0.0, RIGHT)).empty());
+	EXPECT_EQ(planning.getNumExpansions(), 1u);
+}
+
+TEST(FootstepPlanning, clearanceMaps) {
+	// 0.8 m x 0.6 m with a block, a single cell and a diagonal line
+	const int width = 80, height = 60;
+	std::vector<bool> data(width * height, false);
+	for (int y = 10; y < 15; ++y) {
+		for (int x = 10; x < 20; ++x) {
+			data[y * width + x] = true;
+		}
+	}
+	data[30 * width + 50] = true;
+	for (int i = 0; i < 12; ++i) {
+		data[(55 - i) * width + 30 + i] = true;
+	}
+	FootstepMap map(width, height, data, std::vector<std::vector<unsigned char> >(), 0.01, 5.0);
+	EXPECT_DOUBLE_EQ(map.getDistanceToNearestObstacle(0.4, 0.3, 0.0), 0.0);
+	EXPECT_THROW(ClearanceMaps(-0.01, 0.07), std::invalid_argument);
+	const ClearanceMaps clearanceMaps(0.09, 0.07, 3);
+	EXPECT_THROW(clearanceMaps.update(map, 0, 0, 1, 1), std::invalid_argument);
+	EXPECT_THROW(clearanceMaps.compute(map, 0), std::invalid_argument);
+
+	clearanceMaps.compute(map);
+	ASSERT_EQ(map.getNumDistanceMaps(), 12u);
+	expectClearance(map, 4.5, 3.5);
+
+	// the foot points along x at 0 degrees and along y at 90 degrees
+	EXPECT_DOUBLE_EQ(map.getDistanceToNearestObstacle(0.55, 0.30, 0.0), 0.0);
+	EXPECT_NEAR(map.getDistanceToNearestObstacle(0.56, 0.30, 0.0), 0.01, 1e-9);
+	EXPECT_GT(map.getDistanceToNearestObstacle(0.55, 0.30, 0.5 * M_PI), 0.0);
+	EXPECT_DOUBLE_EQ(map.getDistanceToNearestObstacle(0.50, 0.35, 0.5 * M_PI), 0.0);
+	// orientations close to 180 degrees use the map of 0 degrees
+	EXPECT_NEAR(map.getDistanceToNearestObstacle(0.56, 0.30, M_PI - 0.01), 0.01, 1e-9);
+
+	// updating the changed rectangles gives the same result as computing everything
+	FootstepMap expected = map;
+	EXPECT_THROW(clearanceMaps.update(map, 70, 50, 11, 5), std::out_of_range);
+	for (int y = 11; y < 14; ++y) {
+		for (int x = 12; x < 18; ++x) {
+			map.setOccupied(x, y, false);
+			expected.setOccupied(x, y, false);
+		}
+	}
+	clearanceMaps.update(map, 12, 11, 6, 3);
+	map.setOccupied(79, 0, true);
+	expected.setOccupied(79, 0, true);
+	clearanceMaps.update(map, 79, 0, 1, 1);
+	map.setOccupied(50, 30, false);
+	expected.setOccupied(50, 30, false);
+	clearanceMaps.update(map, 50, 30, 1, 1);
+	clearanceMaps.compute(expected);
+	EXPECT_TRUE(map.getDistanceData() == expected.getDistanceData());
+	expectClearance(map, 4.5, 3.5);
+
+	// the default foot reproduces the collisions of the distance maps of data/map.pbm
+	const FileIO fileIO(PROJECT_SOURCE_DIR);
+	ASSERT_TRUE(fileIO.map != NULL);
+	FootstepMap computed = *fileIO.map;
+	ClearanceMaps().compute(computed);
+	ASSERT_EQ(computed.getNumDistanceMaps(), fileIO.map->getNumDistanceMaps());
+	for (size_t a = 0; a < computed.getNumDistanceMaps(); ++a) {
+		const unsigned char * const values = computed.getDistanceMap(a);
+		const unsigned char * const loaded = fileIO.map->getDistanceMap(a);
+		size_t collisions = 0, computedCollisions = 0, agreements = 0;
+		for (size_t i = 0; i < computed.width * computed.height; ++i) {
+			collisions += loaded[i] < 5;
+			computedCollisions += values[i] < 5;
+			agreements += loaded[i] < 5 && values[i] < 5;
+		}
+		EXPECT_GT(agreements, 0.95 * collisions) << "for " << a * 15 << " degrees";
+		EXPECT_GT(agreements, 0.95 * computedCollisions) << "for " << a * 15 << " degrees";
+	}
+}
+
+TEST(FootstepPlanning, collisionBatch) {
+	const FileIO fileIO(PROJECT_SOURCE_DIR);
+	ASSERT_TRUE(fileIO.map != NULL);
+	const FootstepMap& map = *fileIO.map;
+	// random poses around the map, and poses on the boundaries of cells and orientations
+	std::vector<double> x, y, theta;
+	unsigned int seed = 42;
+	for (size_t i = 0; i < 20000; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		x.push_back(-0.2 + 4.4 * (seed >> 8) / 16777216.0);
+		seed = seed * 1103515245u + 12345u;
+		y.push_back(-0.2 + 4.4 * (seed >> 8) / 16777216.0);
+		seed = seed * 1103515245u + 12345u;
+		theta.push_back(-20.0 + 40.0 * (seed >> 8) / 16777216.0);
+	}
+	for (int i = -30; i < 30; ++i) {
+		x.push_back(1.0 + 0.005 * i);
+		y.push_back(2.0 - 0.005 * i);
+		theta.push_back(M_PI / 24.0 * i);
+	}
+	for (size_t first = 0, n = 1; first < x.size(); first += n, n = n % FootstepMap::MAX_BATCH_SIZE + 1) {
+		n = std::min(n, x.size() - first);
+		uint32_t expected = 0;
+		for (size_t i = 0; i < n; ++i) {
+			if (map.getDistanceToNearestObstacle(x[first + i], y[first + i], theta[first + i]) < 0.01) {
+				expected |= static_cast<uint32_t>(1) << i;
+			}
+		}
+		ASSERT_EQ(map.getCollisions(&x[first], &y[first], &theta[first], n, 0.01), expected) << "at pose " << first;
+		// a distance between two values of the distance maps
+		expected = 0;
+		for (size_t i = 0; i < n; ++i) {
+			if (map.getDistanceToNearestObstacle(x[first + i], y[first + i], theta[first + i]) < 0.055) {
+				expected |= static_cast<uint32_t>(1) << i;
+			}
+		}
+		ASSERT_EQ(map.getCollisions(&x[first], &y[first], &theta[first], n, 0.055), expected) << "at pose " << first;
+	}
+	EXPECT_THROW(map.getCollisions(&x[0], &y[0], &theta[0], FootstepMap::MAX_BATCH_SIZE + 1, 0.01), std::length_error);
+
+	// the planner tests its foot steps like isColliding()
+	FootstepPlanning planning(&map);
+	std::vector<const FootstepNode *> steps;
+	uint32_t expected = 0;
+	for (size_t i = 0; i < 12; ++i) {
+		steps.push_back(planning.getLattice().get(x[i], y[i], theta[i], LEFT));
+		if (planning.isColliding(steps.back())) {
+			expected |= static_cast<uint32_t>(1) << i;
+		}
+	}
+	EXPECT_EQ(planning.getCollisions(&steps[0], steps.size()), expected);
+
+	// an overridden isColliding() is used instead of the map
+	CollidingFootstepPlanning colliding(&map);
+	EXPECT_EQ(colliding.getCollisions(&steps[0], steps.size()), (static_cast<uint32_t>(1) << steps.size()) - 1);
+	std::vector<AbstractNode *> neighbors;
+	colliding.getNeighborNodes(colliding.getLattice().get(1.0, 0.2, 0.0, LEFT), neighbors);
+	EXPECT_TRUE(neighbors.empty());
+}
+
+TEST(FootstepPlanning, anytimePlanning) {
+	// 1.6 m x 1 m with a wall of 60 cm at 0.5 m < x < 1.1 m, which is open above y = 0.4 m
+	const size_t width = 160, height = 100;
+	std::vector<bool> data(width * height, false);
+	std::vector<unsigned char> distanceMap(width * height, 100);
+	for (size_t row = 0; row < height; ++row) {
+		for (size_t x = 0; x < width; ++x) {
+			if (row >= 60 && x >= 50 && x < 110) {
+				data[row * width + x] = true;
+			}
+			if (row >= 58 && x >= 48 && x < 112) {
+				distanceMap[row * width + x] = 0;
+			}
+		}
+	}
+	const FootstepMap map(width, height, data, std::vector<std::vector<unsigned char> >(12, distanceMap), 0.01, 5.0);
+	EXPECT_THROW(AnytimeFootstepPlanning(&map, 0.5), std::invalid_argument);
+	EXPECT_THROW(AnytimeFootstepPlanning(&map, 2.0, 0.0), std::invalid_argument);
+
+	FootstepPlanning astar(&map);
+	const std::deque<const AbstractNode *> optimal = astar.planPath(FootstepNode::get(0.2, 0.2, 0.0, LEFT), FootstepNode::get(1.4, 0.2, 0.0, RIGHT));
+	ASSERT_FALSE(optimal.empty());
+
+	// the plans get better in costs or bound, and the last one is optimal
+	AnytimeFootstepPlanning planning(&map, 3.0, 0.5);
+	std::vector<AnytimeFootstepPlanning::Solution> solutions;
+	const std::deque<const AbstractNode *> path = planning.planPath(FootstepNode::get(0.2, 0.2, 0.0, LEFT), FootstepNode::get(1.4, 0.2, 0.0, RIGHT),
+			AnytimeFootstepPlanning::Clock::time_point::max(),
+			[&solutions](const AnytimeFootstepPlanning::Solution& solution) { solutions.push_back(solution); });
+	ASSERT_FALSE(path.empty());
+	ASSERT_FALSE(solutions.empty());
+	EXPECT_DOUBLE_EQ(solutions[0].epsilon, 3.0);
+	for (size_t i = 0; i < solutions.size(); ++i) {
+		const std::deque<const AbstractNode *>& solutionPath = solutions[i].path;
+		ASSERT_FALSE(solutionPath.empty());
+		EXPECT_TRUE(planning.isCloseToGoal(solutionPath.back(), planning.getLattice().get(1.4, 0.2, 0.0, RIGHT)));
+		double costs = 0.0;
+		for (size_t j = 1; j < solutionPath.size(); ++j) {
+			costs += planning.getCosts(solutionPath[j - 1], solutionPath[j]);
+		}
+		EXPECT_LE(costs, solutions[i].costs + 1e-9);
+		EXPECT_GE(solutions[i].bound, 1.0);
+		EXPECT_LE(solutions[i].bound, solutions[i].epsilon);
+		if (i > 0) {
+			EXPECT_LE(solutions[i].costs, solutions[i - 1].costs);
+			EXPECT_LE(solutions[i].bound, solutions[i - 1].bound);
+			EXPECT_TRUE(solutions[i].costs < solutions[i - 1].costs || solutions[i].bound < solutions[i - 1].bound);
+			EXPECT_GE(solutions[i].numExpansions, solutions[i - 1].numExpansions);
+		}
+	}
+	EXPECT_DOUBLE_EQ(solutions.back().bound, 1.0);
+	EXPECT_DOUBLE_EQ(planning.getBound(), 1.0);
+	EXPECT_EQ(path, solutions.back().path);
+	// A lattice node keeps the exact pose of the first foot step that reached it, so the costs of the
+	// successors depend on the order of the expansions, which differs between the inflations of ARA*
+	// and A*. On this map, the final plan costs 2.179 instead of 2.168 (0.5 %).
+	EXPECT_NEAR(solutions.back().costs, optimal.back()->costs, 0.01 * optimal.back()->costs);
+	EXPECT_LE(solutions.front().numExpansions, astar.getNumExpansions());
+
+	// without time or after cancellation, there is no plan
+	solutions.clear();
+	EXPECT_TRUE(planning.planPath(FootstepNode::get(0.2, 0.2, 0.0, LEFT), FootstepNode::get(1.4, 0.2, 0.0, RIGHT),
+			AnytimeFootstepPlanning::Clock::now(),
+			[&solutions](const AnytimeFootstepPlanning::Solution& solution) { solutions.push_back(solution); }).empty());
+	const std::atomic<bool> cancel(true);
+	EXPECT_TRUE(planning.planPath(FootstepNode::get(0.2, 0.2, 0.0, LEFT), FootstepNode::get(1.4, 0.2, 0.0, RIGHT),
+			AnytimeFootstepPlanning::Clock::time_point::max(),
+			[&solutions](const AnytimeFootstepPlanning::Solution& solution) { solutions.push_back(solution); }, &cancel).empty());
+	EXPECT_TRUE(solutions.empty());
+	EXPECT_EQ(planning.getNumExpansions(), 0u);
+	EXPECT_THROW(planning.planPath(NULL, FootstepNode::get(1.4, 0.2, 0.0, RIGHT)), std::invalid_argument);
 }
 
 int main(int argc, char *argv[]) {
@@ -0,0 +1,169 @@
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <benchmark-helpers.h>
+#include <ara_star/ARAStar.h>
+#include <ara_star/FileIO.h>
+
+using namespace ara_star;
+
+namespace {
+
+/**
+ * @brief The Euclidean distance, for the A* baseline.
+ */
+class StraightLineHeuristic : public GridHeuristic {
+public:
+	using GridHeuristic::heuristic;
+	double heuristic(const GridNode * const currentNode, const GridNode * const goalNode) const {
+		const double dx = currentNode->x - goalNode->x;
+		const double dy = currentNode->y - goalNode->y;
+		return std::sqrt(dx * dx + dy * dy);
+	}
+};
+
+double pathLength(const std::deque<const AbstractNode*>& path) {
+	double length = 0.0;
+	for (size_t i = 1; i < path.size(); ++i) {
+		const GridNode * const a = static_cast<const GridNode *>(path[i - 1]);
+		const GridNode * const b = static_cast<const GridNode *>(path[i]);
+		length += std::sqrt(static_cast<double>((a->x - b->x) * (a->x - b->x) + (a->y - b->y) * (a->y - b->y)));
+	}
+	return length;
+}
+
+/**
+ * @brief Clears the search state that the start node keeps from earlier queries.
+ *
+ * The nodes are shared by all queries, and followPath() would follow an old predecessor of the start.
+ */
+void resetStart(AbstractNode * const start) {
+	start->costs = 0.0;
+	start->setPredecessor(NULL);
+}
+
+/**
+ * @brief Runs A* and ARA* on synthetic maps of increasing size (random obstacles, mazes, rooms and
+ * corridors) and writes the statistics as JSON.
+ */
+void benchmarkSuite(const size_t& maxSize, const size_t& numQueries, const double& timeLimit) {
+	const size_t sizes[] = { 100, 512, 1024, 4096 };
+	std::vector<benchmark_helpers::BenchmarkResult> results;
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= maxSize; ++s) {
+		std::vector<benchmark_helpers::SyntheticMap> syntheticMaps;
+		syntheticMaps.push_back(benchmark_helpers::randomMap(sizes[s], sizes[s], 10, 1));
+		syntheticMaps.push_back(benchmark_helpers::randomMap(sizes[s], sizes[s], 30, 2));
+		syntheticMaps.push_back(benchmark_helpers::mazeMap(sizes[s], sizes[s], 4, 3));
+		syntheticMaps.push_back(benchmark_helpers::roomsMap(sizes[s], sizes[s], 32, 4));
+		for (size_t m = 0; m < syntheticMaps.size(); ++m) {
+			const GridMap map(syntheticMaps[m].width, syntheticMaps[m].height, syntheticMaps[m].data);
+			OpenList::map = &map;
+			const std::vector<benchmark_helpers::Query> queries = benchmark_helpers::randomQueries(syntheticMaps[m], numQueries, 42);
+
+			StraightLineHeuristic straightLine;
+			GridPathPlanning aStar(map, straightLine);
+			benchmark_helpers::BenchmarkResult aStarResult("A*", syntheticMaps[m]);
+			for (size_t i = 0; i < queries.size(); ++i) {
+				GridNode * const start = GridNode::get(queries[i].startX, queries[i].startY);
+				resetStart(start);
+				const benchmark_helpers::Stopwatch stopwatch;
+				const std::deque<const AbstractNode*> path = aStar.planPath(start, GridNode::get(queries[i].goalX, queries[i].goalY));
+				const double milliseconds = stopwatch.milliseconds();
+				aStarResult.add(milliseconds, aStar.getNumExpansions(), aStar.getPeakOpenListSize(), path.empty() ? -1.0 : pathLength(path));
+			}
+			results.push_back(aStarResult);
+
+			ARAStarHeuristic araHeuristic;
+			ARAStarPlanning ara(map, araHeuristic);
+			benchmark_helpers::BenchmarkResult araResult("ARA*", syntheticMaps[m]);
+			for (size_t i = 0; i < queries.size(); ++i) {
+				GridNode * const start = GridNode::get(queries[i].startX, queries[i].startY);
+				resetStart(start);
+				const benchmark_helpers::Stopwatch stopwatch;
+				const std::deque<const AbstractNode*> path = ara.runARA(5.0, 0.5, timeLimit, start, GridNode::get(queries[i].goalX, queries[i].goalY));
+				const double milliseconds = stopwatch.milliseconds();
+				size_t expansions = 0;
+				for (size_t j = 0; j < ara.getIterations().size(); ++j) {
+					expansions += ara.getIterations()[j].numExpansions;
+				}
+				araResult.add(milliseconds, expansions, ara.getPeakOpenListSize(), path.empty() ? -1.0 : pathLength(path));
+			}
+			results.push_back(araResult);
+			OpenList::map = NULL;
+		}
+	}
+	benchmark_helpers::writeJson(std::cout, "ara_star", results);
+}
+
+/**
+ * @brief Plans the query of ara_star_node on data/map.pbm with ARA*, once continuing the search
+ * between the iterations and once restarting it for each w, and prints the iterations.
+ */
+void benchmarkMap(const double& wInitial, const double& wDelta) {
+	const GridMap *map = FileIO::loadMap(PROJECT_SOURCE_DIR + std::string("/data/map.pbm"));
+	if (!map) {
+		std::cerr << "Could not load the map from " << PROJECT_SOURCE_DIR << "/data" << std::endl;
+		return;
+	}
+	OpenList::map = map;
+	ARAStarHeuristic heuristic;
+	ARAStarPlanning planning(*map, heuristic);
+	const AbstractNode * const start = GridNode::get(17, 48);
+	const AbstractNode * const goal = GridNode::get(85, 47);
+	for (int restart = 0; restart < 2; ++restart) {
+		const benchmark_helpers::Stopwatch stopwatch;
+		size_t totalExpansions = 0;
+		std::vector<ARAStarPlanning::Iteration> iterations;
+		if (restart) {
+			for (double w = wInitial; ; w = std::max(1.0, w - wDelta)) {
+				planning.resetSearch();
+				heuristic.setW(w);
+				planning.planPath(start, goal, time(0), 1e9);
+				iterations.push_back(planning.getIterations().back());
+				if (w <= 1.0) {
+					break;
+				}
+			}
+		} else {
+			planning.runARA(wInitial, wDelta, 1e9, start, goal);
+			iterations = planning.getIterations();
+		}
+		const double milliseconds = stopwatch.milliseconds();
+		for (size_t i = 0; i < iterations.size(); ++i) {
+			std::cout << (restart ? "restart" : "ARA*") << ", w " << iterations[i].w << ": " << iterations[i].numExpansions
+					<< " expansions, costs " << iterations[i].costs << ", bound " << iterations[i].bound << std::endl;
+			totalExpansions += iterations[i].numExpansions;
+		}
+		std::cout << (restart ? "restart" : "ARA*") << ": " << iterations.size() << " iterations, " << totalExpansions
+				<< " expansions, " << milliseconds << " ms" << std::endl;
+	}
+	OpenList::map = NULL;
+	delete map;
+}
+
+}  // namespace
+
+/*
+ * Usage: ara_star-benchmark [largest map size] [number of queries] [ARA* time limit]
+ *        ara_star-benchmark --map [initial w] [decrease of w]
+ *
+ * Plans paths with A* and ARA* (w from 5 down to 1 in steps of 0.5) on synthetic maps from
+ * 100x100 up to the given size (default 1024x1024, the nodes of all cells stay allocated) with
+ * 20 queries each (by default) and writes the statistics to stdout as JSON. The time limit of
+ * ARA* is given in seconds (default 10). The expansions of ARA* are those of all iterations.
+ *
+ * With --map, the query of ara_star_node on data/map.pbm is planned with ARA* (w from 5 down to 1
+ * in steps of 0.5 by default), which continues the search between the iterations, and with one
+ * new search per w, and the expansions and suboptimality bounds of the iterations are printed.
+ */
+int main(int argc, char **argv) {
+	if (argc > 1 && std::string(argv[1]) == "--map") {
+		benchmarkMap(argc > 2 ? std::atof(argv[2]) : 5.0, argc > 3 ? std::atof(argv[3]) : 0.5);
+		return 0;
+	}
+	benchmarkSuite(argc > 1 ? std::atoi(argv[1]) : 1024, argc > 2 ? std::atoi(argv[2]) : 20, argc > 3 ? std::atof(argv[3]) : 10.0);
+	return 0;
+}
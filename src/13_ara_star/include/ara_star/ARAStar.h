@@ -1,7 +1,9 @@
 #ifndef ARA_STAR_H_
 #define ARA_STAR_H_
 
+#include <ctime>
 #include <sstream>
+#include <vector>
 
 #include <ara_star/Heuristic.h>
 #include <ara_star/PathPlanning.h>
@@ -46,26 +48,150 @@ private:
 /**
  * @brief ARA* planning.
  *
- * This class overloads the methods of GridPathPlanning with grid-based node types for convenience.
+ * Each call to planPath() is one iteration of ARA* for the current w of the heuristic. The
+ * iterations of a query (the same start and goal) continue one search: the costs and
+ * predecessors of the cells are kept, a cell is expanded at most once per iteration, and a closed
+ * cell whose costs decrease is put into the INCONS list instead of the open list. When the next
+ * iteration starts with a smaller w, the open list is rebuilt from the open and the inconsistent
+ * cells with their f-values for the new w. A new start or goal, or resetSearch(), starts a new
+ * search.
+ *
+ * runARA() calls planPath() for w from wInitial down to 1. After each iteration, getIterations()
+ * holds its number of expansions and the suboptimality bound of its path, i.e. the factor by which
+ * the costs of the path exceed the optimum at most: the minimum of w and the costs divided by the
+ * smallest f-value (with w = 1) of the open and inconsistent cells.
  */
 class ARAStarPlanning : public GridPathPlanning {
 public:
+	/**
+	 * @brief The statistics of an iteration of ARA*.
+	 */
+	struct Iteration {
+		double w;              ///< The inflation of the heuristic.
+		size_t numExpansions;  ///< The number of cells expanded by the iteration.
+		double costs;          ///< The costs of the path, infinite if the goal has not been reached.
+		double bound;          ///< The costs exceed the optimum by at most this factor, infinite without a path.
+	};
+
 	/**
 	 * @brief Constructs an A* planner for a given grid map and heuristic.
 	 * @param map The grid map for which a plan should be generated.
 	 * @param heuristic The heuristic to use.
 	 */
-	ARAStarPlanning(const GridMap& map, ARAStarHeuristic& heuristic) : GridPathPlanning(map, heuristic),
-	    map_(map), heuristic_(heuristic) {};
+	ARAStarPlanning(const GridMap& map, ARAStarHeuristic& heuristic);
 	virtual ~ARAStarPlanning() {};
 
+	using GridPathPlanning::planPath;
+	using GridPathPlanning::expandNode;
+
+	/**
+	 * @brief Runs one iteration of ARA* with the current w of the heuristic.
+	 * @param[in] startNode The start node.
+	 * @param[in] goalNode The goal node.
+	 * @param[in] tstart The start time at which the ARA* was initially executed.
+	 * @param[in] timeLimit The time limit in seconds, which should not be exceeded.
+	 * @return The path from the start node to the goal node, or an empty path if there is none or the time limit has been exceeded.
+	 * @throws std::invalid_argument if one of the nodes is NULL.
+	 *
+	 * The search of the previous call is continued if start and goal are the same.
+	 */
 	virtual std::deque<const AbstractNode*> planPath(const ara_star::AbstractNode * const startNode, const ara_star::AbstractNode * const goalNode,const time_t & tstart,const double& timeLimit);
 
+	/**
+	 * @brief Runs ARA* until the path is optimal or the time limit has been exceeded.
+	 * @param wInitial The w of the first iteration.
+	 * @param wDelta The decrease of w per iteration.
+	 * @param timeLimit The time limit in seconds.
+	 * @param startNode The start node.
+	 * @param goalNode The goal node.
+	 * @return The path of the last iteration that has found one, or an empty path.
+	 * @throws std::invalid_argument if wDelta is not positive or one of the nodes is NULL.
+	 */
 	std::deque<const AbstractNode*> runARA(const double& wInitial, const double& wDelta, const double& timeLimit,const ara_star::AbstractNode * const startNode, const ara_star::AbstractNode * const goalNode);
 
+	/**
+	 * @brief Expands a cell: updates the costs of its neighbors and opens them or adds them to INCONS.
+	 * @param[in] currentNode The cell to expand.
+	 * @param[in] goalNode The goal cell.
+	 */
+	virtual void expandNode(const AbstractNode * const currentNode, const AbstractNode * const goalNode);
+
+	/**
+	 * @brief Discards the search state, so that the next call to planPath() starts a new search.
+	 */
+	void resetSearch();
+
+	/**
+	 * @brief Tests if a cell is in the open list of the current search.
+	 * @param node The cell.
+	 * @return True iff the cell is open.
+	 */
+	bool isOpen(const AbstractNode * const node) const;
+
+	/**
+	 * @brief Returns the statistics of the iterations of the current search that have run to the end.
+	 * @return One entry per iteration, in the order of the calls to planPath().
+	 */
+	const std::vector<Iteration>& getIterations() const {
+		return iterations;
+	}
+
 private:
+	/**
+	 * @brief The search state of a cell.
+	 *
+	 * The costs and the predecessor are stored in the node, and are valid iff reached is true.
+	 */
+	struct CellState {
+		double key;             ///< The priority of the cell in the open list.
+		unsigned int closedIn;  ///< The iteration in which the cell was expanded last, 0 if never.
+		bool reached;           ///< True iff the cell has been reached by the current search.
+		bool open;              ///< True iff the cell is in the open list.
+		bool inconsistent;      ///< True iff the cell is in the INCONS list.
+		CellState() : key(0.0), closedIn(0), reached(false), open(false), inconsistent(false) {}
+	};
+
+	/**
+	 * @brief An entry of the open list, outdated if its key differs from that of the cell.
+	 */
+	struct Entry {
+		double key;
+		const AbstractNode *node;
+		bool operator<(const Entry& other) const {
+			// std::push_heap() builds a max-heap
+			return key > other.key;
+		}
+	};
+
+	CellState& getState(const AbstractNode * const node);
+	const CellState& getState(const AbstractNode * const node) const;
+
+	/**
+	 * @brief Inserts a cell into the open list or updates its key.
+	 */
+	void push(const AbstractNode * const node, CellState& state, const double& key);
+
+	/**
+	 * @brief Moves the inconsistent cells to the open list and recomputes the keys for the current w.
+	 */
+	void rebuildOpenList(const AbstractNode * const goalNode);
+
+	/**
+	 * @brief Returns the smallest f-value with w = 1 of the open and the inconsistent cells.
+	 */
+	double getLowerBound(const AbstractNode * const goalNode);
+
    	const GridMap map_;
    	ARAStarHeuristic& heuristic_;
+   	std::vector<CellState> states;                   ///< The search state of each cell, in row-major order.
+   	std::vector<const AbstractNode *> reachedNodes;  ///< The cells that the current search has reached.
+   	std::vector<Entry> openList;                     ///< A heap of the open cells, with outdated entries.
+   	std::vector<const AbstractNode *> inconsistent;  ///< The INCONS list.
+   	std::vector<Iteration> iterations;
+   	const AbstractNode *searchStart;                 ///< The start of the current search, NULL if there is none.
+   	const AbstractNode *searchGoal;                  ///< The goal of the current search.
+   	unsigned int iteration;                          ///< The number of the current iteration, starting at 1.
+   	size_t numOpen;                                  ///< The number of open cells.
 };
 
 }  // namespace ara_star
@@ -34,8 +34,8 @@ public:
 
 	virtual std::deque<const AbstractNode*> planPath(const ara_star::AbstractNode * const startNode, const ara_star::AbstractNode * const goalNode,const time_t & tstart,const double& timeLimit);
 
-	virtual void expandNode(const AbstractNode * const currentNode, const ara_star::AbstractNode * const goalNode,
-		OpenList& openList, const ara_star::ClosedList& closedList);
+	using ARAStarPlanning::expandNode;
+	virtual void expandNode(const AbstractNode * const currentNode, const ara_star::AbstractNode * const goalNode);
 
 	void savePathLengthHistory();
 };
@@ -51,7 +51,7 @@ public:
 class PathPlanning
 {
 public:
-	PathPlanning() {};
+	PathPlanning() : numExpansions(0), peakOpenListSize(0) {};
    	virtual ~PathPlanning() {};
    	/**
    	 * @brief Plans a path from a start node to a goal node.
@@ -112,6 +112,26 @@ public:
 	 * @throws std::invalid_argument if one of the arguments is NULL.
 	 */
 	virtual bool isCloseToGoal(const AbstractNode * const currentNode, const AbstractNode * const goalNode) = 0;
+
+	/**
+	 * @brief Returns the number of nodes that were expanded by the last call to planPath().
+	 * @return The number of expanded nodes.
+	 */
+	size_t getNumExpansions() const {
+		return numExpansions;
+	}
+
+	/**
+	 * @brief Returns the largest number of open nodes during the last call to planPath().
+	 * @return The peak size of the open list.
+	 */
+	size_t getPeakOpenListSize() const {
+		return peakOpenListSize;
+	}
+
+protected:
+	size_t numExpansions;     ///< Number of nodes expanded by the last call to planPath().
+	size_t peakOpenListSize;  ///< Largest number of open nodes during the last call to planPath().
 };
 
 /**
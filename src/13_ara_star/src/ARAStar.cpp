@@ -1,6 +1,8 @@
 #include <ara_star/ARAStar.h>
-#include <ctime>
+#include <algorithm>
 #include <cmath>
+#include <ctime>
+#include <limits>
 
 namespace ara_star {
 
@@ -14,15 +16,124 @@ double ARAStarHeuristic::heuristic(
 		const GridNode * const currentNode,
 		const GridNode * const goalNode) const
 {
-	double result = 0.0;
-	// TODO
-	/* Available fields and methods:
-	 * - node->x: the x index of the cell
-	 * - node->y: the y index of the cell
-	 * - getW(): the current w value of ARA*
-	 */
+	const double dx = currentNode->x - goalNode->x;
+	const double dy = currentNode->y - goalNode->y;
+	const double result = getW() * sqrt(dx * dx + dy * dy);
+	return result;
+}
+
+ARAStarPlanning::ARAStarPlanning(const GridMap& map, ARAStarHeuristic& heuristic) :
+		GridPathPlanning(map, heuristic), map_(map), heuristic_(heuristic),
+		states(map.width * map.height), searchStart(NULL), searchGoal(NULL), iteration(0), numOpen(0) {
+}
+
+ARAStarPlanning::CellState& ARAStarPlanning::getState(const AbstractNode * const node) {
+	const GridNode * const cell = static_cast<const GridNode *>(node);
+	if (cell->x < 0 || cell->x >= static_cast<int>(map_.width) || cell->y < 0 || cell->y >= static_cast<int>(map_.height)) {
+		throw std::out_of_range("ARAStarPlanning: the cell is outside the map");
+	}
+	return states[cell->y * map_.width + cell->x];
+}
+
+const ARAStarPlanning::CellState& ARAStarPlanning::getState(const AbstractNode * const node) const {
+	const GridNode * const cell = static_cast<const GridNode *>(node);
+	if (cell->x < 0 || cell->x >= static_cast<int>(map_.width) || cell->y < 0 || cell->y >= static_cast<int>(map_.height)) {
+		throw std::out_of_range("ARAStarPlanning: the cell is outside the map");
+	}
+	return states[cell->y * map_.width + cell->x];
+}
+
+void ARAStarPlanning::resetSearch() {
+	for (size_t i = 0; i < reachedNodes.size(); ++i) {
+		getState(reachedNodes[i]) = CellState();
+	}
+	reachedNodes.clear();
+	openList.clear();
+	inconsistent.clear();
+	iterations.clear();
+	searchStart = NULL;
+	searchGoal = NULL;
+	iteration = 0;
+	numOpen = 0;
+}
+
+bool ARAStarPlanning::isOpen(const AbstractNode * const node) const {
+	if (!node) {
+		throw std::invalid_argument("ARAStarPlanning::isOpen(): node is NULL");
+	}
+	return getState(node).open;
+}
 
+void ARAStarPlanning::push(const AbstractNode * const node, CellState& state, const double& key) {
+	if (!state.open) {
+		state.open = true;
+		++numOpen;
+	}
+	state.key = key;
+	const Entry entry = { key, node };
+	openList.push_back(entry);
+	std::push_heap(openList.begin(), openList.end());
+}
+
+void ARAStarPlanning::expandNode(const AbstractNode * const currentNode, const AbstractNode * const goalNode) {
+	const std::vector<AbstractNode *> neighbors = getNeighborNodes(currentNode);
+	for (std::vector<AbstractNode *>::const_iterator neighborIt = neighbors.begin(); neighborIt != neighbors.end(); ++neighborIt) {
+		AbstractNode * const neighbor = *neighborIt;
+		CellState& state = getState(neighbor);
+		const double tentative_g = currentNode->costs + getCosts(currentNode, neighbor);
+		if (state.reached && tentative_g >= neighbor->costs) {
+			continue;
+		}
+		if (!state.reached) {
+			state.reached = true;
+			reachedNodes.push_back(neighbor);
+		}
+		neighbor->setPredecessor(currentNode);
+		neighbor->costs = tentative_g;
+		if (state.closedIn == iteration) {
+			// a cell is expanded at most once per iteration, the next iteration opens it again
+			if (!state.inconsistent) {
+				state.inconsistent = true;
+				inconsistent.push_back(neighbor);
+			}
+		} else {
+			push(neighbor, state, tentative_g + heuristic(neighbor, goalNode));
+		}
+	}
+}
 
+void ARAStarPlanning::rebuildOpenList(const AbstractNode * const goalNode) {
+	for (size_t i = 0; i < inconsistent.size(); ++i) {
+		CellState& state = getState(inconsistent[i]);
+		state.inconsistent = false;
+		if (!state.open) {
+			state.open = true;
+			++numOpen;
+		}
+	}
+	inconsistent.clear();
+	openList.clear();
+	for (size_t i = 0; i < reachedNodes.size(); ++i) {
+		CellState& state = getState(reachedNodes[i]);
+		if (state.open) {
+			state.key = reachedNodes[i]->costs + heuristic(reachedNodes[i], goalNode);
+			const Entry entry = { state.key, reachedNodes[i] };
+			openList.push_back(entry);
+		}
+	}
+	std::make_heap(openList.begin(), openList.end());
+}
+
+double ARAStarPlanning::getLowerBound(const AbstractNode * const goalNode) {
+	const double w = heuristic_.getW();
+	double result = std::numeric_limits<double>::infinity();
+	for (size_t i = 0; i < reachedNodes.size(); ++i) {
+		const CellState& state = getState(reachedNodes[i]);
+		if (state.open || state.inconsistent) {
+			const double h = w > 0.0 ? heuristic(reachedNodes[i], goalNode) / w : 0.0;
+			result = std::min(result, reachedNodes[i]->costs + h);
+		}
+	}
 	return result;
 }
 
@@ -32,7 +143,7 @@ double ARAStarHeuristic::heuristic(
  * @param[in] goalNode The goal node.
  * @param[in] tstart The start time at which the ARA* was initially executed.
  * @param[in] timeLimit The time limit in seconds, which should not be exceeded.
- * @return The optimal path from the start node to the end node.
+ * @return The path from the start node to the goal node, empty if the time limit has been exceeded.
  */
 std::deque<const AbstractNode*> ARAStarPlanning::planPath(
 		const AbstractNode * const startNode,
@@ -40,26 +151,75 @@ std::deque<const AbstractNode*> ARAStarPlanning::planPath(
 		const time_t & tstart,
 		const double& timeLimit)
 {
-	// Create empty lists for open nodes and closed nodes
-   	OpenList openList;
-   	ClosedList closedList;
-
-   	std::deque<const AbstractNode*> resultPath;
-
-   	/* TODO: Fill resultPath by planning a path from the startNode to the goalNode */
+	if (!startNode) {
+		throw std::invalid_argument("ARAStarPlanning::planPath(): startNode is NULL");
+	}
+	if (!goalNode) {
+		throw std::invalid_argument("ARAStarPlanning::planPath(): goalNode is NULL");
+	}
+	if (startNode != searchStart || goalNode != searchGoal) {
+		resetSearch();
+	}
+	numExpansions = 0;
+	++iteration;
+	if (!searchStart) {
+		searchStart = startNode;
+		searchGoal = goalNode;
+		// the nodes are shared by all searches, so the start may have costs and a predecessor from an earlier one
+		AbstractNode * const start = GridNode::get(static_cast<const GridNode *>(startNode)->x, static_cast<const GridNode *>(startNode)->y);
+		start->costs = 0.0;
+		start->setPredecessor(NULL);
+		CellState& state = getState(start);
+		state.reached = true;
+		reachedNodes.push_back(start);
+		push(start, state, heuristic(start, goalNode));
+	} else {
+		// the previous iteration has used a larger w
+		rebuildOpenList(goalNode);
+	}
+	peakOpenListSize = numOpen;
 
-   	/*
-	**** Hint: Copy your code that you have implemented for exercise 11
-	**** (PathPlanning::planPath method) and extend it so that it aborts
-	**** searching for a path as soon as the time limit is exceeded.
-	*/
+	const CellState& goalState = getState(goalNode);
+	while (!openList.empty()) {
+		const Entry top = openList.front();
+		CellState& state = getState(top.node);
+		if (!state.open || state.key != top.key) {
+			// here updated nodes are deleted (lazy deletion)
+			std::pop_heap(openList.begin(), openList.end());
+			openList.pop_back();
+			continue;
+		}
+		// no open cell can lead to a cheaper path to the goal with the current w
+		if (goalState.reached && goalNode->costs <= top.key) {
+			break;
+		}
+		if (difftime(time(0), tstart) >= timeLimit) {
+			return std::deque<const AbstractNode*>();
+		}
+		std::pop_heap(openList.begin(), openList.end());
+		openList.pop_back();
+		state.open = false;
+		--numOpen;
+		state.closedIn = iteration;
+		++numExpansions;
+		expandNode(top.node, goalNode);
+		peakOpenListSize = std::max(peakOpenListSize, numOpen);
+	}
 
-   	/* Available methods: all of the methods available in PathPlanning::planPath (exercise 11) plus:
-   	 * - difftime(time(0), tstart): returns the time elapsed since tstart in seconds.
-   	 */
-
-
-	return resultPath;
+	Iteration result;
+	result.w = heuristic_.getW();
+	result.numExpansions = numExpansions;
+	result.costs = goalState.reached ? goalNode->costs : std::numeric_limits<double>::infinity();
+	result.bound = std::numeric_limits<double>::infinity();
+	if (goalState.reached) {
+		const double lowerBound = getLowerBound(goalNode);
+		result.bound = result.costs <= lowerBound ? 1.0 : std::max(1.0, std::min(result.w, result.costs / lowerBound));
+	}
+	iterations.push_back(result);
+	if (!goalState.reached) {
+		return std::deque<const AbstractNode*>();
+	}
+	return followPath(goalNode);
 }
 
 /**
@@ -72,24 +232,33 @@ std::deque<const AbstractNode*> ARAStarPlanning::planPath(
  * @return The path from the start node to the goal node (empty if no path was found).
  */
 std::deque<const AbstractNode*>  ARAStarPlanning::runARA(const double& wInitial, const double& wDelta, const double& timeLimit,const ara_star::AbstractNode * const startNode, const ara_star::AbstractNode * const goalNode) {
+	if (!(wDelta > 0.0)) {
+		throw std::invalid_argument("ARAStarPlanning::runARA(): wDelta must be positive");
+	}
 	std::deque<const AbstractNode*> resultPath;
 
 	const time_t tstart = time(0);
-
-	/*
-	 * TODO: Implement the ARA* algorithm.
-	 */
-
-	/* Available methods:
-	 * - heuristic_.setW(): Sets the current w value for the ARA* heuristic.
-	 * - heuristic_.getW(): Returns the current w value set using setW().
-	 * - planPath(startNode, goalNode, tstart, timeLimit): Runs the planning method that you implemented above.
-	 * - difftime(time(0), tstart): returns the ellapsed time in seconds.
-	 */
+	resetSearch();
+	double w = wInitial;
+	while (true) {
+		heuristic_.setW(w);
+		const size_t numIterations = iterations.size();
+		const std::deque<const AbstractNode*> path = planPath(startNode, goalNode, tstart, timeLimit);
+		if (!path.empty()) {
+			resultPath = path;
+		}
+		// stop when the path is optimal, or when a whole iteration has not reached the goal, which is unreachable then
+		const bool completed = iterations.size() > numIterations;
+		if (completed && !(iterations.back().bound > 1.0 && iterations.back().bound < std::numeric_limits<double>::infinity())) {
+			break;
+		}
+		if (w <= 1.0 || difftime(time(0), tstart) >= timeLimit) {
+			break;
+		}
+		w = std::max(1.0, w - wDelta);
+	}
 
 	return resultPath;
-
-
 }
 
 }
@@ -65,16 +65,18 @@ std::deque<const AbstractNode*> ARAStarPlanningLog::planPath(const ara_star::Abs
 		return resultPath;
 	}
 
-	void ARAStarPlanningLog::expandNode(const AbstractNode * const currentNode, const ara_star::AbstractNode * const goalNode,
-		OpenList& openList, const ara_star::ClosedList& closedList)
+	void ARAStarPlanningLog::expandNode(const AbstractNode * const currentNode, const ara_star::AbstractNode * const goalNode)
 	{
-		ARAStarPlanning::expandNode(currentNode,goalNode,openList,closedList);
-
-		for(size_t r=0;r<mapHistory.height;r++) {
-			for(size_t c=0;c<mapHistory.width;c++) {
-				if (openList.contains(GridNode::get(static_cast<int>(c), static_cast<int>(r)))) {
-					mapLog.at(r).at(c) = 2;
-				}
+		ARAStarPlanning::expandNode(currentNode,goalNode);
+
+		// the open cells only change around the expanded cell
+		const GridNode * const cell = static_cast<const GridNode *>(currentNode);
+		mapLog.at(cell->y).at(cell->x) = 2;
+		const std::vector<AbstractNode *> neighbors = getNeighborNodes(currentNode);
+		for (size_t i = 0; i < neighbors.size(); ++i) {
+			if (isOpen(neighbors[i])) {
+				const GridNode * const neighbor = static_cast<const GridNode *>(neighbors[i]);
+				mapLog.at(neighbor->y).at(neighbor->x) = 2;
 			}
 		}
 
@@ -8,6 +8,7 @@ bool OpenList::logToStdout = false;
 const GridMap *OpenList::map = NULL;
 
 OpenList::OpenList() :
+		numOpen(0),
 		duplicateWarning(false),
 		reinsertWarning(false),
 		data(map->width * map->height)
@@ -15,6 +16,10 @@ OpenList::OpenList() :
 }
 
 OpenList::~OpenList() {
+	while (!openList.empty()) {
+		delete openList.top();
+		openList.pop();
+	}
 }
 
 OpenList::OpenListData& OpenList::getData(AbstractNode * node) {
@@ -61,6 +66,9 @@ void OpenList::enqueue(const AbstractNode * const node, const double costs) {
 				<< std::endl;
 			reinsertWarning = true;
 	}
+	if (d.state != OpenListData::OPEN) {
+		++numOpen;
+	}
 	d.state = OpenListData::OPEN;
 	d.cost = costs;
 	NodeWrapper *wrapper = new NodeWrapper(node, costs);
@@ -75,6 +83,7 @@ const AbstractNode * OpenList::removeMin() {
 		OpenList::OpenListData& d = getData(node);
 		if (d.state == OpenListData::OPEN) {
 			d.state = OpenListData::CLOSED;
+			--numOpen;
 			return node;
 		}
 		// here updated nodes are deleted (lazy deletion)
@@ -110,6 +119,7 @@ double OpenList::getCosts(const AbstractNode * const node) const {
 bool OpenList::isEmpty() const {
 	// do lazy deletion
 	while(!openList.empty() && getData(openList.top()->node).state == OpenListData::CLOSED) {
+		delete openList.top();
 		openList.pop();
 	}
 	return openList.empty();
@@ -1,4 +1,5 @@
 #include <ara_star/PathPlanning.h>
+#include <algorithm>
 #include <cmath>
 
 namespace ara_star {
@@ -79,7 +80,9 @@ std::deque<const AbstractNode*> PathPlanning::planPath(const AbstractNode * cons
    	ClosedList closedList;
 
    	std::deque<const AbstractNode*> resultPath;
+	numExpansions = 0;
 	openList.enqueue(startNode, 0.0);
+	peakOpenListSize = openList.size();
 	while (!openList.isEmpty()) {
 		const AbstractNode * currentNode = openList.removeMin();
 		if (isCloseToGoal(currentNode, goalNode)) {
@@ -87,7 +90,9 @@ std::deque<const AbstractNode*> PathPlanning::planPath(const AbstractNode * cons
 			break;
 		}
 		closedList.add(currentNode);
+		++numExpansions;
 		expandNode(currentNode, goalNode, openList, closedList);
+		peakOpenListSize = std::max(peakOpenListSize, openList.size());
 	}
 
 	return resultPath;
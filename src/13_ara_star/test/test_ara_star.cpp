@@ -171,6 +171,69 @@ TEST(ARAStar, runARA) {
 	}
 }
 
+TEST(ARAStar, reuseSearch) {
+	// 40 x 40 cells with a wall at x = 20 from y = 5 to y = 39
+	const size_t size = 40;
+	std::vector<bool> data(size * size, false);
+	for (size_t y = 5; y < size; ++y) {
+		data[y * size + 20] = true;
+	}
+	GridMap map(size, size, data);
+	OpenList::map = &map;
+	ARAStarHeuristic h;
+	h.setW(1.0);
+	GridPathPlanning aStar(map, h);
+	AbstractNode * const start = GridNode::get(5, 30);
+	AbstractNode * const goal = GridNode::get(35, 30);
+	start->costs = 0.0;
+	start->setPredecessor(NULL);
+	const std::deque<const AbstractNode *> optimal = aStar.planPath(start, goal);
+	ASSERT_FALSE(optimal.empty());
+	const double optimalCosts = optimal.back()->costs;
+
+	ARAStarPlanning planner(map, h);
+	EXPECT_THROW(planner.runARA(3.0, 0.0, 10.0, start, goal), std::invalid_argument);
+	const std::deque<const AbstractNode *> path = planner.runARA(3.0, 0.5, 10.0, start, goal);
+	ASSERT_FALSE(path.empty());
+	EXPECT_EQ(path.front(), start);
+	EXPECT_EQ(path.back(), goal);
+	EXPECT_NEAR(goal->costs, optimalCosts, 1e-9);
+
+	// the bounds decrease with w, and the last path is optimal
+	const std::vector<ARAStarPlanning::Iteration> iterations = planner.getIterations();
+	ASSERT_FALSE(iterations.empty());
+	EXPECT_DOUBLE_EQ(iterations[0].w, 3.0);
+	size_t expansions = 0;
+	for (size_t i = 0; i < iterations.size(); ++i) {
+		EXPECT_GE(iterations[i].bound, 1.0);
+		EXPECT_LE(iterations[i].bound, iterations[i].w);
+		EXPECT_LE(iterations[i].costs, iterations[i].bound * optimalCosts + 1e-9);
+		if (i > 0) {
+			EXPECT_LT(iterations[i].w, iterations[i - 1].w);
+			EXPECT_LE(iterations[i].costs, iterations[i - 1].costs);
+		}
+		expansions += iterations[i].numExpansions;
+	}
+	EXPECT_DOUBLE_EQ(iterations.back().bound, 1.0);
+	EXPECT_NEAR(iterations.back().costs, optimalCosts, 1e-9);
+
+	// a new search for each w expands more cells in total
+	size_t restartExpansions = 0;
+	for (size_t i = 0; i < iterations.size(); ++i) {
+		planner.resetSearch();
+		h.setW(iterations[i].w);
+		planner.planPath(start, goal, time(0), 10.0);
+		restartExpansions += planner.getNumExpansions();
+	}
+	EXPECT_LT(expansions, restartExpansions);
+
+	// without time, there is no path
+	planner.resetSearch();
+	EXPECT_TRUE(planner.planPath(start, goal, time(0), 0.0).empty());
+	EXPECT_TRUE(planner.getIterations().empty());
+	EXPECT_THROW(planner.planPath(NULL, goal, time(0), 10.0), std::invalid_argument);
+}
+
 int main(int argc, char *argv[]) {
 	::testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -0,0 +1,91 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <benchmark-helpers.h>
+#include <rrt/RRT.h>
+
+using namespace rrt;
+
+namespace {
+
+/**
+ * @brief RRTGrid that counts its extend steps.
+ */
+class CountingRRT : public RRTGrid {
+public:
+	explicit CountingRRT(const GridMap& map) : RRTGrid(map), numExtensions(0) {}
+
+	virtual ExtendStepReturnValue extendClosestNode(AbstractNode * const randomNode,
+			std::vector<AbstractNode *> & list, const std::vector<AbstractNode *> & otherList) {
+		++numExtensions;
+		return RRTGrid::extendClosestNode(randomNode, list, otherList);
+	}
+
+	size_t numExtensions;  ///< The number of extend steps since the counter was reset.
+};
+
+double pathLength(const std::deque<AbstractNode*>& path) {
+	double length = 0.0;
+	for (size_t i = 1; i < path.size(); ++i) {
+		const GridNode * const a = static_cast<const GridNode *>(path[i - 1]);
+		const GridNode * const b = static_cast<const GridNode *>(path[i]);
+		length += std::sqrt(static_cast<double>((a->x - b->x) * (a->x - b->x) + (a->y - b->y) * (a->y - b->y)));
+	}
+	return length;
+}
+
+/**
+ * @brief Runs the bidirectional RRT on synthetic maps of increasing size (random obstacles, mazes,
+ * rooms and corridors) and writes the statistics as JSON.
+ *
+ * The expansions are the extend steps of both trees. An RRT has no open list, so its peak size
+ * is reported as 0.
+ */
+void benchmarkSuite(const size_t& maxSize, const size_t& numQueries, const size_t& maxIterations) {
+	const size_t sizes[] = { 100, 512, 1024, 4096 };
+	std::vector<benchmark_helpers::BenchmarkResult> results;
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= maxSize; ++s) {
+		std::vector<benchmark_helpers::SyntheticMap> syntheticMaps;
+		syntheticMaps.push_back(benchmark_helpers::randomMap(sizes[s], sizes[s], 10, 1));
+		syntheticMaps.push_back(benchmark_helpers::randomMap(sizes[s], sizes[s], 30, 2));
+		syntheticMaps.push_back(benchmark_helpers::mazeMap(sizes[s], sizes[s], 4, 3));
+		syntheticMaps.push_back(benchmark_helpers::roomsMap(sizes[s], sizes[s], 32, 4));
+		for (size_t m = 0; m < syntheticMaps.size(); ++m) {
+			std::vector<bool> data(syntheticMaps[m].data);
+			const GridMap map(syntheticMaps[m].width, syntheticMaps[m].height, data);
+			const std::vector<benchmark_helpers::Query> queries = benchmark_helpers::randomQueries(syntheticMaps[m], numQueries, 42);
+			// the random samples of the RRT are reproducible as well
+			srand(42);
+			CountingRRT planner(map);
+			benchmark_helpers::BenchmarkResult result("bidirectional RRT", syntheticMaps[m]);
+			for (size_t i = 0; i < queries.size(); ++i) {
+				GridNode * const start = GridNode::get(queries[i].startX, queries[i].startY);
+				GridNode * const goal = GridNode::get(queries[i].goalX, queries[i].goalY);
+				// the nodes are shared by all queries, so the roots must not keep predecessors from earlier trees
+				start->setPredecessor(NULL);
+				goal->setPredecessor(NULL);
+				planner.numExtensions = 0;
+				const benchmark_helpers::Stopwatch stopwatch;
+				const std::deque<AbstractNode*> path = planner.planPath(start, goal, maxIterations);
+				const double milliseconds = stopwatch.milliseconds();
+				result.add(milliseconds, planner.numExtensions, 0, path.empty() ? -1.0 : pathLength(path));
+			}
+			results.push_back(result);
+		}
+	}
+	benchmark_helpers::writeJson(std::cout, "rrt", results);
+}
+
+}  // namespace
+
+/*
+ * Usage: rrt-benchmark [largest map size] [number of queries] [maximum number of iterations]
+ *
+ * Plans paths on synthetic maps from 100x100 up to the given size (default 1024x1024) with 20
+ * queries each (by default), at most 10000 iterations per query (by default), and writes the
+ * statistics to stdout as JSON.
+ */
+int main(int argc, char **argv) {
+	benchmarkSuite(argc > 1 ? std::atoi(argv[1]) : 1024, argc > 2 ? std::atoi(argv[2]) : 20, argc > 3 ? std::atoi(argv[3]) : 10000);
+	return 0;
+}
@@ -0,0 +1,410 @@
+#ifndef BENCHMARK_HELPERS_H_
+#define BENCHMARK_HELPERS_H_
+
+/*
+ * Synthetic maps, seeded queries and JSON reports shared by the benchmarks of the planning
+ * modules. Everything is reproducible: the same arguments always give the same maps and
+ * queries, on every platform, so the reports of two versions can be compared directly.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#if !(_WIN32 || _WIN64)
+#include <sys/resource.h>
+#endif
+
+namespace benchmark_helpers {
+
+/**
+ * @brief An occupancy grid, row by row (index y * width + x), true for occupied cells.
+ */
+struct SyntheticMap {
+	std::string name;  ///< Describes the generator and its parameters, e.g. "random-20".
+	size_t width;
+	size_t height;
+	std::vector<bool> data;
+
+	SyntheticMap() : width(0), height(0) {}
+
+	bool isOccupied(const size_t& x, const size_t& y) const {
+		return data[y * width + x];
+	}
+};
+
+/**
+ * @brief Linear congruential generator, identical on all platforms unlike std::rand().
+ */
+class Random {
+public:
+	explicit Random(const unsigned int& seed) : seed(seed) {}
+
+	/**
+	 * @brief Returns a number in [0, n).
+	 */
+	size_t next(const size_t& n) {
+		seed = seed * 1103515245u + 12345u;
+		size_t value = seed >> 8;
+		if (n > (1u << 24)) {
+			// a single step has only 24 usable bits
+			seed = seed * 1103515245u + 12345u;
+			value = (value << 24) | (seed >> 8);
+		}
+		return value % n;
+	}
+
+private:
+	unsigned int seed;
+};
+
+inline std::string mapName(const std::string& generator, const size_t& parameter) {
+	std::ostringstream name;
+	name << generator << "-" << parameter;
+	return name.str();
+}
+
+/**
+ * @brief Creates a map whose cells are occupied independently of each other.
+ * @param densityPercent The probability of a cell to be occupied, in percent.
+ */
+inline SyntheticMap randomMap(const size_t& width, const size_t& height, const size_t& densityPercent, const unsigned int& seed) {
+	SyntheticMap map;
+	map.name = mapName("random", densityPercent);
+	map.width = width;
+	map.height = height;
+	map.data.resize(width * height);
+	Random random(seed);
+	for (size_t i = 0; i < map.data.size(); ++i) {
+		map.data[i] = random.next(100) < densityPercent;
+	}
+	return map;
+}
+
+/**
+ * @brief Frees the cells of the rectangle [x0, x1) x [y0, y1), clipped to the map.
+ */
+inline void freeRect(SyntheticMap& map, const size_t& x0, const size_t& y0, const size_t& x1, const size_t& y1) {
+	for (size_t y = y0; y < std::min(y1, map.height); ++y) {
+		for (size_t x = x0; x < std::min(x1, map.width); ++x) {
+			map.data[y * map.width + x] = false;
+		}
+	}
+}
+
+/**
+ * @brief Creates a perfect maze (exactly one path between any two cells) by a randomized depth-first search.
+ * @param corridorWidth The width of the corridors in cells, the walls are one cell thick.
+ */
+inline SyntheticMap mazeMap(const size_t& width, const size_t& height, const size_t& corridorWidth, const unsigned int& seed) {
+	SyntheticMap map;
+	map.name = mapName("maze", corridorWidth);
+	map.width = width;
+	map.height = height;
+	map.data.assign(width * height, true);
+	const size_t pitch = corridorWidth + 1;
+	const size_t cellsX = width / pitch > 0 ? width / pitch : 1;
+	const size_t cellsY = height / pitch > 0 ? height / pitch : 1;
+
+	Random random(seed);
+	std::vector<bool> visited(cellsX * cellsY, false);
+	std::vector<size_t> stack(1, 0);
+	visited[0] = true;
+	freeRect(map, 0, 0, corridorWidth, corridorWidth);
+	while (!stack.empty()) {
+		const size_t cell = stack.back();
+		const size_t cx = cell % cellsX;
+		const size_t cy = cell / cellsX;
+		size_t candidates[4];
+		size_t numCandidates = 0;
+		if (cx > 0 && !visited[cell - 1]) candidates[numCandidates++] = cell - 1;
+		if (cx + 1 < cellsX && !visited[cell + 1]) candidates[numCandidates++] = cell + 1;
+		if (cy > 0 && !visited[cell - cellsX]) candidates[numCandidates++] = cell - cellsX;
+		if (cy + 1 < cellsY && !visited[cell + cellsX]) candidates[numCandidates++] = cell + cellsX;
+		if (numCandidates == 0) {
+			stack.pop_back();
+			continue;
+		}
+		const size_t next = candidates[random.next(numCandidates)];
+		const size_t nx = next % cellsX;
+		const size_t ny = next / cellsX;
+		// the corridor from the current cell to the next one includes the wall between them
+		freeRect(map, std::min(cx, nx) * pitch, std::min(cy, ny) * pitch,
+				std::max(cx, nx) * pitch + corridorWidth, std::max(cy, ny) * pitch + corridorWidth);
+		visited[next] = true;
+		stack.push_back(next);
+	}
+	return map;
+}
+
+/**
+ * @brief Creates square rooms separated by one cell thick walls, with a door in every wall
+ * and a corridor along every fourth row and column of rooms.
+ * @param roomSize The width and height of the rooms in cells.
+ */
+inline SyntheticMap roomsMap(const size_t& width, const size_t& height, const size_t& roomSize, const unsigned int& seed) {
+	SyntheticMap map;
+	map.name = mapName("rooms", roomSize);
+	map.width = width;
+	map.height = height;
+	map.data.assign(width * height, false);
+	const size_t pitch = roomSize + 1;
+	const size_t doorWidth = std::max<size_t>(1, roomSize / 4);
+	Random random(seed);
+	// walls at x = k * pitch - 1, interrupted by the corridors and one door per room
+	for (size_t x = roomSize; x < width; x += pitch) {
+		for (size_t roomY = 0; roomY * pitch < height; ++roomY) {
+			if (roomY % 4 == 3) {
+				continue;
+			}
+			const size_t door = roomY * pitch + random.next(roomSize - doorWidth + 1);
+			for (size_t y = roomY * pitch; y < std::min((roomY + 1) * pitch, height); ++y) {
+				map.data[y * width + x] = y < door || y >= door + doorWidth;
+			}
+		}
+	}
+	// walls at y = k * pitch - 1
+	for (size_t y = roomSize; y < height; y += pitch) {
+		for (size_t roomX = 0; roomX * pitch < width; ++roomX) {
+			if (roomX % 4 == 3) {
+				continue;
+			}
+			const size_t door = roomX * pitch + random.next(roomSize - doorWidth + 1);
+			for (size_t x = roomX * pitch; x < std::min((roomX + 1) * pitch, width); ++x) {
+				map.data[y * width + x] = x < door || x >= door + doorWidth;
+			}
+		}
+	}
+	return map;
+}
+
+inline size_t distance(const size_t& a, const size_t& b) {
+	return a > b ? a - b : b - a;
+}
+
+/**
+ * @brief A query between two cells.
+ */
+struct Query {
+	int startX;
+	int startY;
+	int goalX;
+	int goalY;
+};
+
+/**
+ * @brief Draws reproducible queries between free cells that are connected by a path.
+ *
+ * Start and goal are connected without diagonal steps, so the queries are solvable for planners
+ * with 4- and 8-connectivity. Returns fewer queries if the map has hardly any connected free cells.
+ *
+ * @param maxDistance The largest distance between start and goal along each axis in cells, 0 for no limit.
+ */
+inline std::vector<Query> randomQueries(const SyntheticMap& map, const size_t& count, const unsigned int& seed,
+		const size_t& maxDistance = 0) {
+	// label the 4-connected components
+	const size_t NONE = static_cast<size_t>(-1);
+	std::vector<size_t> component(map.data.size(), NONE);
+	std::vector<size_t> queue;
+	size_t numFree = 0;
+	for (size_t start = 0; start < map.data.size(); ++start) {
+		if (map.data[start] || component[start] != NONE) {
+			continue;
+		}
+		component[start] = start;
+		queue.assign(1, start);
+		while (!queue.empty()) {
+			const size_t cell = queue.back();
+			queue.pop_back();
+			++numFree;
+			const size_t x = cell % map.width;
+			const size_t neighbors[4] = {
+				x > 0 ? cell - 1 : NONE,
+				x + 1 < map.width ? cell + 1 : NONE,
+				cell >= map.width ? cell - map.width : NONE,
+				cell + map.width < map.data.size() ? cell + map.width : NONE
+			};
+			for (int i = 0; i < 4; ++i) {
+				if (neighbors[i] != NONE && !map.data[neighbors[i]] && component[neighbors[i]] == NONE) {
+					component[neighbors[i]] = start;
+					queue.push_back(neighbors[i]);
+				}
+			}
+		}
+	}
+
+	std::vector<Query> queries;
+	if (numFree < 2) {
+		return queries;
+	}
+	Random random(seed);
+	for (size_t tries = 0; queries.size() < count && tries < 100 * count; ++tries) {
+		size_t start, goal;
+		do {
+			start = random.next(map.data.size());
+		} while (map.data[start]);
+		// give up on starts in tiny components instead of searching for a goal forever
+		size_t attempts = 0;
+		do {
+			goal = random.next(map.data.size());
+		} while ((component[goal] != component[start] || goal == start
+				|| (maxDistance > 0 && (distance(goal % map.width, start % map.width) > maxDistance
+						|| distance(goal / map.width, start / map.width) > maxDistance)))
+				&& ++attempts < 1000);
+		if (attempts == 1000) {
+			continue;
+		}
+		const Query query = { static_cast<int>(start % map.width), static_cast<int>(start / map.width),
+				static_cast<int>(goal % map.width), static_cast<int>(goal / map.width) };
+		queries.push_back(query);
+	}
+	return queries;
+}
+
+/**
+ * @brief Returns the p-th percentile (nearest rank) of some values, 0 if there are none.
+ */
+inline double percentile(std::vector<double> values, const double& p) {
+	if (values.empty()) {
+		return 0.0;
+	}
+	std::sort(values.begin(), values.end());
+	size_t rank = static_cast<size_t>(p / 100.0 * values.size() + 0.999999);
+	rank = std::max<size_t>(1, std::min(rank, values.size()));
+	return values[rank - 1];
+}
+
+/**
+ * @brief Returns the peak resident memory of the process in KiB, 0 if it is not available.
+ */
+inline size_t peakMemoryKiB() {
+#if _WIN32 || _WIN64
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+#ifdef __APPLE__
+	return static_cast<size_t>(usage.ru_maxrss) / 1024;  // bytes on macOS
+#else
+	return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+/**
+ * @brief Measures the wall clock time since its creation.
+ */
+class Stopwatch {
+public:
+	Stopwatch() : begin(std::chrono::steady_clock::now()) {}
+
+	double milliseconds() const {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point begin;
+};
+
+/**
+ * @brief The statistics of one planner on one map, query by query.
+ */
+struct BenchmarkResult {
+	std::string planner;
+	std::string map;
+	size_t width;
+	size_t height;
+	std::vector<double> milliseconds;    ///< The latency of each query.
+	std::vector<size_t> expansions;      ///< The number of expanded nodes of each query.
+	std::vector<size_t> peakOpenList;    ///< The largest number of open nodes of each query.
+	std::vector<double> costs;           ///< The path costs of each query, -1 if no path was found.
+	size_t peakMemoryKiB;                ///< The peak resident memory of the process after the last query.
+
+	BenchmarkResult() : width(0), height(0), peakMemoryKiB(0) {}
+
+	BenchmarkResult(const std::string& planner, const SyntheticMap& map) :
+			planner(planner), map(map.name), width(map.width), height(map.height), peakMemoryKiB(0) {}
+
+	void add(const double& queryMilliseconds, const size_t& queryExpansions, const size_t& queryPeakOpenList, const double& queryCosts) {
+		milliseconds.push_back(queryMilliseconds);
+		expansions.push_back(queryExpansions);
+		peakOpenList.push_back(queryPeakOpenList);
+		costs.push_back(queryCosts);
+		peakMemoryKiB = benchmark_helpers::peakMemoryKiB();
+	}
+};
+
+template<typename T>
+void writeJsonArray(std::ostream& out, const std::vector<T>& values) {
+	out << "[";
+	for (size_t i = 0; i < values.size(); ++i) {
+		out << (i > 0 ? ", " : "") << values[i];
+	}
+	out << "]";
+}
+
+/**
+ * @brief Writes the results of a benchmark as JSON.
+ * @param out The stream, e.g. std::cout.
+ * @param module The name of the module, e.g. "path_planning".
+ * @param results The results of all planners on all maps.
+ *
+ * For each result, the summary (number of solved queries, total and maximum expansions, largest
+ * open list, peak memory, latency percentiles) is followed by the statistics of each query.
+ */
+inline void writeJson(std::ostream& out, const std::string& module, const std::vector<BenchmarkResult>& results) {
+	const std::ios::fmtflags flags = out.flags();
+	const std::streamsize precision = out.precision();
+	out << std::fixed << std::setprecision(4);
+	out << "{\n  \"module\": \"" << module << "\",\n  \"results\": [";
+	for (size_t r = 0; r < results.size(); ++r) {
+		const BenchmarkResult& result = results[r];
+		size_t solved = 0, totalExpansions = 0, maxExpansions = 0, peakOpenList = 0;
+		for (size_t i = 0; i < result.costs.size(); ++i) {
+			solved += result.costs[i] >= 0.0 ? 1 : 0;
+			totalExpansions += result.expansions[i];
+			maxExpansions = std::max(maxExpansions, result.expansions[i]);
+			peakOpenList = std::max(peakOpenList, result.peakOpenList[i]);
+		}
+		double totalMilliseconds = 0.0;
+		for (size_t i = 0; i < result.milliseconds.size(); ++i) {
+			totalMilliseconds += result.milliseconds[i];
+		}
+		out << (r > 0 ? "," : "") << "\n    {\n"
+				<< "      \"planner\": \"" << result.planner << "\",\n"
+				<< "      \"map\": \"" << result.map << "\",\n"
+				<< "      \"width\": " << result.width << ",\n"
+				<< "      \"height\": " << result.height << ",\n"
+				<< "      \"queries\": " << result.costs.size() << ",\n"
+				<< "      \"solved\": " << solved << ",\n"
+				<< "      \"expansions\": " << totalExpansions << ",\n"
+				<< "      \"maxExpansions\": " << maxExpansions << ",\n"
+				<< "      \"peakOpenListSize\": " << peakOpenList << ",\n"
+				<< "      \"peakMemoryKiB\": " << result.peakMemoryKiB << ",\n"
+				<< "      \"totalMs\": " << totalMilliseconds << ",\n"
+				<< "      \"p50Ms\": " << percentile(result.milliseconds, 50.0) << ",\n"
+				<< "      \"p99Ms\": " << percentile(result.milliseconds, 99.0) << ",\n"
+				<< "      \"perQuery\": {\n        \"ms\": ";
+		writeJsonArray(out, result.milliseconds);
+		out << ",\n        \"expansions\": ";
+		writeJsonArray(out, result.expansions);
+		out << ",\n        \"peakOpenListSize\": ";
+		writeJsonArray(out, result.peakOpenList);
+		out << ",\n        \"costs\": ";
+		writeJsonArray(out, result.costs);
+		out << "\n      }\n    }";
+	}
+	out << "\n  ]\n}" << std::endl;
+	out.flags(flags);
+	out.precision(precision);
+}
+
+}  // namespace benchmark_helpers
+
+#endif // BENCHMARK_HELPERS_H_
@@ -0,0 +1,132 @@
+#ifndef FILE_HELPERS_H_
+#define FILE_HELPERS_H_
+
+/*
+ * Read-only file access shared by the map loaders of the planning modules.
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#if _WIN32 || _WIN64
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace file_helpers {
+
+/**
+ * @brief Read-only view of the contents of a file.
+ *
+ * On POSIX systems, the file is mapped into memory with mmap(), so nothing is copied and the
+ * pages are only read from the page cache when they are accessed. On other systems, the file
+ * is read into a buffer with a single read.
+ */
+class MappedFile {
+public:
+	MappedFile() : begin(NULL), length(0), mapped(false) {}
+
+	~MappedFile() {
+		close();
+	}
+
+	/**
+	 * @brief Maps a file, closing the previously mapped file.
+	 * @param filename The filename of the file.
+	 * @return True iff the file could be opened and mapped.
+	 */
+	bool open(const std::string& filename) {
+		close();
+#if _WIN32 || _WIN64
+		std::ifstream ifs(filename.c_str(), std::ios::binary | std::ios::ate);
+		if (!ifs.good()) {
+			return false;
+		}
+		buffer.resize(static_cast<size_t>(ifs.tellg()));
+		ifs.seekg(0);
+		if (!buffer.empty() && !ifs.read(&buffer[0], buffer.size())) {
+			buffer.clear();
+			return false;
+		}
+		begin = buffer.empty() ? NULL : &buffer[0];
+		length = buffer.size();
+		return true;
+#else
+		const int fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return false;
+		}
+		struct stat status;
+		if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode)) {
+			::close(fd);
+			return false;
+		}
+		length = static_cast<size_t>(status.st_size);
+		if (length > 0) {
+			void * const address = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (address == MAP_FAILED) {
+				::close(fd);
+				length = 0;
+				return false;
+			}
+			// the maps are decoded front to back
+			madvise(address, length, MADV_SEQUENTIAL);
+			begin = static_cast<const char *>(address);
+			mapped = true;
+		}
+		// the mapping stays valid after the descriptor is closed
+		::close(fd);
+		return true;
+#endif
+	}
+
+	/**
+	 * @brief Unmaps the file. The pointers returned by data() become invalid.
+	 */
+	void close() {
+#if !(_WIN32 || _WIN64)
+		if (mapped) {
+			munmap(const_cast<char *>(begin), length);
+		}
+#endif
+		std::vector<char>().swap(buffer);
+		begin = NULL;
+		length = 0;
+		mapped = false;
+	}
+
+	/**
+	 * @brief Returns the contents of the file.
+	 * @return Pointer to the first byte, NULL if no file is mapped or the file is empty.
+	 *
+	 * The memory is aligned to a page (or to the alignment of new) and read-only.
+	 */
+	const char * data() const {
+		return begin;
+	}
+
+	/**
+	 * @brief Returns the size of the file.
+	 * @return The size in bytes, 0 if no file is mapped.
+	 */
+	size_t size() const {
+		return length;
+	}
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+	const char *begin;
+	size_t length;
+	bool mapped;              ///< True iff begin points to a memory mapping, otherwise into buffer.
+	std::vector<char> buffer;
+};
+
+}  // namespace file_helpers
+
+#endif // FILE_HELPERS_H_